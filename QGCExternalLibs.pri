@@ -120,6 +120,7 @@ INCLUDEPATH += \
 INCLUDEPATH += libs/shapelib
 SOURCES += \
     libs/shapelib/shpopen.c \
+    libs/shapelib/dbfopen.c \
     libs/shapelib/safileio.c
 
 #
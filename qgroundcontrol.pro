@@ -482,6 +482,7 @@ DebugBuild { PX4FirmwarePlugin { PX4FirmwarePluginFactory { APMFirmwarePlugin {
         src/FactSystem/FactSystemTestBase.h \
         src/FactSystem/FactSystemTestGeneric.h \
         src/FactSystem/FactSystemTestPX4.h \
+        src/FactSystem/FactValueTest.h \
         src/FactSystem/ParameterManagerTest.h \
         src/MissionManager/CameraCalcTest.h \
         src/MissionManager/CameraSectionTest.h \
@@ -507,17 +508,25 @@ DebugBuild { PX4FirmwarePlugin { PX4FirmwarePluginFactory { APMFirmwarePlugin {
         src/MissionManager/TransectStyleComplexItemTestBase.h \
         src/MissionManager/VisualMissionItemTest.h \
         src/qgcunittest/ComponentInformationCacheTest.h \
+        src/qgcunittest/CRC32Test.h \
         src/qgcunittest/GeoTest.h \
         src/qgcunittest/MavlinkLogTest.h \
         src/qgcunittest/MultiSignalSpy.h \
         src/qgcunittest/MultiSignalSpyV2.h \
         src/qgcunittest/UnitTest.h \
+        src/SiYi/SiYiTcpClientTest.h \
+        src/Terrain/TerrainQueryTest.h \
+        src/Vehicle/CompInfoParamTest.h \
         src/Vehicle/FTPManagerTest.h \
         src/Vehicle/InitialConnectTest.h \
+        src/Vehicle/MAVLinkLogManagerTest.h \
+        src/Vehicle/MockLinkSwarmTest.h \
         src/Vehicle/RequestMessageTest.h \
         src/Vehicle/SendMavCommandWithHandlerTest.h \
         src/Vehicle/SendMavCommandWithSignallingTest.h \
         src/Vehicle/VehicleLinkManagerTest.h \
+        src/VideoManager/TelemetrySidecarWriterTest.h \
+        src/uas/UASMessageHandlerTest.h \
         #src/qgcunittest/RadioConfigTest.h \
         #src/AnalyzeView/LogDownloadTest.h \
         #src/qgcunittest/FileDialogTest.h \
@@ -530,6 +539,7 @@ DebugBuild { PX4FirmwarePlugin { PX4FirmwarePluginFactory { APMFirmwarePlugin {
         src/FactSystem/FactSystemTestBase.cc \
         src/FactSystem/FactSystemTestGeneric.cc \
         src/FactSystem/FactSystemTestPX4.cc \
+        src/FactSystem/FactValueTest.cc \
         src/FactSystem/ParameterManagerTest.cc \
         src/MissionManager/CameraCalcTest.cc \
         src/MissionManager/CameraSectionTest.cc \
@@ -555,18 +565,26 @@ DebugBuild { PX4FirmwarePlugin { PX4FirmwarePluginFactory { APMFirmwarePlugin {
         src/MissionManager/TransectStyleComplexItemTestBase.cc \
         src/MissionManager/VisualMissionItemTest.cc \
         src/qgcunittest/ComponentInformationCacheTest.cc \
+        src/qgcunittest/CRC32Test.cc \
         src/qgcunittest/GeoTest.cc \
         src/qgcunittest/MavlinkLogTest.cc \
         src/qgcunittest/MultiSignalSpy.cc \
         src/qgcunittest/MultiSignalSpyV2.cc \
         src/qgcunittest/UnitTest.cc \
         src/qgcunittest/UnitTestList.cc \
+        src/SiYi/SiYiTcpClientTest.cc \
+        src/Terrain/TerrainQueryTest.cc \
+        src/Vehicle/CompInfoParamTest.cc \
         src/Vehicle/FTPManagerTest.cc \
         src/Vehicle/InitialConnectTest.cc \
+        src/Vehicle/MAVLinkLogManagerTest.cc \
+        src/Vehicle/MockLinkSwarmTest.cc \
         src/Vehicle/RequestMessageTest.cc \
         src/Vehicle/SendMavCommandWithHandlerTest.cc \
         src/Vehicle/SendMavCommandWithSignallingTest.cc \
         src/Vehicle/VehicleLinkManagerTest.cc \
+        src/VideoManager/TelemetrySidecarWriterTest.cc \
+        src/uas/UASMessageHandlerTest.cc \
         #src/qgcunittest/RadioConfigTest.cc \
         #src/AnalyzeView/LogDownloadTest.cc \
         #src/qgcunittest/FileDialogTest.cc \
@@ -574,6 +592,14 @@ DebugBuild { PX4FirmwarePlugin { PX4FirmwarePluginFactory { APMFirmwarePlugin {
         #src/qgcunittest/MainWindowTest.cc \
         #src/qgcunittest/MessageBoxTest.cc \
 
+    # Fake bootloader runs on a pseudo terminal
+    !NoSerialBuild { unix {
+        HEADERS += \
+            src/VehicleSetup/BootloaderTest.h
+        SOURCES += \
+            src/VehicleSetup/BootloaderTest.cc
+    } }
+
 } } } } } }
 
 # Main QGC Headers and Source files
@@ -610,6 +636,7 @@ HEADERS += \
     src/MissionManager/CorridorScanPlanCreator.h \
     src/MissionManager/BlankPlanCreator.h \
     src/MissionManager/FixedWingLandingComplexItem.h \
+    src/MissionManager/FleetPlanUploader.h \
     src/MissionManager/GeoFenceController.h \
     src/MissionManager/GeoFenceManager.h \
     src/MissionManager/KMLPlanDomDocument.h \
@@ -621,6 +648,7 @@ HEADERS += \
     src/MissionManager/MissionItem.h \
     src/MissionManager/MissionManager.h \
     src/MissionManager/MissionSettingsItem.h \
+    src/MissionManager/PlanBinaryFile.h \
     src/MissionManager/PlanElementController.h \
     src/MissionManager/PlanCreator.h \
     src/MissionManager/PlanManager.h \
@@ -778,6 +806,7 @@ HEADERS += \
     src/comm/MockLink.h \
     src/comm/MockLinkFTP.h \
     src/comm/MockLinkMissionItemHandler.h \
+    src/comm/MockLinkSwarm.h \
 }
 
 WindowsBuild {
@@ -864,6 +893,7 @@ SOURCES += \
     src/MissionManager/CorridorScanPlanCreator.cc \
     src/MissionManager/BlankPlanCreator.cc \
     src/MissionManager/FixedWingLandingComplexItem.cc \
+    src/MissionManager/FleetPlanUploader.cc \
     src/MissionManager/GeoFenceController.cc \
     src/MissionManager/GeoFenceManager.cc \
     src/MissionManager/KMLPlanDomDocument.cc \
@@ -875,6 +905,7 @@ SOURCES += \
     src/MissionManager/MissionItem.cc \
     src/MissionManager/MissionManager.cc \
     src/MissionManager/MissionSettingsItem.cc \
+    src/MissionManager/PlanBinaryFile.cc \
     src/MissionManager/PlanElementController.cc \
     src/MissionManager/PlanCreator.cc \
     src/MissionManager/PlanManager.cc \
@@ -1024,6 +1055,7 @@ SOURCES += \
     src/comm/MockLink.cc \
     src/comm/MockLinkFTP.cc \
     src/comm/MockLinkMissionItemHandler.cc \
+    src/comm/MockLinkSwarm.cc \
 }
 
 !NoSerialBuild {
@@ -1263,6 +1295,7 @@ HEADERS += \
     src/FactSystem/FactGroup.h \
     src/FactSystem/FactMetaData.h \
     src/FactSystem/FactSystem.h \
+    src/FactSystem/FactValueNotifier.h \
     src/FactSystem/FactValueSliderListModel.h \
     src/FactSystem/ParameterManager.h \
     src/FactSystem/SettingsFact.h \
@@ -1273,6 +1306,7 @@ SOURCES += \
     src/FactSystem/FactGroup.cc \
     src/FactSystem/FactMetaData.cc \
     src/FactSystem/FactSystem.cc \
+    src/FactSystem/FactValueNotifier.cc \
     src/FactSystem/FactValueSliderListModel.cc \
     src/FactSystem/ParameterManager.cc \
     src/FactSystem/SettingsFact.cc \
@@ -1471,11 +1505,15 @@ INCLUDEPATH += \
 
 HEADERS += \
     src/VideoManager/SubtitleWriter.h \
-    src/VideoManager/VideoManager.h
+    src/VideoManager/TelemetrySidecarWriter.h \
+    src/VideoManager/VideoManager.h \
+    src/VideoManager/VideoReceiverPool.h
 
 SOURCES += \
     src/VideoManager/SubtitleWriter.cc \
-    src/VideoManager/VideoManager.cc
+    src/VideoManager/TelemetrySidecarWriter.cc \
+    src/VideoManager/VideoManager.cc \
+    src/VideoManager/VideoReceiverPool.cc
 
 contains (CONFIG, DISABLE_VIDEOSTREAMING) {
     message("Skipping support for video streaming (manual override from command line)")
@@ -9,6 +9,7 @@
 
 #include "Fact.h"
 #include "FactValueSliderListModel.h"
+#include "FactValueNotifier.h"
 #include "QGCMAVLink.h"
 #include "QGCApplication.h"
 #include "QGCCorePlugin.h"
@@ -71,6 +72,16 @@ Fact::Fact(const QString& settingsGroup, FactMetaData* metaData, QObject* parent
     _init();
 }
 
+Fact::~Fact()
+{
+    if (_queuedForNotify) {
+        FactValueNotifier* notifier = FactValueNotifier::instance();
+        if (notifier) {
+            notifier->_removeFact(this);
+        }
+    }
+}
+
 Fact::Fact(const Fact& other, QObject* parent)
     : QObject(parent)
 {
@@ -100,6 +111,7 @@ const Fact& Fact::operator=(const Fact& other)
     } else {
         _metaData = nullptr;
     }
+    _clearCookedValueCache();
     
     return *this;
 }
@@ -112,6 +124,7 @@ void Fact::forceSetRawValue(const QVariant& value)
         
         if (_metaData->convertAndValidateRaw(value, true /* convertOnly */, typedValue, errorString)) {
             _rawValue.setValue(typedValue);
+            _clearCookedValueCache();
             _sendValueChangedSignal(cookedValue());
             //-- Must be in this order
             emit _containerRawValueChanged(rawValue());
@@ -131,6 +144,7 @@ void Fact::setRawValue(const QVariant& value)
         if (_metaData->convertAndValidateRaw(value, true /* convertOnly */, typedValue, errorString)) {
             if (typedValue != _rawValue) {
                 _rawValue.setValue(typedValue);
+                _clearCookedValueCache();
                 _sendValueChangedSignal(cookedValue());
                 //-- Must be in this order
                 emit _containerRawValueChanged(rawValue());
@@ -142,6 +156,65 @@ void Fact::setRawValue(const QVariant& value)
     }
 }
 
+void Fact::setTelemetryRawValue(double value)
+{
+    QVariant typedValue;
+
+    // Same conversions as FactMetaData::convertAndValidateRaw, without the round trip through QVariant
+    switch (_type) {
+    case FactMetaData::valueTypeInt8:
+    case FactMetaData::valueTypeInt16:
+    case FactMetaData::valueTypeInt32:
+        if (qIsNaN(value)) {
+            return;
+        }
+        typedValue = QVariant(static_cast<int>(qRound64(value)));
+        break;
+    case FactMetaData::valueTypeInt64:
+        if (qIsNaN(value)) {
+            return;
+        }
+        typedValue = QVariant(static_cast<qlonglong>(qRound64(value)));
+        break;
+    case FactMetaData::valueTypeUint8:
+    case FactMetaData::valueTypeUint16:
+    case FactMetaData::valueTypeUint32:
+        if (qIsNaN(value)) {
+            return;
+        }
+        typedValue = QVariant(static_cast<uint>(qRound64(value)));
+        break;
+    case FactMetaData::valueTypeUint64:
+        if (qIsNaN(value)) {
+            return;
+        }
+        typedValue = QVariant(static_cast<qulonglong>(qRound64(value)));
+        break;
+    case FactMetaData::valueTypeFloat:
+        typedValue = QVariant(static_cast<float>(value));
+        break;
+    case FactMetaData::valueTypeElapsedTimeInSeconds:
+    case FactMetaData::valueTypeDouble:
+        typedValue = QVariant(value);
+        break;
+    case FactMetaData::valueTypeBool:
+        typedValue = QVariant(QVariant(value).toBool());
+        break;
+    default:
+        setRawValue(value);
+        return;
+    }
+
+    if (typedValue != _rawValue) {
+        _rawValue = typedValue;
+        _clearCookedValueCache();
+        _sendValueChangedSignal(cookedValue());
+        //-- Must be in this order
+        emit _containerRawValueChanged(rawValue());
+        emit rawValueChanged(_rawValue);
+    }
+}
+
 void Fact::setCookedValue(const QVariant& value)
 {
     if (_metaData) {
@@ -181,6 +254,7 @@ void Fact::_containerSetRawValue(const QVariant& value)
 {
     if(_rawValue != value) {
         _rawValue = value;
+        _clearCookedValueCache();
         _sendValueChangedSignal(cookedValue());
         emit rawValueChanged(_rawValue);
     }
@@ -202,7 +276,13 @@ int Fact::componentId(void) const
 QVariant Fact::cookedValue(void) const
 {
     if (_metaData) {
-        return _metaData->rawTranslator()(_rawValue);
+        FactMetaData::Translator translator = _metaData->rawTranslator();
+        if (translator != _cookedValueCacheTranslator) {
+            _cookedValueCache               = translator(_rawValue);
+            _cookedValueCacheTranslator     = translator;
+            _cookedValueStringCacheValid    = false;
+        }
+        return _cookedValueCache;
     } else {
         qWarning() << kMissingMetadata << name();
         return _rawValue;
@@ -397,7 +477,17 @@ QString Fact::rawValueString(void) const
 
 QString Fact::cookedValueString(void) const
 {
-    return _variantToString(cookedValue(), decimalPlaces());
+    if (!_metaData) {
+        return _variantToString(cookedValue(), decimalPlaces());
+    }
+
+    // Refreshes the cached cooked value first, which also invalidates the string when needed
+    QVariant value = cookedValue();
+    if (!_cookedValueStringCacheValid) {
+        _cookedValueStringCache         = _variantToString(value, decimalPlaces());
+        _cookedValueStringCacheValid    = true;
+    }
+    return _cookedValueStringCache;
 }
 
 QVariant Fact::rawDefaultValue(void) const
@@ -579,6 +669,7 @@ QString Fact::group(void) const
 void Fact::setMetaData(FactMetaData* metaData, bool setDefaultFromMetaData)
 {
     _metaData = metaData;
+    _clearCookedValueCache();
     if (setDefaultFromMetaData && metaData->defaultValueAvailable()) {
         setRawValue(rawDefaultValue());
     }
@@ -672,14 +763,29 @@ void Fact::setSendValueChangedSignals (bool sendValueChangedSignals)
 
 void Fact::_sendValueChangedSignal(QVariant value)
 {
-    if (_sendValueChangedSignals) {
+    FactValueNotifier* notifier = _sendValueChangedSignals ? nullptr : FactValueNotifier::instance();
+
+    if (!notifier) {
         emit valueChanged(value);
         _deferredValueChangeSignal = false;
     } else {
+        if (_deferredValueChangeSignal) {
+            notifier->_valueCoalesced();
+        }
         _deferredValueChangeSignal = true;
+        if (!_queuedForNotify) {
+            notifier->_queueFact(this);
+        }
     }
 }
 
+bool Fact::_hasValueChangedObservers(void) const
+{
+    // Also true for QML bindings to any of the properties notified by valueChanged
+    static const QMetaMethod valueChangedSignal = QMetaMethod::fromSignal(&Fact::valueChanged);
+    return isSignalConnected(valueChangedSignal);
+}
+
 void Fact::sendDeferredValueChangedSignal(void)
 {
     if (_deferredValueChangeSignal) {
@@ -33,6 +33,8 @@ public:
     /// custom builds to override the metadata.
     Fact(const QString& settingsGroup, FactMetaData* metaData, QObject* parent = nullptr);
 
+    ~Fact();
+
     const Fact& operator=(const Fact& other);
 
     Q_PROPERTY(int          componentId             READ componentId                                        CONSTANT)
@@ -143,9 +145,12 @@ public:
     int  valueIndex         (const QString& value);
 
     // The following methods allow you to defer sending of the valueChanged signals in order to implement
-    // rate limited signalling for ui performance. Used by FactGroup for example.
+    // rate limited signalling for ui performance. Used by FactGroup for example. Deferred signals are sent
+    // by FactValueNotifier, at most once per display frame.
 
     void setSendValueChangedSignals (bool sendValueChangedSignals);
+    /// Minimum time between deferred valueChanged signals, 0: every frame with a change
+    void setDeferredValueChangeInterval(int intervalMSecs) { _deferredValueChangeIntervalMSecs = intervalMSecs; }
     bool sendValueChangedSignals (void) const { return _sendValueChangedSignals; }
     bool deferredValueChangeSignal(void) const { return _deferredValueChangeSignal; }
     void clearDeferredValueChangeSignal(void) { _deferredValueChangeSignal = false; }
@@ -155,6 +160,11 @@ public:
 
     /// Sets and sends new value to vehicle even if value is the same
     void forceSetRawValue(const QVariant& value);
+
+    /// Fast path for values decoded from telemetry messages. Converts straight to the storage type of the
+    /// Fact, skipping the QVariant conversion and validation done by setRawValue. Signalling is the same as
+    /// setRawValue. String and custom Facts fall back to setRawValue.
+    void setTelemetryRawValue(double value);
     
     /// Sets the meta data associated with the Fact.
     ///     @param metaData FactMetaData for Fact
@@ -201,6 +211,10 @@ private:
 protected:
     QString _variantToString(const QVariant& variant, int decimalPlaces) const;
     void _sendValueChangedSignal(QVariant value);
+    bool _hasValueChangedObservers(void) const;
+
+    /// Must be called whenever _rawValue is changed directly
+    void _clearCookedValueCache(void) { _cookedValueCacheTranslator = nullptr; _cookedValueStringCacheValid = false; }
 
     QString                     _name;
     int                         _componentId;
@@ -211,4 +225,19 @@ protected:
     bool                        _deferredValueChangeSignal;
     FactValueSliderListModel*   _valueSliderModel;
     bool                        _ignoreQGCRebootRequired;
+
+private:
+    // Deferred signal state, managed by FactValueNotifier
+    int                                 _deferredValueChangeIntervalMSecs   = 0;
+    qint64                              _lastValueChangedMSecs              = 0;
+    bool                                _queuedForNotify                    = false;
+
+    // Cooked value and string are only recalculated after the raw value changes. The cached value is
+    // only valid for the translator it was created with, nullptr: nothing cached.
+    mutable QVariant                    _cookedValueCache;
+    mutable FactMetaData::Translator    _cookedValueCacheTranslator     = nullptr;
+    mutable QString                     _cookedValueStringCache;
+    mutable bool                        _cookedValueStringCacheValid    = false;
+
+    friend class FactValueNotifier;
 };
@@ -23,7 +23,6 @@ FactGroup::FactGroup(int updateRateMsecs, const QString& metaDataFile, QObject*
     , _updateRateMSecs(updateRateMsecs)
     , _ignoreCamelCase(ignoreCamelCase)
 {
-    _setupTimer();
     _nameToFactMetaDataMap = FactMetaData::createMapFromJsonFile(metaDataFile, this);
     QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
 }
@@ -33,7 +32,6 @@ FactGroup::FactGroup(int updateRateMsecs, QObject* parent, bool ignoreCamelCase)
     , _updateRateMSecs(updateRateMsecs)
     , _ignoreCamelCase(ignoreCamelCase)
 {
-    _setupTimer();
     QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
 }
 
@@ -43,16 +41,6 @@ void FactGroup::_loadFromJsonArray(const QJsonArray jsonArray)
     _nameToFactMetaDataMap = FactMetaData::createMapFromJsonArray(jsonArray, defineMap, this);
 }
 
-void FactGroup::_setupTimer()
-{
-    if (_updateRateMSecs > 0) {
-        connect(&_updateTimer, &QTimer::timeout, this, &FactGroup::_updateAllValues);
-        _updateTimer.setSingleShot(false);
-        _updateTimer.setInterval(_updateRateMSecs);
-        _updateTimer.start();
-    }
-}
-
 bool FactGroup::factExists(const QString& name)
 {
     if (name.contains(".")) {
@@ -129,7 +117,9 @@ void FactGroup::_addFact(Fact* fact, const QString& name)
         return;
     }
 
+    // Rate limited values are sent by FactValueNotifier, coalesced to display frames
     fact->setSendValueChangedSignals(_updateRateMSecs == 0);
+    fact->setDeferredValueChangeInterval(_updateRateMSecs);
     if (_nameToFactMetaDataMap.contains(name)) {
         fact->setMetaData(_nameToFactMetaDataMap[name], true /* setDefaultFromMetaData */);
     }
@@ -151,26 +141,15 @@ void FactGroup::_addFactGroup(FactGroup* factGroup, const QString& name)
     emit factGroupNamesChanged();
 }
 
-void FactGroup::_updateAllValues(void)
-{
-    for(Fact* fact: _nameToFactMap) {
-        fact->sendDeferredValueChangedSignal();
-    }
-}
-
 void FactGroup::setLiveUpdates(bool liveUpdates)
 {
-    if (_updateTimer.interval() == 0) {
+    if (_updateRateMSecs == 0) {
         return;
     }
 
-    if (liveUpdates) {
-        _updateTimer.stop();
-    } else {
-        _updateTimer.start();
-    }
+    // Live values still go through FactValueNotifier, but on every frame instead of at the group rate
     for(Fact* fact: _nameToFactMap) {
-        fact->setSendValueChangedSignals(liveUpdates);
+        fact->setDeferredValueChangeInterval(liveUpdates ? 0 : _updateRateMSecs);
     }
 }
 
@@ -180,6 +159,12 @@ QString FactGroup::_camelCase(const QString& text)
     return text[0].toLower() + text.right(text.length() - 1);
 }
 
+void FactGroup::_setHandledMessageIds(const QVector<uint32_t>& msgIds)
+{
+    _handledMessageIds  = msgIds;
+    _handlesAllMessages = false;
+}
+
 void FactGroup::handleMessage(Vehicle* /* vehicle */, mavlink_message_t& /* message */)
 {
     // Default implementation does nothing
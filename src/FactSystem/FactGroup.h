@@ -15,6 +15,7 @@
 
 #include <QStringList>
 #include <QMap>
+#include <QVector>
 #include <QTimer>
 
 class Vehicle;
@@ -54,21 +55,25 @@ public:
     /// Allows a FactGroup to parse incoming messages and fill in values
     virtual void handleMessage(Vehicle* vehicle, mavlink_message_t& message);
 
+    /// @return Message ids handleMessage is called for, only valid if handlesAllMessages is false
+    const QVector<uint32_t>& handledMessageIds(void) const { return _handledMessageIds; }
+
+    /// @return true: Group has not declared its message ids and handleMessage is called for every message
+    bool handlesAllMessages(void) const { return _handlesAllMessages; }
+
 signals:
     void factNamesChanged           (void);
     void factGroupNamesChanged      (void);
     void telemetryAvailableChanged  (bool telemetryAvailable);
 
-protected slots:
-    virtual void _updateAllValues(void);
-
 protected:
     void _addFact               (Fact* fact, const QString& name);
     void _addFactGroup          (FactGroup* factGroup, const QString& name);
     void _loadFromJsonArray     (const QJsonArray jsonArray);
     void _setTelemetryAvailable (bool telemetryAvailable);
+    void _setHandledMessageIds  (const QVector<uint32_t>& msgIds);
 
-    int  _updateRateMSecs;   ///< Update rate for Fact::valueChanged signals, 0: immediate update
+    int  _updateRateMSecs;   ///< Minimum interval between Fact::valueChanged signals, 0: immediate update
 
     QMap<QString, Fact*>            _nameToFactMap;
     QMap<QString, FactGroup*>       _nameToFactGroupMap;
@@ -76,10 +81,11 @@ protected:
     QStringList                     _factNames;
 
 private:
-    void    _setupTimer (void);
     QString _camelCase  (const QString& text);
 
     bool    _ignoreCamelCase    = false;
-    QTimer  _updateTimer;
     bool    _telemetryAvailable = false;
+
+    QVector<uint32_t>   _handledMessageIds;
+    bool                _handlesAllMessages = true;
 };
@@ -1488,6 +1488,19 @@ QMap<QString, FactMetaData*> FactMetaData::createMapFromJsonFile(const QString&
     return createMapFromJsonArray(factArray, defineMap, metaDataParent);
 }
 
+const FactMetaData::NameToMetaDataMap_t& FactMetaData::sharedMapFromJsonFile(const QString& jsonFilename, const QString& settingsGroup)
+{
+    // Shared meta data is never deleted, it lives for the lifetime of the app
+    static QHash<QString /* jsonFilename:settingsGroup */, NameToMetaDataMap_t> sharedMaps;
+
+    QString key = jsonFilename + QStringLiteral(":") + settingsGroup;
+    auto iter = sharedMaps.find(key);
+    if (iter == sharedMaps.end()) {
+        iter = sharedMaps.insert(key, createMapFromJsonFile(jsonFilename, nullptr /* metaDataParent */));
+    }
+    return iter.value();
+}
+
 QMap<QString, FactMetaData*> FactMetaData::createMapFromJsonArray(const QJsonArray jsonArray, QMap<QString, QString>& defineMap, QObject* metaDataParent)
 {
     QMap<QString, FactMetaData*> metaDataMap;
@@ -59,6 +59,12 @@ public:
     static QMap<QString, FactMetaData*> createMapFromJsonFile(const QString& jsonFilename, QObject* metaDataParent);
     static QMap<QString, FactMetaData*> createMapFromJsonArray(const QJsonArray jsonArray, DefineMap_t& defineMap, QObject* metaDataParent);
 
+    /// Returns a process wide meta data map for the specified json file. The file is only loaded and parsed the first time it is
+    /// requested, subsequent calls hand out the same meta data. The returned meta data is shared and must not be modified by the caller.
+    ///     @param settingsGroup Settings group the meta data is used with. The core plugin can adjust meta data per settings group,
+    ///                          so each group gets its own copy.
+    static const NameToMetaDataMap_t& sharedMapFromJsonFile(const QString& jsonFilename, const QString& settingsGroup = QString());
+
     static FactMetaData* createFromJsonObject(const QJsonObject& json, QMap<QString, QString>& defineMap, QObject* metaDataParent);
 
     const FactMetaData& operator=(const FactMetaData& other);
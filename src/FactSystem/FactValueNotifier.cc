@@ -0,0 +1,146 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "FactValueNotifier.h"
+#include "Fact.h"
+#include "QGCApplication.h"
+
+#include <QQuickWindow>
+#include <QScreen>
+
+#include <limits>
+
+QGC_LOGGING_CATEGORY(FactValueNotifierLog, "FactValueNotifierLog")
+
+static QPointer<FactValueNotifier> _factValueNotifier;
+
+FactValueNotifier::FactValueNotifier(QObject* parent)
+    : QObject(parent)
+{
+    _flushTimer.setSingleShot(true);
+    connect(&_flushTimer, &QTimer::timeout, this, &FactValueNotifier::flush);
+    _clock.start();
+}
+
+FactValueNotifier* FactValueNotifier::instance(void)
+{
+    // Owned by the application so its timer and window connection go away with it. Nothing is created before the
+    // application exists or once it is being destroyed, callers fall back to immediate signals then.
+    if (!_factValueNotifier && qgcApp()) {
+        _factValueNotifier = new FactValueNotifier(qgcApp());
+    }
+    return _factValueNotifier;
+}
+
+void FactValueNotifier::setWindow(QQuickWindow* window)
+{
+    if (_window) {
+        disconnect(_window, &QQuickWindow::afterAnimating, this, &FactValueNotifier::flush);
+    }
+
+    _window = window;
+
+    if (_window) {
+        // Called on the gui thread ahead of each frame, so the new values make it into that frame
+        connect(_window, &QQuickWindow::afterAnimating, this, &FactValueNotifier::flush);
+        if (_window->screen() && _window->screen()->refreshRate() > 0) {
+            _frameIntervalMSecs = qMax(1, qRound(1000.0 / _window->screen()->refreshRate()));
+        }
+    }
+}
+
+void FactValueNotifier::_queueFact(Fact* fact)
+{
+    fact->_queuedForNotify = true;
+    _queuedFacts.append(fact);
+
+    const qint64 waitMSecs = fact->_lastValueChangedMSecs + fact->_deferredValueChangeIntervalMSecs - _clock.elapsed();
+    if (!_flushTimer.isActive() || _flushTimer.remainingTime() > qMax(waitMSecs, static_cast<qint64>(_frameIntervalMSecs))) {
+        _scheduleFlush(waitMSecs);
+    }
+}
+
+void FactValueNotifier::_removeFact(Fact* fact)
+{
+    fact->_queuedForNotify = false;
+    _queuedFacts.removeOne(fact);
+
+    const int index = _flushingFacts.indexOf(fact);
+    if (index != -1) {
+        _flushingFacts[index] = nullptr;
+    }
+}
+
+void FactValueNotifier::_scheduleFlush(qint64 waitMSecs)
+{
+    // A frame drawn in the meantime flushes first, the timer covers the times nothing is rendered
+    _flushTimer.start(static_cast<int>(qMax(waitMSecs, static_cast<qint64>(_frameIntervalMSecs))));
+}
+
+void FactValueNotifier::flush(void)
+{
+    if (_queuedFacts.isEmpty() || !_flushingFacts.isEmpty()) {
+        return;
+    }
+
+    const qint64 now = _clock.elapsed();
+
+    // Signals sent from here can change other Facts, those queue up for the next flush
+    _flushingFacts.swap(_queuedFacts);
+
+    for (int i=0; i<_flushingFacts.count(); i++) {
+        Fact* fact = _flushingFacts[i];
+
+        if (!fact) {
+            continue;   // Destroyed by an earlier signal from this flush
+        }
+
+        if (fact->deferredValueChangeSignal()) {
+            const qint64 dueMSecs = fact->_lastValueChangedMSecs + fact->_deferredValueChangeIntervalMSecs;
+            if (dueMSecs > now) {
+                _queuedFacts.append(fact);
+                continue;
+            }
+        }
+
+        fact->_queuedForNotify      = false;
+        fact->_lastValueChangedMSecs = now;
+
+        if (!fact->deferredValueChangeSignal()) {
+            continue;   // Sent or cleared by someone else since it was queued
+        }
+
+        if (fact->_hasValueChangedObservers()) {
+            _emittedCount++;
+            fact->sendDeferredValueChangedSignal();
+        } else {
+            // Anyone binding to the value later reads the current value at that point
+            _suppressedCount++;
+            fact->clearDeferredValueChangeSignal();
+        }
+    }
+
+    _flushingFacts.clear();
+
+    if (_queuedFacts.isEmpty()) {
+        _flushTimer.stop();
+    } else {
+        qint64 nextDueMSecs = std::numeric_limits<qint64>::max();
+        for (const Fact* fact: _queuedFacts) {
+            nextDueMSecs = qMin(nextDueMSecs, fact->_lastValueChangedMSecs + fact->_deferredValueChangeIntervalMSecs);
+        }
+        _scheduleFlush(nextDueMSecs - now);
+    }
+
+    if (now - _lastCountsMSecs >= countsIntervalMSecs) {
+        _lastCountsMSecs = now;
+        qCDebug(FactValueNotifierLog) << "emitted" << _emittedCount << "suppressed" << _suppressedCount << "coalesced" << _coalescedCount;
+        emit countsChanged();
+    }
+}
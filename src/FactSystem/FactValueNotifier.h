@@ -0,0 +1,80 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "QGCLoggingCategory.h"
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QVector>
+
+Q_DECLARE_LOGGING_CATEGORY(FactValueNotifierLog)
+
+class Fact;
+class QQuickWindow;
+
+/// Sends the deferred valueChanged signals of all Facts in a single pass per display frame.
+///
+/// A Fact which does not send value changes immediately (see Fact::setSendValueChangedSignals) queues itself here on
+/// its first change. Queued Facts are handled on each frame of the main window, or from a timer while nothing is being
+/// rendered. A Fact is not notified more often than its deferred value change interval, and a Fact which nobody is
+/// connected to, neither QML bindings nor C++, is dropped from the queue without a signal.
+class FactValueNotifier : public QObject
+{
+    Q_OBJECT
+
+public:
+    FactValueNotifier(QObject* parent = nullptr);
+
+    Q_PROPERTY(quint64 emittedCount     READ emittedCount       NOTIFY countsChanged)
+    Q_PROPERTY(quint64 suppressedCount  READ suppressedCount    NOTIFY countsChanged)
+    Q_PROPERTY(quint64 coalescedCount   READ coalescedCount     NOTIFY countsChanged)
+
+    /// @return Notifier owned by the application, nullptr without one
+    static FactValueNotifier* instance(void);
+
+    /// Handle queued Facts once per frame of this window, nullptr for timer driven notification only
+    void setWindow(QQuickWindow* window);
+
+    quint64 emittedCount    (void) const { return _emittedCount; }      ///< valueChanged signals sent
+    quint64 suppressedCount (void) const { return _suppressedCount; }   ///< Notifications dropped for Facts without observers
+    quint64 coalescedCount  (void) const { return _coalescedCount; }    ///< Value changes folded into an already queued notification
+    int     queuedCount     (void) const { return _queuedFacts.count(); }
+
+    static const int countsIntervalMSecs = 10000;   ///< How often the counts are logged and countsChanged is signalled
+
+signals:
+    void countsChanged(void);
+
+public slots:
+    /// Notifies all queued Facts which are due
+    void flush(void);
+
+private:
+    void _queueFact     (Fact* fact);
+    void _removeFact    (Fact* fact);
+    void _valueCoalesced(void) { _coalescedCount++; }
+    void _scheduleFlush (qint64 waitMSecs);
+
+    QVector<Fact*>          _queuedFacts;
+    QVector<Fact*>          _flushingFacts;     ///< Facts taken from the queue by the flush in progress
+    QPointer<QQuickWindow>  _window;
+    int                     _frameIntervalMSecs = 16;
+    QTimer                  _flushTimer;
+    QElapsedTimer           _clock;
+    qint64                  _lastCountsMSecs    = 0;
+    quint64                 _emittedCount       = 0;
+    quint64                 _suppressedCount    = 0;
+    quint64                 _coalescedCount     = 0;
+
+    friend class Fact;
+};
@@ -0,0 +1,200 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "FactValueTest.h"
+#include "Fact.h"
+#include "FactValueNotifier.h"
+
+#include <QSignalSpy>
+
+namespace {
+    int _translatorCalls = 0;
+
+    QVariant _countingTranslator(const QVariant& from)
+    {
+        _translatorCalls++;
+        return from.toDouble() * 2.0;
+    }
+
+    QVariant _otherTranslator(const QVariant& from)
+    {
+        return from.toDouble() * 3.0;
+    }
+}
+
+void FactValueTest::_telemetryConversion(void)
+{
+    // The fast path must store exactly what setRawValue would have stored
+    static const FactMetaData::ValueType_t types[] = {
+        FactMetaData::valueTypeUint8,   FactMetaData::valueTypeInt8,
+        FactMetaData::valueTypeUint16,  FactMetaData::valueTypeInt16,
+        FactMetaData::valueTypeUint32,  FactMetaData::valueTypeInt32,
+        FactMetaData::valueTypeUint64,  FactMetaData::valueTypeInt64,
+        FactMetaData::valueTypeFloat,   FactMetaData::valueTypeDouble,
+        FactMetaData::valueTypeBool,    FactMetaData::valueTypeElapsedTimeInSeconds,
+        FactMetaData::valueTypeString,
+    };
+    static const double values[] = { 0, 1, 42.4, 42.5, 1e-7 * 473977419, 65535 };
+
+    for (FactMetaData::ValueType_t type: types) {
+        for (double value: values) {
+            Fact expected(0, "expected", type);
+            Fact actual(0, "actual", type);
+
+            expected.setRawValue(value);
+            actual.setTelemetryRawValue(value);
+
+            QCOMPARE(actual.rawValue().userType(), expected.rawValue().userType());
+            QCOMPARE(actual.rawValue(), expected.rawValue());
+        }
+    }
+
+    // Signals go out as for setRawValue, and only on change
+    Fact fact(0, "fact", FactMetaData::valueTypeDouble);
+    QSignalSpy valueSpy(&fact, &Fact::valueChanged);
+    QSignalSpy rawValueSpy(&fact, &Fact::rawValueChanged);
+    QSignalSpy containerSpy(&fact, &Fact::_containerRawValueChanged);
+
+    fact.setTelemetryRawValue(12.5);
+    fact.setTelemetryRawValue(12.5);
+    QCOMPARE(valueSpy.count(), 1);
+    QCOMPARE(rawValueSpy.count(), 1);
+    QCOMPARE(containerSpy.count(), 1);
+    QCOMPARE(valueSpy[0][0].toDouble(), 12.5);
+
+    // NaN can't be stored in an integer fact, the value is left alone
+    Fact intFact(0, "intFact", FactMetaData::valueTypeUint32);
+    intFact.setTelemetryRawValue(7);
+    intFact.setTelemetryRawValue(qQNaN());
+    QCOMPARE(intFact.rawValue().toUInt(), 7u);
+}
+
+void FactValueTest::_cookedValueCache(void)
+{
+    Fact fact(0, "fact", FactMetaData::valueTypeDouble);
+    fact.metaData()->setTranslators(_countingTranslator, _countingTranslator);
+    fact.metaData()->setDecimalPlaces(1);
+
+    _translatorCalls = 0;
+    fact.setTelemetryRawValue(1.5);
+    QCOMPARE(_translatorCalls, 1);
+
+    // Repeated reads, as done by the ui for each bound property, don't translate again
+    QCOMPARE(fact.cookedValue().toDouble(), 3.0);
+    QCOMPARE(fact.cookedValue().toDouble(), 3.0);
+    QCOMPARE(fact.cookedValueString(), QStringLiteral("3.0"));
+    QCOMPARE(_translatorCalls, 1);
+
+    // Unchanged value keeps the cache
+    fact.setTelemetryRawValue(1.5);
+    fact.setRawValue(1.5);
+    QCOMPARE(_translatorCalls, 1);
+
+    // Each way of changing the raw value invalidates the cache
+    fact.setTelemetryRawValue(2.0);
+    QCOMPARE(fact.cookedValue().toDouble(), 4.0);
+    fact.setRawValue(3.0);
+    QCOMPARE(fact.cookedValue().toDouble(), 6.0);
+    QCOMPARE(fact.cookedValueString(), QStringLiteral("6.0"));
+    fact.forceSetRawValue(4.0);
+    QCOMPARE(fact.cookedValue().toDouble(), 8.0);
+    fact._containerSetRawValue(5.0);
+    QCOMPARE(fact.cookedValue().toDouble(), 10.0);
+    QCOMPARE(fact.cookedValueString(), QStringLiteral("10.0"));
+    QCOMPARE(_translatorCalls, 5);
+
+    // As does changing the translator
+    fact.metaData()->setTranslators(_otherTranslator, _otherTranslator);
+    QCOMPARE(fact.cookedValue().toDouble(), 15.0);
+    QCOMPARE(fact.cookedValueString(), QStringLiteral("15.0"));
+}
+
+void FactValueTest::_deferredNotify(void)
+{
+    FactValueNotifier* notifier = FactValueNotifier::instance();
+
+    Fact observed   (0, "observed",     FactMetaData::valueTypeDouble);
+    Fact unobserved (0, "unobserved",   FactMetaData::valueTypeDouble);
+    Fact rateLimited(0, "rateLimited",  FactMetaData::valueTypeDouble);
+    observed.setSendValueChangedSignals(false);
+    unobserved.setSendValueChangedSignals(false);
+    rateLimited.setSendValueChangedSignals(false);
+    rateLimited.setDeferredValueChangeInterval(500);
+
+    QSignalSpy observedSpy      (&observed,     &Fact::valueChanged);
+    QSignalSpy rateLimitedSpy   (&rateLimited,  &Fact::valueChanged);
+
+    const quint64 emitted       = notifier->emittedCount();
+    const quint64 suppressed    = notifier->suppressedCount();
+    const quint64 coalesced     = notifier->coalescedCount();
+
+    // A burst of changes turns into a single signal with the latest value
+    observed.setTelemetryRawValue(1);
+    observed.setTelemetryRawValue(2);
+    observed.setTelemetryRawValue(3);
+    unobserved.setTelemetryRawValue(1);
+    QCOMPARE(observedSpy.count(), 0);
+
+    QTRY_COMPARE(observedSpy.count(), 1);
+    QCOMPARE(observedSpy[0][0].toDouble(), 3.0);
+    QTRY_COMPARE(notifier->suppressedCount(), suppressed + 1);
+    QCOMPARE(notifier->emittedCount(), emitted + 1);
+    QCOMPARE(notifier->coalescedCount(), coalesced + 2);
+    QVERIFY(!unobserved.deferredValueChangeSignal());
+
+    // The interval holds back the following notification, not the first
+    rateLimited.setTelemetryRawValue(1);
+    QTRY_COMPARE(rateLimitedSpy.count(), 1);
+    rateLimited.setTelemetryRawValue(2);
+    QTest::qWait(200);
+    QCOMPARE(rateLimitedSpy.count(), 1);
+    QTRY_COMPARE(rateLimitedSpy.count(), 2);
+
+    // Destroying a queued Fact takes it out of the queue
+    Fact* transient = new Fact(0, "transient", FactMetaData::valueTypeDouble);
+    transient->setSendValueChangedSignals(false);
+    transient->setTelemetryRawValue(1);
+    const int queued = notifier->queuedCount();
+    delete transient;
+    QCOMPARE(notifier->queuedCount(), queued - 1);
+}
+
+void FactValueTest::_benchmark_data(void)
+{
+    QTest::addColumn<bool>("telemetry");
+
+    QTest::newRow("setRawValue")            << false;
+    QTest::newRow("setTelemetryRawValue")   << true;
+}
+
+void FactValueTest::_benchmark(void)
+{
+    QFETCH(bool, telemetry);
+
+    // One telemetry update followed by the reads of a fact bound to an instrument value
+    Fact fact(0, "fact", FactMetaData::valueTypeDouble);
+    fact.metaData()->setRawUnits("m");
+    fact.metaData()->setBuiltInTranslator();
+    fact.metaData()->setDecimalPlaces(1);
+
+    double value = 0;
+
+    QBENCHMARK {
+        value += 0.1;
+        if (telemetry) {
+            fact.setTelemetryRawValue(value);
+        } else {
+            fact.setRawValue(value);
+        }
+        fact.cookedValue();
+        fact.cookedValueString();
+        fact.cookedValue();
+        fact.cookedValueString();
+    }
+}
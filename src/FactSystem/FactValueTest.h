@@ -0,0 +1,25 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Fact value storage: telemetry fast path, cooked value caching, deferred notification and per update cost
+class FactValueTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _telemetryConversion       (void);
+    void _cookedValueCache          (void);
+    void _deferredNotify            (void);
+    void _benchmark_data            (void);
+    void _benchmark                 (void);
+};
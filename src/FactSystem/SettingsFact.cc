@@ -52,6 +52,7 @@ SettingsFact::SettingsFact(QString settingsGroup, FactMetaData* metaData, QObjec
                 _rawValue = rawDefaultValue;
             }
         }
+        _clearCookedValueCache();
     }
 
     connect(this, &Fact::rawValueChanged, this, &SettingsFact::_rawValueChanged);
@@ -69,6 +69,8 @@ public:
     virtual void        initializeStreamRates           (Vehicle* vehicle);
     void                initializeVehicle               (Vehicle* vehicle) override;
     bool                sendHomePositionToVehicle       (void) override;
+    bool                supportsPartialMissionWrite     (void) const override { return true; }
+    bool                supportsMissionFtp              (void) const override { return true; }
     QString             missionCommandOverrides         (QGCMAVLink::VehicleClass_t vehicleClass) const override;
     QString             _internalParameterMetaDataFile  (Vehicle* vehicle) override;
     FactMetaData*       _getMetaDataForFact             (QObject* parameterMetaData, const QString& name, FactMetaData::ValueType_t type, MAV_TYPE vehicleType) override;
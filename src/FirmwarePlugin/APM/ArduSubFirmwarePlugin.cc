@@ -285,6 +285,9 @@ APMSubmarineFactGroup::APMSubmarineFactGroup(QObject* parent)
     , _rollPitchToggleFact     (0, _rollPitchToggleFactName,     FactMetaData::valueTypeDouble)
     , _rangefinderDistanceFact (0, _rangefinderDistanceFactName, FactMetaData::valueTypeDouble)
 {
+    // Values are filled in from outside handleMessage
+    _setHandledMessageIds({});
+
     _addFact(&_camTiltFact,             _camTiltFactName);
     _addFact(&_tetherTurnsFact,         _tetherTurnsFactName);
     _addFact(&_lightsLevel1Fact,        _lightsLevel1FactName);
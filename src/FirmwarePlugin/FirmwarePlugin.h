@@ -213,6 +213,12 @@ public:
     ///     false: Do not send first item to vehicle, sequence numbers must be adjusted
     virtual bool sendHomePositionToVehicle(void);
 
+    /// @return true: Vehicle accepts MISSION_WRITE_PARTIAL_LIST to replace a range of mission items in place
+    virtual bool supportsPartialMissionWrite(void) const { return false; }
+
+    /// @return true: Vehicle serves the plan as the @MISSION files of MavlinkFTP::missionFilePath for MAVLink FTP transfers
+    virtual bool supportsMissionFtp(void) const { return false; }
+
     /// Returns the parameter set version info pulled from inside the meta data file. -1 if not found.
     /// Note: The implementation for this must not vary by vehicle type.
     /// Important: Only CompInfoParam code should use this method
@@ -2061,7 +2061,9 @@ Item {
 
                                 var element = QGroundControl.videoManager.streams[cameraControlOverlay.cameraIndex]
                                 if (element.ip) {
-                                    QGroundControl.settingsManager.videoSettings.rtspUrl.rawValue = element.ip
+                                    // Streams keep running in the background, only the display moves. Recording
+                                    // starts on whichever stream is shown.
+                                    QGroundControl.videoManager.showStream(cameraControlOverlay.cameraIndex)
                                 }
                             }
                         }
@@ -83,6 +83,7 @@ const float Joystick::_minAxisFrequencyHz       = 0.25f;
 const float Joystick::_maxAxisFrequencyHz       = 200.0f;
 const float Joystick::_minButtonFrequencyHz     = 0.25f;
 const float Joystick::_maxButtonFrequencyHz     = 50.0f;
+const int   Joystick::_maxInputWaitMsecs        = 10;   ///< Upper bound on input waits so repeat buttons are still serviced
 
 AssignedButtonAction::AssignedButtonAction(QObject* parent, const QString name)
     : QObject(parent)
@@ -109,11 +110,15 @@ Joystick::Joystick(const QString& name, int axisCount, int buttonCount, int hatC
     _rgAxisValues   = new int[static_cast<size_t>(_axisCount)];
     _rgCalibration  = new Calibration_t[static_cast<size_t>(_axisCount)];
     _rgButtonValues = new uint8_t[static_cast<size_t>(_totalButtonCount)];
+    _rgLastInputAxisValues      = new int[static_cast<size_t>(_axisCount)];
+    _rgLastInputButtonValues    = new bool[static_cast<size_t>(_totalButtonCount)];
     for (int i = 0; i < _axisCount; i++) {
         _rgAxisValues[i] = 0;
+        _rgLastInputAxisValues[i] = 0;
     }
     for (int i = 0; i < _totalButtonCount; i++) {
         _rgButtonValues[i] = BUTTON_UP;
+        _rgLastInputButtonValues[i] = false;
         _buttonActionArray.append(nullptr);
     }
     _buildActionList(_multiVehicleManager->activeVehicle());
@@ -138,6 +143,8 @@ Joystick::~Joystick()
     delete[] _rgAxisValues;
     delete[] _rgCalibration;
     delete[] _rgButtonValues;
+    delete[] _rgLastInputAxisValues;
+    delete[] _rgLastInputButtonValues;
     _assignableButtonActions.clearAndDeleteContents();
     for (int button = 0; button < _totalButtonCount; button++) {
         if(_buttonActionArray[button]) {
@@ -477,21 +484,81 @@ void Joystick::run()
     //-- Joystick thread
     _open();
     //-- Reset timers
-    _axisTime.start();
+    _manualControlTime.start();
+    _lastManualControlNsecs = 0;
+    _lastStatsNsecs         = 0;
+    _inputChangePending     = false;
     for (int buttonIndex = 0; buttonIndex < _totalButtonCount; buttonIndex++) {
         if(_buttonActionArray[buttonIndex]) {
             _buttonActionArray[buttonIndex]->buttonTime.start();
         }
     }
     while (!_exitThread) {
-        _update();
+        if (_waitForInput(_msecsToNextManualControl()) && !_inputChangePending) {
+            _inputChangePending = true;
+            _inputChangedNsecs  = _manualControlTime.nsecsElapsed();
+        }
         _handleButtons();
         _handleAxis();
-        QGC::SLEEP::msleep(qMin(static_cast<int>(1000.0f / _maxAxisFrequencyHz), static_cast<int>(1000.0f / _maxButtonFrequencyHz)) / 2);
     }
     _close();
 }
 
+bool Joystick::_waitForInput(int timeoutMsecs)
+{
+    if (timeoutMsecs > 0) {
+        QGC::SLEEP::msleep(static_cast<unsigned long>(qMin(timeoutMsecs, static_cast<int>(1000.0f / _maxAxisFrequencyHz))));
+    }
+    _update();
+
+    bool inputChanged = false;
+    for (int axisIndex = 0; axisIndex < _axisCount; axisIndex++) {
+        int axisValue = _getAxis(axisIndex);
+        if (axisValue != _rgLastInputAxisValues[axisIndex]) {
+            _rgLastInputAxisValues[axisIndex] = axisValue;
+            inputChanged = true;
+        }
+    }
+    for (int buttonIndex = 0; buttonIndex < _totalButtonCount; buttonIndex++) {
+        bool buttonValue = buttonIndex < _buttonCount ? _getButton(buttonIndex) : _getHat((buttonIndex - _buttonCount) / 4, (buttonIndex - _buttonCount) % 4);
+        if (buttonValue != _rgLastInputButtonValues[buttonIndex]) {
+            _rgLastInputButtonValues[buttonIndex] = buttonValue;
+            inputChanged = true;
+        }
+    }
+    return inputChanged;
+}
+
+/// @return Time to wait for input before the next MANUAL_CONTROL is due
+int Joystick::_msecsToNextManualControl()
+{
+    qint64 nextNsecs = _lastManualControlNsecs + static_cast<qint64>(1e9 / _axisFrequencyHz);
+    if (_inputChangePending) {
+        nextNsecs = qMin(nextNsecs, _lastManualControlNsecs + static_cast<qint64>(1e9 / _maxAxisFrequencyHz));
+    }
+    qint64 waitMsecs = (nextNsecs - _manualControlTime.nsecsElapsed()) / 1000000;
+    return static_cast<int>(qBound(static_cast<qint64>(0), waitMsecs, static_cast<qint64>(_maxInputWaitMsecs)));
+}
+
+void Joystick::_updateManualControlStats(qint64 sentNsecs, qint64 intervalNsecs, bool keepAlive)
+{
+    // Exponential moving averages so a single late message doesn't dominate
+    static const float filterAlpha = 0.1f;
+
+    if (keepAlive) {
+        float jitterMs = qAbs(intervalNsecs - static_cast<qint64>(1e9 / _axisFrequencyHz)) / 1e6f;
+        _manualControlJitterMs = _manualControlJitterMs + filterAlpha * (jitterMs - _manualControlJitterMs);
+    } else {
+        float latencyMs = (sentNsecs - _inputChangedNsecs) / 1e6f;
+        _manualControlLatencyMs = _manualControlLatencyMs + filterAlpha * (latencyMs - _manualControlLatencyMs);
+    }
+    if (sentNsecs - _lastStatsNsecs > 1000000000) {
+        _lastStatsNsecs = sentNsecs;
+        qCDebug(JoystickValuesLog) << "MANUAL_CONTROL latency:jitter (ms)" << _manualControlLatencyMs.load() << _manualControlJitterMs.load();
+        emit manualControlStatsChanged();
+    }
+}
+
 void Joystick::_handleButtons()
 {
     int lastBbuttonValues[256];
@@ -590,11 +657,14 @@ void Joystick::_handleButtons()
 
 void Joystick::_handleAxis()
 {
-    //-- Get frequency
-    int axisDelay = static_cast<int>(1000.0f / _axisFrequencyHz);
-    //-- Check elapsed time since last run
-    if(_axisTime.elapsed() > axisDelay) {
-        _axisTime.start();
+    //-- Send on input change (rate limited to max axis frequency) or as keep alive at the axis frequency
+    qint64  nowNsecs        = _manualControlTime.nsecsElapsed();
+    qint64  intervalNsecs   = nowNsecs - _lastManualControlNsecs;
+    bool    keepAliveDue    = intervalNsecs >= static_cast<qint64>(1e9 / _axisFrequencyHz);
+    bool    changeDue       = _inputChangePending && intervalNsecs >= static_cast<qint64>(1e9 / _maxAxisFrequencyHz);
+    if (keepAliveDue || changeDue) {
+        _lastManualControlNsecs = nowNsecs;
+        _inputChangePending     = false;
         //-- Update axis
         for (int axisIndex = 0; axisIndex < _axisCount; axisIndex++) {
             int newAxisValue = _getAxis(axisIndex);
@@ -680,6 +750,7 @@ void Joystick::_handleAxis()
 
             uint16_t shortButtons = static_cast<uint16_t>(buttonPressedBits & 0xFFFF);
             _activeVehicle->sendJoystickDataThreadSafe(roll, pitch, yaw, throttle, shortButtons);
+            _updateManualControlStats(_manualControlTime.nsecsElapsed(), intervalNsecs, !changeDue);
         }
     }
 }
@@ -944,9 +1015,7 @@ void Joystick::setCircleCorrection(bool circleCorrection)
 void Joystick::setAxisFrequency(float val)
 {
     //-- Arbitrary limits
-    val = qMin(_minAxisFrequencyHz, val);
-    val = qMax(_maxAxisFrequencyHz, val);
-    _axisFrequencyHz = val;
+    _axisFrequencyHz = qBound(_minAxisFrequencyHz, val, _maxAxisFrequencyHz);
     _saveSettings();
     emit axisFrequencyHzChanged();
 }
@@ -954,9 +1023,7 @@ void Joystick::setAxisFrequency(float val)
 void Joystick::setButtonFrequency(float val)
 {
     //-- Arbitrary limits
-    val = qMin(_minButtonFrequencyHz, val);
-    val = qMax(_maxButtonFrequencyHz, val);
-    _buttonFrequencyHz = val;
+    _buttonFrequencyHz = qBound(_minButtonFrequencyHz, val, _maxButtonFrequencyHz);
     _saveSettings();
     emit buttonFrequencyHzChanged();
 }
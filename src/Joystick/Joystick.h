@@ -112,6 +112,8 @@ public:
     Q_PROPERTY(float    exponential             READ exponential            WRITE setExponential        NOTIFY exponentialChanged)
     Q_PROPERTY(bool     accumulator             READ accumulator            WRITE setAccumulator        NOTIFY accumulatorChanged)
     Q_PROPERTY(bool     circleCorrection        READ circleCorrection       WRITE setCircleCorrection   NOTIFY circleCorrectionChanged)
+    Q_PROPERTY(float    manualControlLatencyMs  READ manualControlLatencyMs                             NOTIFY manualControlStatsChanged)
+    Q_PROPERTY(float    manualControlJitterMs   READ manualControlJitterMs                              NOTIFY manualControlStatsChanged)
 
     Q_INVOKABLE void    setButtonRepeat     (int button, bool repeat);
     Q_INVOKABLE bool    getButtonRepeat     (int button);
@@ -183,6 +185,11 @@ public:
     /// Set joystick button repeat rate (in Hz)
     void  setButtonFrequency(float val);
 
+    /// Smoothed time from detecting an input change to the resulting MANUAL_CONTROL being handed to the link (in ms)
+    float manualControlLatencyMs() const { return _manualControlLatencyMs; }
+    /// Smoothed deviation of keep alive MANUAL_CONTROL messages from the axis frequency period (in ms)
+    float manualControlJitterMs () const { return _manualControlJitterMs; }
+
 signals:
     // The raw signals are only meant for use by calibration
     void rawAxisValueChanged        (int index, int value);
@@ -200,6 +207,7 @@ signals:
 
     void axisFrequencyHzChanged     ();
     void buttonFrequencyHzChanged   ();
+    void manualControlStatsChanged  ();
     void startContinuousZoom        (int direction);
     void stopContinuousZoom         ();
     void stepZoom                   (int direction);
@@ -231,6 +239,13 @@ protected:
     void    _handleAxis             ();
     void    _handleButtons          ();
     void    _buildActionList        (Vehicle* activeVehicle);
+    int     _msecsToNextManualControl();
+    void    _updateManualControlStats(qint64 sentNsecs, qint64 intervalNsecs, bool keepAlive);
+
+    /// Waits up to timeoutMsecs for joystick input and updates the joystick state. The default implementation polls
+    /// the joystick and compares against the previous values. Implementations with change events should override.
+    ///     @return true: input changed
+    virtual bool _waitForInput      (int timeoutMsecs);
 
     void    _pitchStep              (int direction);
     void    _yawStep                (int direction);
@@ -292,7 +307,18 @@ protected:
 
     static int          _transmitterMode;
     int                 _rgFunctionAxis[maxFunction] = {};
-    QElapsedTimer       _axisTime;
+
+    // MANUAL_CONTROL scheduling: messages are sent as soon as input changes (limited to _maxAxisFrequencyHz) and at
+    // _axisFrequencyHz as a keep alive when nothing changes.
+    QElapsedTimer       _manualControlTime;
+    qint64              _lastManualControlNsecs     = 0;
+    bool                _inputChangePending         = false;
+    qint64              _inputChangedNsecs          = 0;
+    qint64              _lastStatsNsecs             = 0;
+    std::atomic<float>  _manualControlLatencyMs{0};
+    std::atomic<float>  _manualControlJitterMs{0};
+    int*                _rgLastInputAxisValues      = nullptr;  ///< Used by default _waitForInput for change detection
+    bool*               _rgLastInputButtonValues    = nullptr;  ///< Used by default _waitForInput for change detection
 
     QmlObjectListModel              _assignableButtonActions;
     QList<AssignedButtonAction*>    _buttonActionArray;
@@ -305,6 +331,7 @@ protected:
     static const float  _maxAxisFrequencyHz;
     static const float  _minButtonFrequencyHz;
     static const float  _maxButtonFrequencyHz;
+    static const int    _maxInputWaitMsecs;
 
 private:
     static const char*  _rgFunctionSettingsKey[maxFunction];
@@ -2,6 +2,7 @@
 
 #include "QGCApplication.h"
 
+#include <QElapsedTimer>
 #include <QQmlEngine>
 #include <QTextStream>
 
@@ -153,6 +154,62 @@ bool JoystickSDL::_update(void)
     return true;
 }
 
+namespace {
+
+typedef struct {
+    SDL_JoystickID  instanceId;
+    bool            inputChanged;
+} InputEventFilter_t;
+
+/// SDL_FilterEvents callback which removes the input events of a single joystick. Events from other joysticks and
+/// device added/removed events stay queued for their own consumers.
+int removeJoystickInputEvents(void* userdata, SDL_Event* event)
+{
+    InputEventFilter_t* filter = static_cast<InputEventFilter_t*>(userdata);
+
+    // All joystick and controller input events share the same layout for the instance id
+    bool joystickInput      = event->type >= SDL_JOYAXISMOTION && event->type <= SDL_JOYBUTTONUP;
+    bool controllerInput    = event->type >= SDL_CONTROLLERAXISMOTION && event->type <= SDL_CONTROLLERBUTTONUP;
+    if ((joystickInput && event->jaxis.which == filter->instanceId) || (controllerInput && event->caxis.which == filter->instanceId)) {
+        filter->inputChanged = true;
+        return 0;
+    }
+
+    return 1;
+}
+
+}
+
+/// Waits for SDL input events from this joystick. SDL joystick backends are polled, events are only generated by an
+/// update. The update runs at the maximum MANUAL_CONTROL rate, updating any faster only burns cpu since input can't
+/// be sent any sooner than that.
+bool JoystickSDL::_waitForInput(int timeoutMsecs)
+{
+    if (!sdlJoystick) {
+        return Joystick::_waitForInput(timeoutMsecs);
+    }
+
+    InputEventFilter_t  filter      = { SDL_JoystickInstanceID(sdlJoystick), false };
+    const int           pollMsecs   = qMax(1, static_cast<int>(1000.0f / _maxAxisFrequencyHz));
+    QElapsedTimer       waitTime;
+
+    waitTime.start();
+    while (true) {
+        _update();
+
+        SDL_FilterEvents(removeJoystickInputEvents, &filter);
+        if (filter.inputChanged) {
+            return true;
+        }
+
+        int remainingMsecs = timeoutMsecs - static_cast<int>(waitTime.elapsed());
+        if (remainingMsecs <= 0) {
+            return false;
+        }
+        SDL_Delay(static_cast<Uint32>(qMin(remainingMsecs, pollMsecs)));
+    }
+}
+
 bool JoystickSDL::_getButton(int i) {
     if (_isGameController) {
         return SDL_GameControllerGetButton(sdlController, SDL_GameControllerButton(i)) == 1;
@@ -10,7 +10,9 @@
 #include "KMLHelper.h"
 
 #include <QFile>
+#include <QRegularExpression>
 #include <QVariant>
+#include <QXmlStreamReader>
 
 const char* KMLHelper::_errorPrefix = QT_TR_NOOP("KML file load failed. %1");
 
@@ -165,3 +167,145 @@ bool KMLHelper::loadPolylineFromFile(const QString& kmlFile, QList<QGeoCoordinat
 
     return true;
 }
+
+void KMLHelper::_parseCoordinates(const QString& coordinatesText, QList<QGeoCoordinate>& coords)
+{
+    coords.clear();
+
+    static const QRegularExpression whitespace(QStringLiteral("\\s+"));
+
+    const QVector<QStringRef> rgCoordinateStrings = coordinatesText.splitRef(whitespace, Qt::SkipEmptyParts);
+    coords.reserve(rgCoordinateStrings.count());
+    for (const QStringRef& coordinateString: rgCoordinateStrings) {
+        const QVector<QStringRef> rgValueStrings = coordinateString.split(QLatin1Char(','));
+        if (rgValueStrings.count() >= 2) {
+            coords.append(QGeoCoordinate(rgValueStrings[1].toDouble(), rgValueStrings[0].toDouble()));
+        }
+    }
+}
+
+bool KMLHelper::_streamFeatures(const QString& kmlFile, int featureIndex, bool loadGeometry, double simplifyToleranceMeters, const ShapeFileHelper::FeatureHandler_t& handler, QString& errorString)
+{
+    errorString.clear();
+
+    QFile file(kmlFile);
+    if (!file.exists()) {
+        errorString = QString(_errorPrefix).arg(tr("File not found: %1").arg(kmlFile));
+        return false;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        errorString = QString(_errorPrefix).arg(tr("Unable to open file: %1 error: $%2").arg(kmlFile).arg(file.errorString()));
+        return false;
+    }
+
+    QXmlStreamReader        xml(&file);
+    QStringList             elementStack;
+    int                     placemarkDepth      = -1;       // -1: not in a Placemark
+    int                     nextFeatureIndex    = 0;
+    bool                    geometryFound       = false;
+    bool                    keepReading         = true;
+    QString                 dataName;
+    QList<QGeoCoordinate>   coords;
+    ShapeFileHelper::Feature feature;
+
+    while (keepReading && !xml.atEnd()) {
+        QXmlStreamReader::TokenType token = xml.readNext();
+
+        if (token == QXmlStreamReader::StartElement) {
+            QString name    = xml.name().toString();
+            QString parent  = elementStack.isEmpty() ? QString() : elementStack.last();
+
+            if (name == QStringLiteral("Placemark")) {
+                placemarkDepth  = elementStack.count();
+                geometryFound   = false;
+                feature         = ShapeFileHelper::Feature();
+                coords.clear();
+            } else if (placemarkDepth != -1) {
+                bool wantFeature = featureIndex == -1 || featureIndex == nextFeatureIndex;
+
+                if (name == QStringLiteral("name") && parent == QStringLiteral("Placemark")) {
+                    feature.name = xml.readElementText();
+                    continue;
+                } else if (name == QStringLiteral("SimpleData")) {
+                    QString attributeName = xml.attributes().value(QStringLiteral("name")).toString();
+                    feature.attributes[attributeName] = xml.readElementText();
+                    continue;
+                } else if (name == QStringLiteral("Data")) {
+                    dataName = xml.attributes().value(QStringLiteral("name")).toString();
+                } else if (name == QStringLiteral("value") && parent == QStringLiteral("Data")) {
+                    feature.attributes[dataName] = xml.readElementText();
+                    continue;
+                } else if (feature.type == ShapeFileHelper::Error && name == QStringLiteral("Polygon")) {
+                    feature.type = ShapeFileHelper::Polygon;
+                } else if (feature.type == ShapeFileHelper::Error && name == QStringLiteral("LineString")) {
+                    feature.type = ShapeFileHelper::Polyline;
+                } else if (name == QStringLiteral("coordinates")) {
+                    bool polygonOuterRing   = feature.type == ShapeFileHelper::Polygon && parent == QStringLiteral("LinearRing") && elementStack.contains(QStringLiteral("outerBoundaryIs"));
+                    bool polyline           = feature.type == ShapeFileHelper::Polyline && parent == QStringLiteral("LineString");
+                    if (!geometryFound && (polygonOuterRing || polyline)) {
+                        geometryFound = true;
+                        if (wantFeature) {
+                            _parseCoordinates(xml.readElementText(), coords);
+                            if (polygonOuterRing && coords.count() > 1 && coords.first() == coords.last()) {
+                                // KML polygons repeat the first vertex to close the ring
+                                coords.removeLast();
+                            }
+                        } else {
+                            xml.skipCurrentElement();
+                        }
+                        continue;
+                    }
+                }
+            }
+
+            elementStack.append(name);
+        } else if (token == QXmlStreamReader::EndElement) {
+            elementStack.removeLast();
+
+            if (placemarkDepth != -1 && elementStack.count() == placemarkDepth) {
+                placemarkDepth = -1;
+                if (feature.type != ShapeFileHelper::Error && geometryFound) {
+                    feature.index = nextFeatureIndex++;
+                    if (featureIndex == -1 || featureIndex == feature.index) {
+                        ShapeFileHelper::finalizeFeature(feature, coords, loadGeometry, simplifyToleranceMeters);
+                        keepReading = handler(feature) && featureIndex == -1;
+                    }
+                }
+            }
+        }
+    }
+
+    if (xml.hasError()) {
+        errorString = QString(_errorPrefix).arg(tr("Unable to parse KML file: %1 error: %2 line: %3").arg(kmlFile).arg(xml.errorString()).arg(xml.lineNumber()));
+        return false;
+    }
+
+    return true;
+}
+
+bool KMLHelper::loadFeaturesFromFile(const QString& kmlFile, bool loadGeometry, double simplifyToleranceMeters, const ShapeFileHelper::FeatureHandler_t& handler, QString& errorString)
+{
+    return _streamFeatures(kmlFile, -1 /* all features */, loadGeometry, simplifyToleranceMeters, handler, errorString);
+}
+
+bool KMLHelper::loadFeatureFromFile(const QString& kmlFile, int featureIndex, double simplifyToleranceMeters, ShapeFileHelper::Feature& feature, QString& errorString)
+{
+    if (featureIndex < 0) {
+        errorString = QString(_errorPrefix).arg(tr("Feature %1 not found.").arg(featureIndex));
+        return false;
+    }
+
+    bool found = false;
+
+    _streamFeatures(kmlFile, featureIndex, true /* loadGeometry */, simplifyToleranceMeters, [&](const ShapeFileHelper::Feature& loadedFeature) {
+        feature = loadedFeature;
+        found   = true;
+        return false;
+    }, errorString);
+
+    if (errorString.isEmpty() && !found) {
+        errorString = QString(_errorPrefix).arg(tr("Feature %1 not found.").arg(featureIndex));
+    }
+
+    return errorString.isEmpty();
+}
@@ -25,8 +25,16 @@ public:
     static bool loadPolygonFromFile(const QString& kmlFile, QList<QGeoCoordinate>& vertices, QString& errorString);
     static bool loadPolylineFromFile(const QString& kmlFile, QList<QGeoCoordinate>& coords, QString& errorString);
 
+    /// Streams all Placemark polygons and polylines from the file without building a DOM, see ShapeFileHelper::loadFeaturesFromFile
+    static bool loadFeaturesFromFile(const QString& kmlFile, bool loadGeometry, double simplifyToleranceMeters, const ShapeFileHelper::FeatureHandler_t& handler, QString& errorString);
+    static bool loadFeatureFromFile(const QString& kmlFile, int featureIndex, double simplifyToleranceMeters, ShapeFileHelper::Feature& feature, QString& errorString);
+
 private:
     static QDomDocument _loadFile(const QString& kmlFile, QString& errorString);
 
+    /// @param featureIndex -1 for all features, otherwise only the specified feature is parsed and handed to the handler
+    static bool _streamFeatures(const QString& kmlFile, int featureIndex, bool loadGeometry, double simplifyToleranceMeters, const ShapeFileHelper::FeatureHandler_t& handler, QString& errorString);
+    static void _parseCoordinates(const QString& coordinatesText, QList<QGeoCoordinate>& coords);
+
     static const char* _errorPrefix;
 };
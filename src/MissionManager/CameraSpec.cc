@@ -24,7 +24,7 @@ const char* CameraSpec::_minTriggerIntervalName =   "MinTriggerInterval";
 CameraSpec::CameraSpec(const QString& settingsGroup, QObject* parent)
     : QObject                   (parent)
     , _dirty                    (false)
-    , _metaDataMap              (FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/CameraSpec.FactMetaData.json"), this))
+    , _metaDataMap              (FactMetaData::sharedMapFromJsonFile(QStringLiteral(":/json/CameraSpec.FactMetaData.json"), settingsGroup))
     , _sensorWidthFact          (settingsGroup, _metaDataMap[_sensorWidthName])
     , _sensorHeightFact         (settingsGroup, _metaDataMap[_sensorHeightName])
     , _imageWidthFact           (settingsGroup, _metaDataMap[_imageWidthName])
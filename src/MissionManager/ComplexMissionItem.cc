@@ -121,22 +121,15 @@ void ComplexMissionItem::addKMLVisuals(KMLPlanDomDocument& /* domDocument */)
 
 void ComplexMissionItem::_appendFlightPathSegment(FlightPathSegment::SegmentType segmentType, const QGeoCoordinate& coord1, double coord1AMSLAlt, const QGeoCoordinate& coord2, double coord2AMSLAlt)
 {
-    FlightPathSegment* segment = new FlightPathSegment(segmentType, coord1, coord1AMSLAlt, coord2, coord2AMSLAlt, true /* queryTerrainData */, this /* parent */);
+    // Terrain heights come from the mission controller's clearance pass over the whole plan, not a query per segment
+    FlightPathSegment* segment = new FlightPathSegment(segmentType, coord1, coord1AMSLAlt, coord2, coord2AMSLAlt, false /* queryTerrainData */, this /* parent */);
 
     connect(segment, &FlightPathSegment::terrainCollisionChanged,       this,               &ComplexMissionItem::_segmentTerrainCollisionChanged);
     connect(segment, &FlightPathSegment::terrainCollisionChanged,       _missionController, &MissionController::recalcTerrainProfile, Qt::QueuedConnection);
     connect(segment, &FlightPathSegment::amslTerrainHeightsChanged,     _missionController, &MissionController::recalcTerrainProfile, Qt::QueuedConnection);
 
-    // Signals may have been emitted in contructor so we need to deal with that now since they were missed
-
     _flightPathSegments.append(segment);
-    if (segment->terrainCollision()) {
-        emit _segmentTerrainCollisionChanged(true);
-    }
-
-    if (segment->amslTerrainHeights().count()) {
-        _missionController->recalcTerrainProfile();
-    }
+    _missionController->addTerrainClearanceSegment(segment);
 }
 
 void ComplexMissionItem::_segmentTerrainCollisionChanged(bool terrainCollision)
@@ -33,7 +33,7 @@ const char* CorridorScanComplexItem::jsonComplexItemTypeValue = "CorridorScan";
 CorridorScanComplexItem::CorridorScanComplexItem(PlanMasterController* masterController, bool flyView, const QString& kmlFile)
     : TransectStyleComplexItem  (masterController, flyView, settingsGroup)
     , _entryPoint               (0)
-    , _metaDataMap              (FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/CorridorScan.SettingsGroup.json"), this))
+    , _metaDataMap              (FactMetaData::sharedMapFromJsonFile(QStringLiteral(":/json/CorridorScan.SettingsGroup.json"), settingsGroup))
     , _corridorWidthFact        (settingsGroup, _metaDataMap[corridorWidthName])
 {
     _editorQml = "qrc:/qml/CorridorScanEditor.qml";
@@ -0,0 +1,457 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "FleetPlanUploader.h"
+#include "PlanMasterController.h"
+#include "MissionManager.h"
+#include "GeoFenceManager.h"
+#include "RallyPointManager.h"
+#include "RallyPoint.h"
+#include "QGCFencePolygon.h"
+#include "QGCFenceCircle.h"
+#include "MultiVehicleManager.h"
+#include "QGCApplication.h"
+
+#include <QTimer>
+
+QGC_LOGGING_CATEGORY(FleetPlanUploaderLog, "FleetPlanUploaderLog")
+
+FleetPlanUploader::FleetPlanUploader(QObject* parent)
+    : QObject(parent)
+{
+    connect(qgcApp()->toolbox()->multiVehicleManager(), &MultiVehicleManager::vehicleRemoved, this, &FleetPlanUploader::_vehicleRemoved);
+}
+
+FleetPlanUploader::~FleetPlanUploader()
+{
+    for (VehicleUpload_t* upload: _uploads) {
+        if (upload->vehicle) {
+            _disconnectVehicle(upload->vehicle);
+        }
+        delete upload;
+    }
+    _clearMissionItems();
+    _polygons.clearAndDeleteContents();
+    _circles.clearAndDeleteContents();
+}
+
+void FleetPlanUploader::setPlan(PlanMasterController* planController)
+{
+    if (_inProgress) {
+        qCWarning(FleetPlanUploaderLog) << "setPlan called while upload in progress";
+        return;
+    }
+
+    _clearMissionItems();
+    addMissionConversion(planController);
+
+    GeoFenceController* geoFenceController = planController->geoFenceController();
+    _polygons.clearAndDeleteContents();
+    for (int i=0; i<geoFenceController->polygons()->count(); i++) {
+        _polygons.append(new QGCFencePolygon(*geoFenceController->polygons()->value<QGCFencePolygon*>(i), this));
+    }
+    _circles.clearAndDeleteContents();
+    for (int i=0; i<geoFenceController->circles()->count(); i++) {
+        _circles.append(new QGCFenceCircle(*geoFenceController->circles()->value<QGCFenceCircle*>(i), this));
+    }
+    _breachReturnPoint = geoFenceController->breachReturnPoint();
+
+    _rallyPoints.clear();
+    QmlObjectListModel* points = planController->rallyPointController()->points();
+    for (int i=0; i<points->count(); i++) {
+        _rallyPoints.append(points->value<RallyPoint*>(i)->coordinate());
+    }
+
+    qCDebug(FleetPlanUploaderLog) << "setPlan polygons:circles:rally" << _polygons.count() << _circles.count() << _rallyPoints.count();
+}
+
+void FleetPlanUploader::addMissionConversion(PlanMasterController* planController)
+{
+    if (_inProgress) {
+        qCWarning(FleetPlanUploaderLog) << "addMissionConversion called while upload in progress";
+        return;
+    }
+
+    const ConversionKey_t key = _conversionKey(planController->managerVehicle());
+
+    qDeleteAll(_missionItems[key]);
+    _missionItems[key].clear();
+    planController->missionController()->convertToMissionItems(_missionItems[key], this);
+
+    qCDebug(FleetPlanUploaderLog) << "addMissionConversion firmware:vehicle:count" << key.first << key.second << _missionItems[key].count();
+}
+
+FleetPlanUploader::ConversionKey_t FleetPlanUploader::_conversionKey(Vehicle* vehicle)
+{
+    return ConversionKey_t(vehicle->firmwareType(), vehicle->vehicleType());
+}
+
+bool FleetPlanUploader::start(const QList<Vehicle*>& vehicles)
+{
+    if (_inProgress || vehicles.isEmpty()) {
+        return false;
+    }
+
+    for (VehicleUpload_t* upload: _uploads) {
+        delete upload;
+    }
+    _uploads.clear();
+
+    for (Vehicle* vehicle: vehicles) {
+        VehicleUpload_t* upload = new VehicleUpload_t;
+
+        upload->vehicle         = vehicle;
+        upload->state           = StatePending;
+        upload->error           = false;
+        upload->itemCount       = _missionItems.value(_conversionKey(vehicle)).count();
+        upload->itemsComplete   = 0;
+        upload->stageItemCount  = 0;
+        upload->progress        = 0;
+        if (_geoFenceSupported(vehicle)) {
+            upload->itemCount += _geoFenceItemCount();
+        }
+        if (_rallyPointsSupported(vehicle)) {
+            upload->itemCount += _rallyPoints.count();
+        }
+        _uploads.append(upload);
+
+        // A busy vehicle is skipped until its plan managers go idle
+        connect(vehicle->missionManager(),      &PlanManager::inProgressChanged, this, &FleetPlanUploader::_startNext);
+        connect(vehicle->geoFenceManager(),     &PlanManager::inProgressChanged, this, &FleetPlanUploader::_startNext);
+        connect(vehicle->rallyPointManager(),   &PlanManager::inProgressChanged, this, &FleetPlanUploader::_startNext);
+    }
+
+    qCDebug(FleetPlanUploaderLog) << "start vehicles:maxConcurrentUploads" << _uploads.count() << _maxConcurrentUploads;
+
+    _inProgress = true;
+    _elapsedMSecs = 0;
+    _elapsedTimer.start();
+    emit inProgressChanged(true);
+    emit progressChanged(0);
+
+    // Vehicles which can't be sent to fail synchronously in _startNext. Running it from the event loop lets the caller
+    // connect to the uploader first, sendPlanToVehicles callers only get hold of it once start has returned.
+    QTimer::singleShot(0, this, &FleetPlanUploader::_startNext);
+
+    return true;
+}
+
+double FleetPlanUploader::progress(void) const
+{
+    if (_uploads.isEmpty()) {
+        return 0;
+    }
+
+    double total = 0;
+    for (const VehicleUpload_t* upload: _uploads) {
+        total += upload->progress;
+    }
+    return total / _uploads.count();
+}
+
+double FleetPlanUploader::vehicleProgress(Vehicle* vehicle) const
+{
+    for (const VehicleUpload_t* upload: _uploads) {
+        if (upload->vehicle == vehicle) {
+            return upload->progress;
+        }
+    }
+    return -1;
+}
+
+qint64 FleetPlanUploader::elapsedMSecs(void) const
+{
+    return _inProgress ? _elapsedTimer.elapsed() : _elapsedMSecs;
+}
+
+void FleetPlanUploader::setMaxConcurrentUploads(int maxConcurrentUploads)
+{
+    _maxConcurrentUploads = qMax(1, maxConcurrentUploads);
+    if (_inProgress) {
+        _startNext();
+    }
+}
+
+FleetPlanUploader* FleetPlanUploader::sendPlanToVehicles(const QList<Vehicle*>& vehicles, const QString& filename)
+{
+    if (vehicles.isEmpty()) {
+        return nullptr;
+    }
+
+    FleetPlanUploader* uploader = new FleetPlanUploader();
+    uploader->_deleteWhenComplete = true;
+
+    // Load the plan the same way PlanMasterController::sendPlanToVehicle does, but only once per firmware and
+    // vehicle type instead of once per vehicle
+    QList<ConversionKey_t> keys;
+    for (Vehicle* vehicle: vehicles) {
+        const ConversionKey_t key = _conversionKey(vehicle);
+        if (keys.contains(key)) {
+            continue;
+        }
+        keys.append(key);
+
+        PlanMasterController planController;
+        planController.startStaticActiveVehicle(vehicle);
+        planController.loadFromFile(filename);
+        if (keys.count() == 1) {
+            uploader->setPlan(&planController);
+        } else {
+            uploader->addMissionConversion(&planController);
+        }
+    }
+
+    uploader->start(vehicles);
+
+    return uploader;
+}
+
+void FleetPlanUploader::_startNext(void)
+{
+    if (!_inProgress) {
+        return;
+    }
+
+    int running = 0;
+    for (const VehicleUpload_t* upload: _uploads) {
+        if (upload->state != StatePending && upload->state != StateDone) {
+            running++;
+        }
+    }
+
+    for (int i=0; i<_uploads.count() && running < _maxConcurrentUploads; i++) {
+        VehicleUpload_t* upload = _uploads[i];
+        if (upload->state == StatePending && (!upload->vehicle || !_vehicleBusy(upload->vehicle))) {
+            _startVehicle(upload);
+            if (upload->state != StateDone) {
+                running++;
+            }
+        }
+    }
+}
+
+void FleetPlanUploader::_vehicleRemoved(Vehicle* vehicle)
+{
+    VehicleUpload_t* upload = _uploadForVehicle(vehicle);
+    if (upload && upload->state != StateDone) {
+        qCDebug(FleetPlanUploaderLog) << "_vehicleRemoved vehicle removed during upload" << vehicle->id();
+        _vehicleDone(upload, true /* error */);
+    }
+}
+
+FleetPlanUploader::VehicleUpload_t* FleetPlanUploader::_uploadForVehicle(Vehicle* vehicle)
+{
+    for (VehicleUpload_t* upload: _uploads) {
+        if (upload->vehicle == vehicle) {
+            return upload;
+        }
+    }
+    return nullptr;
+}
+
+bool FleetPlanUploader::_vehicleBusy(Vehicle* vehicle) const
+{
+    return vehicle->missionManager()->inProgress() || vehicle->geoFenceManager()->inProgress() || vehicle->rallyPointManager()->inProgress();
+}
+
+bool FleetPlanUploader::_geoFenceSupported(Vehicle* vehicle) const
+{
+    // Same test as GeoFenceController::supported
+    return (vehicle->capabilityBits() & MAV_PROTOCOL_CAPABILITY_MISSION_FENCE) && (vehicle->maxProtoVersion() >= 200);
+}
+
+bool FleetPlanUploader::_rallyPointsSupported(Vehicle* vehicle) const
+{
+    // Same test as RallyPointController::supported
+    return (vehicle->capabilityBits() & MAV_PROTOCOL_CAPABILITY_MISSION_RALLY) && (vehicle->maxProtoVersion() >= 200);
+}
+
+int FleetPlanUploader::_geoFenceItemCount(void)
+{
+    int count = _circles.count() + (_breachReturnPoint.isValid() ? 1 : 0);
+    for (int i=0; i<_polygons.count(); i++) {
+        count += _polygons.value<QGCFencePolygon*>(i)->count();
+    }
+    return count;
+}
+
+void FleetPlanUploader::_startVehicle(VehicleUpload_t* upload)
+{
+    Vehicle* vehicle = upload->vehicle;
+    if (!vehicle) {
+        _vehicleDone(upload, true /* error */);
+        return;
+    }
+
+    // PlanManager ignores writes to the offline editing vehicle without signalling completion
+    if (vehicle->isOfflineEditingVehicle()) {
+        qCDebug(FleetPlanUploaderLog) << "_startVehicle offline editing vehicle, skipping";
+        _vehicleDone(upload, true /* error */);
+        return;
+    }
+
+    const ConversionKey_t key = _conversionKey(vehicle);
+    if (!_missionItems.contains(key)) {
+        qCWarning(FleetPlanUploaderLog) << "_startVehicle plan not converted for firmware:vehicle type, skipping vehicle" << key.first << key.second << vehicle->id();
+        _vehicleDone(upload, true /* error */);
+        return;
+    }
+
+    WeakLinkInterfacePtr weakLink = vehicle->vehicleLinkManager()->primaryLink();
+    if (weakLink.expired() || weakLink.lock()->linkConfiguration()->isHighLatency()) {
+        qCDebug(FleetPlanUploaderLog) << "_startVehicle no link or high latency link, skipping vehicle" << vehicle->id();
+        _vehicleDone(upload, true /* error */);
+        return;
+    }
+
+    qCDebug(FleetPlanUploaderLog) << "_startVehicle mission" << vehicle->id();
+
+    connect(vehicle->missionManager(),      &PlanManager::sendComplete, this, [this, vehicle](bool error) { _sendComplete(vehicle, error); });
+    connect(vehicle->geoFenceManager(),     &PlanManager::sendComplete, this, [this, vehicle](bool error) { _sendComplete(vehicle, error); });
+    connect(vehicle->rallyPointManager(),   &PlanManager::sendComplete, this, [this, vehicle](bool error) { _sendComplete(vehicle, error); });
+    connect(vehicle->missionManager(),      &PlanManager::progressPct,  this, [this, vehicle](double pct) { _stageProgress(vehicle, pct); });
+    connect(vehicle->geoFenceManager(),     &PlanManager::progressPct,  this, [this, vehicle](double pct) { _stageProgress(vehicle, pct); });
+    connect(vehicle->rallyPointManager(),   &PlanManager::progressPct,  this, [this, vehicle](double pct) { _stageProgress(vehicle, pct); });
+
+    QList<MissionItem*> rgMissionItems;
+    for (const MissionItem* item: _missionItems[key]) {
+        rgMissionItems.append(new MissionItem(*item, vehicle));
+    }
+
+    upload->state           = StateMission;
+    upload->stageItemCount  = rgMissionItems.count();
+
+    // PlanManager takes control of MissionItems so no need to delete
+    vehicle->missionManager()->writeMissionItems(rgMissionItems);
+}
+
+void FleetPlanUploader::_sendGeoFence(VehicleUpload_t* upload)
+{
+    upload->state = StateGeoFence;
+    if (_geoFenceSupported(upload->vehicle)) {
+        qCDebug(FleetPlanUploaderLog) << "_sendGeoFence" << upload->vehicle->id();
+        upload->stageItemCount = _geoFenceItemCount();
+        upload->vehicle->geoFenceManager()->sendToVehicle(_breachReturnPoint, _polygons, _circles);
+    } else {
+        _sendRallyPoints(upload);
+    }
+}
+
+void FleetPlanUploader::_sendRallyPoints(VehicleUpload_t* upload)
+{
+    upload->state = StateRallyPoints;
+    if (_rallyPointsSupported(upload->vehicle)) {
+        qCDebug(FleetPlanUploaderLog) << "_sendRallyPoints" << upload->vehicle->id();
+        upload->stageItemCount = _rallyPoints.count();
+        upload->vehicle->rallyPointManager()->sendToVehicle(_rallyPoints);
+    } else {
+        _vehicleDone(upload, false /* error */);
+    }
+}
+
+void FleetPlanUploader::_sendComplete(Vehicle* vehicle, bool error)
+{
+    VehicleUpload_t* upload = _uploadForVehicle(vehicle);
+    if (!upload || upload->state == StatePending || upload->state == StateDone) {
+        return;
+    }
+
+    if (error) {
+        qCDebug(FleetPlanUploaderLog) << "_sendComplete failed vehicle:state" << vehicle->id() << upload->state;
+        _vehicleDone(upload, true /* error */);
+        return;
+    }
+
+    upload->itemsComplete += upload->stageItemCount;
+    upload->stageItemCount = 0;
+
+    switch (upload->state) {
+    case StateMission:
+        _sendGeoFence(upload);
+        break;
+    case StateGeoFence:
+        _sendRallyPoints(upload);
+        break;
+    case StateRallyPoints:
+        _vehicleDone(upload, false /* error */);
+        break;
+    default:
+        break;
+    }
+}
+
+void FleetPlanUploader::_stageProgress(Vehicle* vehicle, double stageProgress)
+{
+    VehicleUpload_t* upload = _uploadForVehicle(vehicle);
+    if (!upload || upload->state == StatePending || upload->state == StateDone || upload->itemCount == 0) {
+        return;
+    }
+
+    double newProgress = (upload->itemsComplete + (stageProgress * upload->stageItemCount)) / upload->itemCount;
+    if (newProgress > upload->progress) {
+        upload->progress = qMin(newProgress, 1.0);
+        emit vehicleProgressChanged(vehicle, upload->progress);
+        emit progressChanged(progress());
+    }
+}
+
+void FleetPlanUploader::_vehicleDone(VehicleUpload_t* upload, bool error)
+{
+    Vehicle* vehicle = upload->vehicle;
+
+    upload->state = StateDone;
+    upload->error = error;
+    upload->progress = 1;
+    if (vehicle) {
+        _disconnectVehicle(vehicle);
+    }
+
+    qCDebug(FleetPlanUploaderLog) << "_vehicleDone vehicle:error:elapsed" << (vehicle ? vehicle->id() : -1) << error << _elapsedTimer.elapsed();
+
+    emit vehicleProgressChanged(vehicle, 1);
+    emit vehicleComplete(vehicle, error);
+    emit progressChanged(progress());
+
+    int failedCount = 0;
+    for (const VehicleUpload_t* other: _uploads) {
+        if (other->state != StateDone) {
+            // Free slot goes to the next waiting vehicle, from the event loop since we may be inside a PlanManager signal
+            QMetaObject::invokeMethod(this, "_startNext", Qt::QueuedConnection);
+            return;
+        }
+        if (other->error) {
+            failedCount++;
+        }
+    }
+
+    _inProgress = false;
+    _elapsedMSecs = _elapsedTimer.elapsed();
+    qCDebug(FleetPlanUploaderLog) << "complete vehicles:failed:elapsed" << _uploads.count() << failedCount << _elapsedMSecs;
+    emit inProgressChanged(false);
+    emit complete(failedCount, _elapsedMSecs);
+
+    if (_deleteWhenComplete) {
+        deleteLater();
+    }
+}
+
+void FleetPlanUploader::_disconnectVehicle(Vehicle* vehicle)
+{
+    disconnect(vehicle->missionManager(),       nullptr, this, nullptr);
+    disconnect(vehicle->geoFenceManager(),      nullptr, this, nullptr);
+    disconnect(vehicle->rallyPointManager(),    nullptr, this, nullptr);
+}
+
+void FleetPlanUploader::_clearMissionItems(void)
+{
+    for (const QList<MissionItem*>& missionItems: _missionItems) {
+        qDeleteAll(missionItems);
+    }
+    _missionItems.clear();
+}
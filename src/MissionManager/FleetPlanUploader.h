@@ -0,0 +1,137 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QGeoCoordinate>
+#include <QMap>
+#include <QPair>
+
+#include "QGCLoggingCategory.h"
+#include "QmlObjectListModel.h"
+
+Q_DECLARE_LOGGING_CATEGORY(FleetPlanUploaderLog)
+
+class Vehicle;
+class MissionItem;
+class PlanMasterController;
+
+/// Sends a single plan to many vehicles at the same time.
+///
+/// The plan is converted to MissionItems once per firmware and vehicle type in the fleet, up front. Each vehicle is
+/// sent plain copies of the items converted for its type, so the cost per vehicle is the upload itself instead of a
+/// PlanMasterController loading and converting the plan again.
+/// The mission, fence and rally uploads of a vehicle follow each other as they do in PlanMasterController, while
+/// the uploads to separate vehicles run side by side.
+///
+/// The mission item protocol keeps at most one item in flight per upload, which bounds the link load of a single
+/// upload. The maximum number of concurrent uploads is therefore the budget which keeps the combined load within
+/// what the links can carry. Vehicles beyond it wait for a running upload to finish.
+class FleetPlanUploader : public QObject
+{
+    Q_OBJECT
+
+public:
+    FleetPlanUploader(QObject* parent = nullptr);
+    ~FleetPlanUploader();
+
+    Q_PROPERTY(bool     inProgress  READ inProgress NOTIFY inProgressChanged)
+    Q_PROPERTY(double   progress    READ progress   NOTIFY progressChanged)     ///< 0 to 1 across all vehicles
+
+    /// Takes a copy of the plan from the controller. The mission is converted to mission items using the
+    /// firmware and vehicle type of the controller's manager vehicle.
+    void setPlan(PlanMasterController* planController);
+
+    /// Adds the mission as converted by a controller whose manager vehicle has another firmware or vehicle type
+    /// than the one passed to setPlan. The fence and rally points are taken from setPlan.
+    void addMissionConversion(PlanMasterController* planController);
+
+    /// Starts sending the plan to the vehicles. The first uploads begin from the event loop. Vehicles with a firmware
+    /// and vehicle type the mission wasn't converted for fail as soon as their upload would begin.
+    /// @return false: Upload already in progress or no vehicles
+    bool start(const QList<Vehicle*>& vehicles);
+
+    bool    inProgress              (void) const { return _inProgress; }
+    double  progress                (void) const;
+    double  vehicleProgress         (Vehicle* vehicle) const;       ///< 0 to 1, -1 for a vehicle which isn't part of the upload
+    qint64  elapsedMSecs            (void) const;                   ///< Since start, stops counting when the last vehicle completes
+    int     maxConcurrentUploads    (void) const { return _maxConcurrentUploads; }
+    void    setMaxConcurrentUploads (int maxConcurrentUploads);
+
+    /// Sends a plan file to the specified vehicles. The returned uploader deletes itself when complete.
+    ///     @param[in] vehicles Vehicles we are sending the plan to, the plan is converted once per firmware and vehicle type
+    ///     @param[in] filename Plan file to load
+    static FleetPlanUploader* sendPlanToVehicles(const QList<Vehicle*>& vehicles, const QString& filename);
+
+    static const int defaultMaxConcurrentUploads = 8;
+
+signals:
+    void inProgressChanged      (bool inProgress);
+    void progressChanged        (double progress);
+    void vehicleProgressChanged (Vehicle* vehicle, double progress);
+    void vehicleComplete        (Vehicle* vehicle, bool error);
+    void complete               (int failedCount, qint64 elapsedMSecs);
+
+private slots:
+    void _startNext             (void);
+    void _vehicleRemoved        (Vehicle* vehicle);
+
+private:
+    typedef enum {
+        StatePending,
+        StateMission,
+        StateGeoFence,
+        StateRallyPoints,
+        StateDone
+    } State_t;
+
+    typedef struct {
+        QPointer<Vehicle>   vehicle;
+        State_t             state;
+        bool                error;
+        int                 itemCount;          ///< Total items sent to this vehicle, over all plan types
+        int                 itemsComplete;      ///< Items in plan types which are already sent
+        int                 stageItemCount;     ///< Items in the plan type currently being sent
+        double              progress;
+    } VehicleUpload_t;
+
+    typedef QPair<int, int> ConversionKey_t;    ///< MAV_AUTOPILOT, MAV_TYPE
+
+    static ConversionKey_t _conversionKey       (Vehicle* vehicle);
+
+    VehicleUpload_t*    _uploadForVehicle       (Vehicle* vehicle);
+    bool                _vehicleBusy            (Vehicle* vehicle) const;
+    bool                _geoFenceSupported      (Vehicle* vehicle) const;
+    bool                _rallyPointsSupported   (Vehicle* vehicle) const;
+    int                 _geoFenceItemCount      (void);
+    void                _startVehicle           (VehicleUpload_t* upload);
+    void                _sendGeoFence           (VehicleUpload_t* upload);
+    void                _sendRallyPoints        (VehicleUpload_t* upload);
+    void                _sendComplete           (Vehicle* vehicle, bool error);
+    void                _stageProgress          (Vehicle* vehicle, double stageProgress);
+    void                _vehicleDone            (VehicleUpload_t* upload, bool error);
+    void                _disconnectVehicle      (Vehicle* vehicle);
+    void                _clearMissionItems      (void);
+
+    QMap<ConversionKey_t, QList<MissionItem*>> _missionItems;  ///< Converted once per type, every vehicle is sent copies of these
+    QmlObjectListModel          _polygons;
+    QmlObjectListModel          _circles;
+    QGeoCoordinate              _breachReturnPoint;
+    QList<QGeoCoordinate>       _rallyPoints;
+
+    QList<VehicleUpload_t*>     _uploads;
+    int                         _maxConcurrentUploads   = defaultMaxConcurrentUploads;
+    bool                        _inProgress             = false;
+    bool                        _deleteWhenComplete     = false;
+    QElapsedTimer               _elapsedTimer;
+    qint64                      _elapsedMSecs           = 0;
+};
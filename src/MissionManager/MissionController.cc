@@ -39,7 +39,7 @@ QGC_LOGGING_CATEGORY(MissionControllerLog, "MissionControllerLog")
 
 const char* MissionController::_settingsGroup =                 "MissionController";
 const char* MissionController::_jsonFileTypeValue =             "Mission";
-const char* MissionController::_jsonItemsKey =                  "items";
+const char* MissionController::jsonItemsKey =                   "items";
 const char* MissionController::_jsonPlannedHomePositionKey =    "plannedHomePosition";
 const char* MissionController::_jsonFirmwareTypeKey =           "firmwareType";
 const char* MissionController::_jsonVehicleTypeKey =            "vehicleType";
@@ -66,8 +66,16 @@ MissionController::MissionController(PlanMasterController* masterController, QOb
     _resetMissionFlightStatus();
 
     _updateTimer.setSingleShot(true);
+    _incrementalLoadTimer.setSingleShot(true);
+    _incrementalLoadTimer.setInterval(0);
+    _terrainClearanceTimer.setSingleShot(true);
+    _terrainClearanceTimer.setInterval(_terrainClearanceDelayMsecs);
 
     connect(&_updateTimer,                                  &QTimer::timeout,                           this, &MissionController::_updateTimeout);
+    connect(&_incrementalLoadTimer,                         &QTimer::timeout,                           this, &MissionController::_incrementalLoadNextBatch);
+    connect(&_terrainClearanceTimer,                        &QTimer::timeout,                           this, &MissionController::_sendTerrainClearanceRequest);
+    connect(&_terrainClearanceEngine,                       &TerrainClearanceEngine::segmentClearanceReceived, this, &MissionController::_terrainClearanceReceived);
+    connect(&_terrainClearanceEngine,                       &TerrainClearanceEngine::clearanceComplete, this, &MissionController::_terrainClearanceComplete);
     connect(_planViewSettings->takeoffItemNotRequired(),    &Fact::rawValueChanged,                     this, &MissionController::_takeoffItemNotRequiredChanged);
     connect(this,                                           &MissionController::missionDistanceChanged, this, &MissionController::recalcTerrainProfile);
 
@@ -233,6 +241,7 @@ void MissionController::sendToVehicle(void)
         qCWarning(MissionControllerLog) << "MissionControllerLog::sendToVehicle called while syncInProgress";
     } else {
         qCDebug(MissionControllerLog) << "MissionControllerLog::sendToVehicle";
+        loadAllPendingItems();
         if (_visualItems->count() == 1) {
             // This prevents us from sending a possibly bogus home position to the vehicle
             QmlObjectListModel emptyModel;
@@ -277,11 +286,22 @@ bool MissionController::_convertToMissionItems(QmlObjectListModel* visualMission
     return endActionSet;
 }
 
+void MissionController::convertToMissionItems(QList<MissionItem*>& rgMissionItems, QObject* missionItemParent)
+{
+    loadAllPendingItems();
+
+    // A plan with only the settings item sends nothing, the same as sendToVehicle
+    if (_visualItems->count() > 1) {
+        _convertToMissionItems(_visualItems, rgMissionItems, missionItemParent);
+    }
+}
+
 void MissionController::addMissionToKML(KMLPlanDomDocument& planKML)
 {
     QObject*            deleteParent = new QObject();
     QList<MissionItem*> rgMissionItems;
 
+    loadAllPendingItems();
     _convertToMissionItems(_visualItems, rgMissionItems, deleteParent);
     planKML.addMission(_controllerVehicle, _visualItems, rgMissionItems);
     deleteParent->deleteLater();
@@ -312,6 +332,8 @@ int MissionController::_nextSequenceNumber(void)
 
 VisualMissionItem* MissionController::_insertSimpleMissionItemWorker(QGeoCoordinate coordinate, MAV_CMD command, int visualItemIndex, bool makeCurrentItem)
 {
+    loadAllPendingItems();
+
     int sequenceNumber = _nextSequenceNumber();
     SimpleMissionItem * newItem = new SimpleMissionItem(_masterController, _flyView, false /* forLoad */);
     newItem->setSequenceNumber(sequenceNumber);
@@ -359,6 +381,8 @@ VisualMissionItem* MissionController::insertSimpleMissionItem(QGeoCoordinate coo
 
 VisualMissionItem* MissionController::insertTakeoffItem(QGeoCoordinate /*coordinate*/, int visualItemIndex, bool makeCurrentItem)
 {
+    loadAllPendingItems();
+
     int sequenceNumber = _nextSequenceNumber();
     _takeoffMissionItem = new TakeoffMissionItem(_controllerVehicle->vtol() ? MAV_CMD_NAV_VTOL_TAKEOFF : MAV_CMD_NAV_TAKEOFF, _masterController, _flyView, _settingsItem, false /* forLoad */);
     _takeoffMissionItem->setSequenceNumber(sequenceNumber);
@@ -431,6 +455,8 @@ VisualMissionItem* MissionController::insertComplexMissionItem(QString itemName,
 {
     ComplexMissionItem* newItem = nullptr;
 
+    loadAllPendingItems();
+
     if (itemName == SurveyComplexItem::name) {
         newItem = new SurveyComplexItem(_masterController, _flyView, QString() /* kmlFile */);
         newItem->setCoordinate(mapCenterCoordinate);
@@ -465,6 +491,8 @@ VisualMissionItem* MissionController::insertComplexMissionItemFromKMLOrSHP(QStri
 {
     ComplexMissionItem* newItem = nullptr;
 
+    loadAllPendingItems();
+
     if (itemName == SurveyComplexItem::name) {
         newItem = new SurveyComplexItem(_masterController, _flyView, file);
     } else if (itemName == StructureScanComplexItem::name) {
@@ -540,6 +568,8 @@ void MissionController::_insertComplexMissionItemWorker(const QGeoCoordinate& ma
 
 void MissionController::removeVisualItem(int viIndex)
 {
+    loadAllPendingItems();
+
     if (viIndex <= 0 || viIndex >= _visualItems->count()) {
         qWarning() << "MissionController::removeVisualItem called with bad index - count:index" << _visualItems->count() << viIndex;
         return;
@@ -622,7 +652,7 @@ bool MissionController::_loadJsonMissionFileV1(const QJsonObject& json, QmlObjec
     // Validate root object keys
     QList<JsonHelper::KeyValidateInfo> rootKeyInfoList = {
         { _jsonPlannedHomePositionKey,      QJsonValue::Object, true },
-        { _jsonItemsKey,                    QJsonValue::Array,  true },
+        { jsonItemsKey,                     QJsonValue::Array,  true },
         { _jsonMavAutopilotKey,             QJsonValue::Double, true },
         { _jsonComplexItemsKey,             QJsonValue::Array,  true },
     };
@@ -658,7 +688,7 @@ bool MissionController::_loadJsonMissionFileV1(const QJsonObject& json, QmlObjec
     int nextSimpleItemIndex= 0;
     int nextComplexItemIndex= 0;
     int nextSequenceNumber = 1; // Start with 1 since home is in 0
-    QJsonArray itemArray(json[_jsonItemsKey].toArray());
+    QJsonArray itemArray(json[jsonItemsKey].toArray());
 
     MissionSettingsItem* settingsItem = _addMissionSettings(visualItems);
     if (json.contains(_jsonPlannedHomePositionKey)) {
@@ -724,7 +754,7 @@ bool MissionController::_loadJsonMissionFileV2(const QJsonObject& json, QmlObjec
     // Validate root object keys
     QList<JsonHelper::KeyValidateInfo> rootKeyInfoList = {
         { _jsonPlannedHomePositionKey,      QJsonValue::Array,  true },
-        { _jsonItemsKey,                    QJsonValue::Array,  true },
+        { jsonItemsKey,                     QJsonValue::Array,  true },
         { _jsonFirmwareTypeKey,             QJsonValue::Double, true },
         { _jsonVehicleTypeKey,              QJsonValue::Double, false },
         { _jsonCruiseSpeedKey,              QJsonValue::Double, false },
@@ -737,7 +767,7 @@ bool MissionController::_loadJsonMissionFileV2(const QJsonObject& json, QmlObjec
 
     setGlobalAltitudeMode(QGroundControlQmlGlobal::AltitudeModeMixed);
 
-    qCDebug(MissionControllerLog) << "MissionController::_loadJsonMissionFileV2 itemCount:" << json[_jsonItemsKey].toArray().count();
+    qCDebug(MissionControllerLog) << "MissionController::_loadJsonMissionFileV2 itemCount:" << json[jsonItemsKey].toArray().count();
 
     AppSettings* appSettings = qgcApp()->toolbox()->settingsManager()->appSettings();
 
@@ -783,7 +813,7 @@ bool MissionController::_loadJsonMissionFileV2(const QJsonObject& json, QmlObjec
     // Read mission items
 
     int nextSequenceNumber = 1; // Start with 1 since home is in 0
-    const QJsonArray rgMissionItems(json[_jsonItemsKey].toArray());
+    const QJsonArray rgMissionItems(json[jsonItemsKey].toArray());
     for (int i=0; i<rgMissionItems.count(); i++) {
         // Convert to QJsonObject
         const QJsonValue& itemValue = rgMissionItems[i];
@@ -791,98 +821,113 @@ bool MissionController::_loadJsonMissionFileV2(const QJsonObject& json, QmlObjec
             errorString = tr("Mission item %1 is not an object").arg(i);
             return false;
         }
-        const QJsonObject itemObject = itemValue.toObject();
+        if (!_loadVisualItemFromJson(itemValue.toObject(), nextSequenceNumber, settingsItem, visualItems, errorString)) {
+            return false;
+        }
+    }
+
+    return _fixupDoJumpSequenceNumbers(visualItems, errorString);
+}
+
+/// Creates the visual item for a single mission item json object and appends it to visualItems
+///     @param nextSequenceNumber Sequence number for the item, updated to the sequence number following it
+/// @return false: Load failed, errorString set. An unsupported complex item type sets errorString but is skipped.
+bool MissionController::_loadVisualItemFromJson(const QJsonObject& itemObject, int& nextSequenceNumber, MissionSettingsItem* settingsItem, QmlObjectListModel* visualItems, QString& errorString)
+{
+    // Load item based on type
 
-        // Load item based on type
+    QList<JsonHelper::KeyValidateInfo> itemKeyInfoList = {
+        { VisualMissionItem::jsonTypeKey,  QJsonValue::String, true },
+    };
+    if (!JsonHelper::validateKeys(itemObject, itemKeyInfoList, errorString)) {
+        return false;
+    }
+    QString itemType = itemObject[VisualMissionItem::jsonTypeKey].toString();
 
-        QList<JsonHelper::KeyValidateInfo> itemKeyInfoList = {
-            { VisualMissionItem::jsonTypeKey,  QJsonValue::String, true },
+    if (itemType == VisualMissionItem::jsonTypeSimpleItemValue) {
+        SimpleMissionItem* simpleItem = new SimpleMissionItem(_masterController, _flyView, true /* forLoad */);
+        if (simpleItem->load(itemObject, nextSequenceNumber, errorString)) {
+            if (TakeoffMissionItem::isTakeoffCommand(static_cast<MAV_CMD>(simpleItem->command()))) {
+                // This needs to be a TakeoffMissionItem
+                TakeoffMissionItem* takeoffItem = new TakeoffMissionItem(_masterController, _flyView, settingsItem, true /* forLoad */);
+                takeoffItem->load(itemObject, nextSequenceNumber, errorString);
+                simpleItem->deleteLater();
+                simpleItem = takeoffItem;
+            }
+            qCDebug(MissionControllerLog) << "Loading simple item: nextSequenceNumber:command" << nextSequenceNumber << simpleItem->command();
+            nextSequenceNumber = simpleItem->lastSequenceNumber() + 1;
+            visualItems->append(simpleItem);
+        } else {
+            return false;
+        }
+    } else if (itemType == VisualMissionItem::jsonTypeComplexItemValue) {
+        QList<JsonHelper::KeyValidateInfo> complexItemKeyInfoList = {
+            { ComplexMissionItem::jsonComplexItemTypeKey,  QJsonValue::String, true },
         };
-        if (!JsonHelper::validateKeys(itemObject, itemKeyInfoList, errorString)) {
+        if (!JsonHelper::validateKeys(itemObject, complexItemKeyInfoList, errorString)) {
             return false;
         }
-        QString itemType = itemObject[VisualMissionItem::jsonTypeKey].toString();
+        QString complexItemType = itemObject[ComplexMissionItem::jsonComplexItemTypeKey].toString();
 
-        if (itemType == VisualMissionItem::jsonTypeSimpleItemValue) {
-            SimpleMissionItem* simpleItem = new SimpleMissionItem(_masterController, _flyView, true /* forLoad */);
-            if (simpleItem->load(itemObject, nextSequenceNumber, errorString)) {
-                if (TakeoffMissionItem::isTakeoffCommand(static_cast<MAV_CMD>(simpleItem->command()))) {
-                    // This needs to be a TakeoffMissionItem
-                    TakeoffMissionItem* takeoffItem = new TakeoffMissionItem(_masterController, _flyView, settingsItem, true /* forLoad */);
-                    takeoffItem->load(itemObject, nextSequenceNumber, errorString);
-                    simpleItem->deleteLater();
-                    simpleItem = takeoffItem;
-                }
-                qCDebug(MissionControllerLog) << "Loading simple item: nextSequenceNumber:command" << nextSequenceNumber << simpleItem->command();
-                nextSequenceNumber = simpleItem->lastSequenceNumber() + 1;
-                visualItems->append(simpleItem);
-            } else {
+        if (complexItemType == SurveyComplexItem::jsonComplexItemTypeValue) {
+            qCDebug(MissionControllerLog) << "Loading Survey: nextSequenceNumber" << nextSequenceNumber;
+            SurveyComplexItem* surveyItem = new SurveyComplexItem(_masterController, _flyView, QString() /* kmlFile */);
+            if (!surveyItem->load(itemObject, nextSequenceNumber++, errorString)) {
                 return false;
             }
-        } else if (itemType == VisualMissionItem::jsonTypeComplexItemValue) {
-            QList<JsonHelper::KeyValidateInfo> complexItemKeyInfoList = {
-                { ComplexMissionItem::jsonComplexItemTypeKey,  QJsonValue::String, true },
-            };
-            if (!JsonHelper::validateKeys(itemObject, complexItemKeyInfoList, errorString)) {
+            nextSequenceNumber = surveyItem->lastSequenceNumber() + 1;
+            qCDebug(MissionControllerLog) << "Survey load complete: nextSequenceNumber" << nextSequenceNumber;
+            visualItems->append(surveyItem);
+        } else if (complexItemType == FixedWingLandingComplexItem::jsonComplexItemTypeValue) {
+            qCDebug(MissionControllerLog) << "Loading Fixed Wing Landing Pattern: nextSequenceNumber" << nextSequenceNumber;
+            FixedWingLandingComplexItem* landingItem = new FixedWingLandingComplexItem(_masterController, _flyView);
+            if (!landingItem->load(itemObject, nextSequenceNumber++, errorString)) {
                 return false;
             }
-            QString complexItemType = itemObject[ComplexMissionItem::jsonComplexItemTypeKey].toString();
-
-            if (complexItemType == SurveyComplexItem::jsonComplexItemTypeValue) {
-                qCDebug(MissionControllerLog) << "Loading Survey: nextSequenceNumber" << nextSequenceNumber;
-                SurveyComplexItem* surveyItem = new SurveyComplexItem(_masterController, _flyView, QString() /* kmlFile */);
-                if (!surveyItem->load(itemObject, nextSequenceNumber++, errorString)) {
-                    return false;
-                }
-                nextSequenceNumber = surveyItem->lastSequenceNumber() + 1;
-                qCDebug(MissionControllerLog) << "Survey load complete: nextSequenceNumber" << nextSequenceNumber;
-                visualItems->append(surveyItem);
-            } else if (complexItemType == FixedWingLandingComplexItem::jsonComplexItemTypeValue) {
-                qCDebug(MissionControllerLog) << "Loading Fixed Wing Landing Pattern: nextSequenceNumber" << nextSequenceNumber;
-                FixedWingLandingComplexItem* landingItem = new FixedWingLandingComplexItem(_masterController, _flyView);
-                if (!landingItem->load(itemObject, nextSequenceNumber++, errorString)) {
-                    return false;
-                }
-                nextSequenceNumber = landingItem->lastSequenceNumber() + 1;
-                qCDebug(MissionControllerLog) << "FW Landing Pattern load complete: nextSequenceNumber" << nextSequenceNumber;
-                visualItems->append(landingItem);
-            } else if (complexItemType == VTOLLandingComplexItem::jsonComplexItemTypeValue) {
-                qCDebug(MissionControllerLog) << "Loading VTOL Landing Pattern: nextSequenceNumber" << nextSequenceNumber;
-                VTOLLandingComplexItem* landingItem = new VTOLLandingComplexItem(_masterController, _flyView);
-                if (!landingItem->load(itemObject, nextSequenceNumber++, errorString)) {
-                    return false;
-                }
-                nextSequenceNumber = landingItem->lastSequenceNumber() + 1;
-                qCDebug(MissionControllerLog) << "VTOL Landing Pattern load complete: nextSequenceNumber" << nextSequenceNumber;
-                visualItems->append(landingItem);
-            } else if (complexItemType == StructureScanComplexItem::jsonComplexItemTypeValue) {
-                qCDebug(MissionControllerLog) << "Loading Structure Scan: nextSequenceNumber" << nextSequenceNumber;
-                StructureScanComplexItem* structureItem = new StructureScanComplexItem(_masterController, _flyView, QString() /* kmlFile */);
-                if (!structureItem->load(itemObject, nextSequenceNumber++, errorString)) {
-                    return false;
-                }
-                nextSequenceNumber = structureItem->lastSequenceNumber() + 1;
-                qCDebug(MissionControllerLog) << "Structure Scan load complete: nextSequenceNumber" << nextSequenceNumber;
-                visualItems->append(structureItem);
-            } else if (complexItemType == CorridorScanComplexItem::jsonComplexItemTypeValue) {
-                qCDebug(MissionControllerLog) << "Loading Corridor Scan: nextSequenceNumber" << nextSequenceNumber;
-                CorridorScanComplexItem* corridorItem = new CorridorScanComplexItem(_masterController, _flyView, QString() /* kmlFile */);
-                if (!corridorItem->load(itemObject, nextSequenceNumber++, errorString)) {
-                    return false;
-                }
-                nextSequenceNumber = corridorItem->lastSequenceNumber() + 1;
-                qCDebug(MissionControllerLog) << "Corridor Scan load complete: nextSequenceNumber" << nextSequenceNumber;
-                visualItems->append(corridorItem);
-            } else {
-                errorString = tr("Unsupported complex item type: %1").arg(complexItemType);
+            nextSequenceNumber = landingItem->lastSequenceNumber() + 1;
+            qCDebug(MissionControllerLog) << "FW Landing Pattern load complete: nextSequenceNumber" << nextSequenceNumber;
+            visualItems->append(landingItem);
+        } else if (complexItemType == VTOLLandingComplexItem::jsonComplexItemTypeValue) {
+            qCDebug(MissionControllerLog) << "Loading VTOL Landing Pattern: nextSequenceNumber" << nextSequenceNumber;
+            VTOLLandingComplexItem* landingItem = new VTOLLandingComplexItem(_masterController, _flyView);
+            if (!landingItem->load(itemObject, nextSequenceNumber++, errorString)) {
+                return false;
+            }
+            nextSequenceNumber = landingItem->lastSequenceNumber() + 1;
+            qCDebug(MissionControllerLog) << "VTOL Landing Pattern load complete: nextSequenceNumber" << nextSequenceNumber;
+            visualItems->append(landingItem);
+        } else if (complexItemType == StructureScanComplexItem::jsonComplexItemTypeValue) {
+            qCDebug(MissionControllerLog) << "Loading Structure Scan: nextSequenceNumber" << nextSequenceNumber;
+            StructureScanComplexItem* structureItem = new StructureScanComplexItem(_masterController, _flyView, QString() /* kmlFile */);
+            if (!structureItem->load(itemObject, nextSequenceNumber++, errorString)) {
+                return false;
+            }
+            nextSequenceNumber = structureItem->lastSequenceNumber() + 1;
+            qCDebug(MissionControllerLog) << "Structure Scan load complete: nextSequenceNumber" << nextSequenceNumber;
+            visualItems->append(structureItem);
+        } else if (complexItemType == CorridorScanComplexItem::jsonComplexItemTypeValue) {
+            qCDebug(MissionControllerLog) << "Loading Corridor Scan: nextSequenceNumber" << nextSequenceNumber;
+            CorridorScanComplexItem* corridorItem = new CorridorScanComplexItem(_masterController, _flyView, QString() /* kmlFile */);
+            if (!corridorItem->load(itemObject, nextSequenceNumber++, errorString)) {
+                return false;
             }
+            nextSequenceNumber = corridorItem->lastSequenceNumber() + 1;
+            qCDebug(MissionControllerLog) << "Corridor Scan load complete: nextSequenceNumber" << nextSequenceNumber;
+            visualItems->append(corridorItem);
         } else {
-            errorString = tr("Unknown item type: %1").arg(itemType);
-            return false;
+            errorString = tr("Unsupported complex item type: %1").arg(complexItemType);
         }
+    } else {
+        errorString = tr("Unknown item type: %1").arg(itemType);
+        return false;
     }
 
-    // Fix up the DO_JUMP commands jump sequence number by finding the item with the matching doJumpId
+    return true;
+}
+
+/// Fix up the DO_JUMP commands jump sequence number by finding the item with the matching doJumpId
+bool MissionController::_fixupDoJumpSequenceNumbers(QmlObjectListModel* visualItems, QString& errorString)
+{
     for (int i=0; i<visualItems->count(); i++) {
         if (visualItems->value<VisualMissionItem*>(i)->isSimpleItem()) {
             SimpleMissionItem* doJumpItem = visualItems->value<SimpleMissionItem*>(i);
@@ -995,7 +1040,10 @@ bool MissionController::_loadTextMissionFile(QTextStream& stream, QmlObjectListM
     return true;
 }
 
-void MissionController::_initLoadedVisualItems(QmlObjectListModel* loadedVisualItems)
+/// Makes a newly loaded item list the current one
+///     @param itemsPending true: More items from a binary plan follow, the scan for a landing pattern at the end
+///                             of the mission waits for the last of them
+void MissionController::_initLoadedVisualItems(QmlObjectListModel* loadedVisualItems, bool itemsPending)
 {
     if (_visualItems) {
         _deinitAllVisualItems();
@@ -1012,7 +1060,7 @@ void MissionController::_initLoadedVisualItems(QmlObjectListModel* loadedVisualI
         _settingsItem = _visualItems->value<MissionSettingsItem*>(0);
     }
 
-    MissionController::_scanForAdditionalSettings(_visualItems, _masterController);
+    MissionController::_scanForAdditionalSettings(_visualItems, _masterController, !itemsPending /* scanForLanding */);
 
     _initAllVisualItems();
 
@@ -1062,6 +1110,152 @@ bool MissionController::loadJsonFile(QFile& file, QString& errorString)
     return true;
 }
 
+bool MissionController::loadBinaryPlan(const QJsonObject& json, const PlanBinaryFile& binaryFile, QString& errorString)
+{
+    QString errorStr;
+    QString errorMessage = tr("Mission: %1");
+    QmlObjectListModel* loadedVisualItems = new QmlObjectListModel(this);
+
+    // The json has an empty item list, so this only loads the mission settings
+    if (!_loadJsonMissionFileV2(json, loadedVisualItems, errorStr)) {
+        errorString = errorMessage.arg(errorStr);
+        return false;
+    }
+
+    int batchEnd = _incrementalLoadBatchEnd(binaryFile, 0);
+    if (!_loadBinaryPlanItems(binaryFile, 0, batchEnd, 1 /* nextSequenceNumber */, loadedVisualItems->value<MissionSettingsItem*>(0), loadedVisualItems, errorStr)) {
+        errorString = errorMessage.arg(errorStr);
+        return false;
+    }
+
+    bool itemsPending = batchEnd < binaryFile.itemCount();
+    if (!itemsPending && !_fixupDoJumpSequenceNumbers(loadedVisualItems, errorStr)) {
+        errorString = errorMessage.arg(errorStr);
+        return false;
+    }
+
+    _initLoadedVisualItems(loadedVisualItems, itemsPending);
+
+    if (itemsPending) {
+        qCDebug(MissionControllerLog) << "loadBinaryPlan incremental load started: loaded:total" << batchEnd << binaryFile.itemCount();
+        _pendingItems = binaryFile;
+        _pendingNextItemIndex = batchEnd;
+        _incrementalLoadTimer.start();
+    }
+
+    return true;
+}
+
+/// Creates the visual items for the binary plan items in the range [firstItemIndex, endItemIndex) and appends them to visualItems
+bool MissionController::_loadBinaryPlanItems(const PlanBinaryFile& binaryFile, int firstItemIndex, int endItemIndex, int nextSequenceNumber, MissionSettingsItem* settingsItem, QmlObjectListModel* visualItems, QString& errorString)
+{
+    for (int i=firstItemIndex; i<endItemIndex; i++) {
+        QJsonObject itemObject;
+
+        if (!binaryFile.itemJson(i, itemObject, errorString)) {
+            return false;
+        }
+        if (!_loadVisualItemFromJson(itemObject, nextSequenceNumber, settingsItem, visualItems, errorString)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// @return Item index following the last item in the batch which starts at firstItemIndex
+int MissionController::_incrementalLoadBatchEnd(const PlanBinaryFile& binaryFile, int firstItemIndex)
+{
+    int itemCount   = binaryFile.itemCount();
+    int batchEnd    = qMin(firstItemIndex + static_cast<int>(incrementalLoadBatchSize), itemCount);
+
+    // Non-nav commands following a nav item may be scanned into its camera/speed sections, so a batch never ends in
+    // front of one of them
+    while (batchEnd < itemCount && !binaryFile.itemIsComplex(batchEnd) && binaryFile.itemCommand(batchEnd) >= MAV_CMD_NAV_LAST) {
+        batchEnd++;
+    }
+
+    // A short tail goes along with this batch. This also keeps a landing pattern at the end of the mission within the
+    // final batch, where the scan for it takes place.
+    if (itemCount - batchEnd < incrementalLoadBatchSize / 2) {
+        batchEnd = itemCount;
+    }
+
+    return batchEnd;
+}
+
+void MissionController::_incrementalLoadNextBatch(void)
+{
+    _incrementalLoadBatch(false /* allRemaining */);
+}
+
+void MissionController::loadAllPendingItems(void)
+{
+    if (_pendingItems.isOpen()) {
+        _incrementalLoadBatch(true /* allRemaining */);
+    }
+}
+
+/// Creates the next batch of items from a binary plan load and adds them to the end of the mission
+///     @param allRemaining true: Create all remaining items instead of a single batch
+void MissionController::_incrementalLoadBatch(bool allRemaining)
+{
+    if (!_pendingItems.isOpen()) {
+        return;
+    }
+
+    int     batchEnd    = allRemaining ? _pendingItems.itemCount() : _incrementalLoadBatchEnd(_pendingItems, _pendingNextItemIndex);
+    bool    finalBatch  = batchEnd == _pendingItems.itemCount();
+    bool    wasDirty    = dirty();
+    QString errorString;
+
+    qCDebug(MissionControllerLog) << "_incrementalLoadBatch first:end:total" << _pendingNextItemIndex << batchEnd << _pendingItems.itemCount();
+
+    // Sections and landing patterns are scanned within the batch before the items join the mission
+    QmlObjectListModel batchItems;
+    bool success = _loadBinaryPlanItems(_pendingItems, _pendingNextItemIndex, batchEnd, _nextSequenceNumber(), _settingsItem, &batchItems, errorString);
+    _scanForAdditionalSettings(&batchItems, _masterController, finalBatch /* scanForLanding */);
+    _pendingNextItemIndex = batchEnd;
+
+    for (int i=0; i<batchItems.count(); i++) {
+        VisualMissionItem* item = batchItems.value<VisualMissionItem*>(i);
+
+        _initVisualItem(item);
+        _visualItems->append(item);
+
+        TakeoffMissionItem* takeoffItem = qobject_cast<TakeoffMissionItem*>(item);
+        if (takeoffItem && !_takeoffMissionItem) {
+            _takeoffMissionItem = takeoffItem;
+            emit takeoffMissionItemChanged();
+        }
+    }
+
+    _recalcAll();
+
+    // DO_JUMP targets can be anywhere in the mission, so they are resolved once the last item is in place
+    if (success && finalBatch) {
+        success = _fixupDoJumpSequenceNumbers(_visualItems, errorString);
+    }
+    if (!success || finalBatch) {
+        _cancelIncrementalLoad();
+    } else {
+        _incrementalLoadTimer.start();
+    }
+
+    setDirty(wasDirty);
+
+    if (!success) {
+        qgcApp()->showAppMessage(tr("Mission: %1").arg(errorString));
+    }
+}
+
+void MissionController::_cancelIncrementalLoad(void)
+{
+    _incrementalLoadTimer.stop();
+    _pendingItems.close();
+    _pendingNextItemIndex = 0;
+}
+
 bool MissionController::loadTextFile(QFile& file, QString& errorString)
 {
     QString     errorStr;
@@ -1096,6 +1290,8 @@ int MissionController::readyForSaveState(void) const
 
 void MissionController::save(QJsonObject& json)
 {
+    loadAllPendingItems();
+
     json[JsonHelper::jsonVersionKey] = _missionFileVersion;
 
     // Mission settings
@@ -1138,7 +1334,7 @@ void MissionController::save(QJsonObject& json)
         }
     }
 
-    json[_jsonItemsKey] = rgJsonMissionItems;
+    json[jsonItemsKey] = rgJsonMissionItems;
 }
 
 void MissionController::_calcPrevWaypointValues(VisualMissionItem* currentItem, VisualMissionItem* prevItem, double* azimuth, double* distance, double* altDifference)
@@ -1182,7 +1378,8 @@ FlightPathSegment* MissionController::_createFlightPathSegmentWorker(VisualItemP
         segmentType = FlightPathSegment::SegmentTypeLand;
     }
 
-    FlightPathSegment* segment = new FlightPathSegment(segmentType, coord1, coord1AMSLAlt, coord2, coord2AMSLAlt, !_flyView /* queryTerrainData */,  this);
+    // Terrain heights for all segments come from a single _terrainClearanceEngine pass instead of a query per segment
+    FlightPathSegment* segment = new FlightPathSegment(segmentType, coord1, coord1AMSLAlt, coord2, coord2AMSLAlt, false /* queryTerrainData */,  this);
 
     if (takeoffStraightUp) {
         connect(pair.second, &VisualMissionItem::amslEntryAltChanged, segment, &FlightPathSegment::setCoord1AMSLAlt);
@@ -1201,6 +1398,11 @@ FlightPathSegment* MissionController::_createFlightPathSegmentWorker(VisualItemP
     connect(segment,    &FlightPathSegment::amslTerrainHeightsChanged,  this,       &MissionController::recalcTerrainProfile,             Qt::QueuedConnection);
     connect(segment,    &FlightPathSegment::terrainCollisionChanged,    this,       &MissionController::recalcTerrainProfile,             Qt::QueuedConnection);
 
+    if (!_flyView) {
+        connect(segment, &FlightPathSegment::coordinate1Changed, this, &MissionController::_queueTerrainClearanceRequest);
+        connect(segment, &FlightPathSegment::coordinate2Changed, this, &MissionController::_queueTerrainClearanceRequest);
+    }
+
     return segment;
 }
 
@@ -1462,6 +1664,137 @@ void MissionController::_recalcFlightPathSegments(void)
     if (signalSplitSegmentChanged) {
         emit splitSegmentChanged();
     }
+
+    if (!_flyView) {
+        _queueTerrainClearanceRequest();
+    }
+}
+
+void MissionController::addTerrainClearanceSegment(FlightPathSegment* segment)
+{
+    _complexItemClearanceSegments.append(segment);
+    _queueTerrainClearanceRequest();
+}
+
+void MissionController::requestTransectTerrainHeights(TransectStyleComplexItem* item, const QList<TerrainClearanceEngine::Segment_t>& segments)
+{
+    cancelTransectTerrainHeights(item);
+
+    TransectTerrainRequest_t request;
+    request.item            = item;
+    request.segments        = segments;
+    request.firstIndex      = -1;
+    request.resolvedCount   = 0;
+    _transectTerrainRequests.append(request);
+
+    _queueTerrainClearanceRequest();
+}
+
+void MissionController::cancelTransectTerrainHeights(TransectStyleComplexItem* item)
+{
+    // Requests from deleted items are dropped as well
+    for (int i=_transectTerrainRequests.count() - 1; i >= 0; i--) {
+        if (!_transectTerrainRequests[i].item || _transectTerrainRequests[i].item == item) {
+            _transectTerrainRequests.removeAt(i);
+        }
+    }
+}
+
+void MissionController::_queueTerrainClearanceRequest(void)
+{
+    // Results from a pass over the previous flight path are stale. The request isn't sent until the timer times out,
+    // this way a burst of changes results in a single pass.
+    _terrainClearanceEngine.cancel();
+    _terrainClearanceTimer.start();
+}
+
+void MissionController::_sendTerrainClearanceRequest(void)
+{
+    QList<TerrainClearanceEngine::Segment_t> segments;
+
+    _terrainClearanceSegments.clear();
+    _terrainClearanceResolved.clear();
+    QList<FlightPathSegment*> candidates;
+    if (!_flyView) {
+        candidates = _flightPathSegmentHashTable.values();
+    }
+
+    // Complex items rebuild their segments rather than moving them, deleted ones drop out here
+    _complexItemClearanceSegments.removeAll(nullptr);
+    for (FlightPathSegment* segment: _complexItemClearanceSegments) {
+        candidates.append(segment);
+    }
+
+    for (FlightPathSegment* segment: candidates) {
+        if (segment->coordinate1().isValid() && segment->coordinate2().isValid()) {
+            _terrainClearanceSegments.append(segment);
+            segments.append(segment->clearanceSegment());
+        }
+    }
+
+    // Transect terrain heights follow the flight path segments in the same request
+    cancelTransectTerrainHeights(nullptr);
+    for (TransectTerrainRequest_t& request: _transectTerrainRequests) {
+        request.firstIndex      = segments.count();
+        request.resolvedCount   = 0;
+        request.rgPathHeightInfo.clear();
+        for (int i=0; i<request.segments.count(); i++) {
+            request.rgPathHeightInfo.append(TerrainPathQuery::PathHeightInfo_t());
+        }
+        segments.append(request.segments);
+    }
+
+    qCDebug(MissionControllerLog) << "_sendTerrainClearanceRequest segment count" << segments.count();
+
+    _terrainClearanceEngine.requestClearance(segments);
+}
+
+void MissionController::_terrainClearanceReceived(int index, const TerrainClearanceEngine::SegmentClearance_t& segmentClearance)
+{
+    if (index < _terrainClearanceSegments.count()) {
+        _terrainClearanceResolved.insert(index);
+
+        FlightPathSegment* segment = _terrainClearanceSegments[index];
+        if (segment) {
+            segment->setTerrainClearance(segmentClearance);
+        }
+        return;
+    }
+
+    for (TransectTerrainRequest_t& request: _transectTerrainRequests) {
+        if (request.firstIndex != -1 && index >= request.firstIndex && index < request.firstIndex + request.segments.count()) {
+            request.rgPathHeightInfo[index - request.firstIndex] = segmentClearance.pathHeightInfo;
+            request.resolvedCount++;
+            break;
+        }
+    }
+}
+
+void MissionController::_terrainClearanceComplete(bool success)
+{
+    // Every transect request still in the list was part of this pass, since a new request restarts the pass. Items may
+    // make new requests from the callback so the list is cleared first.
+    QList<TransectTerrainRequest_t> transectTerrainRequests = _transectTerrainRequests;
+    _transectTerrainRequests.clear();
+    for (const TransectTerrainRequest_t& request: transectTerrainRequests) {
+        if (request.item) {
+            bool allResolved = request.resolvedCount == request.segments.count();
+            request.item->transectTerrainHeightsReceived(allResolved, allResolved ? request.rgPathHeightInfo : QList<TerrainPathQuery::PathHeightInfo_t>());
+        }
+    }
+
+    if (success) {
+        return;
+    }
+
+    // Segments the pass couldn't resolve must not keep showing heights or collisions from before they moved
+    qCDebug(MissionControllerLog) << "_terrainClearanceComplete failed, resolved:total" << _terrainClearanceResolved.count() << _terrainClearanceSegments.count();
+    for (int i=0; i<_terrainClearanceSegments.count(); i++) {
+        FlightPathSegment* segment = _terrainClearanceSegments[i];
+        if (segment && !_terrainClearanceResolved.contains(i)) {
+            segment->clearTerrainData();
+        }
+    }
 }
 
 void MissionController::_updateBatteryInfo(int waypointIndex)
@@ -1938,6 +2271,9 @@ void MissionController::_initAllVisualItems(void)
 
 void MissionController::_deinitAllVisualItems(void)
 {
+    // Items still pending from a binary plan load belong to the list which is going away
+    _cancelIncrementalLoad();
+
     disconnect(_settingsItem, &MissionSettingsItem::coordinateChanged, this, &MissionController::_recalcAll);
     disconnect(_settingsItem, &MissionSettingsItem::coordinateChanged, this, &MissionController::plannedHomePositionChanged);
 
@@ -2198,10 +2534,10 @@ void MissionController::setDirty(bool dirty)
     }
 }
 
-void MissionController::_scanForAdditionalSettings(QmlObjectListModel* visualItems, PlanMasterController* masterController)
+void MissionController::_scanForAdditionalSettings(QmlObjectListModel* visualItems, PlanMasterController* masterController, bool scanForLanding)
 {
     // First we look for a Landing Patterns which are at the end
-    if (!FixedWingLandingComplexItem::scanForItem(visualItems, _flyView, masterController)) {
+    if (scanForLanding && !FixedWingLandingComplexItem::scanForItem(visualItems, _flyView, masterController)) {
         VTOLLandingComplexItem::scanForItem(visualItems, _flyView, masterController);
     }
 
@@ -2289,6 +2625,7 @@ void MissionController::applyDefaultMissionAltitude(void)
 {
     double defaultAltitude = _appSettings->defaultMissionItemAltitude()->rawValue().toDouble();
 
+    loadAllPendingItems();
     for (int i=1; i<_visualItems->count(); i++) {
         VisualMissionItem* item = _visualItems->value<VisualMissionItem*>(i);
         item->applyNewAltitude(defaultAltitude);
@@ -2367,6 +2704,11 @@ bool MissionController::_isROICancelItem(SimpleMissionItem* simpleItem)
 
 void MissionController::setCurrentPlanViewSeqNum(int sequenceNumber, bool force)
 {
+    // Viewing an item which hasn't been created yet needs the rest of a binary plan load
+    if (_pendingItems.isOpen() && sequenceNumber >= _nextSequenceNumber()) {
+        loadAllPendingItems();
+    }
+
     if (_visualItems && (force || sequenceNumber != _currentPlanViewSeqNum)) {
         qDebug() << "setCurrentPlanViewSeqNum";
         bool    foundLand =             false;
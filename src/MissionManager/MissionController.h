@@ -16,8 +16,12 @@
 #include "KMLPlanDomDocument.h"
 #include "QGCGeoBoundingCube.h"
 #include "QGroundControlQmlGlobal.h"
+#include "PlanBinaryFile.h"
+#include "TerrainQuery.h"
 
 #include <QHash>
+#include <QPointer>
+#include <QSet>
 
 class FlightPathSegment;
 class VisualMissionItem;
@@ -28,6 +32,7 @@ class SimpleMissionItem;
 class ComplexMissionItem;
 class MissionSettingsItem;
 class TakeoffMissionItem;
+class TransectStyleComplexItem;
 class QDomDocument;
 class PlanViewSettings;
 
@@ -192,9 +197,30 @@ public:
     /// Sends the mission items to the specified vehicle
     static void sendItemsToVehicle(Vehicle* vehicle, QmlObjectListModel* visualMissionItems);
 
+    /// Converts the plan to the mission items sendToVehicle would send
+    ///     @param missionItemParent QObject parent for newly allocated MissionItems
+    void convertToMissionItems(QList<MissionItem*>& rgMissionItems, QObject* missionItemParent);
+
     bool loadJsonFile(QFile& file, QString& errorString);
     bool loadTextFile(QFile& file, QString& errorString);
 
+    /// Loads the mission from a binary plan file. The first batch of items is created up front and the rest follow a
+    /// batch per event loop pass, so a large plan shows up without blocking the UI for the whole load. Mission stats
+    /// and the flight path need every item, so all items exist shortly after the load; this does not save memory.
+    /// Editing, saving or sending the mission creates any remaining items first.
+    ///     @param json Mission json from the binary plan file, the items come from binaryFile
+    bool loadBinaryPlan(const QJsonObject& json, const PlanBinaryFile& binaryFile, QString& errorString);
+
+    /// @return true: Items from a binary plan are still waiting to be created
+    bool incrementalLoadInProgress(void) const { return _pendingItems.isOpen(); }
+
+    /// Creates all remaining items from a binary plan load
+    void loadAllPendingItems(void);
+
+    static const int incrementalLoadBatchSize = 100;
+
+    static const char* jsonItemsKey;    ///< Plan json key for the mission item array
+
     QGCGeoBoundingCube* travelBoundingCube  () { return &_travelBoundingCube; }
     QGeoCoordinate      takeoffCoordinate   () { return _takeoffCoordinate; }
 
@@ -216,6 +242,16 @@ public:
     // Create KML file
     void addMissionToKML(KMLPlanDomDocument& planKML);
 
+    /// Adds a flight path segment owned by a complex item to the terrain clearance pass, so the segments of the whole
+    /// plan are resolved together. The segment drops out of the pass once it is deleted.
+    void addTerrainClearanceSegment(FlightPathSegment* segment);
+
+    /// Adds the terrain heights needed by a terrain following complex item to the terrain clearance pass. Replaces a
+    /// request from the same item which hasn't completed yet. The heights are passed back through
+    /// TransectStyleComplexItem::transectTerrainHeightsReceived.
+    void requestTransectTerrainHeights  (TransectStyleComplexItem* item, const QList<TerrainClearanceEngine::Segment_t>& segments);
+    void cancelTransectTerrainHeights   (TransectStyleComplexItem* item);
+
     // Property accessors
 
     QmlObjectListModel* visualItems                 (void) { return _visualItems; }
@@ -316,6 +352,11 @@ private slots:
     void _recalcAll                             (void);
     void _managerVehicleChanged                 (Vehicle* managerVehicle);
     void _takeoffItemNotRequiredChanged         (void);
+    void _incrementalLoadNextBatch              (void);
+    void _queueTerrainClearanceRequest          (void);
+    void _sendTerrainClearanceRequest           (void);
+    void _terrainClearanceReceived              (int index, const TerrainClearanceEngine::SegmentClearance_t& segmentClearance);
+    void _terrainClearanceComplete              (bool success);
 
 private:
     void                    _init                               (void);
@@ -337,14 +378,19 @@ private:
     bool                    _loadJsonMissionFileV2              (const QJsonObject& json, QmlObjectListModel* visualItems, QString& errorString);
     bool                    _loadTextMissionFile                (QTextStream& stream, QmlObjectListModel* visualItems, QString& errorString);
     int                     _nextSequenceNumber                 (void);
-    void                    _scanForAdditionalSettings          (QmlObjectListModel* visualItems, PlanMasterController* masterController);
+    void                    _scanForAdditionalSettings          (QmlObjectListModel* visualItems, PlanMasterController* masterController, bool scanForLanding = true);
     void                    _setPlannedHomePositionFromFirstCoordinate(const QGeoCoordinate& clickCoordinate);
     void                    _resetMissionFlightStatus           (void);
     void                    _addHoverTime                       (double hoverTime, double hoverDistance, int waypointIndex);
     void                    _addCruiseTime                      (double cruiseTime, double cruiseDistance, int wayPointIndex);
     void                    _updateBatteryInfo                  (int waypointIndex);
     bool                    _loadItemsFromJson                  (const QJsonObject& json, QmlObjectListModel* visualItems, QString& errorString);
-    void                    _initLoadedVisualItems              (QmlObjectListModel* loadedVisualItems);
+    void                    _initLoadedVisualItems              (QmlObjectListModel* loadedVisualItems, bool itemsPending = false);
+    bool                    _loadVisualItemFromJson             (const QJsonObject& itemObject, int& nextSequenceNumber, MissionSettingsItem* settingsItem, QmlObjectListModel* visualItems, QString& errorString);
+    bool                    _fixupDoJumpSequenceNumbers         (QmlObjectListModel* visualItems, QString& errorString);
+    bool                    _loadBinaryPlanItems                (const PlanBinaryFile& binaryFile, int firstItemIndex, int endItemIndex, int nextSequenceNumber, MissionSettingsItem* settingsItem, QmlObjectListModel* visualItems, QString& errorString);
+    void                    _incrementalLoadBatch               (bool allRemaining);
+    void                    _cancelIncrementalLoad              (void);
     FlightPathSegment*      _addFlightPathSegment               (FlightPathSegmentHashTable& prevItemPairHashTable, VisualItemPair& pair, bool mavlinkTerrainFrame);
     void                    _addTimeDistance                    (bool vtolInHover, double hoverTime, double cruiseTime, double extraTime, double distance, int seqNum);
     VisualMissionItem*      _insertSimpleMissionItemWorker      (QGeoCoordinate coordinate, MAV_CMD command, int visualItemIndex, bool makeCurrentItem);
@@ -359,6 +405,15 @@ private:
     static double           _normalizeLat                       (double lat);
     static double           _normalizeLon                       (double lon);
     static bool             _convertToMissionItems              (QmlObjectListModel* visualMissionItems, QList<MissionItem*>& rgMissionItems, QObject* missionItemParent);
+    static int              _incrementalLoadBatchEnd            (const PlanBinaryFile& binaryFile, int firstItemIndex);
+
+    typedef struct {
+        QPointer<TransectStyleComplexItem>          item;
+        QList<TerrainClearanceEngine::Segment_t>    segments;
+        int                                         firstIndex;         ///< Index of the first segment in the clearance request
+        QList<TerrainPathQuery::PathHeightInfo_t>   rgPathHeightInfo;
+        int                                         resolvedCount;
+    } TransectTerrainRequest_t;
 
 private:
     Vehicle*                    _controllerVehicle =            nullptr;
@@ -398,6 +453,15 @@ private:
     double                      _minAMSLAltitude =              0;
     double                      _maxAMSLAltitude =              0;
     bool                        _missionContainsVTOLTakeoff =   false;
+    PlanBinaryFile              _pendingItems;                                  ///< Open while items are still waiting to be created
+    int                         _pendingNextItemIndex =         0;
+    QTimer                      _incrementalLoadTimer;
+    TerrainClearanceEngine      _terrainClearanceEngine;                        ///< Terrain heights for all flight path segments and transects of the plan in a single pass
+    QList<QPointer<FlightPathSegment>> _terrainClearanceSegments;               ///< Segments in the order of the current clearance request
+    QList<QPointer<FlightPathSegment>> _complexItemClearanceSegments;           ///< Segments added by complex items through addTerrainClearanceSegment
+    QList<TransectTerrainRequest_t> _transectTerrainRequests;                   ///< Requests from requestTransectTerrainHeights which haven't completed
+    QSet<int>                   _terrainClearanceResolved;                      ///< Indices into _terrainClearanceSegments with results from the current request
+    QTimer                      _terrainClearanceTimer;
 
     QGroundControlQmlGlobal::AltMode _globalAltMode = QGroundControlQmlGlobal::AltitudeModeRelative;
 
@@ -409,7 +473,6 @@ private:
     static const char*  _jsonVehicleTypeKey;
     static const char*  _jsonCruiseSpeedKey;
     static const char*  _jsonHoverSpeedKey;
-    static const char*  _jsonItemsKey;
     static const char*  _jsonPlannedHomePositionKey;
     static const char*  _jsonParamsKey;
     static const char*  _jsonGlobalPlanAltitudeModeKey;
@@ -419,4 +482,5 @@ private:
     static const char*  _jsonComplexItemsKey;
 
     static const int    _missionFileVersion;
+    static const int    _terrainClearanceDelayMsecs = 200;
 };
@@ -18,7 +18,7 @@
 #include "VisualMissionItem.h"
 
 const char*  MissionItem::_jsonFrameKey =           "frame";
-const char*  MissionItem::_jsonCommandKey =         "command";
+const char*  MissionItem::jsonCommandKey =          "command";
 const char*  MissionItem::_jsonAutoContinueKey =    "autoContinue";
 const char*  MissionItem::_jsonCoordinateKey =      "coordinate";
 const char*  MissionItem::_jsonParamsKey =          "params";
@@ -159,7 +159,7 @@ void MissionItem::save(QJsonObject& json) const
 {
     json[VisualMissionItem::jsonTypeKey] = VisualMissionItem::jsonTypeSimpleItemValue;
     json[_jsonFrameKey] = frame();
-    json[_jsonCommandKey] = command();
+    json[jsonCommandKey] = command();
     json[_jsonAutoContinueKey] = autoContinue();
     json[_jsonDoJumpIdKey] = _sequenceNumber;
 
@@ -272,7 +272,7 @@ bool MissionItem::load(const QJsonObject& json, int sequenceNumber, QString& err
     QList<JsonHelper::KeyValidateInfo> keyInfoList = {
         { VisualMissionItem::jsonTypeKey,   QJsonValue::String, true },
         { _jsonFrameKey,                    QJsonValue::Double, true },
-        { _jsonCommandKey,                  QJsonValue::Double, true },
+        { jsonCommandKey,                   QJsonValue::Double, true },
         { _jsonParamsKey,                   QJsonValue::Array,  true },
         { _jsonAutoContinueKey,             QJsonValue::Bool,   true },
         { _jsonDoJumpIdKey,                 QJsonValue::Double, false },
@@ -300,7 +300,7 @@ bool MissionItem::load(const QJsonObject& json, int sequenceNumber, QString& err
     }
 
     // Make sure to set these first since they can signal other changes
-    setCommand((MAV_CMD)convertedJson[_jsonCommandKey].toInt());
+    setCommand((MAV_CMD)convertedJson[jsonCommandKey].toInt());
     setFrame((MAV_FRAME)convertedJson[_jsonFrameKey].toInt());
 
     _doJumpId = -1;
@@ -103,6 +103,8 @@ public:
 
     bool relativeAltitude(void) const { return frame() == MAV_FRAME_GLOBAL_RELATIVE_ALT; }
 
+    static const char*  jsonCommandKey;     ///< Json key for the MAV_CMD of a mission item
+
 signals:
     void isCurrentItemChanged       (bool isCurrentItem);
     void sequenceNumberChanged      (int sequenceNumber);
@@ -136,7 +138,6 @@ private:
     
     // Keys for Json save
     static const char*  _jsonFrameKey;
-    static const char*  _jsonCommandKey;
     static const char*  _jsonAutoContinueKey;
     static const char*  _jsonParamsKey;
     static const char*  _jsonDoJumpIdKey;
@@ -392,7 +392,7 @@ void MissionItemTest::_testLoadFromJsonV3(void)
 
     QStringList removeKeys;
     removeKeys << MissionItem::_jsonAutoContinueKey <<
-                  MissionItem::_jsonCommandKey <<
+                  MissionItem::jsonCommandKey <<
                   MissionItem::_jsonFrameKey <<
                   MissionItem::_jsonParamsKey <<
                   VisualMissionItem::jsonTypeKey;
@@ -456,7 +456,7 @@ void MissionItemTest::_testSimpleLoadFromJson(void)
 
     coordinateArray << -10.0 << -20.0 <<-30.0;
     jsonObject.insert(MissionItem::_jsonAutoContinueKey, true);
-    jsonObject.insert(MissionItem::_jsonCommandKey, 80);
+    jsonObject.insert(MissionItem::jsonCommandKey, 80);
     jsonObject.insert(MissionItem::_jsonFrameKey, 3);
     jsonObject.insert(VisualMissionItem::jsonTypeKey, VisualMissionItem::jsonTypeSimpleItemValue);
     jsonObject.insert(MissionItem::_jsonCoordinateKey, coordinateArray);
@@ -494,7 +494,7 @@ QJsonObject MissionItemTest::_createV1Json(void)
 
     coordinateArray << -10.0 << -20.0 <<-30.0;
     jsonObject.insert(MissionItem::_jsonAutoContinueKey, true);
-    jsonObject.insert(MissionItem::_jsonCommandKey, 80);
+    jsonObject.insert(MissionItem::jsonCommandKey, 80);
     jsonObject.insert(MissionItem::_jsonFrameKey, 3);
     jsonObject.insert(MissionItem::_jsonParam1Key, 10);
     jsonObject.insert(MissionItem::_jsonParam2Key, 20);
@@ -513,7 +513,7 @@ QJsonObject MissionItemTest::_createV2Json(void)
 
     coordinateArray << -10.0 << -20.0 <<-30.0;
     jsonObject.insert(MissionItem::_jsonAutoContinueKey, true);
-    jsonObject.insert(MissionItem::_jsonCommandKey, 80);
+    jsonObject.insert(MissionItem::jsonCommandKey, 80);
     jsonObject.insert(MissionItem::_jsonFrameKey, 3);
     jsonObject.insert(VisualMissionItem::jsonTypeKey, VisualMissionItem::jsonTypeSimpleItemValue);
     jsonObject.insert(MissionItem::_jsonCoordinateKey, coordinateArray);
@@ -529,7 +529,7 @@ QJsonObject MissionItemTest::_createV3Json(bool allNaNs)
     QJsonObject jsonObject;
 
     jsonObject.insert(MissionItem::_jsonAutoContinueKey, true);
-    jsonObject.insert(MissionItem::_jsonCommandKey, 80);
+    jsonObject.insert(MissionItem::jsonCommandKey, 80);
     jsonObject.insert(MissionItem::_jsonFrameKey, 3);
     jsonObject.insert(VisualMissionItem::jsonTypeKey, VisualMissionItem::jsonTypeSimpleItemValue);
 
@@ -27,13 +27,9 @@ MissionManagerTest::MissionManagerTest(void)
     
 }
 
-void MissionManagerTest::_writeItems(MockLinkMissionItemHandler::FailureMode_t failureMode, MAV_MISSION_RESULT failureAckResult, bool shouldFail)
+/// Builds the items for _rgTestCases as the editor would hand them to writeMissionItems
+void MissionManagerTest::_testCaseMissionItems(QList<MissionItem*>& missionItems)
 {
-    _mockLink->setMissionItemFailureMode(failureMode, failureAckResult);
-    
-    // Setup our test case data
-    QList<MissionItem*> missionItems;
-    
     // Editor has a home position item on the front, so we do the same
     MissionItem* homeItem = new MissionItem(nullptr /* Vehicle */, this);
     homeItem->setCommand(MAV_CMD_NAV_WAYPOINT);
@@ -56,6 +52,15 @@ void MissionManagerTest::_writeItems(MockLinkMissionItemHandler::FailureMode_t f
         
         missionItems.append(missionItem);
     }
+}
+
+void MissionManagerTest::_writeItems(MockLinkMissionItemHandler::FailureMode_t failureMode, MAV_MISSION_RESULT failureAckResult, bool shouldFail)
+{
+    _mockLink->setMissionItemFailureMode(failureMode, failureAckResult);
+    
+    // Setup our test case data
+    QList<MissionItem*> missionItems;
+    _testCaseMissionItems(missionItems);
     
     // Send the items to the vehicle
     _missionManager->writeMissionItems(missionItems);
@@ -360,3 +365,82 @@ void MissionManagerTest::_testErrorAckFailureStrings(void)
     }
 
 }
+
+void MissionManagerTest::_testFtpTransfer(void)
+{
+    _initForFirmwareType(MAV_AUTOPILOT_ARDUPILOTMEGA);
+    _vehicle->_setCapabilities(_vehicle->capabilityBits() | MAV_PROTOCOL_CAPABILITY_FTP);
+
+    // The mission protocol is broken in both directions, so these only succeed over FTP
+    _writeItems(MockLinkMissionItemHandler::FailWriteMissionCountNoResponse, MAV_MISSION_ERROR, false);
+    _roundTripItems(MockLinkMissionItemHandler::FailReadRequestListNoResponse, MAV_MISSION_ERROR, false);
+}
+
+void MissionManagerTest::_testFtpFallback(void)
+{
+    _initForFirmwareType(MAV_AUTOPILOT_ARDUPILOTMEGA);
+    _vehicle->_setCapabilities(_vehicle->capabilityBits() | MAV_PROTOCOL_CAPABILITY_FTP);
+    _mockLink->mockLinkFTP()->setErrorMode(MockLinkFTP::errModeNakResponse);
+
+    _roundTripItems(MockLinkMissionItemHandler::FailNone, MAV_MISSION_ERROR, false);
+}
+
+void MissionManagerTest::_testFtpNotSupported(void)
+{
+    // PX4 has FTP but doesn't serve the plan as a file, so the read stays on the broken mission protocol and fails
+    _initForFirmwareType(MAV_AUTOPILOT_PX4);
+    _vehicle->_setCapabilities(_vehicle->capabilityBits() | MAV_PROTOCOL_CAPABILITY_FTP);
+
+    _roundTripItems(MockLinkMissionItemHandler::FailReadRequestListNoResponse, MAV_MISSION_ERROR, true);
+}
+
+void MissionManagerTest::_testPartialWrite(void)
+{
+    _initForFirmwareType(MAV_AUTOPILOT_ARDUPILOTMEGA);
+
+    _writeItems(MockLinkMissionItemHandler::FailNone, MAV_MISSION_ERROR, false);
+    QCOMPARE(_mockLink->missionItemHandler()->partialWriteCount(), 0);
+
+    // Change a single item. MISSION_COUNT goes unanswered, so this only succeeds as a partial write.
+    QList<MissionItem*> missionItems;
+    _testCaseMissionItems(missionItems);
+    missionItems[3]->setParam1(55);
+    _mockLink->setMissionItemFailureMode(MockLinkMissionItemHandler::FailWriteMissionCountNoResponse, MAV_MISSION_ERROR);
+    _missionManager->writeMissionItems(missionItems);
+
+    _multiSpyMissionManager->waitForSignalByIndex(sendCompleteSignalIndex, _missionManagerSignalWaitTime);
+    QCOMPARE(_multiSpyMissionManager->pullBoolFromSignalIndex(sendCompleteSignalIndex), false);
+    QCOMPARE(_mockLink->missionItemHandler()->partialWriteCount(), 1);
+    QCOMPARE(_mockLink->missionItemHandler()->planItems(MAV_MISSION_TYPE_MISSION)[3].param1, 55.0f);
+    _multiSpyMissionManager->clearAllSignals();
+
+    // Dropping an item shifts sequence numbers, which needs a full write
+    missionItems.clear();   // Owned by the mission manager now
+    _testCaseMissionItems(missionItems);
+    delete missionItems.takeLast();
+    _mockLink->setMissionItemFailureMode(MockLinkMissionItemHandler::FailNone, MAV_MISSION_ERROR);
+    _missionManager->writeMissionItems(missionItems);
+
+    _multiSpyMissionManager->waitForSignalByIndex(sendCompleteSignalIndex, _missionManagerSignalWaitTime);
+    QCOMPARE(_multiSpyMissionManager->pullBoolFromSignalIndex(sendCompleteSignalIndex), false);
+    QCOMPARE(_mockLink->missionItemHandler()->partialWriteCount(), 1);
+    QCOMPARE(_mockLink->missionItemHandler()->planItems(MAV_MISSION_TYPE_MISSION).count(), static_cast<int>(_cTestCases));
+    _multiSpyMissionManager->clearAllSignals();
+
+    // Another GCS changes the mission behind our back. Writing what we think the vehicle already has must
+    // still reach the vehicle.
+    QList<mavlink_mission_item_int_t> vehicleItems = _mockLink->missionItemHandler()->planItems(MAV_MISSION_TYPE_MISSION);
+    const float expectedParam1 = vehicleItems[1].param1;
+    vehicleItems[1].param1 = expectedParam1 + 10;
+    _mockLink->missionItemHandler()->setPlanItems(MAV_MISSION_TYPE_MISSION, vehicleItems);
+
+    missionItems.clear();
+    _testCaseMissionItems(missionItems);
+    delete missionItems.takeLast();
+    _missionManager->writeMissionItems(missionItems);
+
+    _multiSpyMissionManager->waitForSignalByIndex(sendCompleteSignalIndex, _missionManagerSignalWaitTime);
+    QCOMPARE(_multiSpyMissionManager->pullBoolFromSignalIndex(sendCompleteSignalIndex), false);
+    QCOMPARE(_mockLink->missionItemHandler()->partialWriteCount(), 1);
+    QCOMPARE(_mockLink->missionItemHandler()->planItems(MAV_MISSION_TYPE_MISSION)[1].param1, expectedParam1);
+}
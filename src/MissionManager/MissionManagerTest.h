@@ -32,6 +32,10 @@ private slots:
     void _testReadFailureHandlingPX4(void);
     //void _testReadFailureHandlingAPM(void);
     //void _testErrorAckFailureStrings(void);
+    void _testFtpTransfer(void);
+    void _testFtpFallback(void);
+    void _testFtpNotSupported(void);
+    void _testPartialWrite(void);
 
 private:
     void _testWriteFailureHandlingPX4(void);
@@ -39,6 +43,7 @@ private:
     //void _testReadFailureHandlingPX4(void);
     void _testReadFailureHandlingAPM(void);
     void _testErrorAckFailureStrings(void);
+    void _testCaseMissionItems(QList<MissionItem*>& missionItems);
     void _roundTripItems(MockLinkMissionItemHandler::FailureMode_t failureMode, MAV_MISSION_RESULT failureAckResult, bool shouldFail);
     void _writeItems(MockLinkMissionItemHandler::FailureMode_t failureMode, MAV_MISSION_RESULT failureAckResult, bool shouldFail);
     void _testWriteFailureHandlingWorker(void);
@@ -0,0 +1,240 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "PlanBinaryFile.h"
+#include "PlanMasterController.h"
+#include "MissionController.h"
+#include "MissionItem.h"
+#include "VisualMissionItem.h"
+
+#include <QCborValue>
+#include <QCborMap>
+#include <QJsonArray>
+#include <QtEndian>
+
+const char* PlanBinaryFile::magic = "QGCPLANB";
+
+namespace {
+
+void appendValue16(QByteArray& bytes, quint16 value)
+{
+    const quint16 le = qToLittleEndian<quint16>(value);
+    bytes.append(reinterpret_cast<const char*>(&le), sizeof(le));
+}
+
+void appendValue32(QByteArray& bytes, quint32 value)
+{
+    const quint32 le = qToLittleEndian<quint32>(value);
+    bytes.append(reinterpret_cast<const char*>(&le), sizeof(le));
+}
+
+void setValue32(QByteArray& bytes, int offset, quint32 value)
+{
+    qToLittleEndian<quint32>(value, bytes.data() + offset);
+}
+
+/// Decodes a CBOR map without copying the bytes
+bool decodeCborMap(const char* data, int length, QJsonObject& object)
+{
+    QCborParserError    parserError;
+    QCborValue          value = QCborValue::fromCbor(QByteArray::fromRawData(data, length), &parserError);
+
+    if (parserError.error != QCborError::NoError || !value.isMap()) {
+        return false;
+    }
+    object = value.toMap().toJsonObject();
+    return true;
+}
+
+}
+
+QByteArray PlanBinaryFile::fromJson(const QJsonObject& planJson)
+{
+    QJsonObject missionJson     = planJson[PlanMasterController::kJsonMissionObjectKey].toObject();
+    const QJsonArray rgItems    = missionJson[MissionController::jsonItemsKey].toArray();
+
+    // The items live in their own blobs, the plan keeps an empty array in their place
+    QJsonObject planWithoutItems = planJson;
+    if (missionJson.contains(MissionController::jsonItemsKey)) {
+        missionJson[MissionController::jsonItemsKey] = QJsonArray();
+        planWithoutItems[PlanMasterController::kJsonMissionObjectKey] = missionJson;
+    }
+    const QByteArray planBytes = QCborMap::fromJsonObject(planWithoutItems).toCborValue().toCbor();
+
+    const int itemTableOffset = headerSize + planBytes.length();
+
+    QByteArray bytes;
+    bytes.append(magic, static_cast<int>(qstrlen(magic)));
+    appendValue16(bytes, version);
+    appendValue16(bytes, 0);
+    appendValue32(bytes, static_cast<quint32>(rgItems.count()));
+    appendValue32(bytes, static_cast<quint32>(itemTableOffset));
+    appendValue32(bytes, static_cast<quint32>(headerSize));
+    appendValue32(bytes, static_cast<quint32>(planBytes.length()));
+    appendValue32(bytes, 0);
+    bytes.append(planBytes);
+
+    // Table entries are filled in once the item offsets are known
+    bytes.append(QByteArray(rgItems.count() * itemEntrySize, 0));
+
+    for (int i=0; i<rgItems.count(); i++) {
+        const QJsonObject   itemObject  = rgItems[i].toObject();
+        const bool          complex     = itemObject[VisualMissionItem::jsonTypeKey].toString() == VisualMissionItem::jsonTypeComplexItemValue;
+        const QByteArray    itemBytes   = QCborMap::fromJsonObject(itemObject).toCborValue().toCbor();
+        const int           entryOffset = itemTableOffset + (i * itemEntrySize);
+
+        setValue32(bytes, entryOffset, static_cast<quint32>(bytes.length()));
+        setValue32(bytes, entryOffset + 4, static_cast<quint32>(itemBytes.length()));
+        qToLittleEndian<quint16>(complex ? 0 : static_cast<quint16>(itemObject[MissionItem::jsonCommandKey].toInt()), bytes.data() + entryOffset + 8);
+        qToLittleEndian<quint16>(complex ? itemFlagComplex : 0, bytes.data() + entryOffset + 10);
+
+        bytes.append(itemBytes);
+    }
+
+    return bytes;
+}
+
+bool PlanBinaryFile::isBinaryPlan(const QByteArray& bytes)
+{
+    return bytes.startsWith(magic);
+}
+
+bool PlanBinaryFile::open(const QByteArray& bytes, QString& errorString)
+{
+    close();
+
+    if (bytes.length() < headerSize || !isBinaryPlan(bytes)) {
+        errorString = tr("File is not a binary plan file.");
+        return false;
+    }
+
+    const char* header = bytes.constData();
+    const int fileVersion = qFromLittleEndian<quint16>(header + 8);
+    if (fileVersion > version) {
+        errorString = tr("Binary plan file version %1 is newer than this version of the application supports (%2).").arg(fileVersion).arg(version);
+        return false;
+    }
+
+    const quint64 fileLength        = static_cast<quint64>(bytes.length());
+    const quint64 itemCount         = qFromLittleEndian<quint32>(header + 12);
+    const quint64 itemTableOffset   = qFromLittleEndian<quint32>(header + 16);
+    const quint64 planOffset        = qFromLittleEndian<quint32>(header + 20);
+    const quint64 planLength        = qFromLittleEndian<quint32>(header + 24);
+
+    if (planOffset < headerSize || planOffset + planLength > fileLength || itemTableOffset + (itemCount * itemEntrySize) > fileLength) {
+        errorString = tr("Binary plan file is truncated or corrupt.");
+        return false;
+    }
+
+    QJsonObject planJson;
+    if (!decodeCborMap(header + planOffset, static_cast<int>(planLength), planJson)) {
+        errorString = tr("Binary plan file contains an invalid plan.");
+        return false;
+    }
+
+    _bytes              = bytes;
+    _itemCount          = static_cast<int>(itemCount);
+    _itemTableOffset    = static_cast<quint32>(itemTableOffset);
+
+    for (int i=0; i<_itemCount; i++) {
+        const quint64 itemOffset = _entryValue32(i, 0);
+        const quint64 itemLength = _entryValue32(i, 4);
+        if (itemOffset < headerSize || itemOffset + itemLength > fileLength) {
+            close();
+            errorString = tr("Binary plan file item %1 is out of range.").arg(i);
+            return false;
+        }
+    }
+
+    _planJson = planJson;
+
+    return true;
+}
+
+void PlanBinaryFile::close(void)
+{
+    _bytes.clear();
+    _planJson           = QJsonObject();
+    _itemCount          = -1;
+    _itemTableOffset    = 0;
+}
+
+QJsonObject PlanBinaryFile::planJson(void) const
+{
+    return _planJson;
+}
+
+int PlanBinaryFile::itemCommand(int index) const
+{
+    if (index < 0 || index >= itemCount()) {
+        return 0;
+    }
+    return _entryValue16(index, 8);
+}
+
+bool PlanBinaryFile::itemIsComplex(int index) const
+{
+    if (index < 0 || index >= itemCount()) {
+        return false;
+    }
+    return _entryValue16(index, 10) & itemFlagComplex;
+}
+
+bool PlanBinaryFile::itemJson(int index, QJsonObject& itemObject, QString& errorString) const
+{
+    if (index < 0 || index >= itemCount()) {
+        errorString = tr("Mission item %1 is not in the binary plan file").arg(index);
+        return false;
+    }
+
+    if (!decodeCborMap(_bytes.constData() + _entryValue32(index, 0), static_cast<int>(_entryValue32(index, 4)), itemObject)) {
+        errorString = tr("Mission item %1 is not an object").arg(index);
+        return false;
+    }
+
+    return true;
+}
+
+bool PlanBinaryFile::toJson(QJsonObject& planJson, QString& errorString) const
+{
+    if (!isOpen()) {
+        errorString = tr("Binary plan file is not open.");
+        return false;
+    }
+
+    planJson = _planJson;
+    QJsonObject missionJson = planJson[PlanMasterController::kJsonMissionObjectKey].toObject();
+    if (!missionJson.contains(MissionController::jsonItemsKey)) {
+        return true;
+    }
+
+    QJsonArray rgItems;
+    for (int i=0; i<_itemCount; i++) {
+        QJsonObject itemObject;
+        if (!itemJson(i, itemObject, errorString)) {
+            return false;
+        }
+        rgItems.append(itemObject);
+    }
+
+    missionJson[MissionController::jsonItemsKey] = rgItems;
+    planJson[PlanMasterController::kJsonMissionObjectKey] = missionJson;
+
+    return true;
+}
+
+quint32 PlanBinaryFile::_entryValue32(int index, int fieldOffset) const
+{
+    return qFromLittleEndian<quint32>(_bytes.constData() + _itemTableOffset + (index * itemEntrySize) + fieldOffset);
+}
+
+quint16 PlanBinaryFile::_entryValue16(int index, int fieldOffset) const
+{
+    return qFromLittleEndian<quint16>(_bytes.constData() + _itemTableOffset + (index * itemEntrySize) + fieldOffset);
+}
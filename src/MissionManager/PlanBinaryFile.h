@@ -0,0 +1,72 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+#include <QCoreApplication>
+
+/// Compact binary form of a .plan file.
+///
+/// The file holds the same json as a .plan file, stored as CBOR. The mission items are split out of the plan and
+/// each one is stored as its own CBOR blob, found through an offset table. Opening a file only validates the header
+/// and the table, a single item can then be decoded without touching the others. Converting to and from the .plan
+/// json is lossless.
+///
+/// Layout, all values little endian:
+///     Header:     magic[8] version:u16 reserved:u16 itemCount:u32 itemTableOffset:u32 planOffset:u32 planLength:u32 reserved:u32
+///     Plan:       CBOR of the plan json with an empty mission items array
+///     Item table: itemCount * { offset:u32 length:u32 command:u16 flags:u16 }
+///     Items:      CBOR of each mission item json
+class PlanBinaryFile
+{
+    Q_DECLARE_TR_FUNCTIONS(PlanBinaryFile)
+
+public:
+    PlanBinaryFile(void) = default;
+
+    /// Converts plan json to the binary format
+    static QByteArray fromJson(const QJsonObject& planJson);
+
+    /// @return true: bytes start with the binary plan file magic
+    static bool isBinaryPlan(const QByteArray& bytes);
+
+    /// Validates the header and item table. The item contents are not decoded.
+    bool open(const QByteArray& bytes, QString& errorString);
+
+    bool        isOpen          (void) const { return _itemCount >= 0; }
+    void        close           (void);
+    QJsonObject planJson        (void) const;   ///< Plan json without the mission items
+    int         itemCount       (void) const { return qMax(_itemCount, 0); }
+    int         itemCommand     (int index) const;  ///< MAV_CMD of a simple item, 0 for a complex item
+    bool        itemIsComplex   (int index) const;
+
+    /// Decodes a single mission item
+    bool itemJson(int index, QJsonObject& itemObject, QString& errorString) const;
+
+    /// Full plan json, mission items included
+    bool toJson(QJsonObject& planJson, QString& errorString) const;
+
+    static const char*  magic;
+    static const int    version         = 1;
+    static const int    headerSize      = 32;
+    static const int    itemEntrySize   = 12;
+    static const int    itemFlagComplex = 0x0001;
+
+private:
+    quint32 _entryValue32(int index, int fieldOffset) const;
+    quint16 _entryValue16(int index, int fieldOffset) const;
+
+    QByteArray  _bytes;
+    int         _itemCount          = -1;   ///< -1 for not open
+    quint32     _itemTableOffset    = 0;
+    QJsonObject _planJson;
+};
@@ -15,6 +15,8 @@
 #include "MissionCommandTree.h"
 #include "MissionCommandUIInfo.h"
 
+#include <QFileInfo>
+
 QGC_LOGGING_CATEGORY(PlanManagerLog, "PlanManagerLog")
 
 PlanManager::PlanManager(Vehicle* vehicle, MAV_MISSION_TYPE planType)
@@ -38,7 +40,7 @@ PlanManager::PlanManager(Vehicle* vehicle, MAV_MISSION_TYPE planType)
 
 PlanManager::~PlanManager()
 {
-
+    delete _ftpDir;
 }
 
 void PlanManager::_writeMissionItemsWorker(void)
@@ -49,16 +51,142 @@ void PlanManager::_writeMissionItemsWorker(void)
 
     qCDebug(PlanManagerLog) << QStringLiteral("writeMissionItems %1 count:").arg(_planTypeString()) << _writeMissionItems.count();
 
-    // Prime write list
-    _itemIndicesToWrite.clear();
+    _writeVehicleItems.clear();
     for (int i=0; i<_writeMissionItems.count(); i++) {
-        _itemIndicesToWrite << i;
+        _writeVehicleItems.append(_missionItemToMavlink(i, _writeMissionItems[i]));
     }
 
+    // Compare against what the vehicle has before we start changing it
+    int firstChanged, lastChanged;
+    bool partialWrite = _partialWriteSupported() && _findChangedRange(firstChanged, lastChanged);
+    _vehicleItemsKnown = false;
+
     _retryCount = 0;
     _setTransactionInProgress(TransactionWrite);
     _connectToMavlink();
-    _writeMissionCount();
+
+    _itemIndicesToWrite.clear();
+    if (partialWrite && firstChanged != -1) {
+        _partialWrite       = true;
+        _partialWriteStart  = firstChanged;
+        _partialWriteEnd    = lastChanged;
+        for (int i=firstChanged; i<=lastChanged; i++) {
+            _itemIndicesToWrite << i;
+        }
+        _writePartialList();
+    } else {
+        // Nothing differing from the cache doesn't prove the vehicle still has these items, another GCS may
+        // have changed them, so that is still a full write
+        _fallBackToFullWrite();
+    }
+}
+
+/// Writes all items, as opposed to only the changed range. Also used when a partial write fails.
+void PlanManager::_fallBackToFullWrite(void)
+{
+    _partialWrite = false;
+    _retryCount = 0;
+
+    // Prime write list
+    _itemIndicesToWrite.clear();
+    for (int i=0; i<_writeMissionItems.count(); i++) {
+        _itemIndicesToWrite << i;
+    }
+
+    if (!_ftpWrite()) {
+        _writeMissionCount();
+    }
+}
+
+/// Finds the range of items which differ between _writeVehicleItems and the last known vehicle items.
+///     @param[out] first First changed index, -1 if nothing changed
+///     @param[out] last Last changed index
+/// @return false: a partial write can't express the change, the whole list must be sent
+bool PlanManager::_findChangedRange(int& first, int& last)
+{
+    // Whatever happened on the vehicle while we were not connected to it (reboot, another GCS) isn't in the cache
+    SharedLinkInterfacePtr primaryLink = _vehicle->vehicleLinkManager()->primaryLink().lock();
+    if (!primaryLink || primaryLink != _vehicleItemsLink.lock() || _vehicle->vehicleLinkManager()->communicationLost()) {
+        _vehicleItemsKnown = false;
+    }
+
+    if (!_vehicleItemsKnown || _vehicleItems.count() != _writeVehicleItems.count()) {
+        // Items were inserted or removed, which shifts the sequence numbers of everything following
+        return false;
+    }
+
+    first = last = -1;
+    for (int i=0; i<_writeVehicleItems.count(); i++) {
+        const mavlink_mission_item_int_t& a = _vehicleItems[i];
+        const mavlink_mission_item_int_t& b = _writeVehicleItems[i];
+
+        // Coordinates can be off by one after a round trip through the double based MissionItem
+        bool same = a.frame == b.frame && a.command == b.command && a.autocontinue == b.autocontinue &&
+                a.param1 == b.param1 && a.param2 == b.param2 && a.param3 == b.param3 && a.param4 == b.param4 &&
+                qAbs(a.x - b.x) <= 1 && qAbs(a.y - b.y) <= 1 && a.z == b.z;
+        if (!same) {
+            if (first == -1) {
+                first = i;
+            }
+            last = i;
+        }
+    }
+
+    qCDebug(PlanManagerLog) << QStringLiteral("_findChangedRange %1 first:last").arg(_planTypeString()) << first << last;
+    return true;
+}
+
+bool PlanManager::_partialWriteSupported(void)
+{
+    return _planType == MAV_MISSION_TYPE_MISSION && _vehicle->firmwarePlugin()->supportsPartialMissionWrite();
+}
+
+/// Begins a write of only the _partialWriteStart.._partialWriteEnd range. This may be called during a retry.
+void PlanManager::_writePartialList(void)
+{
+    qCDebug(PlanManagerLog) << QStringLiteral("_writePartialList %1 start:end:_retryCount").arg(_planTypeString()) << _partialWriteStart << _partialWriteEnd << _retryCount;
+
+    WeakLinkInterfacePtr weakLink = _vehicle->vehicleLinkManager()->primaryLink();
+    if (!weakLink.expired()) {
+        mavlink_message_t       message;
+        SharedLinkInterfacePtr  sharedLink = weakLink.lock();
+
+        mavlink_msg_mission_write_partial_list_pack_chan(qgcApp()->toolbox()->mavlinkProtocol()->getSystemId(),
+                                                         qgcApp()->toolbox()->mavlinkProtocol()->getComponentId(),
+                                                         sharedLink->mavlinkChannel(),
+                                                         &message,
+                                                         _vehicle->id(),
+                                                         MAV_COMP_ID_AUTOPILOT1,
+                                                         _partialWriteStart,
+                                                         _partialWriteEnd,
+                                                         _planType);
+
+        _vehicle->sendMessageOnLinkThreadSafe(sharedLink.get(), message);
+    }
+    _startAckTimeout(AckMissionRequest);
+}
+
+mavlink_mission_item_int_t PlanManager::_missionItemToMavlink(int seq, MissionItem* item)
+{
+    mavlink_mission_item_int_t missionItem{};
+
+    missionItem.target_system       = _vehicle->id();
+    missionItem.target_component    = MAV_COMP_ID_AUTOPILOT1;
+    missionItem.seq                 = seq;
+    missionItem.frame               = item->frame();
+    missionItem.command             = item->command();
+    missionItem.current             = seq == 0;
+    missionItem.autocontinue        = item->autoContinue();
+    missionItem.param1              = item->param1();
+    missionItem.param2              = item->param2();
+    missionItem.param3              = item->param3();
+    missionItem.param4              = item->param4();
+    missionItem.x                   = item->frame() == MAV_FRAME_MISSION ? item->param5() : item->param5() * 1e7;
+    missionItem.y                   = item->frame() == MAV_FRAME_MISSION ? item->param6() : item->param6() * 1e7;
+    missionItem.z                   = item->param7();
+    missionItem.mission_type        = _planType;
+
+    return missionItem;
 }
 
 
@@ -135,9 +263,12 @@ void PlanManager::loadFromVehicle(void)
     }
 
     _retryCount = 0;
+    _vehicleItemsKnown = false;
     _setTransactionInProgress(TransactionRead);
     _connectToMavlink();
-    _requestList();
+    if (!_ftpRead()) {
+        _requestList();
+    }
 }
 
 /// Internal call to request list of mission items. May be called during a retry sequence.
@@ -147,6 +278,7 @@ void PlanManager::_requestList(void)
 
     _itemIndicesToRead.clear();
     _clearMissionItems();
+    _vehicleItems.clear();
 
     WeakLinkInterfacePtr weakLink = _vehicle->vehicleLinkManager()->primaryLink();
     if (!weakLink.expired()) {
@@ -205,6 +337,16 @@ void PlanManager::_ackTimeout(void)
             // Vehicle did not send final MISSION_ACK at end of sequence
             _sendError(ProtocolError, tr("Mission write failed, vehicle failed to send final ack."));
             _finishTransaction(false);
+        } else if (_partialWrite && _itemIndicesToWrite[0] == _partialWriteStart) {
+            // Vehicle did not respond to MISSION_WRITE_PARTIAL_LIST
+            if (_retryCount > _maxRetryCount) {
+                qCDebug(PlanManagerLog) << QStringLiteral("Partial write %1 not answered, falling back to full write").arg(_planTypeString());
+                _fallBackToFullWrite();
+            } else {
+                _retryCount++;
+                qCDebug(PlanManagerLog) << QStringLiteral("Retrying %1 MISSION_WRITE_PARTIAL_LIST retry Count").arg(_planTypeString()) << _retryCount;
+                _writePartialList();
+            }
         } else if (_itemIndicesToWrite[0] == 0) {
             // Vehicle did not respond to MISSION_COUNT, try again
             if (_retryCount > _maxRetryCount) {
@@ -373,41 +515,12 @@ void PlanManager::_requestNextMissionItem(void)
 
 void PlanManager::_handleMissionItem(const mavlink_message_t& message)
 {
-    MAV_CMD     command;
-    MAV_FRAME   frame;
-    double      param1;
-    double      param2;
-    double      param3;
-    double      param4;
-    double      param5;
-    double      param6;
-    double      param7;
-    bool        autoContinue;
-    bool        isCurrentItem;
-    int         seq;
-
     mavlink_mission_item_int_t missionItem;
     mavlink_msg_mission_item_int_decode(&message, &missionItem);
 
-    command =       (MAV_CMD)missionItem.command,
-            frame =         (MAV_FRAME)missionItem.frame,
-            param1 =        missionItem.param1;
-    param2 =        missionItem.param2;
-    param3 =        missionItem.param3;
-    param4 =        missionItem.param4;
-    param5 =        missionItem.frame == MAV_FRAME_MISSION ? (double)missionItem.x : (double)missionItem.x * 1e-7;
-    param6 =        missionItem.frame == MAV_FRAME_MISSION ? (double)missionItem.y : (double)missionItem.y * 1e-7;
-    param7 =        (double)missionItem.z;
-    autoContinue =  missionItem.autocontinue;
-    isCurrentItem = missionItem.current;
-    seq =           missionItem.seq;
-
-    // We don't support editing ALT_INT frames so change on the way in.
-    if (frame == MAV_FRAME_GLOBAL_INT) {
-        frame = MAV_FRAME_GLOBAL;
-    } else if (frame == MAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
-        frame = MAV_FRAME_GLOBAL_RELATIVE_ALT;
-    }
+    MAV_CMD command =       (MAV_CMD)missionItem.command;
+    bool    isCurrentItem = missionItem.current;
+    int     seq =           missionItem.seq;
 
     bool ardupilotHomePositionUpdate = false;
     if (!_checkForExpectedAck(AckMissionItem)) {
@@ -422,34 +535,15 @@ void PlanManager::_handleMissionItem(const mavlink_message_t& message)
     qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionItem %1 seq:command:current:ardupilotHomePositionUpdate").arg(_planTypeString()) << seq << command << isCurrentItem << ardupilotHomePositionUpdate;
 
     if (ardupilotHomePositionUpdate) {
-        QGeoCoordinate newHomePosition(param5, param6, param7);
+        QGeoCoordinate newHomePosition((double)missionItem.x * 1e-7, (double)missionItem.y * 1e-7, (double)missionItem.z);
         _vehicle->_setHomePosition(newHomePosition);
         return;
     }
     
     if (_itemIndicesToRead.contains(seq)) {
         _itemIndicesToRead.removeOne(seq);
-
-        MissionItem* item = new MissionItem(seq,
-                                            command,
-                                            frame,
-                                            param1,
-                                            param2,
-                                            param3,
-                                            param4,
-                                            param5,
-                                            param6,
-                                            param7,
-                                            autoContinue,
-                                            isCurrentItem,
-                                            this);
-
-        if (item->command() == MAV_CMD_DO_JUMP && !_vehicle->firmwarePlugin()->sendHomePositionToVehicle()) {
-            // Home is in position 0
-            item->setParam1((int)item->param1() + 1);
-        }
-
-        _missionItems.append(item);
+        _missionItems.append(_missionItemFromMavlink(missionItem));
+        _vehicleItems.append(missionItem);
     } else {
         qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionItem %1 mission item received item index which was not requested, disregrarding:").arg(_planTypeString()) << seq;
         // We have to put the ack timeout back since it was removed above
@@ -467,6 +561,39 @@ void PlanManager::_handleMissionItem(const mavlink_message_t& message)
     }
 }
 
+MissionItem* PlanManager::_missionItemFromMavlink(const mavlink_mission_item_int_t& missionItem)
+{
+    MAV_FRAME frame = (MAV_FRAME)missionItem.frame;
+
+    // We don't support editing ALT_INT frames so change on the way in.
+    if (frame == MAV_FRAME_GLOBAL_INT) {
+        frame = MAV_FRAME_GLOBAL;
+    } else if (frame == MAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
+        frame = MAV_FRAME_GLOBAL_RELATIVE_ALT;
+    }
+
+    MissionItem* item = new MissionItem(missionItem.seq,
+                                        (MAV_CMD)missionItem.command,
+                                        frame,
+                                        missionItem.param1,
+                                        missionItem.param2,
+                                        missionItem.param3,
+                                        missionItem.param4,
+                                        missionItem.frame == MAV_FRAME_MISSION ? (double)missionItem.x : (double)missionItem.x * 1e-7,
+                                        missionItem.frame == MAV_FRAME_MISSION ? (double)missionItem.y : (double)missionItem.y * 1e-7,
+                                        (double)missionItem.z,
+                                        missionItem.autocontinue,
+                                        missionItem.current,
+                                        this);
+
+    if (item->command() == MAV_CMD_DO_JUMP && !_vehicle->firmwarePlugin()->sendHomePositionToVehicle()) {
+        // Home is in position 0
+        item->setParam1((int)item->param1() + 1);
+    }
+
+    return item;
+}
+
 void PlanManager::_clearMissionItems(void)
 {
     _itemIndicesToRead.clear();
@@ -511,33 +638,18 @@ void PlanManager::_handleMissionRequest(const mavlink_message_t& message)
         _itemIndicesToWrite.removeOne(missionRequestSeq);
     }
     
-    MissionItem* item = _writeMissionItems[missionRequestSeq];
-    qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionRequest %1 sequenceNumber:command").arg(_planTypeString()) << missionRequestSeq << item->command();
+    qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionRequest %1 sequenceNumber:command").arg(_planTypeString()) << missionRequestSeq << _writeMissionItems[missionRequestSeq]->command();
 
     WeakLinkInterfacePtr weakLink = _vehicle->vehicleLinkManager()->primaryLink();
     if (!weakLink.expired()) {
         mavlink_message_t       messageOut;
         SharedLinkInterfacePtr  sharedLink = weakLink.lock();
 
-        mavlink_msg_mission_item_int_pack_chan(qgcApp()->toolbox()->mavlinkProtocol()->getSystemId(),
-                                               qgcApp()->toolbox()->mavlinkProtocol()->getComponentId(),
-                                               sharedLink->mavlinkChannel(),
-                                               &messageOut,
-                                               _vehicle->id(),
-                                               MAV_COMP_ID_AUTOPILOT1,
-                                               missionRequestSeq,
-                                               item->frame(),
-                                               item->command(),
-                                               missionRequestSeq == 0,
-                                               item->autoContinue(),
-                                               item->param1(),
-                                               item->param2(),
-                                               item->param3(),
-                                               item->param4(),
-                                               item->frame() == MAV_FRAME_MISSION ? item->param5() : item->param5() * 1e7,
-                                               item->frame() == MAV_FRAME_MISSION ? item->param6() : item->param6() * 1e7,
-                                               item->param7(),
-                                               _planType);
+        mavlink_msg_mission_item_int_encode_chan(qgcApp()->toolbox()->mavlinkProtocol()->getSystemId(),
+                                                 qgcApp()->toolbox()->mavlinkProtocol()->getComponentId(),
+                                                 sharedLink->mavlinkChannel(),
+                                                 &messageOut,
+                                                 &_writeVehicleItems[missionRequestSeq]);
         _vehicle->sendMessageOnLinkThreadSafe(sharedLink.get(), messageOut);
     }
     _startAckTimeout(AckMissionRequest);
@@ -604,6 +716,9 @@ void PlanManager::_handleMissionAck(const mavlink_message_t& message)
                 _sendError(VehicleAckError, _missionResultToString((MAV_MISSION_RESULT)missionAck.type));
                 _finishTransaction(false);
             }
+        } else if (_partialWrite && _itemIndicesToWrite.count() && _itemIndicesToWrite[0] == _partialWriteStart) {
+            qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionAck %1 partial write rejected, falling back to full write").arg(_planTypeString());
+            _fallBackToFullWrite();
         } else {
             _sendError(VehicleAckError, _missionResultToString((MAV_MISSION_RESULT)missionAck.type));
             _finishTransaction(false);
@@ -809,7 +924,9 @@ void PlanManager::_finishTransaction(bool success, bool apmGuidedItemWrite)
         if (!success) {
             // Read from vehicle failed, clear partial list
             _clearAndDeleteMissionItems();
+            _vehicleItems.clear();
         }
+        _vehicleItemsKnown = success;
         emit newMissionItemsAvailable(false);
         break;
     case TransactionWrite:
@@ -817,7 +934,11 @@ void PlanManager::_finishTransaction(bool success, bool apmGuidedItemWrite)
         if (!apmGuidedItemWrite) {
             if (success) {
                 // Write succeeded, update internal list to be current
-                if (_planType == MAV_MISSION_TYPE_MISSION) {
+                _vehicleItems = _writeVehicleItems;
+                _vehicleItemsKnown = true;
+
+                // A partial write leaves the rest of the mission, including the current item, as it was
+                if (_planType == MAV_MISSION_TYPE_MISSION && !_partialWrite) {
                     _currentMissionIndex = -1;
                     _lastCurrentIndex = -1;
                     emit currentIndexChanged(-1);
@@ -836,11 +957,20 @@ void PlanManager::_finishTransaction(bool success, bool apmGuidedItemWrite)
         }
         break;
     case TransactionRemoveAll:
+        if (success) {
+            _vehicleItems.clear();
+            _vehicleItemsKnown = true;
+        }
         emit removeAllComplete(!success /* error */);
         break;
     default:
         break;
     }
+    _partialWrite = false;
+
+    if (_vehicleItemsKnown) {
+        _vehicleItemsLink = _vehicle->vehicleLinkManager()->primaryLink();
+    }
 
     if (_resumeMission) {
         _resumeMission = false;
@@ -957,3 +1087,130 @@ void PlanManager::_setTransactionInProgress(TransactionType_t type)
         emit inProgressChanged(inProgress());
     }
 }
+
+bool PlanManager::_ftpTransferSupported(void)
+{
+    // FTP capability alone says nothing about the @MISSION files, only some firmwares serve the plan that way
+    return _vehicle->firmwarePlugin()->supportsMissionFtp() &&
+            _vehicle->ftpManager() &&
+            (_vehicle->capabilityBits() & MAV_PROTOCOL_CAPABILITY_FTP) &&
+            !MavlinkFTP::missionFilePath(_planType).isEmpty();
+}
+
+/// Starts reading the plan as a single file
+/// @return false: file transfer not available, caller should use the mission protocol
+bool PlanManager::_ftpRead(void)
+{
+    if (!_ftpTransferSupported()) {
+        return false;
+    }
+
+    delete _ftpDir;
+    _ftpDir = new QTemporaryDir();
+
+    FTPManager* ftpManager = _vehicle->ftpManager();
+    connect(ftpManager, &FTPManager::downloadComplete,  this, &PlanManager::_ftpDownloadComplete);
+    connect(ftpManager, &FTPManager::commandProgress,   this, &PlanManager::_ftpProgress);
+
+    if (!_ftpDir->isValid() || !ftpManager->download(MavlinkFTP::missionFilePath(_planType), _ftpDir->path())) {
+        qCDebug(PlanManagerLog) << QStringLiteral("_ftpRead %1 unable to start download").arg(_planTypeString());
+        _ftpTransferDone();
+        return false;
+    }
+
+    qCDebug(PlanManagerLog) << QStringLiteral("_ftpRead %1 download started").arg(_planTypeString());
+    return true;
+}
+
+void PlanManager::_ftpDownloadComplete(const QString& file, const QString& errorMsg)
+{
+    QList<mavlink_mission_item_int_t>   items;
+    bool                                success = false;
+
+    if (errorMsg.isEmpty()) {
+        QFile planFile(file);
+        success = planFile.open(QFile::ReadOnly) && MavlinkFTP::unpackMissionFile(planFile.readAll(), _planType, items);
+    }
+    _ftpTransferDone();
+
+    if (!success) {
+        qCDebug(PlanManagerLog) << QStringLiteral("_ftpDownloadComplete %1 failed, falling back to mission protocol").arg(_planTypeString()) << errorMsg;
+        _requestList();
+        return;
+    }
+
+    qCDebug(PlanManagerLog) << QStringLiteral("_ftpDownloadComplete %1 count:").arg(_planTypeString()) << items.count();
+
+    _clearMissionItems();
+    _vehicleItems = items;
+    for (const mavlink_mission_item_int_t& item: items) {
+        _missionItems.append(_missionItemFromMavlink(item));
+    }
+    _finishTransaction(true);
+}
+
+/// Starts writing _writeMissionItems as a single file
+/// @return false: file transfer not available, caller should use the mission protocol
+bool PlanManager::_ftpWrite(void)
+{
+    if (!_ftpTransferSupported()) {
+        return false;
+    }
+
+    const QList<mavlink_mission_item_int_t>& items = _writeVehicleItems;
+
+    delete _ftpDir;
+    _ftpDir = new QTemporaryDir();
+
+    QFile planFile(_ftpDir->filePath(QFileInfo(MavlinkFTP::missionFilePath(_planType)).fileName()));
+    if (!_ftpDir->isValid() || !planFile.open(QFile::WriteOnly | QFile::Truncate) || planFile.write(MavlinkFTP::packMissionFile(_planType, items)) == -1) {
+        qCDebug(PlanManagerLog) << QStringLiteral("_ftpWrite %1 unable to create local plan file").arg(_planTypeString());
+        _ftpTransferDone();
+        return false;
+    }
+    planFile.close();
+
+    FTPManager* ftpManager = _vehicle->ftpManager();
+    connect(ftpManager, &FTPManager::uploadComplete,    this, &PlanManager::_ftpUploadComplete);
+    connect(ftpManager, &FTPManager::commandProgress,   this, &PlanManager::_ftpProgress);
+
+    if (!ftpManager->upload(MavlinkFTP::missionFilePath(_planType), planFile.fileName())) {
+        qCDebug(PlanManagerLog) << QStringLiteral("_ftpWrite %1 unable to start upload").arg(_planTypeString());
+        _ftpTransferDone();
+        return false;
+    }
+
+    qCDebug(PlanManagerLog) << QStringLiteral("_ftpWrite %1 upload started count:").arg(_planTypeString()) << items.count();
+    return true;
+}
+
+void PlanManager::_ftpUploadComplete(const QString& /*file*/, const QString& errorMsg)
+{
+    _ftpTransferDone();
+
+    if (!errorMsg.isEmpty()) {
+        qCDebug(PlanManagerLog) << QStringLiteral("_ftpUploadComplete %1 failed, falling back to mission protocol").arg(_planTypeString()) << errorMsg;
+        _writeMissionCount();
+        return;
+    }
+
+    qCDebug(PlanManagerLog) << QStringLiteral("_ftpUploadComplete %1 write sequence complete").arg(_planTypeString());
+    _itemIndicesToWrite.clear();
+    _finishTransaction(true);
+}
+
+void PlanManager::_ftpProgress(float value)
+{
+    emit progressPct(value);
+}
+
+void PlanManager::_ftpTransferDone(void)
+{
+    FTPManager* ftpManager = _vehicle->ftpManager();
+    disconnect(ftpManager, &FTPManager::downloadComplete,   this, &PlanManager::_ftpDownloadComplete);
+    disconnect(ftpManager, &FTPManager::uploadComplete,     this, &PlanManager::_ftpUploadComplete);
+    disconnect(ftpManager, &FTPManager::commandProgress,    this, &PlanManager::_ftpProgress);
+
+    delete _ftpDir;
+    _ftpDir = nullptr;
+}
@@ -12,6 +12,7 @@
 #include <QObject>
 #include <QLoggingCategory>
 #include <QTimer>
+#include <QTemporaryDir>
 
 #include "MissionItem.h"
 #include "QGCMAVLink.h"
@@ -25,6 +26,15 @@ Q_DECLARE_LOGGING_CATEGORY(PlanManagerLog)
 
 /// The PlanManager class is the base class for the Mission, GeoFence and Rally Point managers. All of which use the
 /// new mavlink v2 mission protocol.
+///
+/// If the firmware serves the plan over MAVLink FTP (ArduPilot), the whole plan is first transferred as a single file (see
+/// MavlinkFTP::missionFilePath) using burst reads. This avoids the per item round trips of the mission protocol
+/// which dominate the transfer time of large plans over slow links. If the file transfer fails for any reason
+/// the transaction falls back to the mission protocol.
+///
+/// When the firmware supports MISSION_WRITE_PARTIAL_LIST, a mission write is compared against the last item list known
+/// to be on the vehicle and only the changed range is sent. Inserting or removing items shifts the sequence numbers
+/// of everything after them, so a change in count always goes out as a full write.
 class PlanManager : public QObject
 {
     Q_OBJECT
@@ -91,6 +101,9 @@ signals:
 private slots:
     void _mavlinkMessageReceived(const mavlink_message_t& message);
     void _ackTimeout(void);
+    void _ftpDownloadComplete   (const QString& file, const QString& errorMsg);
+    void _ftpUploadComplete     (const QString& file, const QString& errorMsg);
+    void _ftpProgress           (float value);
 
 protected:
     typedef enum {
@@ -155,5 +168,25 @@ protected:
     int                 _lastCurrentIndex;
 
 private:
-    void _setTransactionInProgress(TransactionType_t type);
+    void            _setTransactionInProgress   (TransactionType_t type);
+    bool            _ftpTransferSupported       (void);
+    bool            _ftpRead                    (void);
+    bool            _ftpWrite                   (void);
+    void            _ftpTransferDone            (void);
+    MissionItem*    _missionItemFromMavlink     (const mavlink_mission_item_int_t& missionItem);
+    mavlink_mission_item_int_t _missionItemToMavlink(int seq, MissionItem* item);
+    bool            _partialWriteSupported      (void);
+    bool            _findChangedRange           (int& first, int& last);
+    void            _writePartialList           (void);
+    void            _fallBackToFullWrite        (void);
+
+    QTemporaryDir*  _ftpDir = nullptr;      ///< Local copy of the plan file while a file transfer is in progress
+
+    QList<mavlink_mission_item_int_t>   _vehicleItems;                  ///< Last known items on the vehicle, as sent over the wire
+    bool                                _vehicleItemsKnown  = false;    ///< false: _vehicleItems can't be trusted, for example after a failed write
+    WeakLinkInterfacePtr                _vehicleItemsLink;              ///< Link _vehicleItems were confirmed over, the cache is dropped if it changes
+    QList<mavlink_mission_item_int_t>   _writeVehicleItems;             ///< _writeMissionItems as sent over the wire
+    bool                                _partialWrite       = false;    ///< Current write only sends _partialWriteStart.._partialWriteEnd
+    int                                 _partialWriteStart  = -1;
+    int                                 _partialWriteEnd    = -1;
 };
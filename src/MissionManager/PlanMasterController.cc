@@ -20,6 +20,7 @@
 #include "StructureScanPlanCreator.h"
 #include "CorridorScanPlanCreator.h"
 #include "BlankPlanCreator.h"
+#include "PlanBinaryFile.h"
 #if defined(QGC_AIRMAP_ENABLED)
 #include "AirspaceFlightPlanProvider.h"
 #endif
@@ -362,8 +363,9 @@ void PlanMasterController::loadFromFile(const QString& filename)
 
     QFileInfo fileInfo(filename);
     QFile file(filename);
+    bool binaryPlan = fileInfo.suffix() == AppSettings::binaryPlanFileExtension;
 
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    if (!file.open(binaryPlan ? QIODevice::OpenMode(QIODevice::ReadOnly) : QIODevice::ReadOnly | QIODevice::Text)) {
         errorString = file.errorString() + QStringLiteral(" ") + filename;
         qgcApp()->showAppMessage(errorMessage.arg(errorString));
         return;
@@ -383,15 +385,26 @@ void PlanMasterController::loadFromFile(const QString& filename)
             success = true;
         }
     } else {
-        QJsonDocument   jsonDoc;
+        QJsonObject     json;
+        PlanBinaryFile  binaryFile;
         QByteArray      bytes = file.readAll();
 
-        if (!JsonHelper::isJsonFile(bytes, jsonDoc, errorString)) {
-            qgcApp()->showAppMessage(errorMessage.arg(errorString));
-            return;
+        if (binaryPlan) {
+            // The plan json comes without the mission items, the mission controller creates those from the binary file in batches
+            if (!binaryFile.open(bytes, errorString)) {
+                qgcApp()->showAppMessage(errorMessage.arg(errorString));
+                return;
+            }
+            json = binaryFile.planJson();
+        } else {
+            QJsonDocument jsonDoc;
+            if (!JsonHelper::isJsonFile(bytes, jsonDoc, errorString)) {
+                qgcApp()->showAppMessage(errorMessage.arg(errorString));
+                return;
+            }
+            json = jsonDoc.object();
         }
 
-        QJsonObject json = jsonDoc.object();
         //-- Allow plugins to pre process the load
         qgcApp()->toolbox()->corePlugin()->preLoadFromJson(this, json);
 
@@ -411,7 +424,10 @@ void PlanMasterController::loadFromFile(const QString& filename)
             return;
         }
 
-        if (!_missionController.load(json[kJsonMissionObjectKey].toObject(), errorString) ||
+        bool missionLoaded = binaryPlan ?
+                    _missionController.loadBinaryPlan(json[kJsonMissionObjectKey].toObject(), binaryFile, errorString) :
+                    _missionController.load(json[kJsonMissionObjectKey].toObject(), errorString);
+        if (!missionLoaded ||
                 !_geoFenceController.load(json[kJsonGeoFenceObjectKey].toObject(), errorString) ||
                 !_rallyPointController.load(json[kJsonRallyPointsObjectKey].toObject(), errorString)) {
             qgcApp()->showAppMessage(errorMessage.arg(errorString));
@@ -423,7 +439,7 @@ void PlanMasterController::loadFromFile(const QString& filename)
     }
 
     if(success){
-        _currentPlanFile = QString::asprintf("%s/%s.%s", fileInfo.path().toLocal8Bit().data(), fileInfo.completeBaseName().toLocal8Bit().data(), AppSettings::planFileExtension);
+        _currentPlanFile = QString::asprintf("%s/%s.%s", fileInfo.path().toLocal8Bit().data(), fileInfo.completeBaseName().toLocal8Bit().data(), binaryPlan ? AppSettings::binaryPlanFileExtension : AppSettings::planFileExtension);
     } else {
         _currentPlanFile.clear();
     }
@@ -476,14 +492,15 @@ void PlanMasterController::saveToFile(const QString& filename)
     }
 
     QFile file(planFilename);
+    bool binaryPlan = QFileInfo(planFilename).suffix() == AppSettings::binaryPlanFileExtension;
 
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    if (!file.open(binaryPlan ? QIODevice::OpenMode(QIODevice::WriteOnly) : QIODevice::WriteOnly | QIODevice::Text)) {
         qgcApp()->showAppMessage(tr("Plan save error %1 : %2").arg(filename).arg(file.errorString()));
         _currentPlanFile.clear();
         emit currentPlanFileChanged();
     } else {
         QJsonDocument saveDoc = saveToJson();
-        file.write(saveDoc.toJson());
+        file.write(binaryPlan ? PlanBinaryFile::fromJson(saveDoc.object()) : saveDoc.toJson());
         if(_currentPlanFile != planFilename) {
             _currentPlanFile = planFilename;
             emit currentPlanFileChanged();
@@ -581,7 +598,7 @@ QStringList PlanMasterController::loadNameFilters(void) const
 {
     QStringList filters;
 
-    filters << tr("Supported types (*.%1 *.%2 *.%3 *.%4)").arg(AppSettings::planFileExtension).arg(AppSettings::missionFileExtension).arg(AppSettings::waypointsFileExtension).arg("txt") <<
+    filters << tr("Supported types (*.%1 *.%2 *.%3 *.%4 *.%5)").arg(AppSettings::planFileExtension).arg(AppSettings::binaryPlanFileExtension).arg(AppSettings::missionFileExtension).arg(AppSettings::waypointsFileExtension).arg("txt") <<
                tr("All Files (*)");
     return filters;
 }
@@ -591,7 +608,7 @@ QStringList PlanMasterController::saveNameFilters(void) const
 {
     QStringList filters;
 
-    filters << tr("Plan Files (*.%1)").arg(fileExtension()) << tr("All Files (*)");
+    filters << tr("Plan Files (*.%1)").arg(fileExtension()) << tr("Binary Plan Files (*.%1)").arg(AppSettings::binaryPlanFileExtension) << tr("All Files (*)");
     return filters;
 }
 
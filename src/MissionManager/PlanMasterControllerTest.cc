@@ -16,6 +16,12 @@
 #include "SettingsManager.h"
 #include "AppSettings.h"
 #include "MultiSignalSpyV2.h"
+#include "FleetPlanUploader.h"
+#include "PlanBinaryFile.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTemporaryDir>
 
 PlanMasterControllerTest::PlanMasterControllerTest(void)
     : _masterController(nullptr)
@@ -81,3 +87,123 @@ void PlanMasterControllerTest::_testActiveVehicleChanged(void) {
     // we make sure it does.
     QVERIFY(spyMissionManager.checkOnlySignalByMask(missionManagerErrorSignalMask));
 }
+
+void PlanMasterControllerTest::_testSendPlanToVehicles(void)
+{
+    MultiVehicleManager* multiVehicleManager = qgcApp()->toolbox()->multiVehicleManager();
+
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+
+    // Second vehicle on its own link
+    MockLink* secondLink = MockLink::startPX4MockLink(false);
+    QTRY_COMPARE_WITH_TIMEOUT(multiVehicleManager->vehicles()->count(), 2, 10000);
+    Vehicle* secondVehicle = multiVehicleManager->vehicles()->value<Vehicle*>(0) == _vehicle ?
+                multiVehicleManager->vehicles()->value<Vehicle*>(1) : multiVehicleManager->vehicles()->value<Vehicle*>(0);
+    QSignalSpy spyInitialConnect(secondVehicle, &Vehicle::initialConnectComplete);
+    QVERIFY(spyInitialConnect.wait(30000));
+
+    _masterController->loadFromFile(":/unittest/OldFileFormat.mission");
+
+    FleetPlanUploader uploader;
+    QSignalSpy spyComplete          (&uploader, &FleetPlanUploader::complete);
+    QSignalSpy spyVehicleComplete   (&uploader, &FleetPlanUploader::vehicleComplete);
+
+    // With a single upload slot the second vehicle has to wait for the first
+    uploader.setMaxConcurrentUploads(1);
+    uploader.setPlan(_masterController);
+    QVERIFY(uploader.start({ _vehicle, secondVehicle }));
+    QVERIFY(uploader.inProgress());
+    QCOMPARE(uploader.vehicleProgress(secondVehicle), 0.0);
+
+    QVERIFY(spyComplete.wait(30000));
+    QCOMPARE(spyComplete[0][0].toInt(), 0);
+    QCOMPARE(spyVehicleComplete.count(), 2);
+    QCOMPARE(spyVehicleComplete[0][0].value<Vehicle*>(), _vehicle);
+    QCOMPARE(uploader.progress(), 1.0);
+    QVERIFY(!uploader.inProgress());
+
+    int missionCount = _mockLink->missionItemHandler()->planItems(MAV_MISSION_TYPE_MISSION).count();
+    QVERIFY(missionCount > 0);
+    QCOMPARE(secondLink->missionItemHandler()->planItems(MAV_MISSION_TYPE_MISSION).count(), missionCount);
+
+    // The offline editing vehicle never completes a write, it has to fail right away instead of holding up the fleet
+    spyComplete.clear();
+    spyVehicleComplete.clear();
+    QVERIFY(uploader.start({ multiVehicleManager->offlineEditingVehicle(), _vehicle }));
+    QVERIFY(spyComplete.wait(30000));
+    QCOMPARE(spyComplete[0][0].toInt(), 1);
+    QCOMPARE(spyVehicleComplete[0][0].value<Vehicle*>(), multiVehicleManager->offlineEditingVehicle());
+    QCOMPARE(spyVehicleComplete[0][1].toBool(), true);
+
+    // Vehicles of a firmware and vehicle type the mission wasn't converted for are rejected
+    FleetPlanUploader unconvertedUploader;
+    QSignalSpy spyUnconvertedComplete(&unconvertedUploader, &FleetPlanUploader::complete);
+    QVERIFY(unconvertedUploader.start({ _vehicle }));
+    QCOMPARE(spyUnconvertedComplete.count(), 0);
+    QVERIFY(spyUnconvertedComplete.wait(1000));
+    QCOMPARE(spyUnconvertedComplete[0][0].toInt(), 1);
+
+    // Every vehicle failing still completes after sendPlanToVehicles has returned the uploader
+    QPointer<FleetPlanUploader> sentUploader = FleetPlanUploader::sendPlanToVehicles({ multiVehicleManager->offlineEditingVehicle() }, ":/unittest/OldFileFormat.mission");
+    QVERIFY(sentUploader);
+    QSignalSpy spySentComplete(sentUploader.data(), &FleetPlanUploader::complete);
+    QVERIFY(spySentComplete.wait(1000));
+    QCOMPARE(spySentComplete[0][0].toInt(), 1);
+    QTRY_VERIFY(sentUploader.isNull());
+
+    secondLink->disconnect();
+    QTRY_COMPARE_WITH_TIMEOUT(multiVehicleManager->vehicles()->count(), 1, 10000);
+}
+
+void PlanMasterControllerTest::_testBinaryPlan(void)
+{
+    // Lossless conversion of a plan file with sections and a complex item
+    QFile jsonFile(":/unittest/SectionTest.plan");
+    QVERIFY(jsonFile.open(QIODevice::ReadOnly));
+    QJsonObject json = QJsonDocument::fromJson(jsonFile.readAll()).object();
+
+    QString         errorString;
+    PlanBinaryFile  binaryFile;
+    QJsonObject     roundTripJson;
+    QVERIFY(binaryFile.open(PlanBinaryFile::fromJson(json), errorString));
+    QCOMPARE(binaryFile.itemCount(), json["mission"].toObject()["items"].toArray().count());
+    QVERIFY(binaryFile.toJson(roundTripJson, errorString));
+    QCOMPARE(roundTripJson, json);
+    QVERIFY(!binaryFile.open(QByteArray("QGCPLANB"), errorString));
+
+    // A mission large enough to be loaded in several batches
+    MissionController* missionController = _masterController->missionController();
+    QGeoCoordinate coordinate(47.633, -122.08);
+    missionController->insertTakeoffItem(coordinate, -1);
+    const int waypointCount = MissionController::incrementalLoadBatchSize * 3;
+    for (int i=0; i<waypointCount; i++) {
+        missionController->insertSimpleMissionItem(coordinate.atDistanceAndAzimuth(i * 10.0, 90), -1);
+    }
+    QJsonObject savedJson = _masterController->saveToJson().object();
+    const int visualItemCount = missionController->visualItems()->count();
+
+    QTemporaryDir tempDir;
+    QString binaryFilename = tempDir.filePath(QStringLiteral("IncrementalLoad.%1").arg(AppSettings::binaryPlanFileExtension));
+    _masterController->saveToFile(binaryFilename);
+
+    // Only the first batch is created up front, the rest follow in the background
+    PlanMasterController incrementalController;
+    incrementalController.setFlyView(false);
+    incrementalController.start();
+    incrementalController.loadFromFile(binaryFilename);
+    MissionController* incrementalMissionController = incrementalController.missionController();
+    QVERIFY(incrementalMissionController->incrementalLoadInProgress());
+    QVERIFY(incrementalMissionController->visualItems()->count() < visualItemCount);
+    QVERIFY(!incrementalMissionController->dirty());
+    QTRY_VERIFY(!incrementalMissionController->incrementalLoadInProgress());
+    QCOMPARE(incrementalMissionController->visualItems()->count(), visualItemCount);
+    QVERIFY(!incrementalMissionController->dirty());
+    QCOMPARE(incrementalController.saveToJson().object()["mission"], savedJson["mission"]);
+
+    // Editing while items are pending creates the rest first
+    incrementalController.loadFromFile(binaryFilename);
+    QVERIFY(incrementalMissionController->incrementalLoadInProgress());
+    incrementalMissionController->removeVisualItem(1);
+    QVERIFY(!incrementalMissionController->incrementalLoadInProgress());
+    QCOMPARE(incrementalMissionController->visualItems()->count(), visualItemCount - 1);
+}
@@ -34,6 +34,8 @@ private slots:
     void _testMissionFileLoad(void);
     void _testMissionPlannerFileLoad(void);
     void _testActiveVehicleChanged(void);
+    void _testSendPlanToVehicles(void);
+    void _testBinaryPlan(void);
 
 private:
     PlanMasterController*   _masterController;
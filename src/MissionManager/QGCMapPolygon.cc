@@ -22,6 +22,8 @@
 #include <QFile>
 #include <QDomDocument>
 
+#include <cmath>
+
 const char* QGCMapPolygon::jsonPolygonKey = "polygon";
 
 QGCMapPolygon::QGCMapPolygon(QObject* parent)
@@ -53,6 +55,7 @@ void QGCMapPolygon::_init(void)
     connect(&_polygonModel, &QmlObjectListModel::dirtyChanged, this, &QGCMapPolygon::_polygonModelDirtyChanged);
     connect(&_polygonModel, &QmlObjectListModel::countChanged, this, &QGCMapPolygon::_polygonModelCountChanged);
 
+    connect(this, &QGCMapPolygon::pathChanged,  this, &QGCMapPolygon::_invalidatePreparedGeometry);
     connect(this, &QGCMapPolygon::pathChanged,  this, &QGCMapPolygon::_updateCenter);
     connect(this, &QGCMapPolygon::countChanged, this, &QGCMapPolygon::isValidChanged);
     connect(this, &QGCMapPolygon::countChanged, this, &QGCMapPolygon::isEmptyChanged);
@@ -87,6 +90,7 @@ void QGCMapPolygon::clear(void)
     // we work around it by using the code above to remove all but the last point which in turn
     // will cause the polygon to go away.
     _polygonPath.clear();
+    _invalidatePreparedGeometry();
 
     _polygonModel.clearAndDeleteContents();
 
@@ -99,6 +103,7 @@ void QGCMapPolygon::adjustVertex(int vertexIndex, const QGeoCoordinate coordinat
 {
     _polygonPath[vertexIndex] = QVariant::fromValue(coordinate);
     _polygonModel.value<QGCQGeoCoordinate*>(vertexIndex)->setCoordinate(coordinate);
+    _invalidatePreparedGeometry();
     if (!_centerDrag) {
         // When dragging center we don't signal path changed until all vertices are updated
         emit pathChanged();
@@ -155,13 +160,106 @@ QPolygonF QGCMapPolygon::_toPolygonF(void) const
     return polygon;
 }
 
-bool QGCMapPolygon::containsCoordinate(const QGeoCoordinate& coordinate) const
+void QGCMapPolygon::_prepareGeometry(void) const
 {
+    _preparedVertices.clear();
+    _preparedEdgeBuckets.clear();
+    _preparedBoundingRect = QRectF();
+    _preparedBucketHeight = 0;
+
     if (_polygonPath.count() > 2) {
-        return _toPolygonF().containsPoint(_pointFFromCoord(coordinate), Qt::OddEvenFill);
-    } else {
+        _preparedVertices.reserve(_polygonPath.count());
+        for (const QVariant& vertex: _polygonPath) {
+            _preparedVertices.append(_pointFFromCoord(vertex.value<QGeoCoordinate>()));
+        }
+
+        double minX = _preparedVertices[0].x();
+        double maxX = minX;
+        double minY = _preparedVertices[0].y();
+        double maxY = minY;
+        for (const QPointF& vertex: _preparedVertices) {
+            minX = qMin(minX, vertex.x());
+            maxX = qMax(maxX, vertex.x());
+            minY = qMin(minY, vertex.y());
+            maxY = qMax(maxY, vertex.y());
+        }
+        _preparedBoundingRect = QRectF(QPointF(minX, minY), QPointF(maxX, maxY));
+
+        int vertexCount = _preparedVertices.count();
+        if (vertexCount >= _preparedBucketVertexThreshold && maxY > minY) {
+            int bucketCount = qBound(1, static_cast<int>(std::sqrt(static_cast<double>(vertexCount))) * 4, 4096);
+            _preparedBucketHeight = (maxY - minY) / bucketCount;
+            _preparedEdgeBuckets.resize(bucketCount);
+            for (int i=0; i<vertexCount; i++) {
+                const QPointF& p1 = _preparedVertices[i];
+                const QPointF& p2 = _preparedVertices[(i + 1) % vertexCount];
+                if (qFuzzyCompare(p1.y(), p2.y())) {
+                    // Horizontal edges never count as a crossing
+                    continue;
+                }
+                int firstBucket = _preparedBucketIndex(qMin(p1.y(), p2.y()));
+                int lastBucket  = _preparedBucketIndex(qMax(p1.y(), p2.y()));
+                for (int bucket=firstBucket; bucket<=lastBucket; bucket++) {
+                    _preparedEdgeBuckets[bucket].append(i);
+                }
+            }
+        }
+    }
+
+    _preparedGeometryValid = true;
+}
+
+int QGCMapPolygon::_preparedBucketIndex(double y) const
+{
+    int bucket = static_cast<int>((y - _preparedBoundingRect.top()) / _preparedBucketHeight);
+    return qBound(0, bucket, _preparedEdgeBuckets.count() - 1);
+}
+
+bool QGCMapPolygon::containsCoordinate(const QGeoCoordinate& coordinate) const
+{
+    if (_polygonPath.count() <= 2) {
         return false;
     }
+    if (!_preparedGeometryValid) {
+        _prepareGeometry();
+    }
+
+    QPointF point = _pointFFromCoord(coordinate);
+    if (point.x() < _preparedBoundingRect.left() || point.y() < _preparedBoundingRect.top() || point.y() > _preparedBoundingRect.bottom()) {
+        return false;
+    }
+
+    // Odd-even crossing count with the same edge rules as QPolygonF::containsPoint
+    int vertexCount = _preparedVertices.count();
+    int crossings   = 0;
+    auto countCrossing = [&](int edgeIndex) {
+        QPointF p1 = _preparedVertices[edgeIndex];
+        QPointF p2 = _preparedVertices[(edgeIndex + 1) % vertexCount];
+        if (qFuzzyCompare(p1.y(), p2.y())) {
+            return;
+        }
+        if (p2.y() < p1.y()) {
+            std::swap(p1, p2);
+        }
+        if (point.y() >= p1.y() && point.y() < p2.y()) {
+            double x = p1.x() + ((p2.x() - p1.x()) / (p2.y() - p1.y())) * (point.y() - p1.y());
+            if (x <= point.x()) {
+                crossings++;
+            }
+        }
+    };
+
+    if (_preparedEdgeBuckets.isEmpty()) {
+        for (int i=0; i<vertexCount; i++) {
+            countCrossing(i);
+        }
+    } else {
+        for (int edgeIndex: _preparedEdgeBuckets[_preparedBucketIndex(point.y())]) {
+            countCrossing(edgeIndex);
+        }
+    }
+
+    return crossings % 2 != 0;
 }
 
 void QGCMapPolygon::setPath(const QList<QGeoCoordinate>& path)
@@ -14,6 +14,8 @@
 #include <QGeoCoordinate>
 #include <QVariantList>
 #include <QPolygon>
+#include <QRectF>
+#include <QVector>
 
 #include "QmlObjectListModel.h"
 #include "KMLDomDocument.h"
@@ -155,6 +157,9 @@ private:
     QPointF         _pointFFromCoord        (const QGeoCoordinate& coordinate) const;
     void            _beginResetIfNotActive  (void);
     void            _endResetIfNotActive    (void);
+    void            _invalidatePreparedGeometry(void) { _preparedGeometryValid = false; }
+    void            _prepareGeometry        (void) const;
+    int             _preparedBucketIndex    (double y) const;
 
     QVariantList        _polygonPath;
     QmlObjectListModel  _polygonModel;
@@ -167,6 +172,16 @@ private:
     bool                _traceMode =            false;
     bool                _showAltColor =         false;
     int                 _selectedVertexIndex =  -1;
+
+    // Prepared geometry used by containsCoordinate. Built lazily from the path and invalidated whenever the path changes.
+    // Large polygons also get their edges bucketed into horizontal bands so a containment test only looks at the edges
+    // which cross the band of the test point.
+    static const int                _preparedBucketVertexThreshold = 64;    ///< Polygons with fewer vertices are tested linearly
+    mutable bool                    _preparedGeometryValid = false;
+    mutable QVector<QPointF>        _preparedVertices;                      ///< Vertices in tangent plane coordinates, see _pointFFromCoord
+    mutable QRectF                  _preparedBoundingRect;
+    mutable QVector<QVector<int>>   _preparedEdgeBuckets;                   ///< Indices of the edges (vertex i -> i + 1) which span each band
+    mutable double                  _preparedBucketHeight = 0;
 };
 
 #endif
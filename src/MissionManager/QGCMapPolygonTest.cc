@@ -10,6 +10,11 @@
 #include "QGCMapPolygonTest.h"
 #include "QGCApplication.h"
 #include "QGCQGeoCoordinate.h"
+#include "QGCGeo.h"
+#include "ShapeFileHelper.h"
+#include "shapefil.h"
+
+#include <QTemporaryDir>
 
 QGCMapPolygonTest::QGCMapPolygonTest(void)
 {
@@ -220,6 +225,145 @@ void QGCMapPolygonTest::_testKMLLoad(void)
     checkExpectedMessageBox();
 }
 
+void QGCMapPolygonTest::_testKMLFeatures(void)
+{
+    const QString kmlFile(QStringLiteral(":/unittest/MultiFeature.kml"));
+
+    // Index only: Point placemarks are skipped, no geometry is returned
+    QList<ShapeFileHelper::Feature> rgFeatures;
+    QString errorString;
+    QVERIFY(ShapeFileHelper::loadFeaturesFromFile(kmlFile, false /* loadGeometry */, 0, [&](const ShapeFileHelper::Feature& feature) {
+        rgFeatures.append(feature);
+        return true;
+    }, errorString));
+    QVERIFY(errorString.isEmpty());
+    QCOMPARE(rgFeatures.count(), 3);
+
+    QCOMPARE(rgFeatures[0].index,                       0);
+    QCOMPARE(rgFeatures[0].type,                        ShapeFileHelper::Polygon);
+    QCOMPARE(rgFeatures[0].name,                        QStringLiteral("Field A"));
+    QCOMPARE(rgFeatures[0].attributes[QStringLiteral("crop")].toString(), QStringLiteral("wheat"));
+    QCOMPARE(rgFeatures[0].vertexCount,                 4);
+    QVERIFY(rgFeatures[0].coords.isEmpty());
+    QVERIFY(rgFeatures[0].boundingBox.contains(QGeoCoordinate(47.66, -122.105)));
+
+    QCOMPARE(rgFeatures[1].type,                        ShapeFileHelper::Polyline);
+    QCOMPARE(rgFeatures[1].name,                        QStringLiteral("Fence Line"));
+    QCOMPARE(rgFeatures[1].vertexCount,                 3);
+
+    QCOMPARE(rgFeatures[2].index,                       2);
+    QCOMPARE(rgFeatures[2].name,                        QStringLiteral("Field B"));
+    QCOMPARE(rgFeatures[2].attributes[QStringLiteral("crop")].toString(), QStringLiteral("corn"));
+    QCOMPARE(rgFeatures[2].vertexCount,                 4);     // Inner boundary is ignored
+
+    // Stop after first feature
+    int handlerCount = 0;
+    QVERIFY(ShapeFileHelper::loadFeaturesFromFile(kmlFile, false /* loadGeometry */, 0, [&](const ShapeFileHelper::Feature&) {
+        handlerCount++;
+        return false;
+    }, errorString));
+    QCOMPARE(handlerCount, 1);
+
+    // Single feature with geometry
+    ShapeFileHelper::Feature feature;
+    QVERIFY(ShapeFileHelper::loadFeatureFromFile(kmlFile, 2, 0, feature, errorString));
+    QCOMPARE(feature.name,          QStringLiteral("Field B"));
+    QCOMPARE(feature.coords.count(), 4);
+
+    QVERIFY(!ShapeFileHelper::loadFeatureFromFile(kmlFile, 3, 0, feature, errorString));
+    QVERIFY(!errorString.isEmpty());
+
+    // Simplification drops the vertex which is on the line between its neighbours
+    QList<QGeoCoordinate> rgLine = { QGeoCoordinate(47.0, 8.0), QGeoCoordinate(47.0, 8.001), QGeoCoordinate(47.0, 8.002), QGeoCoordinate(47.001, 8.002) };
+    QList<QGeoCoordinate> rgSimplified = ShapeFileHelper::simplifyCoordinates(rgLine, 1.0);
+    QCOMPARE(rgSimplified.count(), 3);
+    QCOMPARE(rgSimplified[1], rgLine[2]);
+}
+
+void QGCMapPolygonTest::_testSHPFeatures(void)
+{
+    // Shapelib works on real files, so the shape file set is written to a temporary directory
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString basePath  = tempDir.filePath(QStringLiteral("Fields"));
+    const QString shpFile   = basePath + QStringLiteral(".shp");
+
+    QFile prjFile(basePath + QStringLiteral(".prj"));
+    QVERIFY(prjFile.open(QIODevice::WriteOnly | QIODevice::Text));
+    prjFile.write("GEOGCS[\"GCS_WGS_1984\",DATUM[\"D_WGS_1984\",SPHEROID[\"WGS_1984\",6378137,298.257223563]],PRIMEM[\"Greenwich\",0],UNIT[\"Degree\",0.017453292519943295]]\n");
+    prjFile.close();
+
+    SHPHandle shpHandle = SHPCreate(shpFile.toUtf8().constData(), SHPT_POLYGON);
+    DBFHandle dbfHandle = DBFCreate((basePath + QStringLiteral(".dbf")).toUtf8().constData());
+    QVERIFY(shpHandle);
+    QVERIFY(dbfHandle);
+    QCOMPARE(DBFAddField(dbfHandle, "NAME",     FTString, 32, 0), 0);
+    QCOMPARE(DBFAddField(dbfHandle, "HECTARES", FTDouble, 10, 2), 1);
+
+    // SHP rings are closed by repeating the first vertex
+    double rgX1[] = { 8.000,  8.000,  8.010,  8.010,  8.000 };
+    double rgY1[] = { 47.000, 47.010, 47.010, 47.000, 47.000 };
+    double rgX2[] = { 8.020,  8.025,  8.030,  8.020 };
+    double rgY2[] = { 47.000, 47.010, 47.000, 47.000 };
+
+    SHPObject* shpObject = SHPCreateSimpleObject(SHPT_POLYGON, 5, rgX1, rgY1, nullptr);
+    QCOMPARE(SHPWriteObject(shpHandle, -1, shpObject), 0);
+    SHPDestroyObject(shpObject);
+    shpObject = SHPCreateSimpleObject(SHPT_POLYGON, 4, rgX2, rgY2, nullptr);
+    QCOMPARE(SHPWriteObject(shpHandle, -1, shpObject), 1);
+    SHPDestroyObject(shpObject);
+
+    // Second feature has no name and falls back to the default name
+    QVERIFY(DBFWriteStringAttribute(dbfHandle, 0, 0, "Field A"));
+    QVERIFY(DBFWriteDoubleAttribute(dbfHandle, 0, 1, 81.5));
+    QVERIFY(DBFWriteDoubleAttribute(dbfHandle, 1, 1, 40.25));
+
+    SHPClose(shpHandle);
+    DBFClose(dbfHandle);
+
+    // Index only
+    QList<ShapeFileHelper::Feature> rgFeatures;
+    QString errorString;
+    QVERIFY(ShapeFileHelper::loadFeaturesFromFile(shpFile, false /* loadGeometry */, 0, [&](const ShapeFileHelper::Feature& feature) {
+        rgFeatures.append(feature);
+        return true;
+    }, errorString));
+    QVERIFY(errorString.isEmpty());
+    QCOMPARE(rgFeatures.count(), 2);
+
+    QCOMPARE(rgFeatures[0].index,                       0);
+    QCOMPARE(rgFeatures[0].type,                        ShapeFileHelper::Polygon);
+    QCOMPARE(rgFeatures[0].name,                        QStringLiteral("Field A"));
+    QCOMPARE(rgFeatures[0].attributes[QStringLiteral("HECTARES")].toDouble(), 81.5);
+    QCOMPARE(rgFeatures[0].vertexCount,                 4);     // Closing vertex is dropped
+    QVERIFY(rgFeatures[0].coords.isEmpty());
+    QVERIFY(rgFeatures[0].boundingBox.contains(QGeoCoordinate(47.005, 8.005)));
+
+    QCOMPARE(rgFeatures[1].index,                       1);
+    QCOMPARE(rgFeatures[1].name,                        QStringLiteral("Feature 2"));
+    QVERIFY(!rgFeatures[1].attributes.contains(QStringLiteral("NAME")));
+    QCOMPARE(rgFeatures[1].attributes[QStringLiteral("HECTARES")].toDouble(), 40.25);
+    QCOMPARE(rgFeatures[1].vertexCount,                 3);
+
+    // Single feature with geometry
+    ShapeFileHelper::Feature feature;
+    QVERIFY(ShapeFileHelper::loadFeatureFromFile(shpFile, 0, 0, feature, errorString));
+    QCOMPARE(feature.name,          QStringLiteral("Field A"));
+    QCOMPARE(feature.coords.count(), 4);
+    QCOMPARE(feature.coords[1],     QGeoCoordinate(47.010, 8.000));
+
+    QVERIFY(!ShapeFileHelper::loadFeatureFromFile(shpFile, 2, 0, feature, errorString));
+    QVERIFY(!errorString.isEmpty());
+
+    // Missing projection file is reported
+    QVERIFY(QFile::remove(basePath + QStringLiteral(".prj")));
+    errorString.clear();
+    QVERIFY(!ShapeFileHelper::loadFeaturesFromFile(shpFile, false /* loadGeometry */, 0, [](const ShapeFileHelper::Feature&) {
+        return true;
+    }, errorString));
+    QVERIFY(!errorString.isEmpty());
+}
+
 void QGCMapPolygonTest::_testSelectVertex(void)
 {
     // Create polygon
@@ -334,3 +478,47 @@ void QGCMapPolygonTest::_testSegmentSplit(void)
     QVERIFY(_mapPolygon->count() == 14);
     QVERIFY(_mapPolygon->selectedVertex() == _mapPolygon->count()-2);
 }
+
+void QGCMapPolygonTest::_testContainsCoordinate(void)
+{
+    // Simple polygon uses the linear containment test
+    for (const QGeoCoordinate& vertex: _polyPoints) {
+        _mapPolygon->appendVertex(vertex);
+    }
+    QGeoCoordinate center = _mapPolygon->center();
+    QVERIFY(_mapPolygon->containsCoordinate(center));
+    QVERIFY(!_mapPolygon->containsCoordinate(center.atDistanceAndAzimuth(1000, 0)));
+
+    // Editing the polygon must invalidate the prepared geometry
+    _mapPolygon->adjustVertex(1, _polyPoints[1].atDistanceAndAzimuth(2000, 45));
+    QVERIFY(_mapPolygon->containsCoordinate(center.atDistanceAndAzimuth(1000, 45)));
+
+    // Large star shaped polygon uses the bucketed containment test, results must match QPolygonF
+    QList<QGeoCoordinate> rgStar;
+    const int cStarVertices = 2000;
+    for (int i=0; i<cStarVertices; i++) {
+        rgStar.append(center.atDistanceAndAzimuth(i % 2 ? 500 : 1500, (360.0 * i) / cStarVertices));
+    }
+    _mapPolygon->clear();
+    _mapPolygon->appendVertices(rgStar);
+
+    QPolygonF referencePolygon;
+    for (const QGeoCoordinate& vertex: rgStar) {
+        double y, x, down;
+        convertGeoToNed(vertex, rgStar[0], &y, &x, &down);
+        referencePolygon.append(QPointF(x, -y));
+    }
+
+    int insideCount = 0;
+    for (int i=0; i<1000; i++) {
+        QGeoCoordinate testCoord = center.atDistanceAndAzimuth((i * 7) % 1700, (i * 37) % 360 + 0.13);
+        double y, x, down;
+        convertGeoToNed(testCoord, rgStar[0], &y, &x, &down);
+        bool expected = referencePolygon.containsPoint(QPointF(x, -y), Qt::OddEvenFill);
+        QCOMPARE(_mapPolygon->containsCoordinate(testCoord), expected);
+        if (expected) {
+            insideCount++;
+        }
+    }
+    QVERIFY(insideCount > 0 && insideCount < 1000);
+}
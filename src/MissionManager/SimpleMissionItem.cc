@@ -58,13 +58,6 @@ SimpleMissionItem::SimpleMissionItem(PlanMasterController* masterController, boo
     , _supportedCommandFact             (0, "Command:",             FactMetaData::valueTypeUint32)
     , _altitudeFact                     (0, "Altitude",             FactMetaData::valueTypeDouble)
     , _amslAltAboveTerrainFact          (0, "Alt above terrain",    FactMetaData::valueTypeDouble)
-    , _param1MetaData                   (FactMetaData::valueTypeDouble)
-    , _param2MetaData                   (FactMetaData::valueTypeDouble)
-    , _param3MetaData                   (FactMetaData::valueTypeDouble)
-    , _param4MetaData                   (FactMetaData::valueTypeDouble)
-    , _param5MetaData                   (FactMetaData::valueTypeDouble)
-    , _param6MetaData                   (FactMetaData::valueTypeDouble)
-    , _param7MetaData                   (FactMetaData::valueTypeDouble)
 {
     _editorQml = QStringLiteral("qrc:/qml/SimpleItemEditor.qml");
 
@@ -87,13 +80,6 @@ SimpleMissionItem::SimpleMissionItem(PlanMasterController* masterController, boo
     , _supportedCommandFact     (0,         "Command:",             FactMetaData::valueTypeUint32)
     , _altitudeFact             (0,         "Altitude",             FactMetaData::valueTypeDouble)
     , _amslAltAboveTerrainFact  (0,         "Alt above terrain",    FactMetaData::valueTypeDouble)
-    , _param1MetaData           (FactMetaData::valueTypeDouble)
-    , _param2MetaData           (FactMetaData::valueTypeDouble)
-    , _param3MetaData           (FactMetaData::valueTypeDouble)
-    , _param4MetaData           (FactMetaData::valueTypeDouble)
-    , _param5MetaData           (FactMetaData::valueTypeDouble)
-    , _param6MetaData           (FactMetaData::valueTypeDouble)
-    , _param7MetaData           (FactMetaData::valueTypeDouble)
 {
     _editorQml = QStringLiteral("qrc:/qml/SimpleItemEditor.qml");
 
@@ -429,30 +415,30 @@ QString SimpleMissionItem::abbreviation() const
 
 void SimpleMissionItem::_rebuildTextFieldFacts(void)
 {
-    _textFieldFacts.clear();
+    _textFieldFacts->clear();
     
     if (rawEdit()) {
         _missionItem._param1Fact._setName("Param1");
         _missionItem._param1Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param1Fact);
+        _textFieldFacts->append(&_missionItem._param1Fact);
         _missionItem._param2Fact._setName("Param2");
         _missionItem._param2Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param2Fact);
+        _textFieldFacts->append(&_missionItem._param2Fact);
         _missionItem._param3Fact._setName("Param3");
         _missionItem._param3Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param3Fact);
+        _textFieldFacts->append(&_missionItem._param3Fact);
         _missionItem._param4Fact._setName("Param4");
         _missionItem._param4Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param4Fact);
+        _textFieldFacts->append(&_missionItem._param4Fact);
         _missionItem._param5Fact._setName("Lat/X");
         _missionItem._param5Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param5Fact);
+        _textFieldFacts->append(&_missionItem._param5Fact);
         _missionItem._param6Fact._setName("Lon/Y");
         _missionItem._param6Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param6Fact);
+        _textFieldFacts->append(&_missionItem._param6Fact);
         _missionItem._param7Fact._setName("Alt/Z");
         _missionItem._param7Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param7Fact);
+        _textFieldFacts->append(&_missionItem._param7Fact);
     } else {
         _ignoreDirtyChangeSignals = true;
 
@@ -464,7 +450,6 @@ void SimpleMissionItem::_rebuildTextFieldFacts(void)
         }
 
         Fact*           rgParamFacts[7] =       { &_missionItem._param1Fact, &_missionItem._param2Fact, &_missionItem._param3Fact, &_missionItem._param4Fact, &_missionItem._param5Fact, &_missionItem._param6Fact, &_missionItem._param7Fact };
-        FactMetaData*   rgParamMetaData[7] =    { &_param1MetaData, &_param2MetaData, &_param3MetaData, &_param4MetaData, &_param5MetaData, &_param6MetaData, &_param7MetaData };
 
         const MissionCommandUIInfo* uiInfo = _commandTree->getUIInfo(_controllerVehicle, _previousVTOLMode, command);
 
@@ -475,13 +460,13 @@ void SimpleMissionItem::_rebuildTextFieldFacts(void)
 
                 if (showUI && paramInfo && paramInfo->enumStrings().count() == 0 && !paramInfo->nanUnchanged()) {
                     Fact*               paramFact =     rgParamFacts[i-1];
-                    FactMetaData*       paramMetaData = rgParamMetaData[i-1];
+                    FactMetaData*       paramMetaData = _rgParamMetaData[i-1];
 
                     paramFact->_setName(paramInfo->label());
                     paramMetaData->setDecimalPlaces(paramInfo->decimalPlaces());
                     paramMetaData->setRawUnits(paramInfo->units());
                     paramFact->setMetaData(paramMetaData);
-                    _textFieldFacts.append(paramFact);
+                    _textFieldFacts->append(paramFact);
                 }
             }
         }
@@ -492,7 +477,7 @@ void SimpleMissionItem::_rebuildTextFieldFacts(void)
 
 void SimpleMissionItem::_rebuildNaNFacts(void)
 {
-    _nanFacts.clear();
+    _nanFacts->clear();
 
     if (!rawEdit()) {
         _ignoreDirtyChangeSignals = true;
@@ -505,7 +490,6 @@ void SimpleMissionItem::_rebuildNaNFacts(void)
         }
 
         Fact*           rgParamFacts[7] =       { &_missionItem._param1Fact, &_missionItem._param2Fact, &_missionItem._param3Fact, &_missionItem._param4Fact, &_missionItem._param5Fact, &_missionItem._param6Fact, &_missionItem._param7Fact };
-        FactMetaData*   rgParamMetaData[7] =    { &_param1MetaData, &_param2MetaData, &_param3MetaData, &_param4MetaData, &_param5MetaData, &_param6MetaData, &_param7MetaData };
 
         const MissionCommandUIInfo* uiInfo = _commandTree->getUIInfo(_controllerVehicle, _previousVTOLMode, command);
 
@@ -523,13 +507,13 @@ void SimpleMissionItem::_rebuildNaNFacts(void)
                     }
 
                     Fact*               paramFact =     rgParamFacts[i-1];
-                    FactMetaData*       paramMetaData = rgParamMetaData[i-1];
+                    FactMetaData*       paramMetaData = _rgParamMetaData[i-1];
 
                     paramFact->_setName(paramInfo->label());
                     paramMetaData->setDecimalPlaces(paramInfo->decimalPlaces());
                     paramMetaData->setRawUnits(paramInfo->units());
                     paramFact->setMetaData(paramMetaData);
-                    _nanFacts.append(paramFact);
+                    _nanFacts->append(paramFact);
                 }
             }
         }
@@ -569,14 +553,13 @@ double SimpleMissionItem::loiterRadius() const
 
 void SimpleMissionItem::_rebuildComboBoxFacts(void)
 {
-    _comboboxFacts.clear();
+    _comboboxFacts->clear();
 
     if (rawEdit()) {
-        _comboboxFacts.append(&_missionItem._commandFact);
-        _comboboxFacts.append(&_missionItem._frameFact);
+        _comboboxFacts->append(&_missionItem._commandFact);
+        _comboboxFacts->append(&_missionItem._frameFact);
     } else {
         Fact*           rgParamFacts[7] =       { &_missionItem._param1Fact, &_missionItem._param2Fact, &_missionItem._param3Fact, &_missionItem._param4Fact, &_missionItem._param5Fact, &_missionItem._param6Fact, &_missionItem._param7Fact };
-        FactMetaData*   rgParamMetaData[7] =    { &_param1MetaData, &_param2MetaData, &_param3MetaData, &_param4MetaData, &_param5MetaData, &_param6MetaData, &_param7MetaData };
 
         MAV_CMD command;
         if (_homePositionSpecialCase) {
@@ -591,21 +574,42 @@ void SimpleMissionItem::_rebuildComboBoxFacts(void)
 
             if (showUI && paramInfo && paramInfo->enumStrings().count() != 0) {
                 Fact*               paramFact =     rgParamFacts[i-1];
-                FactMetaData*       paramMetaData = rgParamMetaData[i-1];
+                FactMetaData*       paramMetaData = _rgParamMetaData[i-1];
 
                 paramFact->_setName(paramInfo->label());
                 paramMetaData->setDecimalPlaces(paramInfo->decimalPlaces());
                 paramMetaData->setEnumInfo(paramInfo->enumStrings(), paramInfo->enumValues());
                 paramMetaData->setRawUnits(paramInfo->units());
                 paramFact->setMetaData(paramMetaData);
-                _comboboxFacts.append(paramFact);
+                _comboboxFacts->append(paramFact);
             }
         }
     }
 }
 
+void SimpleMissionItem::_createEditFacts(void)
+{
+    if (_textFieldFacts) {
+        return;
+    }
+
+    _textFieldFacts =   new QmlObjectListModel(this);
+    _nanFacts =         new QmlObjectListModel(this);
+    _comboboxFacts =    new QmlObjectListModel(this);
+    for (int i=0; i<7; i++) {
+        _rgParamMetaData[i] = new FactMetaData(FactMetaData::valueTypeDouble, this);
+    }
+
+    _rebuildFacts();
+}
+
 void SimpleMissionItem::_rebuildFacts(void)
 {
+    if (!_textFieldFacts) {
+        // Editing ui has not been requested yet, it is built when it is
+        return;
+    }
+
     _rebuildTextFieldFacts();
     _rebuildNaNFacts();
     _rebuildComboBoxFacts();
@@ -654,7 +658,7 @@ void SimpleMissionItem::setDirty(bool dirty)
 {
     if (!_homePositionSpecialCase || (_dirty != dirty)) {
         _dirty = dirty;
-        if (!dirty) {
+        if (!dirty && _cameraSection) {
             _cameraSection->setDirty(false);
             _speedSection->setDirty(false);
         }
@@ -876,7 +880,7 @@ void SimpleMissionItem::setSequenceNumber(int sequenceNumber)
 
 double SimpleMissionItem::specifiedFlightSpeed(void)
 {
-    if (_speedSection->specifyFlightSpeed()) {
+    if (_speedSection && _speedSection->specifyFlightSpeed()) {
         return _speedSection->flightSpeed()->rawValue().toDouble();
     } else {
         return missionItem().specifiedFlightSpeed();
@@ -885,12 +889,12 @@ double SimpleMissionItem::specifiedFlightSpeed(void)
 
 double SimpleMissionItem::specifiedGimbalYaw(void)
 {
-    return _cameraSection->available() ? _cameraSection->specifiedGimbalYaw() : missionItem().specifiedGimbalYaw();
+    return _cameraSection && _cameraSection->available() ? _cameraSection->specifiedGimbalYaw() : missionItem().specifiedGimbalYaw();
 }
 
 double SimpleMissionItem::specifiedGimbalPitch(void)
 {
-    return _cameraSection->available() ? _cameraSection->specifiedGimbalPitch() : missionItem().specifiedGimbalPitch();
+    return _cameraSection && _cameraSection->available() ? _cameraSection->specifiedGimbalPitch() : missionItem().specifiedGimbalPitch();
 }
 
 double SimpleMissionItem::specifiedVehicleYaw(void)
@@ -909,6 +913,14 @@ bool SimpleMissionItem::scanForSections(QmlObjectListModel* visualItems, int sca
 {
     bool sectionFound = false;
 
+    // Sections are only available on waypoints and can only be followed by simple items
+    if (static_cast<MAV_CMD>(command()) != MAV_CMD_NAV_WAYPOINT || !visualItems->value<SimpleMissionItem*>(scanIndex)) {
+        return false;
+    }
+
+    bool sectionsCreated = !_cameraSection;
+    _createOptionalSections();
+
     if (_cameraSection->available()) {
         sectionFound |= _cameraSection->scanForSection(visualItems, scanIndex);
     }
@@ -916,12 +928,17 @@ bool SimpleMissionItem::scanForSections(QmlObjectListModel* visualItems, int sca
         sectionFound |= _speedSection->scanForSection(visualItems, scanIndex);
     }
 
+    if (sectionsCreated && !sectionFound) {
+        // Nothing to hold on to, they will be created again when needed
+        _releaseOptionalSections();
+    }
+
     return sectionFound;
 }
 
 void SimpleMissionItem::_updateOptionalSections(void)
 {
-    // Remove previous sections
+    // Remove previous sections, new ones are created the next time they are needed
     if (_cameraSection) {
         _cameraSection->deleteLater();
         _cameraSection = nullptr;
@@ -931,7 +948,16 @@ void SimpleMissionItem::_updateOptionalSections(void)
         _speedSection = nullptr;
     }
 
-    // Add new sections
+    emit cameraSectionChanged(_cameraSection);
+    emit speedSectionChanged(_speedSection);
+    emit lastSequenceNumberChanged(lastSequenceNumber());
+}
+
+void SimpleMissionItem::_createOptionalSections(void)
+{
+    if (_cameraSection) {
+        return;
+    }
 
     _cameraSection = new CameraSection(_masterController, this);
     _speedSection = new SpeedSection(_masterController, this);
@@ -951,9 +977,16 @@ void SimpleMissionItem::_updateOptionalSections(void)
     connect(_speedSection,  &SpeedSection::itemCountChanged,            this, &SimpleMissionItem::_updateLastSequenceNumber);
     connect(_speedSection,  &SpeedSection::specifiedFlightSpeedChanged, this, &SimpleMissionItem::specifiedFlightSpeedChanged);
 
-    emit cameraSectionChanged(_cameraSection);
-    emit speedSectionChanged(_speedSection);
-    emit lastSequenceNumberChanged(lastSequenceNumber());
+    _updateSectionDefaults();
+}
+
+void SimpleMissionItem::_releaseOptionalSections(void)
+{
+    // Only used for sections which have not been handed out yet, so they can go away immediately
+    delete _cameraSection;
+    delete _speedSection;
+    _cameraSection = nullptr;
+    _speedSection = nullptr;
 }
 
 int SimpleMissionItem::lastSequenceNumber(void) const
@@ -980,8 +1013,10 @@ void SimpleMissionItem::appendMissionItems(QList<MissionItem*>& items, QObject*
     items.append(new MissionItem(missionItem(), missionItemParent));
     seqNum++;
 
-    _cameraSection->appendSectionItems(items, missionItemParent, seqNum);
-    _speedSection->appendSectionItems(items, missionItemParent, seqNum);
+    if (_cameraSection) {
+        _cameraSection->appendSectionItems(items, missionItemParent, seqNum);
+        _speedSection->appendSectionItems(items, missionItemParent, seqNum);
+    }
 }
 
 void SimpleMissionItem::applyNewAltitude(double newAltitude)
@@ -1006,16 +1041,28 @@ void SimpleMissionItem::setMissionFlightStatus(MissionController::MissionFlightS
 {
     VisualMissionItem::setMissionFlightStatus(missionFlightStatus);
 
+    _flightStatusVehicleSpeed = missionFlightStatus.vehicleSpeed;
+    _flightStatusGimbalYaw =    missionFlightStatus.gimbalYaw;
+    _flightStatusGimbalPitch =  missionFlightStatus.gimbalPitch;
+    _updateSectionDefaults();
+}
+
+void SimpleMissionItem::_updateSectionDefaults(void)
+{
+    if (!_cameraSection) {
+        return;
+    }
+
     // If speed and/or gimbal are not specifically set on this item. Then use the flight status values as initial defaults should a user turn them on.
-    if (_speedSection->available() && !_speedSection->specifyFlightSpeed() && !QGC::fuzzyCompare(_speedSection->flightSpeed()->rawValue().toDouble(), missionFlightStatus.vehicleSpeed)) {
-        _speedSection->flightSpeed()->setRawValue(missionFlightStatus.vehicleSpeed);
+    if (_speedSection->available() && !_speedSection->specifyFlightSpeed() && !qIsNaN(_flightStatusVehicleSpeed) && !QGC::fuzzyCompare(_speedSection->flightSpeed()->rawValue().toDouble(), _flightStatusVehicleSpeed)) {
+        _speedSection->flightSpeed()->setRawValue(_flightStatusVehicleSpeed);
     }
     if (_cameraSection->available() && !_cameraSection->specifyGimbal()) {
-        if (!qIsNaN(missionFlightStatus.gimbalYaw) && !QGC::fuzzyCompare(_cameraSection->gimbalYaw()->rawValue().toDouble(), missionFlightStatus.gimbalYaw)) {
-            _cameraSection->gimbalYaw()->setRawValue(missionFlightStatus.gimbalYaw);
+        if (!qIsNaN(_flightStatusGimbalYaw) && !QGC::fuzzyCompare(_cameraSection->gimbalYaw()->rawValue().toDouble(), _flightStatusGimbalYaw)) {
+            _cameraSection->gimbalYaw()->setRawValue(_flightStatusGimbalYaw);
         }
-        if (!qIsNaN(missionFlightStatus.gimbalPitch) && !QGC::fuzzyCompare(_cameraSection->gimbalPitch()->rawValue().toDouble(), missionFlightStatus.gimbalPitch)) {
-            _cameraSection->gimbalPitch()->setRawValue(missionFlightStatus.gimbalPitch);
+        if (!qIsNaN(_flightStatusGimbalPitch) && !QGC::fuzzyCompare(_cameraSection->gimbalPitch()->rawValue().toDouble(), _flightStatusGimbalPitch)) {
+            _cameraSection->gimbalPitch()->setRawValue(_flightStatusGimbalPitch);
         }
     }
 }
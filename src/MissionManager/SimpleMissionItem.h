@@ -77,12 +77,15 @@ public:
     bool            showLoiterRadius    (void) const;
     double          loiterRadius        (void) const;
 
-    CameraSection*  cameraSection       (void) { return _cameraSection; }
-    SpeedSection*   speedSection        (void) { return _speedSection; }
+    // The optional sections and the editing ui models are only needed once the item is edited. To keep large
+    // missions light they are created on first use.
 
-    QmlObjectListModel* textFieldFacts  (void) { return &_textFieldFacts; }
-    QmlObjectListModel* nanFacts        (void) { return &_nanFacts; }
-    QmlObjectListModel* comboboxFacts   (void) { return &_comboboxFacts; }
+    CameraSection*  cameraSection       (void) { _createOptionalSections(); return _cameraSection; }
+    SpeedSection*   speedSection        (void) { _createOptionalSections(); return _speedSection; }
+
+    QmlObjectListModel* textFieldFacts  (void) { _createEditFacts(); return _textFieldFacts; }
+    QmlObjectListModel* nanFacts        (void) { _createEditFacts(); return _nanFacts; }
+    QmlObjectListModel* comboboxFacts   (void) { _createEditFacts(); return _comboboxFacts; }
 
     void setRawEdit(bool rawEdit);
     void setAltitudeMode(QGroundControlQmlGlobal::AltMode altitudeMode);
@@ -170,6 +173,10 @@ private:
     void _connectSignals        (void);
     void _setupMetaData         (void);
     void _updateOptionalSections(void);
+    void _createOptionalSections(void);
+    void _releaseOptionalSections(void);
+    void _updateSectionDefaults (void);
+    void _createEditFacts       (void);
     void _rebuildNaNFacts       (void);
     void _rebuildComboBoxFacts  (void);
 
@@ -190,9 +197,15 @@ private:
     Fact                                _altitudeFact;
     Fact                                _amslAltAboveTerrainFact;
 
-    QmlObjectListModel  _textFieldFacts;
-    QmlObjectListModel  _nanFacts;
-    QmlObjectListModel  _comboboxFacts;
+    QmlObjectListModel* _textFieldFacts =   nullptr;    ///< nullptr until the editing ui is requested
+    QmlObjectListModel* _nanFacts =         nullptr;
+    QmlObjectListModel* _comboboxFacts =    nullptr;
+    FactMetaData*       _rgParamMetaData[7] = { };
+
+    // Last values from setMissionFlightStatus, used to set up sections which are created later
+    double _flightStatusVehicleSpeed =  qQNaN();
+    double _flightStatusGimbalYaw =     qQNaN();
+    double _flightStatusGimbalPitch =   qQNaN();
     
     static FactMetaData*    _altitudeMetaData;
     static FactMetaData*    _commandMetaData;
@@ -201,14 +214,6 @@ private:
     static FactMetaData*    _latitudeMetaData;
     static FactMetaData*    _longitudeMetaData;
 
-    FactMetaData    _param1MetaData;
-    FactMetaData    _param2MetaData;
-    FactMetaData    _param3MetaData;
-    FactMetaData    _param4MetaData;
-    FactMetaData    _param5MetaData;
-    FactMetaData    _param6MetaData;
-    FactMetaData    _param7MetaData;
-
     static const char* _jsonAltitudeModeKey;
     static const char* _jsonAltitudeKey;
     static const char* _jsonAMSLAltAboveTerrainKey;
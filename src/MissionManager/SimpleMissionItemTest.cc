@@ -395,3 +395,36 @@ void SimpleMissionItemTest::_testAltitudePropogation(void)
     QCOMPARE(_simpleItem->altitude()->rawValue().toDouble(), _simpleItem->missionItem().param7());
     QCOMPARE(_simpleItem->missionItem().frame(), MAV_FRAME_GLOBAL);
 }
+
+void SimpleMissionItemTest::_testOnDemandEditing(void)
+{
+    // Sections and editing ui models should not exist until they are asked for
+    QCOMPARE(_simpleItem->findChildren<CameraSection*>(QString(), Qt::FindDirectChildrenOnly).count(), 0);
+    QCOMPARE(_simpleItem->findChildren<SpeedSection*>(QString(), Qt::FindDirectChildrenOnly).count(), 0);
+    QCOMPARE(_simpleItem->findChildren<QmlObjectListModel*>(QString(), Qt::FindDirectChildrenOnly).count(), 0);
+
+    // Values used by the mission stats come straight from the mission item
+    QVERIFY(qIsNaN(_simpleItem->specifiedFlightSpeed()));
+    QVERIFY(qIsNaN(_simpleItem->specifiedGimbalYaw()));
+    QCOMPARE(_simpleItem->lastSequenceNumber(), _simpleItem->sequenceNumber());
+    QList<MissionItem*> items;
+    _simpleItem->appendMissionItems(items, this);
+    QCOMPARE(items.count(), 1);
+    qDeleteAll(items);
+    QCOMPARE(_simpleItem->findChildren<CameraSection*>(QString(), Qt::FindDirectChildrenOnly).count(), 0);
+
+    // Asking for them creates them, without dirtying the item
+    QVERIFY(_simpleItem->cameraSection());
+    QCOMPARE(_simpleItem->cameraSection()->available(), true);
+    QCOMPARE(_simpleItem->speedSection()->available(), true);
+    QCOMPARE(_simpleItem->findChildren<CameraSection*>(QString(), Qt::FindDirectChildrenOnly).count(), 1);
+    QVERIFY(_simpleItem->textFieldFacts()->count() > 0);
+    QCOMPARE(_simpleItem->findChildren<QmlObjectListModel*>(QString(), Qt::FindDirectChildrenOnly).count(), 3);
+    QCOMPARE(_simpleItem->dirty(), false);
+
+    // Command changes still rebuild the editing ui and sections
+    _simpleItem->setCommand(MAV_CMD_NAV_LOITER_TIME);
+    QCOMPARE(_simpleItem->cameraSection()->available(), false);
+    QCOMPARE(_simpleItem->speedSection()->available(), false);
+    QVERIFY(_simpleItem->textFieldFacts()->count() + _simpleItem->nanFacts()->count() + _simpleItem->comboboxFacts()->count() > 0);
+}
@@ -52,6 +52,7 @@ private slots:
     void _testCameraSection         (void);
     void _testSpeedSection          (void);
     void _testAltitudePropogation   (void);
+    void _testOnDemandEditing       (void);
 
 private:
     enum {
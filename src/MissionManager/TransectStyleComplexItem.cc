@@ -46,7 +46,7 @@ const char* TransectStyleComplexItem::_jsonTerrainFollowKeyDeprecated       = "F
 TransectStyleComplexItem::TransectStyleComplexItem(PlanMasterController* masterController, bool flyView, QString settingsGroup)
     : ComplexMissionItem                (masterController, flyView)
     , _cameraCalc                       (masterController, settingsGroup)
-    , _metaDataMap                      (FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/TransectStyle.SettingsGroup.json"), this))
+    , _metaDataMap                      (FactMetaData::sharedMapFromJsonFile(QStringLiteral(":/json/TransectStyle.SettingsGroup.json"), settingsGroup))
     , _turnAroundDistanceFact           (settingsGroup, _metaDataMap[_controllerVehicle->multiRotor() ? turnAroundDistanceMultiRotorName : turnAroundDistanceName])
     , _cameraTriggerInTurnAroundFact    (settingsGroup, _metaDataMap[cameraTriggerInTurnAroundName])
     , _hoverAndCaptureFact              (settingsGroup, _metaDataMap[hoverAndCaptureName])
@@ -55,9 +55,9 @@ TransectStyleComplexItem::TransectStyleComplexItem(PlanMasterController* masterC
     , _terrainAdjustMaxClimbRateFact    (settingsGroup, _metaDataMap[terrainAdjustMaxClimbRateName])
     , _terrainAdjustMaxDescentRateFact  (settingsGroup, _metaDataMap[terrainAdjustMaxDescentRateName])
 {
-    _terrainPolyPathQueryTimer.setInterval(qgcApp()->runningUnitTests() ? 10 : _terrainQueryTimeoutMsecs);
-    _terrainPolyPathQueryTimer.setSingleShot(true);
-    connect(&_terrainPolyPathQueryTimer, &QTimer::timeout, this, &TransectStyleComplexItem::_reallyQueryTransectsPathHeightInfo);
+    _terrainClearanceTimer.setInterval(qgcApp()->runningUnitTests() ? 10 : _terrainQueryTimeoutMsecs);
+    _terrainClearanceTimer.setSingleShot(true);
+    connect(&_terrainClearanceTimer,    &QTimer::timeout,                                   this, &TransectStyleComplexItem::_reallyQueryTransectsPathHeightInfo);
 
     // The follow is used to compress multiple recalc calls in a row to into a single call.
     connect(this, &TransectStyleComplexItem::_updateFlightPathSegmentsSignal, this, &TransectStyleComplexItem::_updateFlightPathSegmentsDontCallDirectly,   Qt::QueuedConnection);
@@ -411,6 +411,9 @@ void TransectStyleComplexItem::_rebuildTransects(void)
     _rgPathHeightInfo.clear();
     _rgFlightPathCoordInfo.clear();
 
+    // Terrain heights for the previous transects are no longer needed
+    _missionController->cancelTransectTerrainHeights(this);
+
     _rebuildTransectsPhase1();
 
     _minAMSLAltitude = _maxAMSLAltitude = qQNaN();
@@ -574,7 +577,7 @@ void TransectStyleComplexItem::_queryTransectsPathHeightInfo(void)
     if (_transects.count()) {
         // We don't actually send the query until this timer times out. This way we only send
         // the latest request if we get a bunch in a row.
-        _terrainPolyPathQueryTimer.start();
+        _terrainClearanceTimer.start();
     }
 }
 
@@ -583,16 +586,13 @@ void TransectStyleComplexItem::_reallyQueryTransectsPathHeightInfo(void)
     qCDebug(TransectStyleComplexItemLog) << "_reallyQueryTransectsPathHeightInfo";
 
     // Clear any previous queries
-    if (_currentTerrainPolyPathQuery) {
-        disconnect(_currentTerrainPolyPathQuery);
-        _currentTerrainPolyPathQuery = nullptr;
-    }
+    _missionController->cancelTransectTerrainHeights(this);
     if (_currentTerrainAtCoordinateQuery) {
         disconnect(_currentTerrainAtCoordinateQuery);
         _currentTerrainAtCoordinateQuery = nullptr;
     }
 
-    // Append all transects into a single PolyPath query
+    // Append all transects into a single path
     QList<QGeoCoordinate> transectPoints;
     for (const QList<CoordInfo_t>& transect: _transects) {
         for (const CoordInfo_t& coordInfo: transect) {
@@ -601,12 +601,23 @@ void TransectStyleComplexItem::_reallyQueryTransectsPathHeightInfo(void)
     }
 
     if (transectPoints.count() > 1) {
-        _currentTerrainPolyPathQuery = new TerrainPolyPathQuery(true /* autoDelete */);
-        connect(_currentTerrainPolyPathQuery, &TerrainPolyPathQuery::terrainDataReceived, this, &TransectStyleComplexItem::_polyPathTerrainData);
-        _currentTerrainPolyPathQuery->requestData(transectPoints);
+        // Only the terrain heights are needed, the altitudes are calculated from them. They are resolved in the same
+        // pass as the rest of the plan.
+        QList<TerrainClearanceEngine::Segment_t> segments;
+        for (int i=0; i<transectPoints.count() - 1; i++) {
+            TerrainClearanceEngine::Segment_t segment = { transectPoints[i], transectPoints[i + 1], qQNaN(), qQNaN(), 0, 0 };
+            segments.append(segment);
+        }
+
+        _missionController->requestTransectTerrainHeights(this, segments);
     }
 }
 
+void TransectStyleComplexItem::transectTerrainHeightsReceived(bool success, const QList<TerrainPathQuery::PathHeightInfo_t>& rgPathHeightInfo)
+{
+    _polyPathTerrainData(success, rgPathHeightInfo);
+}
+
 void TransectStyleComplexItem::_queryMissionItemCoordHeights(void)
 {
     qCDebug(TransectStyleComplexItemLog) << "_queryMissionItemCoordHeights";
@@ -616,8 +627,7 @@ void TransectStyleComplexItem::_queryMissionItemCoordHeights(void)
     if (_currentTerrainAtCoordinateQuery) {
         qCWarning(TransectStyleComplexItemLog) << "Internal error: _queryMissionItemCoordHeights called multiple times";
         // We are already waiting on another query. We don't care about those results any more.
-        disconnect(_currentTerrainPolyPathQuery);
-        _currentTerrainPolyPathQuery = nullptr;
+        _missionController->cancelTransectTerrainHeights(this);
     }
 
     // We need terrain heights below each mission item we fly through which is terrain frame
@@ -651,7 +661,6 @@ void TransectStyleComplexItem::_polyPathTerrainData(bool success, const QList<Te
         _adjustForAvailableTerrainData();
         emit readyForSaveStateChanged();
     }
-    _currentTerrainPolyPathQuery = nullptr;
 }
 
 void TransectStyleComplexItem::_missionItemCoordTerrainData(bool success, QList<double> heights)
@@ -667,7 +676,6 @@ void TransectStyleComplexItem::_missionItemCoordTerrainData(bool success, QList<
         _adjustForAvailableTerrainData();
         emit readyForSaveStateChanged();
     }
-    _currentTerrainPolyPathQuery = nullptr;
 }
 
 TransectStyleComplexItem::ReadyForSaveState TransectStyleComplexItem::readyForSaveState(void) const
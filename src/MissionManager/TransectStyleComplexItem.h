@@ -110,6 +110,9 @@ public:
     double              minAMSLAltitude             (void) const final;
     double              maxAMSLAltitude             (void) const final;
 
+    /// Called by MissionController with the terrain heights requested through MissionController::requestTransectTerrainHeights
+    void transectTerrainHeightsReceived(bool success, const QList<TerrainPathQuery::PathHeightInfo_t>& rgPathHeightInfo);
+
     static const char* turnAroundDistanceName;
     static const char* turnAroundDistanceMultiRotorName;
     static const char* cameraTriggerInTurnAroundName;
@@ -240,9 +243,8 @@ private:
     int     _maxPathHeight                                                  (const TerrainPathQuery::PathHeightInfo_t& pathHeightInfo, int fromIndex, int toIndex, double& maxHeight);
     BuildMissionItemsState_t _buildMissionItemsState                        (void) const;
 
-    TerrainPolyPathQuery*       _currentTerrainPolyPathQuery        = nullptr;
     TerrainAtCoordinateQuery*   _currentTerrainAtCoordinateQuery    = nullptr;
-    QTimer                      _terrainPolyPathQueryTimer;
+    QTimer                      _terrainClearanceTimer;
 
     // Deprecated json keys
     static const char* _jsonTerrainFollowKeyDeprecated;
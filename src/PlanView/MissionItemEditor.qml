@@ -279,6 +279,7 @@ Rectangle {
         anchors.left:       parent.left
         anchors.top:        topRowLayout.bottom
         source:             missionItem.editorQml
+        active:             _currentItem
         visible:            _currentItem
 
         property var    masterController:   _masterController
@@ -15,6 +15,25 @@
 
 #include <QtGlobal>
 
+#include <string.h>
+
+#if defined(Q_PROCESSOR_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#include <emmintrin.h>
+#include <smmintrin.h>
+#include <wmmintrin.h>
+#endif
+
+#if defined(Q_PROCESSOR_ARM_64) && (defined(__GNUC__) || defined(__clang__))
+#include <arm_acle.h>
+#if defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
 namespace QGC
 {
 
@@ -132,7 +151,8 @@ static const quint32 crctab[] =
     0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94, 0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
 };
 
-quint32 crc32(const quint8 *src, unsigned len, unsigned state)
+/// Byte at a time reference implementation. Every other variant below must produce identical results.
+quint32 crc32Reference(const quint8 *src, unsigned len, unsigned state)
 {
     for (unsigned i = 0; i < len; i++) {
         state = crctab[(state ^ src[i]) & 0xff] ^ (state >> 8);
@@ -140,6 +160,263 @@ quint32 crc32(const quint8 *src, unsigned len, unsigned state)
     return state;
 }
 
+namespace {
+
+/// Slicing-by-8 lookup tables: table[k][i] is the crc of byte i followed by k zero bytes
+struct Crc32SliceTables
+{
+    Crc32SliceTables()
+    {
+        for (int i = 0; i < 256; i++) {
+            table[0][i] = crctab[i];
+        }
+        for (int k = 1; k < 8; k++) {
+            for (int i = 0; i < 256; i++) {
+                table[k][i] = (table[k - 1][i] >> 8) ^ crctab[table[k - 1][i] & 0xff];
+            }
+        }
+    }
+
+    quint32 table[8][256];
+};
+
+const Crc32SliceTables& crc32SliceTables()
+{
+    static const Crc32SliceTables tables;
+    return tables;
+}
+
+typedef quint32 (*Crc32Function)(const quint8 *src, unsigned len, unsigned state);
+
+#if defined(Q_PROCESSOR_X86) && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#define QGC_CRC32_PCLMUL
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define QGC_CRC32_PCLMUL_TARGET
+#else
+#define QGC_CRC32_PCLMUL_TARGET __attribute__((target("pclmul,sse4.1")))
+#endif
+
+/// Carry-less multiply folding as described in Intel's "Fast CRC Computation for Generic Polynomials
+/// Using PCLMULQDQ Instruction" white paper, with the constants for the bit reflected 0x04C11DB7 polynomial.
+/// Requires len >= 64 and a multiple of 16.
+QGC_CRC32_PCLMUL_TARGET quint32 crc32PclmulBlocks(const quint8 *src, unsigned len, unsigned state)
+{
+    alignas(16) static const quint64 k1k2[] = { 0x0154442bd4, 0x01c6e41596 };
+    alignas(16) static const quint64 k3k4[] = { 0x01751997d0, 0x00ccaa009e };
+    alignas(16) static const quint64 k5k0[] = { 0x0163cd6124, 0x0000000000 };
+    alignas(16) static const quint64 poly[] = { 0x01db710641, 0x01f7011641 };
+
+    __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 0x00));
+    __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 0x10));
+    __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 0x20));
+    __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 0x30));
+    __m128i x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+    __m128i x5;
+
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(state)));
+    src += 64;
+    len -= 64;
+
+    // Fold four 128 bit lanes in parallel
+    while (len >= 64) {
+        __m128i x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        __m128i x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        __m128i x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 0x30)));
+
+        src += 64;
+        len -= 64;
+    }
+
+    // Fold the four lanes down to one
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+    const __m128i lanes[] = { x2, x3, x4 };
+    for (const __m128i& lane: lanes) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, lane), x5);
+    }
+
+    // Fold any remaining 16 byte blocks
+    while (len >= 16) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(src))), x5);
+        src += 16;
+        len -= 16;
+    }
+
+    // Fold 128 bits down to 64 bits
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+    x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), x0, 0x10);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask32), x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return static_cast<quint32>(_mm_extract_epi32(x1, 1));
+}
+
+quint32 crc32Pclmul(const quint8 *src, unsigned len, unsigned state)
+{
+    if (len >= 64) {
+        const unsigned blockLen = len & ~15u;
+        state = crc32PclmulBlocks(src, blockLen, state);
+        src += blockLen;
+        len -= blockLen;
+    }
+    return crc32SliceBy8(src, len, state);
+}
+
+bool crc32PclmulSupported()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 1)) && (info[2] & (1 << 19));
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+#endif
+}
+#endif
+
+#if defined(Q_PROCESSOR_ARM_64) && (defined(__GNUC__) || defined(__clang__)) && (defined(Q_OS_LINUX) || defined(Q_OS_ANDROID) || defined(Q_OS_MACOS) || defined(Q_OS_IOS))
+#define QGC_CRC32_ARMV8
+
+#if defined(__clang__)
+#define QGC_CRC32_ARMV8_TARGET __attribute__((target("crc")))
+#else
+#define QGC_CRC32_ARMV8_TARGET __attribute__((target("+crc")))
+#endif
+
+/// The ARMv8 CRC32 instructions use the same reflected polynomial without pre/post inversion
+QGC_CRC32_ARMV8_TARGET quint32 crc32Armv8(const quint8 *src, unsigned len, unsigned state)
+{
+    while (len && (reinterpret_cast<quintptr>(src) & 7)) {
+        state = __crc32b(state, *src++);
+        len--;
+    }
+    while (len >= 8) {
+        quint64 value;
+        memcpy(&value, src, sizeof(value));
+        state = __crc32d(state, value);
+        src += 8;
+        len -= 8;
+    }
+    while (len--) {
+        state = __crc32b(state, *src++);
+    }
+    return state;
+}
+
+bool crc32Armv8Supported()
+{
+#if defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)
+    return getauxval(AT_HWCAP) & HWCAP_CRC32;
+#else
+    // All Apple arm64 cpus implement the CRC32 extension
+    return true;
+#endif
+}
+#endif
+
+struct Crc32Implementation
+{
+    Crc32Implementation()
+        : function  (crc32SliceBy8)
+        , name      ("slice-by-8")
+    {
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+        function    = crc32Reference;
+        name        = "bytewise";
+#endif
+#ifdef QGC_CRC32_PCLMUL
+        if (crc32PclmulSupported()) {
+            function    = crc32Pclmul;
+            name        = "pclmulqdq";
+        }
+#endif
+#ifdef QGC_CRC32_ARMV8
+        if (crc32Armv8Supported()) {
+            function    = crc32Armv8;
+            name        = "armv8-crc32";
+        }
+#endif
+    }
+
+    Crc32Function   function;
+    const char*     name;
+};
+
+const Crc32Implementation& crc32Implementation()
+{
+    static const Crc32Implementation implementation;
+    return implementation;
+}
+
+}
+
+quint32 crc32SliceBy8(const quint8 *src, unsigned len, unsigned state)
+{
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    const auto& table = crc32SliceTables().table;
+
+    while (len && (reinterpret_cast<quintptr>(src) & 3)) {
+        state = table[0][(state ^ *src++) & 0xff] ^ (state >> 8);
+        len--;
+    }
+    while (len >= 8) {
+        quint32 low;
+        quint32 high;
+        memcpy(&low, src, sizeof(low));
+        memcpy(&high, src + 4, sizeof(high));
+        low ^= state;
+        state = table[7][low & 0xff]            ^ table[6][(low >> 8) & 0xff]
+              ^ table[5][(low >> 16) & 0xff]    ^ table[4][low >> 24]
+              ^ table[3][high & 0xff]           ^ table[2][(high >> 8) & 0xff]
+              ^ table[1][(high >> 16) & 0xff]   ^ table[0][high >> 24];
+        src += 8;
+        len -= 8;
+    }
+    for (unsigned i = 0; i < len; i++) {
+        state = table[0][(state ^ src[i]) & 0xff] ^ (state >> 8);
+    }
+    return state;
+#else
+    return crc32Reference(src, len, state);
+#endif
+}
+
+quint32 crc32(const quint8 *src, unsigned len, unsigned state)
+{
+    return crc32Implementation().function(src, len, state);
+}
+
+const char* crc32ImplementationName()
+{
+    return crc32Implementation().name;
+}
+
 bool fuzzyCompare(double value1, double value2)
 {
     if (qIsNaN(value1) && qIsNaN(value2)) {
@@ -52,6 +52,14 @@ public:
     using QThread::usleep;
 };
 
+/// Calculates the crc32 (reflected 0x04C11DB7 polynomial, no pre/post inversion) of the buffer, continuing from state.
+/// Dispatches to the fastest implementation supported by the cpu.
 quint32 crc32(const quint8 *src, unsigned len, unsigned state);
+/// Byte at a time crc32. Same results as crc32, used to cross check the faster implementations.
+quint32 crc32Reference(const quint8 *src, unsigned len, unsigned state);
+/// Portable slicing-by-8 crc32. Same results as crc32.
+quint32 crc32SliceBy8(const quint8 *src, unsigned len, unsigned state);
+/// Returns the name of the implementation crc32 dispatches to
+const char* crc32ImplementationName();
 
 }
@@ -63,6 +63,7 @@
 #include "FlightMapSettings.h"
 #include "FlightPathSegment.h"
 #include "PlanMasterController.h"
+#include "FleetPlanUploader.h"
 #include "VideoManager.h"
 #include "VideoReceiver.h"
 #include "LogDownloadController.h"
@@ -86,6 +87,7 @@
 #include "VisualMissionItem.h"
 #include "EditPositionDialogController.h"
 #include "FactValueSliderListModel.h"
+#include "FactValueNotifier.h"
 #include "ShapeFileHelper.h"
 #include "QGCFileDownload.h"
 #include "FirmwareImage.h"
@@ -468,6 +470,7 @@ void QGCApplication::_initCommon()
     qmlRegisterUncreatableType<MissionController>       (kQGCControllers,                   1, 0, "MissionController",          kRefOnly);
     qmlRegisterUncreatableType<GeoFenceController>      (kQGCControllers,                   1, 0, "GeoFenceController",         kRefOnly);
     qmlRegisterUncreatableType<RallyPointController>    (kQGCControllers,                   1, 0, "RallyPointController",       kRefOnly);
+    qmlRegisterUncreatableType<FleetPlanUploader>       (kQGCControllers,                   1, 0, "FleetPlanUploader",          kRefOnly);
 
     qmlRegisterUncreatableType<MissionItem>         (kQGroundControl,                       1, 0, "MissionItem",                kRefOnly);
     qmlRegisterUncreatableType<VisualMissionItem>   (kQGroundControl,                       1, 0, "VisualMissionItem",          kRefOnly);
@@ -567,6 +570,9 @@ bool QGCApplication::_initForNormalAppBoot()
                 QQuickWindow::BeforeSynchronizingStage);
     }
 
+    // Telemetry value changes go out to the ui in step with its frames
+    FactValueNotifier::instance()->setWindow(rootWindow);
+
     // Safe to show popup error messages now that main window is created
     UASMessageHandler* msgHandler = qgcApp()->toolbox()->uasMessageHandler();
     if (msgHandler) {
@@ -17,9 +17,10 @@
 #include "SettingsManager.h"
 #include "AppSettings.h"
 
-#include <QStringListModel>
 #include <QtConcurrent>
 #include <QTextStream>
+#include <QFileInfo>
+#include <QDir>
 
 Q_GLOBAL_STATIC(AppLogModel, debug_model)
 
@@ -32,7 +33,7 @@ static void msgHandler(QtMsgType type, const QMessageLogContext &context, const
 
     // Avoid recursion
     if (!QString(context.category).startsWith("qt.quick")) {
-        debug_model()->log(output);
+        AppLogModel::log(output);
     }
 
     if (old_handler != nullptr) {
@@ -54,19 +55,49 @@ AppLogModel *AppMessages::getModel()
     return debug_model;
 }
 
-AppLogModel::AppLogModel() : QStringListModel()
+AppLogModel::AppLogModel()
+    : QAbstractListModel()
+    , _ring(maxLines)
 {
-#ifdef __mobile__
-    Qt::ConnectionType contype = Qt::QueuedConnection;
-#else
-    Qt::ConnectionType contype = Qt::AutoConnection;
-#endif
-    connect(this, &AppLogModel::emitLog, this, &AppLogModel::threadsafeLog, contype);
+    _flushTimer.setSingleShot(true);
+    _flushTimer.setInterval(_flushIntervalMsecs);
+    connect(&_flushTimer, &QTimer::timeout, this, &AppLogModel::_flushPending);
+}
+
+AppLogModel::~AppLogModel()
+{
+    if (_writer) {
+        _writer->stop();
+        delete _writer;
+    }
+}
+
+int AppLogModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : _count;
+}
+
+QVariant AppLogModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= _count || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    return _ring[(_head + index.row()) % maxLines];
+}
+
+QStringList AppLogModel::_lines() const
+{
+    QStringList lines;
+    lines.reserve(_count);
+    for (int i = 0; i < _count; i++) {
+        lines.append(_ring[(_head + i) % maxLines]);
+    }
+    return lines;
 }
 
 void AppLogModel::writeMessages(const QString dest_file)
 {
-    const QString writebuffer(stringList().join('\n').append('\n'));
+    const QString writebuffer(_lines().join('\n').append('\n'));
 
     QtConcurrent::run([dest_file, writebuffer] {
         emit debug_model()->writeStarted();
@@ -85,34 +116,214 @@ void AppLogModel::writeMessages(const QString dest_file)
 
 void AppLogModel::log(const QString message)
 {
-    emit debug_model()->emitLog(message);
+    // The model is gone during static destruction
+    AppLogModel* model = debug_model();
+    if (model) {
+        model->_enqueue(message);
+    }
+}
+
+void AppLogModel::_enqueue(const QString& message)
+{
+    bool scheduleFlush = false;
+    {
+        QMutexLocker lock(&_pendingMutex);
+        _pending.append(message);
+        if (!_flushQueued) {
+            _flushQueued = true;
+            scheduleFlush = true;
+        }
+    }
+    // Only the first line of a batch needs to wake up the gui thread
+    if (scheduleFlush) {
+        QMetaObject::invokeMethod(this, &AppLogModel::_scheduleFlush, Qt::QueuedConnection);
+    }
+}
+
+void AppLogModel::_scheduleFlush()
+{
+    if (!_flushTimer.isActive()) {
+        _flushTimer.start();
+    }
 }
 
-void AppLogModel::threadsafeLog(const QString message)
+void AppLogModel::_flushPending()
 {
-    const int line = rowCount();
-    insertRows(line, 1);
-    setData(index(line), message, Qt::DisplayRole);
+    QStringList lines;
+    {
+        QMutexLocker lock(&_pendingMutex);
+        lines.swap(_pending);
+        _flushQueued = false;
+    }
+    if (lines.isEmpty()) {
+        return;
+    }
+
+    // Only the newest maxLines of this batch can be shown
+    const int capacity      = maxLines;
+    const int firstShown    = qMax(0, lines.count() - capacity);
+    const int newCount      = lines.count() - firstShown;
+    const int removeCount   = qMin(_count, qMax(0, _count + newCount - capacity));
+
+    if (removeCount > 0) {
+        beginRemoveRows(QModelIndex(), 0, removeCount - 1);
+        for (int i = 0; i < removeCount; i++) {
+            _ring[(_head + i) % maxLines].clear();
+        }
+        _head = (_head + removeCount) % maxLines;
+        _count -= removeCount;
+        endRemoveRows();
+    }
 
-    if (qgcApp() && qgcApp()->logOutput() && _logFile.fileName().isEmpty()) {
-        qDebug() << _logFile.fileName().isEmpty() << qgcApp()->logOutput();
+    beginInsertRows(QModelIndex(), _count, _count + newCount - 1);
+    for (int i = firstShown; i < lines.count(); i++) {
+        _ring[(_head + _count) % maxLines] = lines[i];
+        _count++;
+    }
+    endInsertRows();
+
+    _updateLogFile(lines);
+}
+
+void AppLogModel::_updateLogFile(const QStringList& lines)
+{
+    if (!_writer && !_writerFailed && qgcApp() && qgcApp()->logOutput()) {
         QGCToolbox* toolbox = qgcApp()->toolbox();
         // Be careful of toolbox not being open yet
         if (toolbox) {
-            QString saveDirPath = qgcApp()->toolbox()->settingsManager()->appSettings()->crashSavePath();
+            QString saveDirPath = toolbox->settingsManager()->appSettings()->crashSavePath();
             QDir saveDir(saveDirPath);
             QString saveFilePath = saveDir.absoluteFilePath(QStringLiteral("QGCConsole.log"));
 
-            _logFile.setFileName(saveFilePath);
-            if (!_logFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-                qgcApp()->showAppMessage(tr("Open console log output file failed %1 : %2").arg(_logFile.fileName()).arg(_logFile.errorString()));
+            _writer = new AppLogWriter(saveFilePath);
+            if (_writer->open()) {
+                _writer->start(QThread::LowPriority);
+            } else {
+                qgcApp()->showAppMessage(tr("Open console log output file failed %1 : %2").arg(saveFilePath).arg(_writer->errorString()));
+                delete _writer;
+                _writer = nullptr;
+                _writerFailed = true;
             }
         }
     }
 
-    if (_logFile.isOpen()) {
-        QTextStream out(&_logFile);
-        out << message << "\n";
-        _logFile.flush();
+    if (_writer) {
+        if (_writer->error()) {
+            qgcApp()->showAppMessage(tr("Console log output failed: %1").arg(_writer->errorString()));
+            _writer->stop();
+            delete _writer;
+            _writer = nullptr;
+            _writerFailed = true;
+        } else {
+            _writer->write(lines);
+        }
+    }
+}
+
+AppLogWriter::AppLogWriter(const QString& filePath)
+    : _file     (filePath)
+    , _fileSize (0)
+    , _stop     (false)
+    , _error    (false)
+{
+    setObjectName("AppLogWriter");
+}
+
+AppLogWriter::~AppLogWriter()
+{
+    stop();
+}
+
+bool AppLogWriter::open()
+{
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QMutexLocker lock(&_mutex);
+        _errorString = _file.errorString();
+        return false;
+    }
+    _fileSize = 0;
+    return true;
+}
+
+void AppLogWriter::write(const QStringList& lines)
+{
+    QMutexLocker lock(&_mutex);
+    _queue.append(lines);
+    _queueCondition.wakeOne();
+}
+
+void AppLogWriter::stop()
+{
+    {
+        QMutexLocker lock(&_mutex);
+        _stop = true;
+        _queueCondition.wakeOne();
+    }
+    wait();
+}
+
+QString AppLogWriter::errorString()
+{
+    QMutexLocker lock(&_mutex);
+    return _errorString;
+}
+
+QString AppLogWriter::_rotatedPath(int index) const
+{
+    const QFileInfo fileInfo(_file.fileName());
+    return fileInfo.dir().absoluteFilePath(QStringLiteral("%1.%2.%3").arg(fileInfo.completeBaseName()).arg(index).arg(fileInfo.suffix()));
+}
+
+void AppLogWriter::_rotate()
+{
+    _file.close();
+
+    QFile::remove(_rotatedPath(_maxFiles - 1));
+    for (int i = _maxFiles - 2; i >= 1; i--) {
+        QFile::rename(_rotatedPath(i), _rotatedPath(i + 1));
+    }
+    QFile::rename(_file.fileName(), _rotatedPath(1));
+
+    if (!open()) {
+        _error = true;
+    }
+}
+
+void AppLogWriter::run()
+{
+    while (true) {
+        QStringList lines;
+        {
+            QMutexLocker lock(&_mutex);
+            while (_queue.isEmpty() && !_stop) {
+                _queueCondition.wait(&_mutex);
+            }
+            if (_queue.isEmpty()) {
+                break;
+            }
+            lines.swap(_queue);
+        }
+        if (_error) {
+            continue;
+        }
+
+        // Everything which queued up while we were writing goes out in a single write and flush
+        const QByteArray batch = lines.join('\n').append('\n').toUtf8();
+        if (_fileSize > 0 && _fileSize + batch.length() > _maxFileSize) {
+            _rotate();
+            if (_error) {
+                continue;
+            }
+        }
+        if (_file.write(batch) != batch.length() || !_file.flush()) {
+            QMutexLocker lock(&_mutex);
+            _errorString = _file.errorString();
+            _error = true;
+        } else {
+            _fileSize += batch.length();
+        }
+    }
+    if (_file.isOpen()) {
+        _file.close();
     }
 }
@@ -11,32 +11,99 @@
 #pragma once
 
 #include <QObject>
-#include <QStringListModel>
+#include <QAbstractListModel>
 #include <QUrl>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QStringList>
+#include <QVector>
+#include <QTimer>
 #include <QFile>
 
+#include <atomic>
+
 // Hackish way to force only this translation unit to have public ctor access
 #ifndef _LOG_CTOR_ACCESS_
 #define _LOG_CTOR_ACCESS_ private
 #endif
 
-class AppLogModel : public QStringListModel
+/// Appends console log lines to a file on a background thread. The file is rotated once it reaches
+/// _maxFileSize, keeping up to _maxFiles files (QGCConsole.log, QGCConsole.1.log, ...).
+/// Must not use qDebug and friends itself since it is fed from the message handler.
+class AppLogWriter : public QThread
+{
+public:
+    AppLogWriter(const QString& filePath);
+    ~AppLogWriter();
+
+    bool    open        ();                                 ///< Must be called before starting the thread
+    void    write       (const QStringList& lines);
+    void    stop        ();                                 ///< Writes out all queued lines and waits for the thread to finish
+    bool    error       () const { return _error; }
+    QString errorString ();
+
+protected:
+    void    run         () final;
+
+private:
+    void    _rotate     ();
+    QString _rotatedPath(int index) const;
+
+    QFile               _file;
+    qint64              _fileSize;
+    QMutex              _mutex;
+    QWaitCondition      _queueCondition;
+    QStringList         _queue;
+    bool                _stop;
+    std::atomic<bool>   _error;
+    QString             _errorString;
+
+    static const qint64 _maxFileSize    = 10 * 1024 * 1024;
+    static const int    _maxFiles       = 5;
+};
+
+/// Holds the most recent _maxLines console log lines in a ring buffer. Lines may be logged from any
+/// thread and are added to the model in batches, at most once per frame.
+class AppLogModel : public QAbstractListModel
 {
     Q_OBJECT
 public:
+    ~AppLogModel();
+
     Q_INVOKABLE void writeMessages(const QString dest_file);
     static void log(const QString message);
 
+    // Overrides from QAbstractListModel
+    int         rowCount    (const QModelIndex& parent = QModelIndex()) const override;
+    QVariant    data        (const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    static const int maxLines = 10000;
+
 signals:
-    void emitLog(const QString message);
     void writeStarted();
     void writeFinished(bool success);
 
 private slots:
-    void threadsafeLog(const QString message);
+    void _scheduleFlush ();
+    void _flushPending  ();
 
 private:
-    QFile _logFile;
+    void        _enqueue        (const QString& message);
+    void        _updateLogFile  (const QStringList& lines);
+    QStringList _lines          () const;
+
+    QVector<QString>    _ring;                      ///< Fixed capacity storage, row 0 is at _head
+    int                 _head           = 0;
+    int                 _count          = 0;
+    QMutex              _pendingMutex;
+    QStringList         _pending;                   ///< Lines logged since the last flush, possibly from other threads
+    bool                _flushQueued    = false;    ///< A flush has been requested for the current _pending lines
+    QTimer              _flushTimer;
+    AppLogWriter*       _writer         = nullptr;
+    bool                _writerFailed   = false;
+
+    static const int    _flushIntervalMsecs = 16;   ///< Coalesce model updates to roughly once per frame
 
 _LOG_CTOR_ACCESS_:
     AppLogModel();
@@ -7,7 +7,7 @@
  *
  ****************************************************************************/
 
-import QtQuick                  2.3
+import QtQuick                  2.12
 import QtQuick.Controls         1.2
 import QtQuick.Controls.Styles  1.4
 import QtQuick.Dialogs          1.2
@@ -39,7 +39,8 @@ Item {
             Connections {
                 target: debugMessageModel
 
-                onDataChanged: {
+                // Rows arrive in batches of at most one per frame
+                onRowsInserted: {
                     // Keep the view in sync if the button is checked
                     if (loaded) {
                         if (followTail.checked) {
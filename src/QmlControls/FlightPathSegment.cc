@@ -36,6 +36,8 @@ void FlightPathSegment::setCoordinate1(const QGeoCoordinate &coordinate)
     if (_coord1 != coordinate) {
         _coord1 = coordinate;
         emit coordinate1Changed(_coord1);
+        // Heights along the old path are wrong now, whoever supplies the terrain data
+        clearTerrainData();
         _delayedTerrainPathQueryTimer.start();
         _updateTotalDistance();
     }
@@ -46,6 +48,7 @@ void FlightPathSegment::setCoordinate2(const QGeoCoordinate &coordinate)
     if (_coord2 != coordinate) {
         _coord2 = coordinate;
         emit coordinate2Changed(_coord2);
+        clearTerrainData();
         _delayedTerrainPathQueryTimer.start();
         _updateTotalDistance();
     }
@@ -88,13 +91,7 @@ void FlightPathSegment::_sendTerrainPathQuery(void)
             _currentTerrainPathQuery = nullptr;
         }
 
-        // Clear old terrain data
-        _amslTerrainHeights.clear();
-        _distanceBetween = 0;
-        _finalDistanceBetween = 0;
-        emit distanceBetweenChanged(0);
-        emit finalDistanceBetweenChanged(0);
-        emit amslTerrainHeightsChanged();
+        clearTerrainData();
 
         _currentTerrainPathQuery = new TerrainPathQuery(true /* autoDelete */);
         connect(_currentTerrainPathQuery, &TerrainPathQuery::terrainDataReceived, this, &FlightPathSegment::_terrainDataReceived);
@@ -105,29 +102,81 @@ void FlightPathSegment::_sendTerrainPathQuery(void)
 void FlightPathSegment::_terrainDataReceived(bool success, const TerrainPathQuery::PathHeightInfo_t& pathHeightInfo)
 {
     qCDebug(FlightPathSegmentLog) << this << "_terrainDataReceived" << success << pathHeightInfo.heights.count();
-    if (success) {
-        if (!QGC::fuzzyCompare(pathHeightInfo.distanceBetween, _distanceBetween)) {
-            _distanceBetween = pathHeightInfo.distanceBetween;
-            emit distanceBetweenChanged(_distanceBetween);
-        }
-        if (!QGC::fuzzyCompare(pathHeightInfo.finalDistanceBetween, _finalDistanceBetween)) {
-            _finalDistanceBetween = pathHeightInfo.finalDistanceBetween;
-            emit finalDistanceBetweenChanged(_finalDistanceBetween);
-        }
-
-        _amslTerrainHeights.clear();
-        for (const double& amslTerrainHeight: pathHeightInfo.heights) {
-            _amslTerrainHeights.append(amslTerrainHeight);
-        }
-        emit amslTerrainHeightsChanged();
-    }
 
     _currentTerrainPathQuery->deleteLater();
     _currentTerrainPathQuery = nullptr;
 
+    if (success) {
+        _setPathHeightInfo(pathHeightInfo);
+    }
     _updateTerrainCollision();
 }
 
+void FlightPathSegment::setTerrainClearance(const TerrainClearanceEngine::SegmentClearance_t& segmentClearance)
+{
+    _setPathHeightInfo(segmentClearance.pathHeightInfo);
+
+    // The altitudes may have changed since the request was sent, so collision is checked against the current ones
+    _updateTerrainCollision();
+}
+
+void FlightPathSegment::clearTerrainData(void)
+{
+    _pathHeightInfo = TerrainPathQuery::PathHeightInfo_t();
+    _amslTerrainHeights.clear();
+    _distanceBetween = 0;
+    _finalDistanceBetween = 0;
+    emit distanceBetweenChanged(0);
+    emit finalDistanceBetweenChanged(0);
+    emit amslTerrainHeightsChanged();
+
+    _setTerrainCollision(false);
+}
+
+void FlightPathSegment::_setPathHeightInfo(const TerrainPathQuery::PathHeightInfo_t& pathHeightInfo)
+{
+    if (!QGC::fuzzyCompare(pathHeightInfo.distanceBetween, _distanceBetween)) {
+        _distanceBetween = pathHeightInfo.distanceBetween;
+        emit distanceBetweenChanged(_distanceBetween);
+    }
+    if (!QGC::fuzzyCompare(pathHeightInfo.finalDistanceBetween, _finalDistanceBetween)) {
+        _finalDistanceBetween = pathHeightInfo.finalDistanceBetween;
+        emit finalDistanceBetweenChanged(_finalDistanceBetween);
+    }
+
+    _pathHeightInfo = pathHeightInfo;
+    _amslTerrainHeights.clear();
+    for (const double& amslTerrainHeight: pathHeightInfo.heights) {
+        _amslTerrainHeights.append(amslTerrainHeight);
+    }
+    emit amslTerrainHeightsChanged();
+}
+
+TerrainClearanceEngine::Segment_t FlightPathSegment::clearanceSegment(void) const
+{
+    TerrainClearanceEngine::Segment_t segment;
+
+    segment.coord1              = _coord1;
+    segment.coord2              = _coord2;
+    segment.ignoreStartMeters   = 0;
+    segment.ignoreEndMeters     = 0;
+    if (_segmentType == SegmentTypeTakeoff) {
+        segment.ignoreStartMeters = _collisionIgnoreMeters;
+    } else if (_segmentType == SegmentTypeLand) {
+        segment.ignoreEndMeters = _collisionIgnoreMeters;
+    }
+
+    // Terrain frame segments follow the terrain so there is no clearance to check
+    if (_segmentType == SegmentTypeTerrainFrame) {
+        segment.coord1AMSLAlt = segment.coord2AMSLAlt = qQNaN();
+    } else {
+        segment.coord1AMSLAlt = _coord1AMSLAlt;
+        segment.coord2AMSLAlt = _coord2AMSLAlt;
+    }
+
+    return segment;
+}
+
 void FlightPathSegment::_updateTotalDistance(void)
 {
     double newTotalDistance = 0;
@@ -143,41 +192,15 @@ void FlightPathSegment::_updateTotalDistance(void)
 
 void FlightPathSegment::_updateTerrainCollision(void)
 {
-    bool newTerrainCollision = false;
-
-    if (_segmentType != SegmentTypeTerrainFrame) {
-        double slope =      (_coord2AMSLAlt - _coord1AMSLAlt) / _totalDistance;
-        double yIntercept = _coord1AMSLAlt;
-
-        double x = 0;
-        for (int i=0; i<_amslTerrainHeights.count(); i++) {
-            bool ignoreCollision = false;
-            if (_segmentType == SegmentTypeTakeoff && x < _collisionIgnoreMeters) {
-                ignoreCollision = true;
-            } else if (_segmentType == SegmentTypeLand && x > _totalDistance - _collisionIgnoreMeters) {
-                ignoreCollision = true;
-            }
-
-            if (!ignoreCollision) {
-                double y = _amslTerrainHeights[i].value<double>();
-                if (y > (slope * x) + yIntercept) {
-                    newTerrainCollision = true;
-                    break;
-                }
-            }
-
-            if (i == _amslTerrainHeights.count() - 2) {
-                x += _finalDistanceBetween;
-            } else {
-                x += _distanceBetween;
-            }
-        }
-    }
+    _setTerrainCollision(TerrainClearanceEngine::minClearance(clearanceSegment(), _pathHeightInfo) < 0);
+}
 
-    qCDebug(FlightPathSegmentLog) << this << "_updateTerrainCollision new:old" << newTerrainCollision << _terrainCollision;
+void FlightPathSegment::_setTerrainCollision(bool terrainCollision)
+{
+    qCDebug(FlightPathSegmentLog) << this << "_setTerrainCollision new:old" << terrainCollision << _terrainCollision;
 
-    if (newTerrainCollision != _terrainCollision) {
-        _terrainCollision = newTerrainCollision;
+    if (terrainCollision != _terrainCollision) {
+        _terrainCollision = terrainCollision;
         emit terrainCollisionChanged(_terrainCollision);
     }
 }
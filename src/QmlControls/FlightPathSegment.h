@@ -60,6 +60,16 @@ public:
 
     void setSpecialVisual(bool specialVisual);
 
+    /// Sets the terrain heights computed by a TerrainClearanceEngine, used instead of the segment's own query.
+    /// Terrain collision is updated from these heights and the current altitudes.
+    void setTerrainClearance(const TerrainClearanceEngine::SegmentClearance_t& segmentClearance);
+
+    /// Drops the terrain heights, for example when they could not be obtained for the current coordinates
+    void clearTerrainData(void);
+
+    /// @return Segment description for a TerrainClearanceEngine request
+    TerrainClearanceEngine::Segment_t clearanceSegment(void) const;
+
 public slots:
     void setCoordinate1     (const QGeoCoordinate& coordinate);
     void setCoordinate2     (const QGeoCoordinate& coordinate);
@@ -85,6 +95,9 @@ private slots:
     void _updateTerrainCollision    (void);
 
 private:
+    void _setPathHeightInfo         (const TerrainPathQuery::PathHeightInfo_t& pathHeightInfo);
+    void _setTerrainCollision       (bool terrainCollision);
+
     QGeoCoordinate      _coord1;
     QGeoCoordinate      _coord2;
     double              _coord1AMSLAlt =                qQNaN();
@@ -95,6 +108,7 @@ private:
     QTimer              _delayedTerrainPathQueryTimer;
     TerrainPathQuery*   _currentTerrainPathQuery =      nullptr;
     QVariantList        _amslTerrainHeights;
+    TerrainPathQuery::PathHeightInfo_t _pathHeightInfo;
     double              _distanceBetween =              0;
     double              _finalDistanceBetween =         0;
     double              _totalDistance =                0;
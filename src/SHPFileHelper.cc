@@ -179,3 +179,152 @@ Error:
     }
     return errorString.isEmpty();
 }
+
+void SHPFileHelper::_readAttributes(DBFHandle dbfHandle, int record, ShapeFileHelper::Feature& feature)
+{
+    if (!dbfHandle || record >= DBFGetRecordCount(dbfHandle)) {
+        return;
+    }
+
+    int cFields = DBFGetFieldCount(dbfHandle);
+    for (int field=0; field<cFields; field++) {
+        char fieldName[XBASE_FLDNAME_LEN_READ + 1];
+        DBFFieldType fieldType = DBFGetFieldInfo(dbfHandle, field, fieldName, Q_NULLPTR /* pnWidth */, Q_NULLPTR /* pnDecimals */);
+        if (DBFIsAttributeNULL(dbfHandle, record, field)) {
+            continue;
+        }
+
+        QString     name = QString::fromUtf8(fieldName);
+        QVariant    value;
+        switch (fieldType) {
+        case FTInteger:
+            value = DBFReadIntegerAttribute(dbfHandle, record, field);
+            break;
+        case FTDouble:
+            value = DBFReadDoubleAttribute(dbfHandle, record, field);
+            break;
+        default:
+            value = QString::fromUtf8(DBFReadStringAttribute(dbfHandle, record, field)).trimmed();
+            break;
+        }
+        feature.attributes[name] = value;
+
+        if (feature.name.isEmpty() && name.compare(QStringLiteral("name"), Qt::CaseInsensitive) == 0) {
+            feature.name = value.toString();
+        }
+    }
+}
+
+bool SHPFileHelper::_readFeatures(const QString& shpFile, int featureIndex, bool loadGeometry, double simplifyToleranceMeters, const ShapeFileHelper::FeatureHandler_t& handler, QString& errorString)
+{
+    int         utmZone = 0;
+    bool        utmSouthernHemisphere;
+    DBFHandle   dbfHandle = Q_NULLPTR;
+
+    errorString.clear();
+
+    SHPHandle shpHandle = SHPFileHelper::_loadShape(shpFile, &utmZone, &utmSouthernHemisphere, errorString);
+    if (!errorString.isEmpty()) {
+        return false;
+    }
+
+    int cEntities, shapeType;
+    SHPGetInfo(shpHandle, &cEntities, &shapeType, Q_NULLPTR /* padfMinBound */, Q_NULLPTR /* padfMaxBound */);
+
+    ShapeFileHelper::ShapeType featureType = ShapeFileHelper::Error;
+    switch (shapeType) {
+    case SHPT_POLYGON:
+    case SHPT_POLYGONZ:
+    case SHPT_POLYGONM:
+        featureType = ShapeFileHelper::Polygon;
+        break;
+    case SHPT_ARC:
+    case SHPT_ARCZ:
+    case SHPT_ARCM:
+        featureType = ShapeFileHelper::Polyline;
+        break;
+    default:
+        errorString = QString(_errorPrefix).arg(tr("File does not contain polygons or polylines."));
+        SHPClose(shpHandle);
+        return false;
+    }
+
+    // Attributes are optional
+    QString dbfFilename = shpFile.left(shpFile.length() - 4) + QStringLiteral(".dbf");
+    if (QFile::exists(dbfFilename)) {
+        dbfHandle = DBFOpen(dbfFilename.toUtf8(), "rb");
+    }
+
+    int firstEntity = featureIndex == -1 ? 0 : featureIndex;
+    int lastEntity  = featureIndex == -1 ? cEntities - 1 : qMin(featureIndex, cEntities - 1);
+    if (featureIndex >= cEntities) {
+        errorString = QString(_errorPrefix).arg(tr("Feature %1 not found.").arg(featureIndex));
+    }
+
+    QList<QGeoCoordinate> coords;
+    for (int entity=firstEntity; errorString.isEmpty() && entity<=lastEntity; entity++) {
+        SHPObject* shpObject = SHPReadObject(shpHandle, entity);
+        if (!shpObject) {
+            errorString = QString(_errorPrefix).arg(tr("Unable to read feature %1.").arg(entity));
+            break;
+        }
+
+        ShapeFileHelper::Feature feature;
+        feature.index   = entity;
+        feature.type    = featureType;
+
+        // Only the first part (outer ring) of multi-part shapes is used
+        int cVertices = shpObject->nParts > 1 ? shpObject->panPartStart[1] : shpObject->nVertices;
+        coords.clear();
+        coords.reserve(cVertices);
+        for (int i=0; i<cVertices; i++) {
+            QGeoCoordinate coord;
+            if (!utmZone || !convertUTMToGeo(shpObject->padfX[i], shpObject->padfY[i], utmZone, utmSouthernHemisphere, coord)) {
+                coord.setLatitude(shpObject->padfY[i]);
+                coord.setLongitude(shpObject->padfX[i]);
+            }
+            coords.append(coord);
+        }
+        SHPDestroyObject(shpObject);
+
+        if (featureType == ShapeFileHelper::Polygon && coords.count() > 1 && coords.first() == coords.last()) {
+            // SHP rings repeat the first vertex to close the ring
+            coords.removeLast();
+        }
+
+        _readAttributes(dbfHandle, entity, feature);
+        if (feature.name.isEmpty()) {
+            feature.name = tr("Feature %1").arg(entity + 1);
+        }
+
+        ShapeFileHelper::finalizeFeature(feature, coords, loadGeometry, simplifyToleranceMeters);
+        if (!handler(feature)) {
+            break;
+        }
+    }
+
+    if (dbfHandle) {
+        DBFClose(dbfHandle);
+    }
+    SHPClose(shpHandle);
+
+    return errorString.isEmpty();
+}
+
+bool SHPFileHelper::loadFeaturesFromFile(const QString& shpFile, bool loadGeometry, double simplifyToleranceMeters, const ShapeFileHelper::FeatureHandler_t& handler, QString& errorString)
+{
+    return _readFeatures(shpFile, -1 /* all features */, loadGeometry, simplifyToleranceMeters, handler, errorString);
+}
+
+bool SHPFileHelper::loadFeatureFromFile(const QString& shpFile, int featureIndex, double simplifyToleranceMeters, ShapeFileHelper::Feature& feature, QString& errorString)
+{
+    if (featureIndex < 0) {
+        errorString = QString(_errorPrefix).arg(tr("Feature %1 not found.").arg(featureIndex));
+        return false;
+    }
+
+    return _readFeatures(shpFile, featureIndex, true /* loadGeometry */, simplifyToleranceMeters, [&](const ShapeFileHelper::Feature& loadedFeature) {
+        feature = loadedFeature;
+        return false;
+    }, errorString);
+}
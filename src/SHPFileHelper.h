@@ -28,7 +28,16 @@ public:
     static ShapeFileHelper::ShapeType determineShapeType(const QString& shpFile, QString& errorString);
     static bool loadPolygonFromFile(const QString& shpFile, QList<QGeoCoordinate>& vertices, QString& errorString);
 
+    /// Reads all polygon and polyline records from the file, see ShapeFileHelper::loadFeaturesFromFile. Records are read on
+    /// demand through the .shx index so only a single record is held in memory at a time.
+    static bool loadFeaturesFromFile(const QString& shpFile, bool loadGeometry, double simplifyToleranceMeters, const ShapeFileHelper::FeatureHandler_t& handler, QString& errorString);
+    static bool loadFeatureFromFile(const QString& shpFile, int featureIndex, double simplifyToleranceMeters, ShapeFileHelper::Feature& feature, QString& errorString);
+
 private:
+    /// @param featureIndex -1 for all features, otherwise only the specified record is read
+    static bool _readFeatures(const QString& shpFile, int featureIndex, bool loadGeometry, double simplifyToleranceMeters, const ShapeFileHelper::FeatureHandler_t& handler, QString& errorString);
+    static void _readAttributes(DBFHandle dbfHandle, int record, ShapeFileHelper::Feature& feature);
+
     static bool         _validateSHPFiles(const QString& shpFile, int* utmZone, bool* utmSouthernHemisphere, QString& errorString);
     static SHPHandle    _loadShape(const QString& shpFile, int* utmZone, bool* utmSouthernHemisphere, QString& errorString);
 
@@ -18,6 +18,7 @@
 
 const char* AppSettings::parameterFileExtension =   "params";
 const char* AppSettings::planFileExtension =        "plan";
+const char* AppSettings::binaryPlanFileExtension =  "planb";
 const char* AppSettings::missionFileExtension =     "mission";
 const char* AppSettings::waypointsFileExtension =   "waypoints";
 const char* AppSettings::fenceFileExtension =       "fence";
@@ -79,6 +79,7 @@ public:
     Q_PROPERTY(QString crashSavePath        READ crashSavePath      NOTIFY savePathsChanged)
 
     Q_PROPERTY(QString planFileExtension        MEMBER planFileExtension        CONSTANT)
+    Q_PROPERTY(QString binaryPlanFileExtension  MEMBER binaryPlanFileExtension  CONSTANT)
     Q_PROPERTY(QString missionFileExtension     MEMBER missionFileExtension     CONSTANT)
     Q_PROPERTY(QString waypointsFileExtension   MEMBER waypointsFileExtension   CONSTANT)
     Q_PROPERTY(QString parameterFileExtension   MEMBER parameterFileExtension   CONSTANT)
@@ -103,6 +104,7 @@ public:
     // Application wide file extensions
     static const char* parameterFileExtension;
     static const char* planFileExtension;
+    static const char* binaryPlanFileExtension;
     static const char* missionFileExtension;
     static const char* waypointsFileExtension;
     static const char* fenceFileExtension;
@@ -77,10 +77,14 @@ DECLARE_SETTINGGROUP(Video, "Video")
 #ifdef Q_OS_WIN
         VideoDecoderOptions::ForceVideoDecoderVAAPI,
         VideoDecoderOptions::ForceVideoDecoderVideoToolbox,
+        VideoDecoderOptions::ForceVideoDecoderV4L2,
+        VideoDecoderOptions::PreferHardwareVideoDecoder,
 #endif
 #ifdef Q_OS_MAC
         VideoDecoderOptions::ForceVideoDecoderDirectX3D,
         VideoDecoderOptions::ForceVideoDecoderVAAPI,
+        VideoDecoderOptions::ForceVideoDecoderV4L2,
+        VideoDecoderOptions::PreferHardwareVideoDecoder,
 #endif
     };
 
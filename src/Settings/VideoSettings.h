@@ -44,6 +44,8 @@ public:
         ForceVideoDecoderVAAPI,
         ForceVideoDecoderDirectX3D,
         ForceVideoDecoderVideoToolbox,
+        ForceVideoDecoderV4L2,
+        PreferHardwareVideoDecoder,     ///< VA-API, then V4L2, then software
     };
     Q_ENUM(VideoDecoderOptions)
 
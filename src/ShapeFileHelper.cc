@@ -11,8 +11,15 @@
 #include "AppSettings.h"
 #include "KMLHelper.h"
 #include "SHPFileHelper.h"
+#include "QGCGeo.h"
 
+#include <QDebug>
 #include <QFile>
+#include <QtMath>
+#include <QPointF>
+#include <QStack>
+
+#include <algorithm>
 
 const char* ShapeFileHelper::_errorPrefix = QT_TR_NOOP("Shape file load failed. %1");
 
@@ -97,6 +104,161 @@ bool ShapeFileHelper::loadPolylineFromFile(const QString& file, QList<QGeoCoordi
     return errorString.isEmpty();
 }
 
+bool ShapeFileHelper::loadFeaturesFromFile(const QString& file, bool loadGeometry, double simplifyToleranceMeters, const FeatureHandler_t& handler, QString& errorString)
+{
+    errorString.clear();
+
+    bool fileIsKML = _fileIsKML(file, errorString);
+    if (errorString.isEmpty()) {
+        if (fileIsKML) {
+            KMLHelper::loadFeaturesFromFile(file, loadGeometry, simplifyToleranceMeters, handler, errorString);
+        } else {
+            SHPFileHelper::loadFeaturesFromFile(file, loadGeometry, simplifyToleranceMeters, handler, errorString);
+        }
+    }
+
+    return errorString.isEmpty();
+}
+
+bool ShapeFileHelper::loadFeatureFromFile(const QString& file, int featureIndex, double simplifyToleranceMeters, Feature& feature, QString& errorString)
+{
+    errorString.clear();
+    feature = Feature();
+
+    bool fileIsKML = _fileIsKML(file, errorString);
+    if (errorString.isEmpty()) {
+        if (fileIsKML) {
+            KMLHelper::loadFeatureFromFile(file, featureIndex, simplifyToleranceMeters, feature, errorString);
+        } else {
+            SHPFileHelper::loadFeatureFromFile(file, featureIndex, simplifyToleranceMeters, feature, errorString);
+        }
+    }
+
+    return errorString.isEmpty();
+}
+
+QVariantList ShapeFileHelper::featureIndex(const QString& file)
+{
+    QVariantList    varFeatures;
+    QString         errorString;
+
+    loadFeaturesFromFile(file, false /* loadGeometry */, 0, [&](const Feature& feature) {
+        QVariantMap varFeature;
+        varFeature[QStringLiteral("index")]         = feature.index;
+        varFeature[QStringLiteral("type")]          = QVariant::fromValue(feature.type);
+        varFeature[QStringLiteral("name")]          = feature.name;
+        varFeature[QStringLiteral("vertexCount")]   = feature.vertexCount;
+        varFeature[QStringLiteral("attributes")]    = feature.attributes;
+        varFeatures.append(varFeature);
+        return true;
+    }, errorString);
+    if (!errorString.isEmpty()) {
+        qWarning() << "ShapeFileHelper::featureIndex" << errorString;
+    }
+
+    return varFeatures;
+}
+
+void ShapeFileHelper::finalizeFeature(Feature& feature, const QList<QGeoCoordinate>& coords, bool loadGeometry, double simplifyToleranceMeters)
+{
+    feature.vertexCount = coords.count();
+    feature.coords.clear();
+
+    if (coords.isEmpty()) {
+        feature.boundingBox = QGeoRectangle();
+        return;
+    }
+
+    double north    = coords[0].latitude();
+    double south    = north;
+    double east     = coords[0].longitude();
+    double west     = east;
+    for (const QGeoCoordinate& coord: coords) {
+        north   = qMax(north,   coord.latitude());
+        south   = qMin(south,   coord.latitude());
+        east    = qMax(east,    coord.longitude());
+        west    = qMin(west,    coord.longitude());
+    }
+    feature.boundingBox = QGeoRectangle(QGeoCoordinate(north, west), QGeoCoordinate(south, east));
+
+    if (loadGeometry) {
+        feature.coords = simplifyToleranceMeters > 0 ? simplifyCoordinates(coords, simplifyToleranceMeters) : coords;
+
+        if (feature.type == Polygon) {
+            // QGC wants clockwise winding
+            double sum = 0;
+            for (int i=0; i<feature.coords.count(); i++) {
+                const QGeoCoordinate& coord1 = feature.coords[i];
+                const QGeoCoordinate& coord2 = feature.coords[(i + 1) % feature.coords.count()];
+                sum += (coord2.longitude() - coord1.longitude()) * (coord2.latitude() + coord1.latitude());
+            }
+            if (sum < 0.0) {
+                std::reverse(feature.coords.begin(), feature.coords.end());
+            }
+        }
+    }
+}
+
+QList<QGeoCoordinate> ShapeFileHelper::simplifyCoordinates(const QList<QGeoCoordinate>& coords, double toleranceMeters)
+{
+    if (coords.count() < 3) {
+        return coords;
+    }
+
+    // Work in a local tangent plane around the first coordinate
+    QVector<QPointF> rgPoints;
+    rgPoints.reserve(coords.count());
+    for (const QGeoCoordinate& coord: coords) {
+        double north, east, down;
+        convertGeoToNed(coord, coords[0], &north, &east, &down);
+        rgPoints.append(QPointF(east, north));
+    }
+
+    QVector<bool> rgKeep(coords.count(), false);
+    rgKeep[0] = true;
+    rgKeep[coords.count() - 1] = true;
+
+    QStack<QPair<int, int>> segmentStack;
+    segmentStack.push(qMakePair(0, coords.count() - 1));
+    while (!segmentStack.isEmpty()) {
+        QPair<int, int> segment = segmentStack.pop();
+        const QPointF&  p1      = rgPoints[segment.first];
+        const QPointF&  p2      = rgPoints[segment.second];
+        QPointF         delta   = p2 - p1;
+        double          length  = qSqrt(delta.x() * delta.x() + delta.y() * delta.y());
+
+        double  maxDistance = -1;
+        int     maxIndex    = -1;
+        for (int i=segment.first+1; i<segment.second; i++) {
+            QPointF offset = rgPoints[i] - p1;
+            double distance;
+            if (length > 0) {
+                distance = qAbs(delta.x() * offset.y() - delta.y() * offset.x()) / length;
+            } else {
+                distance = qSqrt(offset.x() * offset.x() + offset.y() * offset.y());
+            }
+            if (distance > maxDistance) {
+                maxDistance = distance;
+                maxIndex    = i;
+            }
+        }
+
+        if (maxIndex != -1 && maxDistance > toleranceMeters) {
+            rgKeep[maxIndex] = true;
+            segmentStack.push(qMakePair(segment.first, maxIndex));
+            segmentStack.push(qMakePair(maxIndex, segment.second));
+        }
+    }
+
+    QList<QGeoCoordinate> rgSimplified;
+    for (int i=0; i<coords.count(); i++) {
+        if (rgKeep[i]) {
+            rgSimplified.append(coords[i]);
+        }
+    }
+    return rgSimplified;
+}
+
 QStringList ShapeFileHelper::fileDialogKMLFilters(void) const
 {
     return QStringList(tr("KML Files (*.%1)").arg(AppSettings::kmlFileExtension));
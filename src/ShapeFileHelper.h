@@ -12,8 +12,11 @@
 #include <QObject>
 #include <QList>
 #include <QGeoCoordinate>
+#include <QGeoRectangle>
 #include <QVariant>
 
+#include <functional>
+
 /// Routines for loading polygons or polylines from KML or SHP files.
 class ShapeFileHelper : public QObject
 {
@@ -34,13 +37,46 @@ public:
     /// ShapeType is in index 0, error string is in index 1.
     Q_INVOKABLE static QVariantList determineShapeType(const QString& file);
 
+    /// Returns the features contained in the file without their geometry, so a feature can be picked for loading.
+    /// Each entry is a map with index, type, name, vertexCount and attributes keys.
+    Q_INVOKABLE static QVariantList featureIndex(const QString& file);
+
     QStringList fileDialogKMLFilters        (void) const;
     QStringList fileDialogKMLOrSHPFilters   (void) const;
 
+    /// A single polygon or polyline feature from a KML or SHP file
+    struct Feature {
+        int                     index       = -1;       ///< Index of the feature within the file
+        ShapeType               type        = Error;
+        QString                 name;
+        QVariantMap             attributes;             ///< KML ExtendedData or SHP dbf record
+        int                     vertexCount = 0;        ///< Vertex count as stored in the file
+        QGeoRectangle           boundingBox;
+        QList<QGeoCoordinate>   coords;                 ///< Simplified geometry, empty if geometry was not requested
+    };
+
+    /// Called for each feature as it is read from the file
+    ///     @return false: stop reading
+    typedef std::function<bool(const Feature& feature)> FeatureHandler_t;
+
     static ShapeType determineShapeType(const QString& file, QString& errorString);
     static bool loadPolygonFromFile(const QString& file, QList<QGeoCoordinate>& vertices, QString& errorString);
     static bool loadPolylineFromFile(const QString& file, QList<QGeoCoordinate>& coords, QString& errorString);
 
+    /// Streams all polygon and polyline features from the file. Only a single feature is held in memory at a time.
+    ///     @param loadGeometry false: only fill in the index information for each feature (no coords)
+    ///     @param simplifyToleranceMeters Geometry is simplified such that no vertex is removed which is further than this from the result, 0 for no simplification
+    static bool loadFeaturesFromFile(const QString& file, bool loadGeometry, double simplifyToleranceMeters, const FeatureHandler_t& handler, QString& errorString);
+
+    /// Loads the single feature at featureIndex from the file
+    static bool loadFeatureFromFile(const QString& file, int featureIndex, double simplifyToleranceMeters, Feature& feature, QString& errorString);
+
+    /// Douglas-Peucker simplification of the specified coordinates
+    static QList<QGeoCoordinate> simplifyCoordinates(const QList<QGeoCoordinate>& coords, double toleranceMeters);
+
+    /// Fills in the vertex count, bounding box and (if requested) simplified geometry of the feature from the coordinates read from the file
+    static void finalizeFeature(Feature& feature, const QList<QGeoCoordinate>& coords, bool loadGeometry, double simplifyToleranceMeters);
+
 private:
     static bool _fileIsKML(const QString& file, QString& errorString);
 
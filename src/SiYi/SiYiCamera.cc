@@ -60,7 +60,7 @@ bool SiYiCamera::turn(int yaw, int pitch)
     body.append(char(pitch));
 
     QByteArray msg = packMessage(0x01, cmdId, body);
-    sendMessage(msg);
+    sendMessage(msg, cmdId);
     return true;
 }
 
@@ -106,7 +106,7 @@ bool SiYiCamera::zoom(int option)
     body.append(char(option));
 
     QByteArray msg = packMessage(0x01, cmdId, body);
-    sendMessage(msg);
+    sendMessage(msg, cmdId);
     return true;
 }
 
@@ -121,7 +121,7 @@ bool SiYiCamera::focus(int option)
     body.append(char(option));
 
     QByteArray msg = packMessage(0x01, cmdId, body);
-    sendMessage(msg);
+    sendMessage(msg, cmdId);
     return true;
 }
 
@@ -314,183 +314,79 @@ QByteArray SiYiCamera::heartbeatMessage()
     return packMessage(0x01, 0x80, QByteArray());
 }
 
-void SiYiCamera::analyzeMessage()
-{
-    while (rxBytes_.length() >= 4) {
-        if ((rxBytes_.at(0) == char(0x55)) && (rxBytes_.at(1) == char(0x66)) && (rxBytes_.at(3) == char(0xbb)) && (rxBytes_.at(3) == char(0xbb))) {
-            int headerLength = 4+1+4+2+1+4;
-            if (rxBytes_.length() >= headerLength) {
-                ProtocolMessageHeaderContext header;
-                quint32 *ptr32 = nullptr;
-                quint16 *ptr16 = nullptr;
-                quint8 *ptr8 = nullptr;
-                int offset = 0;
-                ptr32 = reinterpret_cast<quint32*>(rxBytes_.data());
-                header.stx = *ptr32;
-                offset += 4;
-
-                ptr8 = reinterpret_cast<quint8*>(rxBytes_.data() + offset);
-                header.control = *ptr8;
-                offset += 1;
-
-                ptr32 = reinterpret_cast<quint32*>(rxBytes_.data() + offset);
-                header.dataLength = *ptr32;
-                offset += 4;
-
-                ptr16 = reinterpret_cast<quint16*>(rxBytes_.data() + offset);
-                header.sequence = *ptr16;
-                offset += 2;
-
-                ptr8 = reinterpret_cast<quint8*>(rxBytes_.data() + offset);
-                header.cmdId = *ptr8;
-                offset += 1;
-
-                ptr32 = reinterpret_cast<quint32*>(rxBytes_.data() + offset);
-                header.crc = (*ptr32);
-#if 0
-                header.stx = qToBigEndian<quint32>(header.stx);
-                header.control = qToBigEndian<quint8>(header.control);
-                header.dataLength = qToBigEndian<quint16>(header.dataLength);
-                header.sequence = qToBigEndian<quint16>(header.sequence);
-                header.cmdId = qToBigEndian<quint8>(header.cmdId);
-                header.crc = qToBigEndian<quint32>(header.crc);
-#endif
-
-                ProtocolMessageContext msg;
-                msg.header = header;
-                int msgLen = headerLength + header.dataLength + 4;
-                if (rxBytes_.length() >= msgLen) {
-                    msg.data = QByteArray(rxBytes_.data() + headerLength);
-                    int offset = headerLength + header.dataLength;
-                    msg.crc = *reinterpret_cast<quint16*>(rxBytes_.data() + offset);
-                    msg.crc = qToBigEndian<quint32>(msg.crc);
-                } else {
-                    // 数据帧未完整
-                    break;
-                }
-
-                QByteArray packet = QByteArray(rxBytes_.data(), msgLen);
-                const QString info = QString("[%1:%2]:").arg(ip_, QString::number(port_));
-                if (msg.header.cmdId == 0x80) {
-                    messageHandle0x80(packet);
-                } else if (msg.header.cmdId == 0x81) {
-                    messageHandle0x81(packet);
-                } else if (msg.header.cmdId == 0x83) {
-                    messageHandle0x83(packet);
-                } else if (msg.header.cmdId == 0x89) {
-                    messageHandle0x89(packet);
-                } else if (msg.header.cmdId == 0x90) {
-                    // Nothin to do yet.
-                } else if (msg.header.cmdId == 0x91) {
-                    // Nothin to do yet.
-                } else if (msg.header.cmdId == 0x92 || msg.header.cmdId == 0x93) {
-                    messageHandle0x92(packet);
-                } else if (msg.header.cmdId == 0x94) {
-                    messageHandle0x94(packet);
-                } else if (msg.header.cmdId == 0x98) {
-                    messageHandle0x98(packet);
-                } else if (msg.header.cmdId == 0x9e) {
-                    messageHandle0x9e(packet);
-                } else if (msg.header.cmdId == 0xa1) {
-                    messageHandle0xa1(packet);
-                } else if (msg.header.cmdId == 0xa2) {
-                    messageHandle0xa2(packet);
-                } else if (msg.header.cmdId == 0xa3) {
-                    messageHandle0xa3(packet);
-                } else if (msg.header.cmdId == 0xa6) {
-                    messageHandle0xa6(packet);
-                } else if (msg.header.cmdId == 0xaa) {
-                    messageHandle0xaa(packet);
-                } else if (msg.header.cmdId == 0xab) {
-                    messageHandle0xab(packet);
-                } else if (msg.header.cmdId == 0xac) {
-                    messageHandle0xac(packet);
-                } else if (msg.header.cmdId == 0xb0) {
-                    messageHandle0xb0(packet);
-                } else if (msg.header.cmdId == 0xba) {
-                    messageHandle0xba(packet);
-                } else if (msg.header.cmdId == 0xbb) {
-                    messageHandle0xbb(packet);
-                } else {
-                    QString id = QString("0x%1").arg(QString::number(msg.header.cmdId, 16), 2, '0');
-                    qWarning() << info << "Unknow handle message, cmd id:" << id;
-                }
-
-                rxBytes_.remove(0, msgLen);
-            } else {
-                break;
-            }
-        } else {
-            rxBytes_.remove(0, 1);
-        }
+void SiYiCamera::handleMessage(quint8 cmdId, const QByteArray &packet)
+{
+    if (cmdId == 0x80) {
+        messageHandle0x80(packet);
+    } else if (cmdId == 0x81) {
+        messageHandle0x81(packet);
+    } else if (cmdId == 0x83) {
+        messageHandle0x83(packet);
+    } else if (cmdId == 0x89) {
+        messageHandle0x89(packet);
+    } else if (cmdId == 0x90) {
+        // Nothin to do yet.
+    } else if (cmdId == 0x91) {
+        // Nothin to do yet.
+    } else if (cmdId == 0x92 || cmdId == 0x93) {
+        messageHandle0x92(packet);
+    } else if (cmdId == 0x94) {
+        messageHandle0x94(packet);
+    } else if (cmdId == 0x98) {
+        messageHandle0x98(packet);
+    } else if (cmdId == 0x9e) {
+        messageHandle0x9e(packet);
+    } else if (cmdId == 0xa1) {
+        messageHandle0xa1(packet);
+    } else if (cmdId == 0xa2) {
+        messageHandle0xa2(packet);
+    } else if (cmdId == 0xa3) {
+        messageHandle0xa3(packet);
+    } else if (cmdId == 0xa6) {
+        messageHandle0xa6(packet);
+    } else if (cmdId == 0xaa) {
+        messageHandle0xaa(packet);
+    } else if (cmdId == 0xab) {
+        messageHandle0xab(packet);
+    } else if (cmdId == 0xac) {
+        messageHandle0xac(packet);
+    } else if (cmdId == 0xb0) {
+        messageHandle0xb0(packet);
+    } else if (cmdId == 0xba) {
+        messageHandle0xba(packet);
+    } else if (cmdId == 0xbb) {
+        messageHandle0xbb(packet);
+    } else {
+        const QString info = QString("[%1:%2]:").arg(ip_, QString::number(port_));
+        QString id = QString("0x%1").arg(QString::number(cmdId, 16), 2, '0');
+        qWarning() << info << "Unknow handle message, cmd id:" << id;
     }
 }
 
 QByteArray SiYiCamera::packMessage(quint8 control, quint8 cmd,
                                    const QByteArray &payload)
 {
-    ProtocolMessageContext ctx;
-    ctx.header.stx = PROTOCOL_STX;
-    ctx.header.control = control;
-    ctx.header.dataLength = payload.length();
-    ctx.header.sequence = sequence();
-    ctx.header.cmdId = cmd;
-    ctx.header.crc = headerCheckSum32(&ctx.header);
-    ctx.data = payload;
-    ctx.crc = packetCheckSum32(&ctx);
+    const quint32 beStx = qToBigEndian<quint32>(PROTOCOL_STX);
+    const quint32 dataLength = quint32(payload.length());
+    const quint16 seq = sequence();
 
+    // Both CRCs are taken over the message as it is built up, no intermediate buffers
     QByteArray msg;
-    quint32 beStx = qToBigEndian<quint32>(ctx.header.stx);
-
-    msg.append(reinterpret_cast<char*>(&beStx), 4);                 // STX
-    msg.append(reinterpret_cast<char*>(&ctx.header.control), 1);    // CTRL
-    msg.append(reinterpret_cast<char*>(&ctx.header.dataLength), 4); // Data_len
-    msg.append(reinterpret_cast<char*>(&ctx.header.sequence), 2);   // SEQ
-    msg.append(reinterpret_cast<char*>(&ctx.header.cmdId), 1);      // CMD_ID
-    msg.append(reinterpret_cast<char*>(&ctx.header.crc), 4);        // CRC32(header)
-    msg.append(ctx.data);                                           // DATA
-    msg.append(reinterpret_cast<char*>(&ctx.crc), 4);               // CRC32(packet)
+    msg.reserve(16 + payload.length() + 4);
+    msg.append(reinterpret_cast<const char*>(&beStx), 4);           // STX
+    msg.append(reinterpret_cast<const char*>(&control), 1);         // CTRL
+    msg.append(reinterpret_cast<const char*>(&dataLength), 4);      // Data_len
+    msg.append(reinterpret_cast<const char*>(&seq), 2);             // SEQ
+    msg.append(reinterpret_cast<const char*>(&cmd), 1);             // CMD_ID
+    const quint32 headerCrc = checkSum32(msg.constData(), msg.length());
+    msg.append(reinterpret_cast<const char*>(&headerCrc), 4);       // CRC32(header)
+    msg.append(payload);                                            // DATA
+    const quint32 packetCrc = checkSum32(msg.constData(), msg.length());
+    msg.append(reinterpret_cast<const char*>(&packetCrc), 4);       // CRC32(packet)
 
     return msg;
 }
 
-quint32 SiYiCamera::headerCheckSum32(ProtocolMessageHeaderContext *ctx)
-{
-    if (ctx) {
-        QByteArray bytes;
-        quint32 beStx = qToBigEndian<quint32>(ctx->stx);
-        bytes.append(reinterpret_cast<char*>(&beStx), 4);
-        bytes.append(reinterpret_cast<char*>(&ctx->control), 1);
-        bytes.append(reinterpret_cast<char*>(&ctx->dataLength), 4);
-        bytes.append(reinterpret_cast<char*>(&ctx->sequence), 2);
-        bytes.append(reinterpret_cast<char*>(&ctx->cmdId), 1);
-
-        return checkSum32(bytes);
-    }
-
-    return 0;
-}
-
-quint32 SiYiCamera::packetCheckSum32(ProtocolMessageContext *ctx)
-{
-    if (ctx) {
-        QByteArray bytes;
-        quint32 beStx = qToBigEndian<quint32>(ctx->header.stx);
-        bytes.append(reinterpret_cast<char*>(&beStx), 4);
-        bytes.append(reinterpret_cast<char*>(&ctx->header.control), 1);
-        bytes.append(reinterpret_cast<char*>(&ctx->header.dataLength), 4);
-        bytes.append(reinterpret_cast<char*>(&ctx->header.sequence), 2);
-        bytes.append(reinterpret_cast<char*>(&ctx->header.cmdId), 1);
-        bytes.append(reinterpret_cast<char*>(&ctx->header.crc), 4);
-
-        bytes.append(ctx->data);
-
-        return checkSum32(bytes);
-    }
-
-    return 0;
-}
-
 bool SiYiCamera::unpackMessage(ProtocolMessageContext *ctx,
                                const QByteArray &msg)
 {
@@ -542,11 +438,8 @@ bool SiYiCamera::unpackMessage(ProtocolMessageContext *ctx,
                 ctx->crc = i32;
 
                 if (ctx->header.stx == PROTOCOL_STX) {
-                    QByteArray headerBytes(msg.data(), 16);
-                    QByteArray packetBytes(msg.data(), 16
-                                           + ctx->header.dataLength);
-                    quint32 headerCrc = checkSum32(headerBytes);
-                    quint32 packetCrc = checkSum32(packetBytes);
+                    quint32 headerCrc = checkSum32(msg.constData(), 16);
+                    quint32 packetCrc = checkSum32(msg.constData(), int(16 + ctx->header.dataLength));
                     if (headerCrc == ctx->header.crc
                             && packetCrc == ctx->crc) {
                         return true;
@@ -119,6 +119,7 @@ public:
     Q_INVOKABLE bool turn(int yaw, int pitch);
     Q_INVOKABLE bool resetPostion();
     Q_INVOKABLE bool autoFocus(int x, int y, int w, int h);
+    // Gimbal rate commands, a burst the link cannot keep up with is sent as its latest value only
     // 1: 放大，0：停止，-1：缩小
     Q_INVOKABLE bool zoom(int option);
     // 1: 远景，0：停止，-1：近景
@@ -142,7 +143,7 @@ public:
 
 protected:
     QByteArray heartbeatMessage() override;
-    void analyzeMessage() override;
+    void handleMessage(quint8 cmdId, const QByteArray &packet) override;
 
 private:
     qint8 recording_state_{0};
@@ -158,8 +159,6 @@ private:
 private:
     QByteArray packMessage(quint8 control, quint8 cmd,
                            const QByteArray &payload);
-    quint32 headerCheckSum32(ProtocolMessageHeaderContext *ctx);
-    quint32 packetCheckSum32(ProtocolMessageContext *ctx);
     bool unpackMessage(ProtocolMessageContext *ctx,
                        const QByteArray &msg);
     void getCamerVersion();
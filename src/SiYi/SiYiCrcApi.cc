@@ -67,7 +67,7 @@ const uint32_t crc32_tab[256]= {
     0xbcb4666d,0xb8757bda,0xb5365d03,0xb1f740b4
 };
 
-uint32_t CRC32_cal(uint8_t *ptr, uint32_t len, uint16_t crc_init)
+uint32_t CRC32_cal(const uint8_t *ptr, uint32_t len, uint32_t crc_init)
 {
     uint32_t crc,
              oldcrc32;
@@ -92,8 +92,10 @@ SiYiCrcApi::SiYiCrcApi(QObject *parent)
 
 quint32 SiYiCrcApi::calculateCrc32(const QByteArray &bytes)
 {
-    QByteArray input = bytes;
-    uint32_t ret = CRC32_cal(
-                reinterpret_cast<uint8_t*>(input.data()), input.length(), 0);
-    return ret;
+    return calculateCrc32(bytes.constData(), bytes.length());
+}
+
+quint32 SiYiCrcApi::calculateCrc32(const char *data, int len, quint32 crc)
+{
+    return CRC32_cal(reinterpret_cast<const uint8_t*>(data), uint32_t(len), crc);
 }
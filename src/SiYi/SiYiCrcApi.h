@@ -13,6 +13,8 @@ class SiYiCrcApi : public QObject
 public:
     SiYiCrcApi(QObject *parent = Q_NULLPTR);
     static quint32 calculateCrc32(const QByteArray &bytes);
+    // Pass the previous result as crc to continue a checksum over several spans
+    static quint32 calculateCrc32(const char *data, int len, quint32 crc = 0);
 };
 
 #endif
@@ -4,10 +4,73 @@
 #include <QTcpSocket>
 #include <QTimerEvent>
 
+#include <algorithm>
+#include <iterator>
+#include <cstring>
+
 #include "SiYiCrcApi.h"
 #include "SiYiTcpClient.h"
 
+SiYiRxRing::SiYiRxRing()
+    : buffer_(capacity, 0)
+{
+
+}
+
+char *SiYiRxRing::writeSpan(int *length)
+{
+    const quint32 offset = tail_ & mask;
+    const int free = capacity - size();
+    const int toEnd = capacity - int(offset);
+    *length = free < toEnd ? free : toEnd;
+    return buffer_.data() + offset;
+}
+
+void SiYiRxRing::commit(int length)
+{
+    tail_ += quint32(length);
+}
 
+const char *SiYiRxRing::peek(int length)
+{
+    const quint32 offset = head_ & mask;
+    if (int(offset) + length <= capacity) {
+        return buffer_.constData() + offset;
+    }
+
+    const int first = capacity - int(offset);
+    linear_.resize(length);
+    memcpy(linear_.data(), buffer_.constData() + offset, size_t(first));
+    memcpy(linear_.data() + first, buffer_.constData(), size_t(length - first));
+    return linear_.constData();
+}
+
+void SiYiRxRing::consume(int length)
+{
+    head_ += quint32(length);
+    if (head_ == tail_) {
+        // Start over at the front so the next frames are contiguous
+        head_ = tail_ = 0;
+    }
+}
+
+void SiYiTxQueue::enqueue(const QByteArray &msg, int coalesceKey)
+{
+    if (coalesceKey != 0) {
+        for (Entry &entry : entries_) {
+            if (entry.coalesceKey == coalesceKey) {
+                entry.msg = msg;
+                return;
+            }
+        }
+    }
+    entries_.append({msg, coalesceKey});
+}
+
+QByteArray SiYiTxQueue::takeFirst()
+{
+    return entries_.takeFirst().msg;
+}
 
 SiYiTcpClient::SiYiTcpClient(const QString ip, quint16 port, QObject *parent)
     : QThread(parent)
@@ -15,6 +78,9 @@ SiYiTcpClient::SiYiTcpClient(const QString ip, quint16 port, QObject *parent)
     , port_(port)
 {
     sequence_ = quint16(QDateTime::currentMSecsSinceEpoch());
+    // Camera frames, 4 byte Data_len. The transmitter sets its own.
+    frameLayout_ = {16, 5, 4, 11};
+    std::fill(std::begin(commandSentMSecs_), std::end(commandSentMSecs_), -1);
     // 自动重连
     connect(this, &SiYiTcpClient::finished, this, [=]() { start(); });
 }
@@ -27,12 +93,20 @@ SiYiTcpClient::~SiYiTcpClient()
     }
 }
 
-void SiYiTcpClient::sendMessage(const QByteArray &msg)
+void SiYiTcpClient::sendMessage(const QByteArray &msg, int coalesceKey)
 {
-    if (isRunning()) {
-        txMessageVectorMutex_.lock();
-        txMessageVector_.append(msg);
-        txMessageVectorMutex_.unlock();
+    if (!isRunning()) {
+        return;
+    }
+
+    QMutexLocker locker(&txQueueMutex_);
+    txQueue_.enqueue(msg, coalesceKey);
+
+    // Wake the client thread, one wake up covers everything queued until it runs
+    if (socket_ && !writePending_) {
+        writePending_ = true;
+        QTcpSocket *socket = socket_;
+        QMetaObject::invokeMethod(socket, [this, socket]() { writeMessages(socket); }, Qt::QueuedConnection);
     }
 }
 
@@ -74,29 +148,39 @@ quint16 SiYiTcpClient::sequence()
 void SiYiTcpClient::run()
 {
     QTcpSocket *tcpClient = new QTcpSocket();
-    QTimer *txTimer = new QTimer();
-    QTimer *rxTimer = new QTimer();
     QTimer *heartbeatTimer = new QTimer();
     const QString info = QString("[%1:%2]:").arg(ip_, QString::number(port_));
 
+    rxRing_.clear();
+    latencyClock_.start();
+    std::fill(std::begin(commandSentMSecs_), std::end(commandSentMSecs_), -1);
+
     connect(tcpClient, &QTcpSocket::connected, tcpClient, [=](){
         qInfo() << info << "Connect to server successfully!";
 
         heartbeatTimer->start();
-        txTimer->start();
+
+        this->txQueueMutex_.lock();
+        this->socket_ = tcpClient;
+        this->txQueueMutex_.unlock();
 
         this->isConnected_ = true;
 
         emit connected();
         emit isConnectedChanged();
+
+        // Anything queued while connecting
+        writeMessages(tcpClient);
     });
     connect(tcpClient, &QTcpSocket::disconnected, tcpClient, [=]() {
         qInfo() << info << "Disconnect from server:" << tcpClient->errorString();
 
         this->isConnected_ = false;
-        this->txMessageVectorMutex_.lock();
-        this->txMessageVector_.clear();
-        this->txMessageVectorMutex_.unlock();
+        this->txQueueMutex_.lock();
+        this->socket_ = nullptr;
+        this->writePending_ = false;
+        this->txQueue_.clear();
+        this->txQueueMutex_.unlock();
 
         emit isConnectedChanged();
 
@@ -109,48 +193,9 @@ void SiYiTcpClient::run()
         qInfo() << info << tcpClient->errorString();
     });
 
-    // 定时发送
-    txTimer->setInterval(10);
-    txTimer->setSingleShot(true);
-    connect(txTimer, &QTimer::timeout, txTimer, [=](){
-        this->txMessageVectorMutex_.lock();
-        QByteArray msg = this->txMessageVector_.isEmpty()
-                             ? QByteArray()
-                             : this->txMessageVector_.takeFirst();
-        this->txMessageVectorMutex_.unlock();
-
-        if ((!msg.isEmpty())) {
-            if ((tcpClient->state() == QTcpSocket::ConnectedState)) {
-                if (tcpClient->write(msg) != -1) {
-                    //qInfo() << info << "Tx:" << msg.toHex(' ');
-                } else {
-                    qInfo() << info << tcpClient->errorString();
-                }
-            } else {
-                qInfo() << info << "Not connected state, the state is:" << tcpClient->state();
-                qInfo() << info << tcpClient->errorString();
-                exit();
-            }
-        }
-
-        txTimer->start();
-    });
-
-    // 定时处理接收数据
-    rxTimer->setInterval(1);
-    rxTimer->setSingleShot(true);
-    connect(rxTimer, &QTimer::timeout, rxTimer, [=](){
-        this->rxBytesMutex_.lock();
-
-        QByteArray bytes = tcpClient->readAll();
-        this->rxBytes_.append(bytes);
-
-        analyzeMessage();
-
-        this->rxBytesMutex_.unlock();
-
-        rxTimer->start();
-    });
+    connect(tcpClient, &QTcpSocket::readyRead, tcpClient, [=]() { readFrames(tcpClient); });
+    // Queued, bytesWritten can be emitted from inside the flush in writeMessages
+    connect(tcpClient, &QTcpSocket::bytesWritten, tcpClient, [=]() { writeMessages(tcpClient); }, Qt::QueuedConnection);
 
     // 心跳
     heartbeatTimer->setInterval(1500);
@@ -181,11 +226,129 @@ void SiYiTcpClient::run()
 
     tcpClient->connectToHost(ip_, port_);
 
-    //txTimer->start();
-    rxTimer->start();
     exec();
-    txTimer->deleteLater();
-    tcpClient->deleteLater();
+
+    this->txQueueMutex_.lock();
+    this->socket_ = nullptr;
+    this->writePending_ = false;
+    this->txQueue_.clear();
+    this->txQueueMutex_.unlock();
+
+    tcpClient->disconnect();
+    delete tcpClient;
+    delete heartbeatTimer;
+}
+
+void SiYiTcpClient::readFrames(QTcpSocket *socket)
+{
+    const SiYiFrameLayout &layout = frameLayout_;
+
+    for (;;) {
+        int span = 0;
+        char *ptr = rxRing_.writeSpan(&span);
+        if (span == 0) {
+            // Frames are limited to the ring capacity, so a full ring always holds a complete frame
+            qWarning() << "SiYi receive buffer overflow, dropping" << rxRing_.size() << "bytes";
+            rxRing_.clear();
+            continue;
+        }
+
+        const qint64 count = socket->read(ptr, span);
+        if (count <= 0) {
+            break;
+        }
+        rxRing_.commit(int(count));
+
+        while (rxRing_.size() >= 4) {
+            if (rxRing_.at(0) != 0x55 || rxRing_.at(1) != 0x66 || rxRing_.at(2) != 0xaa || rxRing_.at(3) != 0xbb) {
+                // Resync on the next STX
+                rxRing_.consume(1);
+                continue;
+            }
+            if (rxRing_.size() < layout.headerLength) {
+                break;
+            }
+
+            quint32 dataLength = 0;
+            for (int i = layout.lengthSize - 1; i >= 0; i--) {
+                dataLength = (dataLength << 8) | rxRing_.at(layout.lengthOffset + i);
+            }
+            if (dataLength > quint32(SiYiRxRing::capacity - layout.headerLength - 4)) {
+                // Not a real header
+                rxRing_.consume(1);
+                continue;
+            }
+
+            const int frameLength = layout.headerLength + int(dataLength) + 4;
+            if (rxRing_.size() < frameLength) {
+                // 数据帧未完整
+                break;
+            }
+
+            const quint8 cmdId = rxRing_.at(layout.cmdIdOffset);
+            commandReplied(cmdId);
+            handleMessage(cmdId, QByteArray::fromRawData(rxRing_.peek(frameLength), frameLength));
+            rxRing_.consume(frameLength);
+        }
+    }
+}
+
+void SiYiTcpClient::writeMessages(QTcpSocket *socket)
+{
+    QMutexLocker locker(&txQueueMutex_);
+    writePending_ = false;
+
+    // Only hand the socket more once it has pushed out everything before, whatever
+    // queues up behind a slow link in the meantime can still be coalesced
+    while (!txQueue_.isEmpty() && socket->bytesToWrite() == 0) {
+        if (socket->state() != QTcpSocket::ConnectedState) {
+            qInfo() << "Not connected state, the state is:" << socket->state();
+            break;
+        }
+
+        const QByteArray msg = txQueue_.takeFirst();
+        if (socket->write(msg) == -1) {
+            qInfo() << socket->errorString();
+            break;
+        }
+        commandSent(msg);
+        socket->flush();
+    }
+}
+
+void SiYiTcpClient::commandSent(const QByteArray &msg)
+{
+    if (msg.length() <= frameLayout_.cmdIdOffset) {
+        return;
+    }
+
+    // Time the oldest outstanding command of each id, replies carry no sequence we could match instead
+    const quint8 cmdId = quint8(msg.at(frameLayout_.cmdIdOffset));
+    const qint64 now = latencyClock_.elapsed();
+    if (commandSentMSecs_[cmdId] < 0 || now - commandSentMSecs_[cmdId] > latencyTimeoutMSecs) {
+        commandSentMSecs_[cmdId] = now;
+    }
+}
+
+void SiYiTcpClient::commandReplied(quint8 cmdId)
+{
+    const qint64 sent = commandSentMSecs_[cmdId];
+    if (sent < 0) {
+        return;
+    }
+    commandSentMSecs_[cmdId] = -1;
+
+    const qint64 latency = latencyClock_.elapsed() - sent;
+    if (latency > latencyTimeoutMSecs) {
+        return;
+    }
+
+    const int previous = commandLatency_;
+    const int smoothed = previous < 0 ? int(latency) : int((previous * 7 + latency) / 8);
+    if (smoothed != previous) {
+        commandLatency_ = smoothed;
+        emit commandLatencyChanged();
+    }
 }
 
 quint32 SiYiTcpClient::checkSum32(const QByteArray &bytes)
@@ -193,6 +356,11 @@ quint32 SiYiTcpClient::checkSum32(const QByteArray &bytes)
     return SiYiCrcApi::calculateCrc32(bytes);
 }
 
+quint32 SiYiTcpClient::checkSum32(const char *data, int len, quint32 crc)
+{
+    return SiYiCrcApi::calculateCrc32(data, len, crc);
+}
+
 void SiYiTcpClient::resetIp(const QString &ip)
 {
     if (ip_ != ip) {
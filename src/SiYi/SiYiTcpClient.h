@@ -5,28 +5,96 @@
 #include <QThread>
 #include <QVector>
 #include <QTcpSocket>
+#include <QElapsedTimer>
+
+#include <atomic>
 
 #define PROTOCOL_STX 0x5566AABB
 
+// Where the transport finds the fields it needs in a frame header, the
+// camera and the transmitter use different header sizes.
+struct SiYiFrameLayout
+{
+    int headerLength;   // STX up to and including the header CRC
+    int lengthOffset;   // Data_len, little endian
+    int lengthSize;     // 2 or 4 bytes
+    int cmdIdOffset;
+};
+
+// Receive ring, the socket reads straight into it and complete frames are
+// handed out in place. Only a frame which wraps around the end of the ring
+// is copied, into a scratch buffer.
+class SiYiRxRing
+{
+public:
+    static const int capacity = 64 * 1024; // Power of two
+
+    SiYiRxRing();
+
+    int size() const { return int(tail_ - head_); }
+    quint8 at(int index) const { return quint8(buffer_[(head_ + quint32(index)) & mask]); }
+
+    char *writeSpan(int *length);           // Largest contiguous free span
+    void commit(int length);
+    const char *peek(int length);           // length bytes from the head as one contiguous block
+    void consume(int length);
+    void clear() { head_ = tail_ = 0; }
+
+private:
+    static const quint32 mask = capacity - 1;
+
+    QByteArray buffer_;
+    QByteArray linear_;
+    quint32 head_{0};
+    quint32 tail_{0};
+};
+
+// Outgoing messages waiting for the socket. A message queued with a coalesce
+// key replaces a still queued message with the same key, so a burst of rate
+// commands goes out as its latest value only.
+class SiYiTxQueue
+{
+public:
+    void enqueue(const QByteArray &msg, int coalesceKey = 0);
+    QByteArray takeFirst();
+    bool isEmpty() const { return entries_.isEmpty(); }
+    int count() const { return entries_.count(); }
+    void clear() { entries_.clear(); }
+
+private:
+    struct Entry {
+        QByteArray msg;
+        int coalesceKey;
+    };
+    QVector<Entry> entries_;
+};
+
 class SiYiTcpClient : public QThread
 {
     Q_OBJECT
     Q_PROPERTY(bool isConnected READ isConnected NOTIFY isConnectedChanged)
+    Q_PROPERTY(int commandLatency READ commandLatency NOTIFY commandLatencyChanged)
 public:
     SiYiTcpClient(const QString ip, quint16 port, QObject *parent = Q_NULLPTR);
     ~SiYiTcpClient();
 
-    void sendMessage(const QByteArray &msg);
+    // coalesceKey: non zero to drop a still queued message with the same key
+    void sendMessage(const QByteArray &msg, int coalesceKey = 0);
     Q_INVOKABLE virtual void analyzeIp(QString videoUrl);
 
+    // Smoothed time from sending a command to receiving a reply with the same
+    // command id, in milliseconds. -1 until the first reply.
+    int commandLatency() { return commandLatency_; }
+
+    static const int latencyTimeoutMSecs = 2000;
+
 protected:
-    virtual void analyzeMessage() = 0;
+    // Called on the client thread for each complete frame, packet is only
+    // valid for the duration of the call.
+    virtual void handleMessage(quint8 cmdId, const QByteArray &packet) = 0;
     virtual QByteArray heartbeatMessage() = 0;
 protected:
-    QVector<QByteArray> txMessageVector_;
-    QMutex txMessageVectorMutex_;
-    QByteArray rxBytes_;
-    QMutex rxBytesMutex_;
+    SiYiFrameLayout frameLayout_;
     int timeoutCount = 0;
     QMutex timeoutCountMutex;
     QString ip_;
@@ -35,13 +103,28 @@ protected:
     quint16 sequence();
     void run() override;
     quint32 checkSum32(const QByteArray &bytes);
+    quint32 checkSum32(const char *data, int len, quint32 crc = 0);
     void resetIp(const QString &ip);
+private:
+    void readFrames(QTcpSocket *socket);
+    void writeMessages(QTcpSocket *socket);
+    void commandSent(const QByteArray &msg);
+    void commandReplied(quint8 cmdId);
 private:
     quint16 sequence_;
+    SiYiRxRing rxRing_;
+    SiYiTxQueue txQueue_;
+    QMutex txQueueMutex_;
+    QTcpSocket *socket_{nullptr};               // Guarded by txQueueMutex_
+    bool writePending_{false};                  // Guarded by txQueueMutex_
+    QElapsedTimer latencyClock_;
+    qint64 commandSentMSecs_[256];
+    std::atomic<int> commandLatency_{-1};
 signals:
     void connected();
     void disconnected();
     void ipChanged();
+    void commandLatencyChanged();
 private:
     bool isConnected_{false};
     bool isConnected(){return isConnected_;}
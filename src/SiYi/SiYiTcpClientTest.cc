@@ -0,0 +1,229 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "SiYiTcpClientTest.h"
+#include "SiYiTcpClient.h"
+#include "SiYiCrcApi.h"
+
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QMutexLocker>
+#include <QtEndian>
+
+namespace {
+
+/// Camera layout client which records every frame it receives
+class TestSiYiClient : public SiYiTcpClient
+{
+public:
+    struct Frame {
+        quint8  cmdId;
+        int     length;
+        bool    crcOk;
+    };
+
+    TestSiYiClient(quint16 port)
+        : SiYiTcpClient("127.0.0.1", port)
+    {
+
+    }
+
+    ~TestSiYiClient()
+    {
+        disconnect(this, &SiYiTcpClient::finished, this, nullptr);
+        if (isRunning()) {
+            exit();
+            wait();
+        }
+    }
+
+    QVector<Frame> frames()
+    {
+        QMutexLocker locker(&_framesMutex);
+        return _frames;
+    }
+
+protected:
+    void handleMessage(quint8 cmdId, const QByteArray &packet) override
+    {
+        const quint32 crc = qFromLittleEndian<quint32>(packet.constData() + packet.length() - 4);
+
+        QMutexLocker locker(&_framesMutex);
+        _frames.append({ cmdId, packet.length(), crc == SiYiCrcApi::calculateCrc32(packet.constData(), packet.length() - 4) });
+    }
+
+    QByteArray heartbeatMessage() override
+    {
+        return QByteArray();
+    }
+
+private:
+    QMutex          _framesMutex;
+    QVector<Frame>  _frames;
+};
+
+}
+
+QByteArray SiYiTcpClientTest::_frame(quint8 cmdId, const QByteArray& payload)
+{
+    const quint32 beStx         = qToBigEndian<quint32>(PROTOCOL_STX);
+    const quint8  control       = 0x02;
+    const quint32 dataLength    = static_cast<quint32>(payload.length());
+    const quint16 seq           = 0;
+
+    QByteArray frame;
+    frame.append(reinterpret_cast<const char*>(&beStx), 4);
+    frame.append(reinterpret_cast<const char*>(&control), 1);
+    frame.append(reinterpret_cast<const char*>(&dataLength), 4);
+    frame.append(reinterpret_cast<const char*>(&seq), 2);
+    frame.append(reinterpret_cast<const char*>(&cmdId), 1);
+    const quint32 headerCrc = SiYiCrcApi::calculateCrc32(frame);
+    frame.append(reinterpret_cast<const char*>(&headerCrc), 4);
+    frame.append(payload);
+    const quint32 packetCrc = SiYiCrcApi::calculateCrc32(frame);
+    frame.append(reinterpret_cast<const char*>(&packetCrc), 4);
+
+    return frame;
+}
+
+void SiYiTcpClientTest::_crc(void)
+{
+    const QByteArray bytes = _frame(0x94, QByteArray(100, 'x'));
+
+    // Continuing over several spans gives the same result as a single pass
+    const quint32 whole = SiYiCrcApi::calculateCrc32(bytes);
+    QCOMPARE(SiYiCrcApi::calculateCrc32(bytes.constData(), bytes.length()), whole);
+    QCOMPARE(SiYiCrcApi::calculateCrc32(bytes.constData() + 16, bytes.length() - 16,
+                                        SiYiCrcApi::calculateCrc32(bytes.constData(), 16)), whole);
+}
+
+void SiYiTcpClientTest::_coalesce(void)
+{
+    SiYiTxQueue queue;
+
+    queue.enqueue(_frame(0x9a, QByteArray("\x10\x00", 2)), 0x9a);
+    queue.enqueue(_frame(0x94, QByteArray()));
+    queue.enqueue(_frame(0x9a, QByteArray("\x20\x00", 2)), 0x9a);
+    queue.enqueue(_frame(0x98, QByteArray("\x01", 1)), 0x98);
+    queue.enqueue(_frame(0x94, QByteArray()));
+    queue.enqueue(_frame(0x9a, QByteArray("\x00\x00", 2)), 0x9a);
+
+    // Latest rate command keeps the place of the first, uncoalesced messages all stay
+    QCOMPARE(queue.count(), 4);
+    QCOMPARE(queue.takeFirst(), _frame(0x9a, QByteArray("\x00\x00", 2)));
+    QCOMPARE(queue.takeFirst(), _frame(0x94, QByteArray()));
+    QCOMPARE(queue.takeFirst(), _frame(0x98, QByteArray("\x01", 1)));
+    QCOMPARE(queue.takeFirst(), _frame(0x94, QByteArray()));
+    QVERIFY(queue.isEmpty());
+}
+
+void SiYiTcpClientTest::_frameParser(void)
+{
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    TestSiYiClient client(server.serverPort());
+    client.start();
+
+    QVERIFY(server.waitForNewConnection(5000));
+    QTcpSocket* socket = server.nextPendingConnection();
+    QTRY_VERIFY(client.property("isConnected").toBool());
+
+    // Line noise, a lone STX and a header claiming more data than any frame can hold
+    QByteArray noise("\x01\x02\x55\x66\xaa", 5);
+    QByteArray bogus = _frame(0x80, QByteArray());
+    bogus[5] = char(0xff); bogus[6] = char(0xff); bogus[7] = char(0xff); bogus[8] = char(0x7f);
+    socket->write(noise);
+    socket->write(bogus.left(16));
+
+    // A frame dribbled out a byte at a time
+    const QByteArray dribbled = _frame(0x94, QByteArray(10, 'v'));
+    for (int i = 0; i < dribbled.length(); i++) {
+        socket->write(dribbled.mid(i, 1));
+        socket->flush();
+    }
+
+    // Several frames in one write
+    socket->write(_frame(0x80, QByteArray(1, '\x01')) + _frame(0x81, QByteArray(2, '\x00')) + _frame(0xa2, QByteArray(4, '\x00')));
+    socket->flush();
+
+    QTRY_COMPARE(client.frames().count(), 4);
+    const QVector<TestSiYiClient::Frame> frames = client.frames();
+    QCOMPARE(frames[0].cmdId, quint8(0x94));
+    QCOMPARE(frames[0].length, dribbled.length());
+    QCOMPARE(frames[1].cmdId, quint8(0x80));
+    QCOMPARE(frames[2].cmdId, quint8(0x81));
+    QCOMPARE(frames[3].cmdId, quint8(0xa2));
+    for (const TestSiYiClient::Frame& frame: frames) {
+        QVERIFY(frame.crcOk);
+    }
+}
+
+void SiYiTcpClientTest::_ringWrap(void)
+{
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    TestSiYiClient client(server.serverPort());
+    client.start();
+
+    QVERIFY(server.waitForNewConnection(5000));
+    QTcpSocket* socket = server.nextPendingConnection();
+    QTRY_VERIFY(client.property("isConnected").toBool());
+
+    // Several times the ring capacity, with a frame size that doesn't divide it so frames straddle the end
+    const int frameCount = 300;
+    for (int i = 0; i < frameCount; i++) {
+        QByteArray payload(1000 + (i % 7), char(i));
+        socket->write(_frame(0x94, payload));
+    }
+    socket->flush();
+
+    QTRY_COMPARE_WITH_TIMEOUT(client.frames().count(), frameCount, 10000);
+    const QVector<TestSiYiClient::Frame> frames = client.frames();
+    for (int i = 0; i < frameCount; i++) {
+        QCOMPARE(frames[i].length, 16 + 1000 + (i % 7) + 4);
+        QVERIFY(frames[i].crcOk);
+    }
+}
+
+void SiYiTcpClientTest::_commandLatency(void)
+{
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    TestSiYiClient client(server.serverPort());
+    QCOMPARE(client.commandLatency(), -1);
+    client.start();
+
+    QVERIFY(server.waitForNewConnection(5000));
+    QTcpSocket* socket = server.nextPendingConnection();
+    QTRY_VERIFY(client.property("isConnected").toBool());
+
+    // Fake camera, acknowledges each command with the same command id
+    QByteArray rxBytes;
+    connect(socket, &QTcpSocket::readyRead, socket, [socket, &rxBytes]() {
+        rxBytes.append(socket->readAll());
+        while (rxBytes.length() >= 16) {
+            const int length = 16 + static_cast<int>(qFromLittleEndian<quint32>(rxBytes.constData() + 5)) + 4;
+            if (rxBytes.length() < length) {
+                break;
+            }
+            socket->write(_frame(static_cast<quint8>(rxBytes.at(11)), QByteArray(1, '\x00')));
+            rxBytes.remove(0, length);
+        }
+    });
+
+    client.sendMessage(_frame(0x94, QByteArray()));
+
+    QTRY_VERIFY(client.commandLatency() >= 0);
+    QVERIFY(client.commandLatency() < SiYiTcpClient::latencyTimeoutMSecs);
+    QCOMPARE(client.frames().count(), 1);
+    QCOMPARE(client.frames()[0].cmdId, quint8(0x94));
+}
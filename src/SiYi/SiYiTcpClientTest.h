@@ -0,0 +1,28 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Runs the SiYi transport against a local fake SiYi TCP server
+class SiYiTcpClientTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _crc               (void);
+    void _coalesce          (void);
+    void _frameParser       (void);
+    void _ringWrap          (void);
+    void _commandLatency    (void);
+
+private:
+    static QByteArray _frame(quint8 cmdId, const QByteArray& payload);
+};
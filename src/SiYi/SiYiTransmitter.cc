@@ -4,7 +4,8 @@
 SiYiTransmitter::SiYiTransmitter(QObject *parent)
     : SiYiTcpClient{"192.168.144.12", 5864, parent}
 {
-
+    // 2 byte Data_len
+    frameLayout_ = {14, 5, 2, 9};
 }
 
 QByteArray SiYiTransmitter::heartbeatMessage()
@@ -16,152 +17,45 @@ QByteArray SiYiTransmitter::heartbeatMessage()
 #endif
 }
 
-void SiYiTransmitter::analyzeMessage()
+void SiYiTransmitter::handleMessage(quint8 cmdId, const QByteArray &packet)
 {
-    while (rxBytes_.length() >= 4) {
-        if (rxBytes_.at(0) == char(0x55)
-                && rxBytes_.at(1) == char(0x66)
-                && rxBytes_.at(2) == char(0xaa)
-                && rxBytes_.at(3) == char(0xbb)) {
-            int headerLength = 4+1+2+2+1+4;
-            if (rxBytes_.length() >= headerLength) {
-                ProtocolMessageHeaderContext header;
-                quint32 *ptr32 = nullptr;
-                quint16 *ptr16 = nullptr;
-                quint8 *ptr8 = nullptr;
-                int offset = 0;
-                ptr32 = reinterpret_cast<quint32*>(rxBytes_.data());
-                header.stx = *ptr32;
-                offset += 4;
-
-                ptr8 = reinterpret_cast<quint8*>(rxBytes_.data() + offset);
-                header.control = *ptr8;
-                offset += 1;
-
-                ptr16 = reinterpret_cast<quint16*>(rxBytes_.data() + offset);
-                header.dataLength = *ptr16;
-                offset += 2;
-
-                ptr16 = reinterpret_cast<quint16*>(rxBytes_.data() + offset);
-                header.sequence = *ptr16;
-                offset += 2;
-
-                ptr8 = reinterpret_cast<quint8*>(rxBytes_.data() + offset);
-                header.cmdId = *ptr8;
-                offset += 1;
-
-                ptr32 = reinterpret_cast<quint32*>(rxBytes_.data() + offset);
-                header.crc = *ptr32;
+    if ((cmdId == 0x83) || (cmdId == 0x2f)) {
 #if 0
-                header.stx = qToBigEndian<quint32>(header.stx);
-                header.control = qToBigEndian<quint8>(header.control);
-                header.dataLength = qToBigEndian<quint16>(header.dataLength);
-                header.sequence = qToBigEndian<quint16>(header.sequence);
-                header.cmdId = qToBigEndian<quint8>(header.cmdId);
-                header.crc = qToBigEndian<quint32>(header.crc);
+        const QString info = QString("[%1:%2]:").arg(ip_, QString::number(port_));
+        qInfo() << info << "Rx:" << packet.toHex(' ');
 #endif
-
-                ProtocolMessageContext msg;
-                msg.header = header;
-                int msgLen = headerLength + header.dataLength + 4;
-                if (rxBytes_.length() >= msgLen) {
-                    msg.data = QByteArray(rxBytes_.data() + headerLength);
-                    int offset = headerLength + header.dataLength;
-                    msg.crc = *reinterpret_cast<quint16*>(rxBytes_.data() + offset);
-                    msg.crc = qToBigEndian<quint32>(msg.crc);
-                } else {
-                    // 数据帧未完整
-                    break;
-                }
-
-                if ((msg.header.cmdId == 0x83) || (msg.header.cmdId == 0x2f)) {
-                    const QString info = QString("[%1:%2]:").arg(ip_, QString::number(port_));
-                    QByteArray packet = QByteArray(rxBytes_.data(), msgLen);
-#if 0
-                    qInfo() << info << "Rx:" << packet.toHex(' ');
-#endif
-                    onHeartbeatMessageReceived(packet);
-                } else if (msg.header.cmdId == 0x8a) {
-                    // Nothing to do yet
-                } else {
-                    qDebug() << "Unknow message id:" << msg.header.cmdId;
-                }
-
-                rxBytes_.remove(0, msgLen);
-            } else {
-                break;
-            }
-        } else {
-            rxBytes_.remove(0, 1);
-        }
+        onHeartbeatMessageReceived(packet);
+    } else if (cmdId == 0x8a) {
+        // Nothing to do yet
+    } else {
+        qDebug() << "Unknow message id:" << cmdId;
     }
 }
 
 QByteArray SiYiTransmitter::packMessage(quint8 control, quint8 cmd,
                        const QByteArray &payload)
 {
-    ProtocolMessageContext ctx;
-    ctx.header.stx = PROTOCOL_STX;
-    ctx.header.control = control;
-    ctx.header.dataLength = payload.length();
-    ctx.header.sequence = sequence();
-    ctx.header.cmdId = cmd;
-    ctx.header.crc = headerCheckSum32(&ctx.header);
-    ctx.data = payload;
-    ctx.crc = packetCheckSum32(&ctx);
+    const quint32 beStx = qToBigEndian<quint32>(PROTOCOL_STX);
+    const quint16 dataLength = quint16(payload.length());
+    const quint16 seq = sequence();
 
+    // Both CRCs are taken over the message as it is built up, no intermediate buffers
     QByteArray msg;
-    quint32 beStx = qToBigEndian<quint32>(ctx.header.stx);
-
-    msg.append(reinterpret_cast<char*>(&beStx), 4);                 // STX
-    msg.append(reinterpret_cast<char*>(&ctx.header.control), 1);    // CTRL
-    msg.append(reinterpret_cast<char*>(&ctx.header.dataLength), 2); // Data_len
-    msg.append(reinterpret_cast<char*>(&ctx.header.sequence), 2);   // SEQ
-    msg.append(reinterpret_cast<char*>(&ctx.header.cmdId), 1);      // CMD_ID
-    msg.append(reinterpret_cast<char*>(&ctx.header.crc), 4);        // CRC32(header)
-    msg.append(ctx.data);                                           // DATA
-    msg.append(reinterpret_cast<char*>(&ctx.crc), 4);               // CRC32(packet)
+    msg.reserve(14 + payload.length() + 4);
+    msg.append(reinterpret_cast<const char*>(&beStx), 4);           // STX
+    msg.append(reinterpret_cast<const char*>(&control), 1);         // CTRL
+    msg.append(reinterpret_cast<const char*>(&dataLength), 2);      // Data_len
+    msg.append(reinterpret_cast<const char*>(&seq), 2);             // SEQ
+    msg.append(reinterpret_cast<const char*>(&cmd), 1);             // CMD_ID
+    const quint32 headerCrc = checkSum32(msg.constData(), msg.length());
+    msg.append(reinterpret_cast<const char*>(&headerCrc), 4);       // CRC32(header)
+    msg.append(payload);                                            // DATA
+    const quint32 packetCrc = checkSum32(msg.constData(), msg.length());
+    msg.append(reinterpret_cast<const char*>(&packetCrc), 4);       // CRC32(packet)
 
     return msg;
 }
 
-quint32 SiYiTransmitter::headerCheckSum32(ProtocolMessageHeaderContext *ctx)
-{
-    if (ctx) {
-        QByteArray bytes;
-        quint32 beStx = qToBigEndian<quint32>(ctx->stx);
-        bytes.append(reinterpret_cast<char*>(&beStx), 4);
-        bytes.append(reinterpret_cast<char*>(&ctx->control), 1);
-        bytes.append(reinterpret_cast<char*>(&ctx->dataLength), 2);
-        bytes.append(reinterpret_cast<char*>(&ctx->sequence), 2);
-        bytes.append(reinterpret_cast<char*>(&ctx->cmdId), 1);
-
-        return checkSum32(bytes);
-    }
-
-    return 0;
-}
-
-quint32 SiYiTransmitter::packetCheckSum32(ProtocolMessageContext *ctx)
-{
-    if (ctx) {
-        QByteArray bytes;
-        quint32 beStx = qToBigEndian<quint32>(ctx->header.stx);
-        bytes.append(reinterpret_cast<char*>(&beStx), 4);
-        bytes.append(reinterpret_cast<char*>(&ctx->header.control), 1);
-        bytes.append(reinterpret_cast<char*>(&ctx->header.dataLength), 2);
-        bytes.append(reinterpret_cast<char*>(&ctx->header.sequence), 2);
-        bytes.append(reinterpret_cast<char*>(&ctx->header.cmdId), 1);
-        bytes.append(reinterpret_cast<char*>(&ctx->header.crc), 4);
-
-        bytes.append(ctx->data);
-
-        return checkSum32(bytes);
-    }
-
-    return 0;
-}
-
 void SiYiTransmitter::onHeartbeatMessageReceived(const QByteArray &msg)
 {
     timeoutCountMutex.lock();
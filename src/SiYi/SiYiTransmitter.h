@@ -46,12 +46,10 @@ public:
     explicit SiYiTransmitter(QObject *parent = nullptr);
 protected:
     QByteArray heartbeatMessage() override;
-    void analyzeMessage() override;
+    void handleMessage(quint8 cmdId, const QByteArray &packet) override;
 private:
     QByteArray packMessage(quint8 control, quint8 cmd,
                            const QByteArray &payload);
-    quint32 headerCheckSum32(ProtocolMessageHeaderContext *ctx);
-    quint32 packetCheckSum32(ProtocolMessageContext *ctx);
     void onHeartbeatMessageReceived(const QByteArray &msg);
 private:
     int signalQuality_{-1};
@@ -22,6 +22,7 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QTimer>
+#include <QMutexLocker>
 #include <QtLocation/private/qgeotilespec_p.h>
 
 #include <cmath>
@@ -463,6 +464,59 @@ bool TerrainTileManager::getAltitudesForCoordinates(const QList<QGeoCoordinate>&
     return true;
 }
 
+bool TerrainTileManager::getCachedAltitudes(const QList<QGeoCoordinate>& coordinates, QList<double>& altitudes, QHash<QString, QGeoCoordinate>& missingTiles, bool& error)
+{
+    error = false;
+    altitudes.clear();
+
+    bool allCached = true;
+
+    QMutexLocker lock(&_tilesMutex);
+
+    if (qgcApp()->runningUnitTests()) {
+        for (const QGeoCoordinate& coordinate: coordinates) {
+            QString tileHash = _getTileHash(coordinate);
+            if (!_unitTestTiles.contains(tileHash)) {
+                allCached = false;
+                if (!missingTiles.contains(tileHash)) {
+                    missingTiles[tileHash] = coordinate;
+                }
+            }
+        }
+        if (allCached) {
+            altitudes = UnitTestTerrainQuery::_requestCoordinateHeights(coordinates);
+            error = altitudes.count() != coordinates.count();
+        }
+        return allCached;
+    }
+
+    for (const QGeoCoordinate& coordinate: coordinates) {
+        QString tileHash = _getTileHash(coordinate);
+
+        auto tileIter = _tiles.constFind(tileHash);
+        if (tileIter == _tiles.constEnd()) {
+            // Keep going so the caller learns about all the missing tiles at once
+            allCached = false;
+            if (!missingTiles.contains(tileHash)) {
+                missingTiles[tileHash] = coordinate;
+            }
+        } else if (allCached) {
+            double elevation = tileIter.value().elevation(coordinate);
+            if (qIsNaN(elevation)) {
+                error = true;
+                qCWarning(TerrainQueryLog) << "TerrainTileManager::getCachedAltitudes Internal Error: missing elevation in tile cache";
+            }
+            altitudes.append(elevation);
+        }
+    }
+
+    if (!allCached) {
+        altitudes.clear();
+    }
+
+    return allCached;
+}
+
 void TerrainTileManager::_tileFailed(void)
 {
     QList<double>    noAltitudes;
@@ -803,6 +857,255 @@ void TerrainPolyPathQuery::_terrainDataReceived(bool success, const TerrainPathQ
     }
 }
 
+TerrainClearanceEngine::TerrainClearanceEngine(QObject* parent)
+    : QObject   (parent)
+    , _worker   (new TerrainClearanceWorker())
+{
+    qRegisterMetaType<TerrainClearanceEngine::SegmentClearance_t>();
+    qRegisterMetaType<QList<TerrainClearanceEngine::SegmentClearance_t>>();
+    qRegisterMetaType<QList<int>>();
+    qRegisterMetaType<QList<QGeoCoordinate>>();
+
+    // The tile manager owns network objects so it must be created on the main thread and not by the first worker pass
+    _terrainTileManager();
+
+    connect(_worker, &TerrainClearanceWorker::segmentsResolved, this, &TerrainClearanceEngine::_segmentsResolved);
+    connect(_worker, &TerrainClearanceWorker::passDone,         this, &TerrainClearanceEngine::_passDone);
+}
+
+TerrainClearanceEngine::~TerrainClearanceEngine()
+{
+    cancel();
+    _worker->stop();
+    _worker->wait();
+    delete _worker;
+}
+
+void TerrainClearanceEngine::requestClearance(const QList<Segment_t>& segments)
+{
+    qCDebug(TerrainQueryLog) << "TerrainClearanceEngine::requestClearance count" << segments.count();
+
+    cancel();
+
+    if (segments.isEmpty()) {
+        emit clearanceComplete(true /* success */);
+        return;
+    }
+
+    _segments               = segments;
+    _inProgress             = true;
+    _missingTilesRequested  = false;
+
+    QList<int> indices;
+    for (int i=0; i<segments.count(); i++) {
+        indices.append(i);
+    }
+    _worker->startPass(_generation, indices, _segments);
+}
+
+void TerrainClearanceEngine::cancel(void)
+{
+    _worker->setGeneration(++_generation);
+    if (_missingTilesQuery) {
+        // We don't care about the results of the tile download any more
+        disconnect(_missingTilesQuery, &TerrainAtCoordinateQuery::terrainDataReceived, this, &TerrainClearanceEngine::_missingTilesReceived);
+        _missingTilesQuery = nullptr;
+    }
+    _segments.clear();
+    _missingIndices.clear();
+    _inProgress = false;
+}
+
+double TerrainClearanceEngine::minClearance(const Segment_t& segment, const TerrainPathQuery::PathHeightInfo_t& pathHeightInfo)
+{
+    double minClearance = qQNaN();
+
+    if (qIsNaN(segment.coord1AMSLAlt) || qIsNaN(segment.coord2AMSLAlt)) {
+        return minClearance;
+    }
+
+    double totalDistance =  segment.coord1.distanceTo(segment.coord2);
+    double slope =          totalDistance > 0 ? (segment.coord2AMSLAlt - segment.coord1AMSLAlt) / totalDistance : 0;
+    double yIntercept =     segment.coord1AMSLAlt;
+
+    double x = 0;
+    for (int i=0; i<pathHeightInfo.heights.count(); i++) {
+        bool ignoreClearance = false;
+        if (segment.ignoreStartMeters > 0 && x < segment.ignoreStartMeters) {
+            ignoreClearance = true;
+        } else if (segment.ignoreEndMeters > 0 && x > totalDistance - segment.ignoreEndMeters) {
+            ignoreClearance = true;
+        }
+
+        if (!ignoreClearance) {
+            double clearance = (slope * x) + yIntercept - pathHeightInfo.heights[i];
+            if (qIsNaN(minClearance) || clearance < minClearance) {
+                minClearance = clearance;
+            }
+        }
+
+        if (i == pathHeightInfo.heights.count() - 2) {
+            x += pathHeightInfo.finalDistanceBetween;
+        } else {
+            x += pathHeightInfo.distanceBetween;
+        }
+    }
+
+    return minClearance;
+}
+
+void TerrainClearanceEngine::_segmentsResolved(quint32 generation, QList<int> indices, QList<TerrainClearanceEngine::SegmentClearance_t> segmentClearances)
+{
+    if (generation != _generation) {
+        return;
+    }
+
+    for (int i=0; i<indices.count(); i++) {
+        emit segmentClearanceReceived(indices[i], segmentClearances[i]);
+    }
+}
+
+void TerrainClearanceEngine::_passDone(quint32 generation, bool error, QList<int> missingIndices, QList<QGeoCoordinate> missingTileCoords)
+{
+    if (generation != _generation) {
+        return;
+    }
+
+    qCDebug(TerrainQueryLog) << "TerrainClearanceEngine::_passDone error:missingSegments:missingTiles" << error << missingIndices.count() << missingTileCoords.count();
+
+    if (error) {
+        _passComplete(false /* success */);
+    } else if (missingIndices.isEmpty()) {
+        _passComplete(true /* success */);
+    } else if (_missingTilesRequested) {
+        qCWarning(TerrainQueryLog) << "TerrainClearanceEngine::_passDone tiles still missing after download";
+        _passComplete(false /* success */);
+    } else {
+        // Download the missing tiles with a single coordinate from each, then run just the segments which needed them again
+        _missingTilesRequested  = true;
+        _missingIndices         = missingIndices;
+        _missingTilesQuery      = new TerrainAtCoordinateQuery(true /* autoDelete */);
+        connect(_missingTilesQuery, &TerrainAtCoordinateQuery::terrainDataReceived, this, &TerrainClearanceEngine::_missingTilesReceived);
+        _missingTilesQuery->requestData(missingTileCoords);
+    }
+}
+
+void TerrainClearanceEngine::_missingTilesReceived(bool success, QList<double> /* heights */)
+{
+    _missingTilesQuery = nullptr;
+
+    if (success) {
+        _worker->startPass(_generation, _missingIndices, _segments);
+    } else {
+        _passComplete(false /* success */);
+    }
+}
+
+void TerrainClearanceEngine::_passComplete(bool success)
+{
+    _inProgress = false;
+    _segments.clear();
+    _missingIndices.clear();
+    emit clearanceComplete(success);
+}
+
+void TerrainClearanceWorker::startPass(quint32 generation, const QList<int>& indices, const QList<TerrainClearanceEngine::Segment_t>& segments)
+{
+    setGeneration(generation);
+
+    QMutexLocker lock(&_mutex);
+    _pendingPass = { generation, indices, segments };
+    _passPending = true;
+    if (_running) {
+        _waitc.wakeAll();
+        return;
+    }
+    _running    = true;
+    _stop       = false;
+    lock.unlock();
+
+    // The thread may still be on its way out from an idle timeout
+    wait();
+    start(QThread::LowPriority);
+}
+
+void TerrainClearanceWorker::stop(void)
+{
+    QMutexLocker lock(&_mutex);
+    _stop           = true;
+    _passPending    = false;
+    _waitc.wakeAll();
+}
+
+void TerrainClearanceWorker::run(void)
+{
+    QMutexLocker lock(&_mutex);
+    while (!_stop) {
+        if (_passPending) {
+            Pass_t pass = _pendingPass;
+            _pendingPass = Pass_t();
+            _passPending = false;
+
+            // Don't need the lock while running the pass
+            lock.unlock();
+            _runPass(pass);
+            lock.relock();
+        } else {
+            _waitc.wait(lock.mutex(), _idleTimeoutMsecs);
+            if (!_passPending) {
+                break;
+            }
+        }
+    }
+    _running = false;
+}
+
+void TerrainClearanceWorker::_runPass(const Pass_t& pass)
+{
+    QList<int>                                          resolvedIndices;
+    QList<TerrainClearanceEngine::SegmentClearance_t>   segmentClearances;
+    QList<int>                                          missingIndices;
+    QHash<QString, QGeoCoordinate>                      missingTiles;
+    bool                                                error = false;
+
+    for (int index: pass.indices) {
+        if (_generation.loadAcquire() != pass.generation) {
+            // Cancelled, the engine isn't interested in anything more from this pass
+            return;
+        }
+
+        const TerrainClearanceEngine::Segment_t&    segment = pass.segments[index];
+        TerrainClearanceEngine::SegmentClearance_t  segmentClearance;
+        bool                                        segmentError;
+
+        QList<QGeoCoordinate> coordinates = TerrainTileManager::pathQueryToCoords(segment.coord1, segment.coord2, segmentClearance.pathHeightInfo.distanceBetween, segmentClearance.pathHeightInfo.finalDistanceBetween);
+        if (!_terrainTileManager()->getCachedAltitudes(coordinates, segmentClearance.pathHeightInfo.heights, missingTiles, segmentError)) {
+            missingIndices.append(index);
+            continue;
+        }
+        if (segmentError) {
+            error = true;
+            break;
+        }
+
+        segmentClearance.minClearance       = TerrainClearanceEngine::minClearance(segment, segmentClearance.pathHeightInfo);
+        segmentClearance.terrainCollision   = segmentClearance.minClearance < 0;
+
+        resolvedIndices.append(index);
+        segmentClearances.append(segmentClearance);
+        if (resolvedIndices.count() == _resultChunkSize) {
+            emit segmentsResolved(pass.generation, resolvedIndices, segmentClearances);
+            resolvedIndices.clear();
+            segmentClearances.clear();
+        }
+    }
+
+    if (resolvedIndices.count()) {
+        emit segmentsResolved(pass.generation, resolvedIndices, segmentClearances);
+    }
+    emit passDone(pass.generation, error, missingIndices, missingTiles.values());
+}
+
 const QGeoCoordinate UnitTestTerrainQuery::pointNemo{-48.875556, -123.392500};
 const UnitTestTerrainQuery::Flat10Region UnitTestTerrainQuery::flat10Region{{
     pointNemo,
@@ -841,6 +1144,13 @@ UnitTestTerrainQuery::UnitTestTerrainQuery(TerrainQueryInterface* parent)
 
 void UnitTestTerrainQuery::requestCoordinateHeights(const QList<QGeoCoordinate>& coordinates) {
     QList<double> result = _requestCoordinateHeights(coordinates);
+    if (result.size() == coordinates.size()) {
+        TerrainTileManager* tileManager = _terrainTileManager();
+        QMutexLocker lock(&tileManager->_tilesMutex);
+        for (const QGeoCoordinate& coordinate: coordinates) {
+            tileManager->_unitTestTiles.insert(tileManager->_getTileHash(coordinate));
+        }
+    }
     emit qobject_cast<TerrainQueryInterface*>(parent())->coordinateHeightsReceived(result.size() == coordinates.size(), result);
 }
 
@@ -883,6 +1193,20 @@ void UnitTestTerrainQuery::requestCarpetHeights(const QGeoCoordinate& swCoord, c
     emit qobject_cast<TerrainQueryInterface*>(parent())->carpetHeightsReceived(true, min, max, carpet);
 }
 
+void UnitTestTerrainQuery::clearCachedTiles(void)
+{
+    TerrainTileManager* tileManager = _terrainTileManager();
+    QMutexLocker lock(&tileManager->_tilesMutex);
+    tileManager->_unitTestTiles.clear();
+}
+
+int UnitTestTerrainQuery::cachedTileCount(void)
+{
+    TerrainTileManager* tileManager = _terrainTileManager();
+    QMutexLocker lock(&tileManager->_tilesMutex);
+    return tileManager->_unitTestTiles.count();
+}
+
 UnitTestTerrainQuery::PathHeightInfo_t UnitTestTerrainQuery::_requestPathHeights(const QGeoCoordinate& fromCoord, const QGeoCoordinate& toCoord)
 {
     PathHeightInfo_t   pathHeights;
@@ -19,12 +19,18 @@
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QTimer>
+#include <QThread>
+#include <QMutex>
+#include <QSet>
+#include <QWaitCondition>
+#include <QAtomicInteger>
 #include <QtLocation/private/qgeotiledmapreply_p.h>
 
 Q_DECLARE_LOGGING_CATEGORY(TerrainQueryLog)
 Q_DECLARE_LOGGING_CATEGORY(TerrainQueryVerboseLog)
 
 class TerrainAtCoordinateQuery;
+class TerrainClearanceWorker;
 
 /// Base class for offline/online terrain queries
 class TerrainQueryInterface : public QObject
@@ -113,6 +119,8 @@ public:
 class TerrainTileManager : public QObject {
     Q_OBJECT
 
+    friend class UnitTestTerrainQuery;
+
 public:
     TerrainTileManager(void);
 
@@ -120,6 +128,12 @@ public:
     void addPathQuery               (TerrainOfflineAirMapQuery* terrainQueryInterface, const QGeoCoordinate& startPoint, const QGeoCoordinate& endPoint);
     bool getAltitudesForCoordinates (const QList<QGeoCoordinate>& coordinates, QList<double>& altitudes, bool& error);
 
+    /// Returns altitudes from the tile cache only, missing tiles are not downloaded. Safe to call from any thread.
+    ///     @param[out] missingTiles One coordinate for each tile which is not in the cache, keyed by tile hash
+    ///     @param[out] error true: altitude not returned due to error, false: altitudes returned
+    /// @return true: altitudes returned (check error as well), false: tiles missing from cache
+    bool getCachedAltitudes         (const QList<QGeoCoordinate>& coordinates, QList<double>& altitudes, QHash<QString, QGeoCoordinate>& missingTiles, bool& error);
+
     static QList<QGeoCoordinate> pathQueryToCoords(const QGeoCoordinate& fromCoord, const QGeoCoordinate& toCoord, double& distanceBetween, double& finalDistanceBetween);
 
 private slots:
@@ -154,6 +168,7 @@ private:
 
     QMutex                      _tilesMutex;
     QHash<QString, TerrainTile> _tiles;
+    QSet<QString>               _unitTestTiles;     ///< Tiles "downloaded" by unit test coordinate queries, stands in for _tiles
 };
 
 /// Used internally by TerrainAtCoordinateQuery to batch coordinate requests together
@@ -298,11 +313,124 @@ private:
     TerrainPathQuery                            _pathQuery;
 };
 
+/// Computes the terrain clearance along all the segments of a flight path in a single pass.
+///
+/// The heights are read from the terrain tile cache on a background thread, so a large plan doesn't hold up the ui.
+/// Segments are signalled in chunks as they are resolved. Segments which need tiles missing from the cache are
+/// collected, the missing tiles are downloaded once and then only those segments are run again. A new request
+/// cancels the pass in progress, nothing more is signalled for it.
+///
+/// NOTE: All calls must be made from the main thread.
+class TerrainClearanceEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    TerrainClearanceEngine(QObject* parent = nullptr);
+    ~TerrainClearanceEngine();
+
+    typedef struct {
+        QGeoCoordinate  coord1;
+        QGeoCoordinate  coord2;
+        double          coord1AMSLAlt;      ///< NaN: Only terrain heights are needed, no clearance
+        double          coord2AMSLAlt;
+        double          ignoreStartMeters;  ///< Distance from start of segment which isn't checked for clearance
+        double          ignoreEndMeters;    ///< Distance from end of segment which isn't checked for clearance
+    } Segment_t;
+
+    typedef struct {
+        TerrainPathQuery::PathHeightInfo_t  pathHeightInfo;
+        double                              minClearance;       ///< Lowest height of the flight path above terrain, NaN if not available
+        bool                                terrainCollision;
+    } SegmentClearance_t;
+
+    /// Starts a new pass over the specified segments, any pass in progress is cancelled.
+    /// Signals: segmentClearanceReceived for each segment, clearanceComplete at the end of the pass
+    void requestClearance(const QList<Segment_t>& segments);
+
+    /// Cancels the pass in progress
+    void cancel(void);
+
+    bool inProgress(void) const { return _inProgress; }
+
+    /// @return Lowest height of the flight path above terrain along the segment, NaN if it can't be calculated
+    static double minClearance(const Segment_t& segment, const TerrainPathQuery::PathHeightInfo_t& pathHeightInfo);
+
+signals:
+    void segmentClearanceReceived   (int index, const TerrainClearanceEngine::SegmentClearance_t& segmentClearance);
+    void clearanceComplete          (bool success);
+
+private slots:
+    void _segmentsResolved      (quint32 generation, QList<int> indices, QList<TerrainClearanceEngine::SegmentClearance_t> segmentClearances);
+    void _passDone              (quint32 generation, bool error, QList<int> missingIndices, QList<QGeoCoordinate> missingTileCoords);
+    void _missingTilesReceived  (bool success, QList<double> heights);
+
+private:
+    void _passComplete          (bool success);
+
+    TerrainClearanceWorker*     _worker;
+    quint32                     _generation             = 0;
+    bool                        _inProgress             = false;
+    bool                        _missingTilesRequested  = false;
+    QList<Segment_t>            _segments;
+    QList<int>                  _missingIndices;
+    TerrainAtCoordinateQuery*   _missingTilesQuery      = nullptr;
+};
+
+Q_DECLARE_METATYPE(TerrainClearanceEngine::SegmentClearance_t)
+
+/// Used internally by TerrainClearanceEngine to run passes on a background thread
+class TerrainClearanceWorker : public QThread
+{
+    Q_OBJECT
+
+public:
+    TerrainClearanceWorker(void) = default;
+
+    /// Queues a pass over the specified segments. Replaces a queued pass which hasn't started yet.
+    void startPass      (quint32 generation, const QList<int>& indices, const QList<TerrainClearanceEngine::Segment_t>& segments);
+
+    /// A running pass stops at the next segment if its generation doesn't match
+    void setGeneration  (quint32 generation) { _generation.storeRelease(generation); }
+
+    /// Stops the thread, call wait() after this
+    void stop           (void);
+
+signals:
+    void segmentsResolved   (quint32 generation, QList<int> indices, QList<TerrainClearanceEngine::SegmentClearance_t> segmentClearances);
+    void passDone           (quint32 generation, bool error, QList<int> missingIndices, QList<QGeoCoordinate> missingTileCoords);
+
+protected:
+    void run(void) final;
+
+private:
+    typedef struct {
+        quint32                                     generation;
+        QList<int>                                  indices;
+        QList<TerrainClearanceEngine::Segment_t>    segments;
+    } Pass_t;
+
+    void _runPass(const Pass_t& pass);
+
+    QMutex                  _mutex;
+    QWaitCondition          _waitc;
+    Pass_t                  _pendingPass;
+    bool                    _passPending    = false;
+    bool                    _running        = false;
+    bool                    _stop           = false;
+    QAtomicInteger<quint32> _generation;
+
+    static const int _resultChunkSize   = 50;   ///< Number of resolved segments signalled together
+    static const int _idleTimeoutMsecs  = 5000; ///< Thread exits when idle for this long
+};
+
 /// @brief Provides unit test terrain query responses.
 /// @details It provides preset, emulated, 1 arc-second (SRTM1) resolution regions that are either
 /// flat or sloped in a fashion that aids testing terrain-sensitive functionality. All emulated
 /// regions are positioned around Point Nemo - should real terrain became useful and checked in one day.
 class UnitTestTerrainQuery : public TerrainQueryInterface {
+    friend class TerrainTileManager;
+
 public:
 
     static constexpr double regionSizeDeg     = 0.1;      // all regions are 0.1deg (~11km) square
@@ -359,6 +487,11 @@ public:
     void requestPathHeights         (const QGeoCoordinate& fromCoord, const QGeoCoordinate& toCoord) override;
     void requestCarpetHeights       (const QGeoCoordinate& swCoord, const QGeoCoordinate& neCoord, bool statsOnly) override;
 
+    /// Successful coordinate queries add the tiles they cover to the terrain tile cache, the same as a real download
+    /// does. Clearing them makes the next cache only lookup miss those tiles again.
+    static void clearCachedTiles    (void);
+    static int  cachedTileCount     (void);
+
 private:
     typedef struct {
         QList<QGeoCoordinate>   rgCoords;
@@ -367,7 +500,7 @@ private:
         double                  finalDistanceBetween;
     } PathHeightInfo_t;
 
-    QList<double> _requestCoordinateHeights(const QList<QGeoCoordinate>& coordinates);
+    static QList<double> _requestCoordinateHeights(const QList<QGeoCoordinate>& coordinates);
     PathHeightInfo_t _requestPathHeights(const QGeoCoordinate& fromCoord, const QGeoCoordinate& toCoord);
 };
 
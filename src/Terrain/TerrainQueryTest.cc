@@ -0,0 +1,171 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TerrainQueryTest.h"
+#include "TerrainQuery.h"
+#include "FlightPathSegment.h"
+
+void TerrainQueryTest::_testTerrainClearance(void)
+{
+    TerrainClearanceEngine  engine;
+    QSignalSpy              clearanceSpy(&engine, &TerrainClearanceEngine::segmentClearanceReceived);
+    QSignalSpy              completeSpy (&engine, &TerrainClearanceEngine::clearanceComplete);
+
+    // Flat region is 10m AMSL: first segment clears it by 10m, second one dips into it, third only wants heights
+    QGeoCoordinate                      coord1 = UnitTestTerrainQuery::flat10Region.center();
+    QGeoCoordinate                      coord2 = coord1.atDistanceAndAzimuth(500, 90);
+    TerrainClearanceEngine::Segment_t   clearSegment    = { coord1, coord2, 20, 20, 0, 0 };
+    TerrainClearanceEngine::Segment_t   collideSegment  = { coord1, coord2, 20, 5, 0, 0 };
+    TerrainClearanceEngine::Segment_t   heightsSegment  = { coord1, coord2, qQNaN(), qQNaN(), 0, 0 };
+
+    // A new request cancels the previous one, nothing is signalled for it
+    engine.requestClearance({ clearSegment, clearSegment, clearSegment, clearSegment });
+    engine.requestClearance({ clearSegment, collideSegment, heightsSegment });
+    QVERIFY(engine.inProgress());
+    QVERIFY(completeSpy.wait(5000));
+    QVERIFY(!engine.inProgress());
+    QCOMPARE(completeSpy.count(), 1);
+    QCOMPARE(completeSpy[0][0].toBool(), true);
+    QCOMPARE(clearanceSpy.count(), 3);
+
+    for (const QList<QVariant>& args: clearanceSpy) {
+        int                                         index               = args[0].toInt();
+        TerrainClearanceEngine::SegmentClearance_t  segmentClearance    = args[1].value<TerrainClearanceEngine::SegmentClearance_t>();
+        QVERIFY(segmentClearance.pathHeightInfo.heights.count() > 1);
+        switch (index) {
+        case 0:
+            QCOMPARE(segmentClearance.minClearance, 10.0);
+            QVERIFY(!segmentClearance.terrainCollision);
+            break;
+        case 1:
+            QCOMPARE(segmentClearance.minClearance, -5.0);
+            QVERIFY(segmentClearance.terrainCollision);
+            break;
+        case 2:
+            QVERIFY(qIsNaN(segmentClearance.minClearance));
+            QVERIFY(!segmentClearance.terrainCollision);
+            break;
+        default:
+            QFAIL("Unexpected segment index");
+        }
+    }
+
+    // Segment which leaves the test regions has no terrain data
+    clearanceSpy.clear();
+    completeSpy.clear();
+    TerrainClearanceEngine::Segment_t noTerrainSegment = { coord1, UnitTestTerrainQuery::pointNemo.atDistanceAndAzimuth(1000, 0), 20, 20, 0, 0 };
+    engine.requestClearance({ noTerrainSegment });
+    QVERIFY(completeSpy.wait(5000));
+    QCOMPARE(completeSpy[0][0].toBool(), false);
+    QCOMPARE(clearanceSpy.count(), 0);
+}
+
+void TerrainQueryTest::_testTerrainClearanceMissingTiles(void)
+{
+    TerrainClearanceEngine  engine;
+    QSignalSpy              clearanceSpy(&engine, &TerrainClearanceEngine::segmentClearanceReceived);
+    QSignalSpy              completeSpy (&engine, &TerrainClearanceEngine::clearanceComplete);
+
+    // One segment in each region, so the pass misses several tiles at once
+    QGeoCoordinate flatCoord    = UnitTestTerrainQuery::flat10Region.center();
+    QGeoCoordinate slopeCoord   = UnitTestTerrainQuery::linearSlopeRegion.center();
+    QGeoCoordinate hillCoord    = UnitTestTerrainQuery::hillRegion.center();
+    QList<TerrainClearanceEngine::Segment_t> segments = {
+        { flatCoord,    flatCoord.atDistanceAndAzimuth(500, 90),    20, 20, 0, 0 },
+        { slopeCoord,   slopeCoord.atDistanceAndAzimuth(500, 90),   2000, 2000, 0, 0 },
+        { hillCoord,    hillCoord.atDistanceAndAzimuth(500, 90),    qQNaN(), qQNaN(), 0, 0 },
+    };
+
+    // Nothing cached: the first pass resolves nothing, the missing tiles are downloaded and the segments run again
+    UnitTestTerrainQuery::clearCachedTiles();
+    engine.requestClearance(segments);
+    QVERIFY(completeSpy.wait(5000));
+    QCOMPARE(completeSpy[0][0].toBool(), true);
+    QCOMPARE(clearanceSpy.count(), segments.count());
+    QVERIFY(UnitTestTerrainQuery::cachedTileCount() > 0);
+
+    QList<int> indices;
+    for (const QList<QVariant>& args: clearanceSpy) {
+        indices.append(args[0].toInt());
+        TerrainClearanceEngine::SegmentClearance_t segmentClearance = args[1].value<TerrainClearanceEngine::SegmentClearance_t>();
+        QVERIFY(segmentClearance.pathHeightInfo.heights.count() > 1);
+    }
+    std::sort(indices.begin(), indices.end());
+    QCOMPARE(indices, QList<int>({ 0, 1, 2 }));
+
+    // Tiles are cached now, so the same request is resolved without another download
+    const int cachedTileCount = UnitTestTerrainQuery::cachedTileCount();
+    clearanceSpy.clear();
+    completeSpy.clear();
+    engine.requestClearance(segments);
+    QVERIFY(completeSpy.wait(5000));
+    QCOMPARE(completeSpy[0][0].toBool(), true);
+    QCOMPARE(clearanceSpy.count(), segments.count());
+    QCOMPARE(UnitTestTerrainQuery::cachedTileCount(), cachedTileCount);
+
+    // Cancelling before the missing tiles arrive drops the pass, nothing is signalled for it
+    UnitTestTerrainQuery::clearCachedTiles();
+    clearanceSpy.clear();
+    completeSpy.clear();
+    engine.requestClearance(segments);
+    engine.cancel();
+    QVERIFY(!completeSpy.wait(1000));
+    QCOMPARE(clearanceSpy.count(), 0);
+}
+
+void TerrainQueryTest::_testFlightPathSegmentClearance(void)
+{
+    QGeoCoordinate coord1 = UnitTestTerrainQuery::flat10Region.center();
+    QGeoCoordinate coord2 = coord1.atDistanceAndAzimuth(500, 90);
+
+    FlightPathSegment segment(FlightPathSegment::SegmentTypeGeneric, coord1, 20, coord2, 5, false /* queryTerrainData */, nullptr);
+    QVERIFY(segment.amslTerrainHeights().isEmpty());
+    QVERIFY(!segment.terrainCollision());
+
+    // Collision is checked against the current altitudes, not the ones the engine had
+    TerrainClearanceEngine::SegmentClearance_t segmentClearance;
+    segmentClearance.pathHeightInfo.distanceBetween         = 100;
+    segmentClearance.pathHeightInfo.finalDistanceBetween    = 100;
+    segmentClearance.pathHeightInfo.heights                 = { 10, 10, 10, 10, 10, 10 };
+    segmentClearance.minClearance                           = 10;
+    segmentClearance.terrainCollision                       = false;
+    segment.setTerrainClearance(segmentClearance);
+    QCOMPARE(segment.amslTerrainHeights().count(), 6);
+    QVERIFY(segment.terrainCollision());
+    QCOMPARE(segment.distanceBetween(), 100.0);
+
+    // Altitude edits after the pass update collision from the same heights
+    segment.setCoord2AMSLAlt(20);
+    QVERIFY(!segment.terrainCollision());
+    QCOMPARE(segment.amslTerrainHeights().count(), 6);
+    segment.setCoord1AMSLAlt(5);
+    QVERIFY(segment.terrainCollision());
+    segment.setCoord1AMSLAlt(20);
+    QVERIFY(!segment.terrainCollision());
+
+    segment.setCoord2AMSLAlt(5);
+    QVERIFY(segment.terrainCollision());
+
+    // Heights along the old path are dropped as soon as the segment moves, even without its own query
+    segment.setCoordinate2(coord1.atDistanceAndAzimuth(500, 0));
+    QVERIFY(segment.amslTerrainHeights().isEmpty());
+    QVERIFY(!segment.terrainCollision());
+    QCOMPARE(segment.distanceBetween(), 0.0);
+
+    segment.setTerrainClearance(segmentClearance);
+    segment.setCoordinate1(coord1.atDistanceAndAzimuth(100, 180));
+    QVERIFY(segment.amslTerrainHeights().isEmpty());
+    QVERIFY(!segment.terrainCollision());
+
+    // A pass which couldn't resolve the segment clears it as well
+    segment.setTerrainClearance(segmentClearance);
+    segment.clearTerrainData();
+    QVERIFY(segment.amslTerrainHeights().isEmpty());
+    QVERIFY(!segment.terrainCollision());
+}
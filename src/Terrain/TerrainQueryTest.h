@@ -0,0 +1,23 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Runs TerrainClearanceEngine against the UnitTestTerrainQuery regions
+class TerrainQueryTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testTerrainClearance              (void);
+    void _testTerrainClearanceMissingTiles  (void);
+    void _testFlightPathSegmentClearance    (void);
+};
@@ -18,6 +18,8 @@
 #include <QJsonDocument>
 #include <QJsonArray>
 
+#include <algorithm>
+
 QGC_LOGGING_CATEGORY(CompInfoParamLog, "CompInfoParamLog")
 
 const char* CompInfoParam::_jsonParametersKey           = "parameters";
@@ -79,6 +81,7 @@ void CompInfoParam::setJson(const QString& metadataJsonFileName, const QString&
 
         if (newMetaData->name().contains(_indexedNameTag)) {
             _indexedNameMetaDataList.append(RegexFactMetaDataPair_t(newMetaData->name(), newMetaData));
+            _indexedNameRegexCompiled = false;
         } else {
             _nameToMetaDataMap[newMetaData->name()] = newMetaData;
         }
@@ -101,29 +104,7 @@ FactMetaData* CompInfoParam::factMetaDataForName(const QString& name, FactMetaDa
             factMetaData = _nameToMetaDataMap[name];
         } else {
             // We didn't get any direct matches. Try an indexed name.
-            for (int i=0; i<_indexedNameMetaDataList.count(); i++) {
-                const RegexFactMetaDataPair_t& pair = _indexedNameMetaDataList[i];
-
-                QString indexedName = pair.first;
-                QString indexedRegex("(\\d+)");
-                indexedName.replace(_indexedNameTag, indexedRegex);
-
-                QRegularExpression      regex(indexedName);
-                QRegularExpressionMatch match = regex.match(name);
-
-                QStringList captured = match.capturedTexts();
-                if (captured.count() == 2) {
-                    factMetaData = new FactMetaData(*pair.second, this);
-                    factMetaData->setName(name);
-
-                    QString shortDescription = factMetaData->shortDescription();
-                    shortDescription.replace(_indexedNameTag, captured[1]);
-                    factMetaData->setShortDescription(shortDescription);
-                    QString longDescription = factMetaData->shortDescription();
-                    longDescription.replace(_indexedNameTag, captured[1]);
-                    factMetaData->setLongDescription(longDescription);
-                }
-            }
+            factMetaData = _indexedNameFactMetaData(name);
 
             if (!factMetaData) {
                 factMetaData = new FactMetaData(type, this);
@@ -142,6 +123,70 @@ FactMetaData* CompInfoParam::factMetaDataForName(const QString& name, FactMetaDa
     return factMetaData;
 }
 
+/// Compiles all indexed names into a single regular expression so that a lookup is a single match
+/// instead of building and running one regular expression per indexed name.
+void CompInfoParam::_compileIndexedNameRegex(void)
+{
+    QStringList alternatives;
+    int         captureCount = 0;
+
+    _indexedNameCaptureStart.clear();
+    for (const RegexFactMetaDataPair_t& pair: _indexedNameMetaDataList) {
+        QStringList literalParts = pair.first.split(_indexedNameTag);
+        for (QString& literalPart: literalParts) {
+            literalPart = QRegularExpression::escape(literalPart);
+        }
+        _indexedNameCaptureStart.append(captureCount + 1);
+        captureCount += literalParts.count() - 1;
+        alternatives.append(literalParts.join(QStringLiteral("(\\d+)")));
+    }
+
+    _indexedNameRegex.setPattern(QStringLiteral("^(?:") + alternatives.join(QLatin1Char('|')) + QStringLiteral(")$"));
+    _indexedNameRegex.optimize();
+    if (!_indexedNameRegex.isValid()) {
+        qCWarning(CompInfoParamLog) << "Indexed name regex compile failed" << _indexedNameRegex.errorString();
+    }
+    _indexedNameRegexCompiled = true;
+}
+
+/// @return Newly created meta data for name if it matches an indexed name, nullptr for no match
+FactMetaData* CompInfoParam::_indexedNameFactMetaData(const QString& name)
+{
+    if (_indexedNameMetaDataList.isEmpty()) {
+        return nullptr;
+    }
+    if (!_indexedNameRegexCompiled) {
+        _compileIndexedNameRegex();
+    }
+
+    QRegularExpressionMatch match = _indexedNameRegex.match(name);
+    if (!match.hasMatch()) {
+        return nullptr;
+    }
+
+    // Only the matching alternative captures, so the last captured group identifies which indexed name matched
+    int lastCaptured = match.lastCapturedIndex();
+    int pairIndex = static_cast<int>(std::upper_bound(_indexedNameCaptureStart.cbegin(), _indexedNameCaptureStart.cend(), lastCaptured) - _indexedNameCaptureStart.cbegin()) - 1;
+    if (pairIndex < 0) {
+        return nullptr;
+    }
+
+    const RegexFactMetaDataPair_t&  pair            = _indexedNameMetaDataList[pairIndex];
+    QString                         index           = match.captured(_indexedNameCaptureStart[pairIndex]);
+    FactMetaData*                   factMetaData    = new FactMetaData(*pair.second, this);
+
+    factMetaData->setName(name);
+
+    QString shortDescription = factMetaData->shortDescription();
+    shortDescription.replace(_indexedNameTag, index);
+    factMetaData->setShortDescription(shortDescription);
+    QString longDescription = factMetaData->longDescription();
+    longDescription.replace(_indexedNameTag, index);
+    factMetaData->setLongDescription(longDescription);
+
+    return factMetaData;
+}
+
 FirmwarePlugin* CompInfoParam::_anyVehicleTypeFirmwarePlugin(MAV_AUTOPILOT firmwareType)
 {
     FirmwarePluginManager*  pluginMgr               = qgcApp()->toolbox()->firmwarePluginManager();
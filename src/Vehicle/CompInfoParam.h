@@ -15,6 +15,7 @@
 #include "FactMetaData.h"
 
 #include <QObject>
+#include <QRegularExpression>
 
 class FactMetaData;
 class Vehicle;
@@ -37,7 +38,9 @@ public:
     static void _cachePX4MetaDataFile(const QString& metaDataFile);
 
 private:
-    QObject* _getOpaqueParameterMetaData(void);
+    QObject*        _getOpaqueParameterMetaData     (void);
+    void            _compileIndexedNameRegex        (void);
+    FactMetaData*   _indexedNameFactMetaData        (const QString& name);
 
     static FirmwarePlugin*  _anyVehicleTypeFirmwarePlugin   (MAV_AUTOPILOT firmwareType);
     static QString          _parameterMetaDataFile          (Vehicle* vehicle, MAV_AUTOPILOT firmwareType, int& majorVersion, int& minorVersion);
@@ -47,6 +50,9 @@ private:
     bool                                _noJsonMetadata             = true;
     FactMetaData::NameToMetaDataMap_t   _nameToMetaDataMap;
     QList<RegexFactMetaDataPair_t>      _indexedNameMetaDataList;
+    bool                                _indexedNameRegexCompiled   = false;
+    QRegularExpression                  _indexedNameRegex;              ///< All indexed names compiled into a single anchored alternation
+    QList<int>                          _indexedNameCaptureStart;       ///< First capture group of each _indexedNameMetaDataList entry within _indexedNameRegex
     QObject*                            _opaqueParameterMetaData    = nullptr;
 
     static const char* _cachedMetaDataFilePrefix;
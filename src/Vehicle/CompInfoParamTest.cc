@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "CompInfoParamTest.h"
+#include "CompInfoParam.h"
+#include "JsonHelper.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+
+QString CompInfoParamTest::_writeMetaDataFile(const QJsonArray& rgParameters)
+{
+    QJsonObject jsonObj;
+    jsonObj[JsonHelper::jsonVersionKey] = 1;
+    jsonObj["parameters"]               = rgParameters;
+
+    QFile file(_tempDir.filePath("Parameter.MetaData.json"));
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        return QString();
+    }
+    file.write(QJsonDocument(jsonObj).toJson());
+    return file.fileName();
+}
+
+void CompInfoParamTest::_indexedNameMatch(void)
+{
+    QJsonArray rgParameters = {
+        QJsonObject { { "name", "TEST_PLAIN" },             { "type", "Int32" }, { "shortDesc", "Plain" } },
+        QJsonObject { { "name", "TEST_{n}_FUNC" },          { "type", "Int32" }, { "shortDesc", "Function {n}" },   { "longDesc", "Function for output {n}" } },
+        QJsonObject { { "name", "TEST_{n}_FUNC_REV" },      { "type", "Int32" }, { "shortDesc", "Reverse {n}" } },
+        QJsonObject { { "name", "TEST.DOT{n}" },            { "type", "Float" }, { "shortDesc", "Dot {n}" } },
+    };
+    QString metaDataFile = _writeMetaDataFile(rgParameters);
+    QVERIFY(!metaDataFile.isEmpty());
+
+    CompInfoParam compInfoParam(MAV_COMP_ID_AUTOPILOT1, nullptr);
+    compInfoParam.setJson(metaDataFile, QString());
+
+    FactMetaData* metaData = compInfoParam.factMetaDataForName("TEST_PLAIN", FactMetaData::valueTypeInt32);
+    QCOMPARE(metaData->shortDescription(), QStringLiteral("Plain"));
+
+    metaData = compInfoParam.factMetaDataForName("TEST_12_FUNC", FactMetaData::valueTypeInt32);
+    QCOMPARE(metaData->name(),              QStringLiteral("TEST_12_FUNC"));
+    QCOMPARE(metaData->shortDescription(),  QStringLiteral("Function 12"));
+    QCOMPARE(metaData->longDescription(),   QStringLiteral("Function for output 12"));
+
+    // Second lookup must return the memoized meta data
+    QCOMPARE(compInfoParam.factMetaDataForName("TEST_12_FUNC", FactMetaData::valueTypeInt32), metaData);
+
+    // Indexed names must match the full parameter name, not a substring of it
+    metaData = compInfoParam.factMetaDataForName("TEST_3_FUNC_REV", FactMetaData::valueTypeInt32);
+    QCOMPARE(metaData->shortDescription(), QStringLiteral("Reverse 3"));
+
+    // Regex special characters in names are literal
+    metaData = compInfoParam.factMetaDataForName("TEST.DOT7", FactMetaData::valueTypeFloat);
+    QCOMPARE(metaData->shortDescription(), QStringLiteral("Dot 7"));
+    metaData = compInfoParam.factMetaDataForName("TESTXDOT7", FactMetaData::valueTypeFloat);
+    QVERIFY(metaData->shortDescription().isEmpty());
+
+    // Unknown names fall back to default meta data grouped by prefix
+    metaData = compInfoParam.factMetaDataForName("OTHER_PARAM", FactMetaData::valueTypeInt32);
+    QVERIFY(metaData->shortDescription().isEmpty());
+    QCOMPARE(metaData->group(), QStringLiteral("OTHER"));
+}
+
+/// Turns each numbered parameter from the MockLink PX4 meta data into an indexed name and times lookups of
+/// unseen indices against the resulting set of indexed names.
+void CompInfoParamTest::_indexedNameLookupBenchmark(void)
+{
+    QString         errorString;
+    QJsonDocument   jsonDoc;
+    QVERIFY2(JsonHelper::isJsonFile(":MockLink/Parameter.MetaData.json", jsonDoc, errorString), qPrintable(errorString));
+
+    QJsonArray          rgParameters = jsonDoc.object()["parameters"].toArray();
+    QStringList         indexedNames;
+    QRegularExpression  digitsRegex("\\d+");
+    for (int i=0; i<rgParameters.count(); i++) {
+        QJsonObject parameterObj    = rgParameters[i].toObject();
+        QString     name            = parameterObj["name"].toString();
+        QRegularExpressionMatch match = digitsRegex.match(name);
+        if (match.hasMatch()) {
+            QString indexedName = name;
+            indexedName.replace(match.capturedStart(), match.capturedLength(), "{n}");
+            if (!indexedNames.contains(indexedName)) {
+                indexedNames.append(indexedName);
+                parameterObj["name"] = indexedName;
+                rgParameters.append(parameterObj);
+            }
+        }
+    }
+    QVERIFY(indexedNames.count() > 100);
+
+    QString metaDataFile = _writeMetaDataFile(rgParameters);
+    QVERIFY(!metaDataFile.isEmpty());
+
+    CompInfoParam compInfoParam(MAV_COMP_ID_AUTOPILOT1, nullptr);
+    compInfoParam.setJson(metaDataFile, QString());
+
+    // Each benchmark iteration uses new indices so lookups are not served from the memoized name map
+    int iteration = 0;
+    QBENCHMARK {
+        iteration++;
+        for (const QString& indexedName: indexedNames) {
+            QString name = indexedName;
+            name.replace("{n}", QString::number(1000 + iteration));
+            FactMetaData* metaData = compInfoParam.factMetaDataForName(name, FactMetaData::valueTypeInt32);
+            QCOMPARE(metaData->name(), name);
+        }
+    }
+}
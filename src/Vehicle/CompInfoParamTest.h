@@ -0,0 +1,28 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QTemporaryDir>
+
+class CompInfoParamTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _indexedNameMatch          (void);
+    void _indexedNameLookupBenchmark(void);
+
+private:
+    QString _writeMetaDataFile      (const QJsonArray& rgParameters);
+
+    QTemporaryDir _tempDir;
+};
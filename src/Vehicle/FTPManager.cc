@@ -81,8 +81,64 @@ bool FTPManager::download(const QString& fromURI, const QString& toDir)
     return true;
 }
 
+bool FTPManager::upload(const QString& toURI, const QString& fromFile)
+{
+    qCDebug(FTPManagerLog) << "upload fromFile:" << fromFile << "to:" << toURI;
+
+    if (!_rgStateMachine.isEmpty()) {
+        qCDebug(FTPManagerLog) << "Cannot upload. Already in another operation";
+        return false;
+    }
+
+    _uploadState.reset();
+
+    QFile file(fromFile);
+    if (!file.open(QFile::ReadOnly)) {
+        qCWarning(FTPManagerLog) << "upload: local file open failed" << file.errorString();
+        return false;
+    }
+    _uploadState.bytes = file.readAll();
+    file.close();
+
+    if (!_parseURI(toURI, _uploadState.fullPathOnVehicle, _ftpCompId)) {
+        qCWarning(FTPManagerLog) << "_parseURI failed";
+        _uploadState.reset();
+        return false;
+    }
+    _uploadState.fromFile = fromFile;
+
+    static const StateFunctions_t rgUploadStateMachine[] = {
+        { &FTPManager::_createFileBegin,            &FTPManager::_createFileAckOrNak,           &FTPManager::_createFileTimeout },
+        { &FTPManager::_writeFileBegin,             &FTPManager::_writeFileAckOrNak,            &FTPManager::_writeFileTimeout },
+        { &FTPManager::_closeUploadBegin,           &FTPManager::_closeUploadAckOrNak,          &FTPManager::_closeUploadTimeout },
+        { &FTPManager::_uploadCompleteNoError,      nullptr,                                    nullptr },
+    };
+    for (size_t i=0; i<sizeof(rgUploadStateMachine)/sizeof(rgUploadStateMachine[0]); i++) {
+        _rgStateMachine.append(rgUploadStateMachine[i]);
+    }
+
+    _startStateMachine();
+
+    return true;
+}
+
 void FTPManager::cancel()
 {
+    if (_uploadState.inProgress()) {
+        _ackOrNakTimeoutTimer.stop();
+        _rgStateMachine.clear();
+        static const StateFunctions_t rgCloseUploadStateMachine[] = {
+            { &FTPManager::_closeUploadBegin,       &FTPManager::_closeUploadAckOrNak,          &FTPManager::_closeUploadTimeout },
+            { &FTPManager::_uploadAborted,          nullptr,                                    nullptr },
+        };
+        for (size_t i=0; i<sizeof(rgCloseUploadStateMachine)/sizeof(rgCloseUploadStateMachine[0]); i++) {
+            _rgStateMachine.append(rgCloseUploadStateMachine[i]);
+        }
+        _uploadState.retryCount = 0;
+        _startStateMachine();
+        return;
+    }
+
     if (!_downloadState.inProgress()) {
         return;
     }
@@ -164,6 +220,22 @@ void FTPManager::_downloadComplete(const QString& errorMsg)
     emit downloadComplete(downloadFilePath, errorMsg);
 }
 
+/// Closes out an upload session.
+///     @param errorMsg Error message, empty if no error
+void FTPManager::_uploadComplete(const QString& errorMsg)
+{
+    qCDebug(FTPManagerLog) << QString("_uploadComplete: errorMsg(%1)").arg(errorMsg);
+
+    QString fromFile = _uploadState.fromFile;
+
+    _ackOrNakTimeoutTimer.stop();
+    _rgStateMachine.clear();
+    _currentStateMachineIndex = -1;
+    _uploadState.reset();
+
+    emit uploadComplete(fromFile, errorMsg);
+}
+
 void FTPManager::_mavlinkMessageReceived(const mavlink_message_t& message)
 {
     if (message.msgid != MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL || message.compid != _ftpCompId) {
@@ -582,6 +654,180 @@ void FTPManager::_resetSessionsTimeout(void)
     _downloadComplete(QString());
 }
 
+void FTPManager::_createFileBegin(void)
+{
+    MavlinkFTP::Request request{};
+    request.hdr.session = 0;
+    request.hdr.opcode  = MavlinkFTP::kCmdCreateFile;
+    request.hdr.offset  = 0;
+    request.hdr.size    = 0;
+    _fillRequestDataWithString(&request, _uploadState.fullPathOnVehicle);
+    _sendRequestExpectAck(&request);
+}
+
+void FTPManager::_createFileTimeout(void)
+{
+    if (++_uploadState.retryCount > _maxRetry) {
+        qCDebug(FTPManagerLog) << QString("_createFileTimeout retries exceeded");
+        _uploadComplete(tr("Upload failed"));
+    } else {
+        // Resending with the same sequence number gets us the original response if the vehicle already created the file
+        qCDebug(FTPManagerLog) << QString("_createFileTimeout: retrying - retryCount(%1)").arg(_uploadState.retryCount);
+        _expectedIncomingSeqNumber -= 2;
+        _createFileBegin();
+    }
+}
+
+void FTPManager::_createFileAckOrNak(const MavlinkFTP::Request* ackOrNak)
+{
+    MavlinkFTP::OpCode_t requestOpCode = static_cast<MavlinkFTP::OpCode_t>(ackOrNak->hdr.req_opcode);
+    if (requestOpCode != MavlinkFTP::kCmdCreateFile) {
+        qCDebug(FTPManagerLog) << "_createFileAckOrNak: Ack disregarding ack for incorrect requestOpCode" << MavlinkFTP::opCodeToString(requestOpCode);
+        return;
+    }
+    if (ackOrNak->hdr.seqNumber != _expectedIncomingSeqNumber) {
+        qCDebug(FTPManagerLog) << "_createFileAckOrNak: Ack disregarding ack for incorrect sequence actual:expected" << ackOrNak->hdr.seqNumber << _expectedIncomingSeqNumber;
+        return;
+    }
+
+    _ackOrNakTimeoutTimer.stop();
+
+    if (ackOrNak->hdr.opcode == MavlinkFTP::kRspAck) {
+        qCDebug(FTPManagerLog) << "_createFileAckOrNak: Ack - sessionId" << ackOrNak->hdr.session;
+        _uploadState.sessionId  = ackOrNak->hdr.session;
+        _uploadState.offset     = 0;
+        _advanceStateMachine();
+    } else if (ackOrNak->hdr.opcode == MavlinkFTP::kRspNak) {
+        qCDebug(FTPManagerLog) << "_createFileAckOrNak: Nak -" << _errorMsgFromNak(ackOrNak);
+        _uploadComplete(tr("Upload failed"));
+    }
+}
+
+void FTPManager::_writeFileWorker(bool firstRequest)
+{
+    if (firstRequest) {
+        // Also covers moving on to closing the session, which must not inherit the retries of the last write
+        _uploadState.retryCount = 0;
+    }
+
+    if (_uploadState.offset >= static_cast<uint32_t>(_uploadState.bytes.size())) {
+        _advanceStateMachine();
+        return;
+    }
+
+    MavlinkFTP::Request request{};
+    uint32_t            cBytesToWrite = qMin(static_cast<uint32_t>(sizeof(request.data)), static_cast<uint32_t>(_uploadState.bytes.size()) - _uploadState.offset);
+
+    request.hdr.session = _uploadState.sessionId;
+    request.hdr.opcode  = MavlinkFTP::kCmdWriteFile;
+    request.hdr.offset  = _uploadState.offset;
+    request.hdr.size    = static_cast<uint8_t>(cBytesToWrite);
+    memcpy(request.data, _uploadState.bytes.constData() + _uploadState.offset, cBytesToWrite);
+
+    if (!firstRequest) {
+        // Must used same sequence number as previous request
+        _expectedIncomingSeqNumber -= 2;
+    }
+
+    _sendRequestExpectAck(&request);
+}
+
+void FTPManager::_writeFileBegin(void)
+{
+    _writeFileWorker(true /* firstRequest */);
+}
+
+void FTPManager::_writeFileAckOrNak(const MavlinkFTP::Request* ackOrNak)
+{
+    MavlinkFTP::OpCode_t requestOpCode = static_cast<MavlinkFTP::OpCode_t>(ackOrNak->hdr.req_opcode);
+
+    if (requestOpCode != MavlinkFTP::kCmdWriteFile) {
+        qCDebug(FTPManagerLog) << "_writeFileAckOrNak: Disregarding due to incorrect requestOpCode" << MavlinkFTP::opCodeToString(requestOpCode);
+        return;
+    }
+    if (ackOrNak->hdr.seqNumber != _expectedIncomingSeqNumber) {
+        qCDebug(FTPManagerLog) << "_writeFileAckOrNak: Disregarding due to incorrect sequence actual:expected" << ackOrNak->hdr.seqNumber << _expectedIncomingSeqNumber;
+        return;
+    }
+    if (ackOrNak->hdr.session != _uploadState.sessionId) {
+        qCDebug(FTPManagerLog) << "_writeFileAckOrNak: Disregarding due to incorrect session id actual:expected" << ackOrNak->hdr.session << _uploadState.sessionId;
+        return;
+    }
+
+    _ackOrNakTimeoutTimer.stop();
+
+    if (ackOrNak->hdr.opcode == MavlinkFTP::kRspAck) {
+        _uploadState.offset += qMin(static_cast<uint32_t>(sizeof(ackOrNak->data)), static_cast<uint32_t>(_uploadState.bytes.size()) - _uploadState.offset);
+        qCDebug(FTPManagerLog) << "_writeFileAckOrNak: Ack offset" << _uploadState.offset;
+
+        _writeFileWorker(true /* firstRequest */);
+
+        // Emit progress last, as cancel could be called in there
+        if (_uploadState.inProgress() && _uploadState.bytes.size() != 0) {
+            emit commandProgress((float)(_uploadState.offset) / (float)_uploadState.bytes.size());
+        }
+    } else if (ackOrNak->hdr.opcode == MavlinkFTP::kRspNak) {
+        qCDebug(FTPManagerLog) << "_writeFileAckOrNak: Nak -" << _errorMsgFromNak(ackOrNak);
+        _uploadComplete(tr("Upload failed"));
+    }
+}
+
+void FTPManager::_writeFileTimeout(void)
+{
+    if (++_uploadState.retryCount > _maxRetry) {
+        qCDebug(FTPManagerLog) << QString("_writeFileTimeout retries exceeded");
+        _uploadComplete(tr("Upload failed"));
+    } else {
+        // Try again
+        qCDebug(FTPManagerLog) << QString("_writeFileTimeout: retrying - retryCount(%1) offset(%2)").arg(_uploadState.retryCount).arg(_uploadState.offset);
+        _writeFileWorker(false /* firstRequest */);
+    }
+}
+
+/// The vehicle only takes the new file into use once the session is terminated
+void FTPManager::_closeUploadBegin(void)
+{
+    MavlinkFTP::Request request{};
+    request.hdr.session = _uploadState.sessionId;
+    request.hdr.opcode  = MavlinkFTP::kCmdTerminateSession;
+    _sendRequestExpectAck(&request);
+}
+
+void FTPManager::_closeUploadAckOrNak(const MavlinkFTP::Request* ackOrNak)
+{
+    MavlinkFTP::OpCode_t requestOpCode = static_cast<MavlinkFTP::OpCode_t>(ackOrNak->hdr.req_opcode);
+    if (requestOpCode != MavlinkFTP::kCmdTerminateSession) {
+        qCDebug(FTPManagerLog) << "_closeUploadAckOrNak: Disregarding due to incorrect requestOpCode" << MavlinkFTP::opCodeToString(requestOpCode);
+        return;
+    }
+    if (ackOrNak->hdr.seqNumber != _expectedIncomingSeqNumber) {
+        qCDebug(FTPManagerLog) << "_closeUploadAckOrNak: Disregarding due to incorrect sequence actual:expected" << ackOrNak->hdr.seqNumber << _expectedIncomingSeqNumber;
+        return;
+    }
+
+    _ackOrNakTimeoutTimer.stop();
+
+    if (ackOrNak->hdr.opcode == MavlinkFTP::kRspAck) {
+        _advanceStateMachine();
+    } else if (ackOrNak->hdr.opcode == MavlinkFTP::kRspNak) {
+        // A vehicle which rejects the file contents does so here
+        qCDebug(FTPManagerLog) << "_closeUploadAckOrNak: Nak -" << _errorMsgFromNak(ackOrNak);
+        _uploadComplete(tr("Upload failed"));
+    }
+}
+
+void FTPManager::_closeUploadTimeout(void)
+{
+    if (++_uploadState.retryCount > _maxRetry) {
+        qCDebug(FTPManagerLog) << QString("_closeUploadTimeout retries exceeded");
+        _uploadComplete(tr("Upload failed"));
+    } else {
+        qCDebug(FTPManagerLog) << QString("_closeUploadTimeout: retrying - retryCount(%1)").arg(_uploadState.retryCount);
+        _expectedIncomingSeqNumber -= 2;
+        _closeUploadBegin();
+    }
+}
+
 void FTPManager::_emitErrorMessage(const QString& msg)
 {
     qCDebug(FTPManagerLog) << "Error:" << msg;
@@ -39,14 +39,22 @@ public:
     /// Signals downloadComplete, commandError, commandProgress
     bool download(const QString& fromURI, const QString& toDir);
 
+    /// Uploads the specified file. The file on the vehicle is created, or truncated if it already exists.
+    ///     @param toURI    File to create on the vehicle, fully qualified path. Same format as download.
+    ///     @param fromFile Local file to upload
+    /// @return true: upload has started, false: error, no upload
+    /// Signals uploadComplete, commandError, commandProgress
+    bool upload(const QString& toURI, const QString& fromFile);
+
     /// Cancel the current operation
-    /// This will emit downloadComplete() when done, and if there's currently a download in progress
+    /// This will emit downloadComplete() or uploadComplete() when done, and if there's currently a transfer in progress
     void cancel();
 
     static const char* mavlinkFTPScheme;
 
 signals:
     void downloadComplete(const QString& file, const QString& errorMsg);
+    void uploadComplete(const QString& file, const QString& errorMsg);
     
     // Signals associated with all commands
     
@@ -105,6 +113,25 @@ private:
         }
     };
 
+    struct UploadState_t {
+        uint8_t                 sessionId;
+        uint32_t                offset;                 ///< offset of the chunk currently being written
+        QString                 fullPathOnVehicle;      ///< Fully qualified path to file on vehicle
+        QString                 fromFile;               ///< Local file being uploaded
+        QByteArray              bytes;                  ///< Contents of the local file
+        int                     retryCount;
+
+        bool inProgress() const { return !fullPathOnVehicle.isEmpty(); }
+
+        void reset() {
+            sessionId       = 0;
+            offset          = 0;
+            retryCount      = 0;
+            fullPathOnVehicle.clear();
+            fromFile.clear();
+            bytes.clear();
+        }
+    };
 
     void    _mavlinkMessageReceived     (const mavlink_message_t& message);
     void    _startStateMachine          (void);
@@ -136,10 +163,25 @@ private:
     void    _terminateSessionTimeout    (void);
     void    _terminateComplete          (void);
 
+    void    _createFileBegin            (void);
+    void    _createFileAckOrNak         (const MavlinkFTP::Request* ackOrNak);
+    void    _createFileTimeout          (void);
+    void    _writeFileBegin             (void);
+    void    _writeFileAckOrNak          (const MavlinkFTP::Request* ackOrNak);
+    void    _writeFileTimeout           (void);
+    void    _writeFileWorker            (bool firstRequest);
+    void    _closeUploadBegin           (void);
+    void    _closeUploadAckOrNak        (const MavlinkFTP::Request* ackOrNak);
+    void    _closeUploadTimeout         (void);
+    void    _uploadCompleteNoError      (void) { _uploadComplete(QString()); }
+    void    _uploadAborted              (void) { _uploadComplete(tr("Aborted")); }
+    void    _uploadComplete             (const QString& errorMsg);
+
     Vehicle*                _vehicle;
     uint8_t                 _ftpCompId = MAV_COMP_ID_AUTOPILOT1;
     QList<StateFunctions_t> _rgStateMachine;
     DownloadState_t         _downloadState;
+    UploadState_t           _uploadState;
     QTimer                  _ackOrNakTimeoutTimer;
     int                     _currentStateMachineIndex   = -1;
     uint16_t                _expectedIncomingSeqNumber  = 0;
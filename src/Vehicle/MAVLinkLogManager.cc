@@ -110,13 +110,100 @@ MAVLinkLogFiles::setUploaded(bool uploaded)
     emit uploadedChanged();
 }
 
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+MAVLinkLogWriter::MAVLinkLogWriter(FILE* fd)
+    : _fd(fd)
+    , _queuedBytes(0)
+    , _stop(false)
+    , _error(false)
+{
+    //-- Data arrives in large batches, stdio buffering would only add a copy
+    setvbuf(_fd, nullptr, _IONBF, 0);
+    setObjectName("MAVLinkLogWriter");
+}
+
+//-----------------------------------------------------------------------------
+MAVLinkLogWriter::~MAVLinkLogWriter()
+{
+    stop();
+}
+
+//-----------------------------------------------------------------------------
+void
+MAVLinkLogWriter::write(QByteArray& batch)
+{
+    if(batch.isEmpty()) {
+        return;
+    }
+    QMutexLocker lock(&_mutex);
+    _queuedBytes += batch.length();
+    _queue.enqueue(batch);
+    //-- Drop our reference so the writer thread owns the only copy
+    batch.clear();
+    _queueCondition.wakeOne();
+}
+
+//-----------------------------------------------------------------------------
+void
+MAVLinkLogWriter::stop()
+{
+    {
+        QMutexLocker lock(&_mutex);
+        _stop = true;
+        _queueCondition.wakeOne();
+    }
+    wait();
+}
+
+//-----------------------------------------------------------------------------
+qint64
+MAVLinkLogWriter::queuedBytes()
+{
+    QMutexLocker lock(&_mutex);
+    return _queuedBytes;
+}
+
+//-----------------------------------------------------------------------------
+void
+MAVLinkLogWriter::run()
+{
+    while(true) {
+        QByteArray batch;
+        {
+            QMutexLocker lock(&_mutex);
+            while(_queue.isEmpty() && !_stop) {
+                _queueCondition.wait(&_mutex);
+            }
+            if(_queue.isEmpty()) {
+                break;
+            }
+            batch = _queue.dequeue();
+        }
+        if(!_error) {
+            if(fwrite(batch.constData(), 1, static_cast<size_t>(batch.length()), _fd) != static_cast<size_t>(batch.length())) {
+                qCWarning(MAVLinkLogManagerLog) << "File IO error:" << batch.length() << "bytes";
+                _error = true;
+            }
+        }
+        QMutexLocker lock(&_mutex);
+        _queuedBytes -= batch.length();
+    }
+    fflush(_fd);
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 MAVLinkLogProcessor::MAVLinkLogProcessor()
     : _fd(nullptr)
+    , _writer(nullptr)
     , _written(0)
     , _sequence(-1)
     , _numDrops(0)
+    , _numGaps(0)
+    , _numDuplicates(0)
+    , _numReordered(0)
+    , _numAcked(0)
     , _gotHeader(false)
     , _error(false)
     , _record(nullptr)
@@ -133,9 +220,18 @@ MAVLinkLogProcessor::~MAVLinkLogProcessor()
 void
 MAVLinkLogProcessor::close()
 {
+    if(_writer) {
+        _flushBatch();
+        _writer->stop();
+        _error |= _writer->error();
+        delete _writer;
+        _writer = nullptr;
+    }
     if(_fd) {
         fclose(_fd);
         _fd = nullptr;
+        qCDebug(MAVLinkLogManagerLog) << "Closed" << _fileName << "bytes:" << _written << "drops:" << _numDrops << "gaps:" << _numGaps
+                                      << "duplicates:" << _numDuplicates << "reordered:" << _numReordered << "acked:" << _numAcked;
     }
 }
 
@@ -150,7 +246,7 @@ MAVLinkLogProcessor::valid()
 bool
 MAVLinkLogProcessor::create(MAVLinkLogManager* manager, const QString path, uint8_t id)
 {
-    _fileName.asprintf("%s/%03d-%s%s",
+    _fileName = QString::asprintf("%s/%03d-%s%s",
                       path.toLatin1().data(),
                       id,
                       QDateTime::currentDateTime().toString("yyyy-MM-dd-hh-mm-ss-zzz").toLocal8Bit().data(),
@@ -160,6 +256,11 @@ MAVLinkLogProcessor::create(MAVLinkLogManager* manager, const QString path, uint
         _record = new MAVLinkLogFiles(manager, _fileName, true);
         _record->setWriting(true);
         _sequence = -1;
+        _batch.reserve(kWriteBatchSize);
+        _ulogMessage.reserve(1024);
+        _batchTimer.start();
+        _writer = new MAVLinkLogWriter(_fd);
+        _writer->start();
         return true;
     }
     return false;
@@ -177,119 +278,132 @@ MAVLinkLogProcessor::_checkSequence(uint16_t seq, int& num_drops)
         return true;
     }
     if((uint16_t)_sequence == seq) {
+        //-- Retransmit of an acked message whose ack got lost
+        _numDuplicates++;
         return false;
     }
     if(seq > (uint16_t)_sequence) {
         // Account for wrap-arounds, sequence is 2 bytes
         if((seq - _sequence) > (1 << 15)) { // Assume reordered
+            _numReordered++;
             return false;
         }
         num_drops = seq - _sequence - 1;
-        _numDrops += num_drops;
-        _sequence = seq;
-        return true;
     } else {
-        if((_sequence - seq) > (1 << 15)) {
-            num_drops = (1 << 16) - _sequence - 1 + seq;
-            _numDrops += num_drops;
-            _sequence = seq;
-            return true;
+        if((_sequence - seq) <= (1 << 15)) {
+            _numReordered++;
+            return false;
         }
-        return false;
+        num_drops = (1 << 16) - _sequence - 1 + seq;
     }
+    if(num_drops > 0) {
+        _numDrops += num_drops;
+        _numGaps++;
+    }
+    _sequence = seq;
+    return true;
 }
 
 //-----------------------------------------------------------------------------
 void
-MAVLinkLogProcessor::_writeData(void* data, int len)
+MAVLinkLogProcessor::_writeData(const void* data, int len)
 {
     if(!_error) {
-        _error = fwrite(data, 1, len, _fd) != (size_t)len;
-        if(!_error) {
-            _written += len;
-            if(_record) {
-                _record->setSize(_written);
-            }
-        } else {
-            qCDebug(MAVLinkLogManagerLog) << "File IO error:" << len << "bytes into" << _fileName;
+        _batch.append(static_cast<const char*>(data), len);
+        _written += len;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+MAVLinkLogProcessor::_flushBatch()
+{
+    if(_writer && !_batch.isEmpty()) {
+        _writer->write(_batch);
+        _batch.reserve(kWriteBatchSize);
+        if(_record) {
+            _record->setSize(_written);
         }
     }
+    _batchTimer.restart();
 }
 
 //-----------------------------------------------------------------------------
-QByteArray
-MAVLinkLogProcessor::_writeUlogMessage(QByteArray& data)
+void
+MAVLinkLogProcessor::_writeUlogMessages(const char* data, int length)
 {
     //-- Write ulog data w/o integrity checking, assuming data starts with a
-    //   valid ulog message. returns the remaining data at the end.
-    while(data.length() > 2) {
-        uint8_t* ptr = (uint8_t*)data.data();
+    //   valid ulog message. The incomplete message at the end (if any) is kept
+    //   until the rest of it arrives.
+    int offset = 0;
+    while(length - offset > 2) {
+        const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data + offset);
         int message_length = ptr[0] + (ptr[1] * 256) + 3; // 3 = ULog msg header
-        if(message_length > data.length())
+        if(message_length > length - offset) {
             break;
-        _writeData(data.data(), message_length);
-        data.remove(0, message_length);
+        }
+        offset += message_length;
     }
-    return data;
+    _writeData(data, offset);
+    _ulogMessage.append(data + offset, length - offset);
 }
 
 //-----------------------------------------------------------------------------
 bool
-MAVLinkLogProcessor::processStreamData(uint16_t sequence, uint8_t first_message, QByteArray data)
+MAVLinkLogProcessor::processStreamData(uint16_t sequence, uint8_t first_message, const QByteArray& data, bool acked)
 {
+    if(acked) {
+        _numAcked++;
+    }
     int num_drops = 0;
-    _error = false;
-    while(_checkSequence(sequence, num_drops)) {
-        //-- The first 16 bytes need special treatment (this sounds awfully brittle)
-        if(!_gotHeader) {
-            if(data.size() < 16) {
-                //-- Shouldn't happen but if it does, we might as well close shop.
-                qCWarning(MAVLinkLogManagerLog) << "Corrupt log header. Canceling log download.";
-                return false;
-            }
-            //-- Write header
-            _writeData(data.data(), 16);
-            data.remove(0, 16);
-            _gotHeader = true;
-            // What about data start offset now that we removed 16 bytes off the start?
-        }
-        if(_gotHeader && num_drops > 0) {
-            if(num_drops > 25) num_drops = 25;
-            //-- Hocus Pocus
-            //   Write a dropout message. We don't really know the actual duration,
-            //   so just use the number of drops * 10 ms
-            uint8_t bogus[] = {2, 0, 79, 0, 0};
-            bogus[3] = num_drops * 10;
-            _writeData(bogus, sizeof(bogus));
-        }
-        if(num_drops > 0) {
-            _writeUlogMessage(_ulogMessage);
-            _ulogMessage.clear();
-            //-- If no useful information in this message. Drop it.
-            if(first_message == 255) {
-                break;
-            }
-            if(first_message > 0) {
-                data.remove(0, first_message);
-                first_message = 0;
-            }
-        }
-        if(first_message == 255 && _ulogMessage.length() > 0) {
-            _ulogMessage.append(data);
-            break;
+    if(!_checkSequence(sequence, num_drops)) {
+        //-- Duplicate or out of order, nothing to write
+        return !_error;
+    }
+    const char* ptr     = data.constData();
+    int         length  = data.length();
+    //-- The first 16 bytes need special treatment (this sounds awfully brittle)
+    if(!_gotHeader) {
+        if(length < 16) {
+            //-- Shouldn't happen but if it does, we might as well close shop.
+            qCWarning(MAVLinkLogManagerLog) << "Corrupt log header. Canceling log download.";
+            return false;
         }
-        if(_ulogMessage.length()) {
-            _writeData(_ulogMessage.data(), _ulogMessage.length());
-            if(first_message) {
-                _writeData(data.left(first_message).data(), first_message);
-            }
-            _ulogMessage.clear();
+        //-- Write header
+        _writeData(ptr, 16);
+        ptr     += 16;
+        length  -= 16;
+        _gotHeader = true;
+    }
+    if(num_drops > 0) {
+        //-- The message in progress is lost. Write a dropout message. We don't
+        //   really know the actual duration, so just use the number of drops * 10 ms
+        _ulogMessage.resize(0);
+        uint8_t dropout[] = {2, 0, 79, 0, 0};
+        dropout[3] = static_cast<uint8_t>(qMin(num_drops, 25) * 10);
+        _writeData(dropout, sizeof(dropout));
+    }
+    if(first_message == 255) {
+        //-- No message starts in here, it all belongs to the message in progress.
+        //   Without a message in progress there is nothing useful in it.
+        if(!_ulogMessage.isEmpty()) {
+            _ulogMessage.append(ptr, length);
         }
-        if(first_message) {
-            data.remove(0, first_message);
+    } else {
+        int continuation = qMin(static_cast<int>(first_message), length);
+        if(!_ulogMessage.isEmpty()) {
+            //-- A new message starts, so the one in progress is complete
+            _ulogMessage.append(ptr, continuation);
+            _writeData(_ulogMessage.constData(), _ulogMessage.length());
+            _ulogMessage.resize(0);
         }
-        _ulogMessage = _writeUlogMessage(data);
-        break;
+        _writeUlogMessages(ptr + continuation, length - continuation);
+    }
+    if(_batch.length() >= kWriteBatchSize || _batchTimer.elapsed() >= kWriteFlushMsecs) {
+        _flushBatch();
+    }
+    if(_writer && _writer->error()) {
+        _error = true;
     }
     return !_error;
 }
@@ -861,10 +975,10 @@ MAVLinkLogManager::_activeVehicleChanged(Vehicle* vehicle)
 
 //-----------------------------------------------------------------------------
 void
-MAVLinkLogManager::_mavlinkLogData(Vehicle* /*vehicle*/, uint8_t /*target_system*/, uint8_t /*target_component*/, uint16_t sequence, uint8_t first_message, QByteArray data, bool /*acked*/)
+MAVLinkLogManager::_mavlinkLogData(Vehicle* /*vehicle*/, uint8_t /*target_system*/, uint8_t /*target_component*/, uint16_t sequence, uint8_t first_message, QByteArray data, bool acked)
 {
     if(_logProcessor && _logProcessor->valid()) {
-        if(!_logProcessor->processStreamData(sequence, first_message, data)) {
+        if(!_logProcessor->processStreamData(sequence, first_message, data, acked)) {
             qCWarning(MAVLinkLogManagerLog) << "Error writing MAVLink log file:" << _logProcessor->fileName();
             delete _logProcessor;
             _logProcessor = nullptr;
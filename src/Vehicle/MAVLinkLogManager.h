@@ -12,6 +12,13 @@
 #define MAVLinkLogManager_H
 
 #include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QElapsedTimer>
+
+#include <atomic>
 
 #include "QmlObjectListModel.h"
 #include "QGCLoggingCategory.h"
@@ -72,6 +79,33 @@ private:
     bool                _uploaded;
 };
 
+//-----------------------------------------------------------------------------
+/// Writes log data to disk from a separate thread. Data is handed over in large
+/// batches so the main thread never blocks on file IO.
+class MAVLinkLogWriter : public QThread
+{
+public:
+    MAVLinkLogWriter(FILE* fd);
+    ~MAVLinkLogWriter();
+
+    void                write       (QByteArray& batch);    ///< Takes ownership of the batch contents, batch is left empty
+    void                stop        ();                     ///< Writes out all queued batches and waits for the thread to finish
+    bool                error       () const { return _error; }
+    qint64              queuedBytes ();
+
+protected:
+    void                run         () final;
+
+private:
+    FILE*               _fd;
+    QMutex              _mutex;
+    QWaitCondition      _queueCondition;
+    QQueue<QByteArray>  _queue;
+    qint64              _queuedBytes;
+    bool                _stop;
+    std::atomic<bool>   _error;
+};
+
 //-----------------------------------------------------------------------------
 class MAVLinkLogProcessor
 {
@@ -83,19 +117,39 @@ public:
     bool                create      (MAVLinkLogManager *manager, const QString path, uint8_t id);
     MAVLinkLogFiles*    record      () { return _record; }
     QString             fileName    () { return _fileName; }
-    bool                processStreamData(uint16_t _sequence, uint8_t first_message, QByteArray data);
+    bool                processStreamData(uint16_t _sequence, uint8_t first_message, const QByteArray& data, bool acked = false);
+
+    // Sequence accounting
+    int                 numDrops        () const { return _numDrops; }          ///< Number of LOGGING_DATA messages lost
+    int                 numGaps         () const { return _numGaps; }           ///< Number of separate sequence gaps
+    int                 numDuplicates   () const { return _numDuplicates; }     ///< Repeated sequence numbers (retransmits)
+    int                 numReordered    () const { return _numReordered; }      ///< Out of order messages which were discarded
+    int                 numAcked        () const { return _numAcked; }          ///< LOGGING_DATA_ACKED messages received
+    quint32             written         () const { return _written; }
+
+    static const int    kWriteBatchSize     = 64 * 1024;    ///< Data is handed to the writer thread in batches of this size
+    static const int    kWriteFlushMsecs    = 1000;         ///< Maximum time data stays in the batch before being handed to the writer thread
+
 private:
-    bool                _checkSequence(uint16_t seq, int &num_drops);
-    QByteArray          _writeUlogMessage(QByteArray &data);
-    void                _writeData(void* data, int len);
+    bool                _checkSequence  (uint16_t seq, int &num_drops);
+    void                _writeUlogMessages(const char* data, int length);
+    void                _writeData      (const void* data, int len);
+    void                _flushBatch     ();
 private:
     FILE*               _fd;
+    MAVLinkLogWriter*   _writer;
     quint32             _written;
     int                 _sequence;
     int                 _numDrops;
+    int                 _numGaps;
+    int                 _numDuplicates;
+    int                 _numReordered;
+    int                 _numAcked;
     bool                _gotHeader;
     bool                _error;
-    QByteArray          _ulogMessage;
+    QByteArray          _ulogMessage;       ///< Start of a ULog message which continues in the next LOGGING_DATA message
+    QByteArray          _batch;             ///< Complete ULog messages waiting to be handed to the writer thread
+    QElapsedTimer       _batchTimer;
     QString             _fileName;
     MAVLinkLogFiles*    _record;
 };
@@ -0,0 +1,230 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkLogManagerTest.h"
+#include "MAVLinkLogManager.h"
+#include "MockLink.h"
+#include "QGCApplication.h"
+#include "SettingsManager.h"
+
+#include <QDir>
+#include <QSignalSpy>
+
+static const int        _ulogHeaderSize     = 16;
+static const int        _ulogStreamRate     = 500 * 1024;   ///< Bytes per second PX4 streams at on a fast link
+static const uint8_t    _ulogDropoutType    = 'O';
+
+/// Generates a ULog stream made up of the file header followed by data messages of varying length
+///     @param messageStarts[out] Stream offsets of each message
+QByteArray MAVLinkLogManagerTest::_ulogStream(int messageCount, QList<int>& messageStarts)
+{
+    QByteArray stream("ULog\x01\x12\x35\x01", 8);
+    stream.append(8, '\0');     // timestamp
+
+    messageStarts.clear();
+    for (int i=0; i<messageCount; i++) {
+        uint16_t payloadLength = static_cast<uint16_t>(1 + ((i * 53) % 400));
+        messageStarts.append(stream.length());
+        stream.append(static_cast<char>(payloadLength & 0xFF));
+        stream.append(static_cast<char>(payloadLength >> 8));
+        stream.append('D');
+        stream.append(payloadLength, static_cast<char>(i));
+    }
+
+    return stream;
+}
+
+/// Splits the stream into LOGGING_DATA messages the way the vehicle sends it. The header goes out on its own.
+QList<MAVLinkLogManagerTest::LogPacket> MAVLinkLogManagerTest::_packetize(const QByteArray& stream, const QList<int>& messageStarts)
+{
+    QList<LogPacket>    rgPackets;
+    int                 messageIndex = 0;
+
+    rgPackets.append({ 0, 255, stream.left(_ulogHeaderSize) });
+    for (int offset=_ulogHeaderSize; offset<stream.length(); offset+=MAVLINK_MSG_LOGGING_DATA_FIELD_DATA_LEN) {
+        int length = qMin(stream.length() - offset, static_cast<int>(MAVLINK_MSG_LOGGING_DATA_FIELD_DATA_LEN));
+
+        uint8_t firstMessage = 255;
+        while (messageIndex < messageStarts.count() && messageStarts[messageIndex] < offset + length) {
+            if (firstMessage == 255) {
+                firstMessage = static_cast<uint8_t>(messageStarts[messageIndex] - offset);
+            }
+            messageIndex++;
+        }
+
+        rgPackets.append({ static_cast<uint16_t>(rgPackets.count()), firstMessage, stream.mid(offset, length) });
+    }
+
+    return rgPackets;
+}
+
+/// Walks the messages in a ULog file
+///     @return true: file is a sequence of complete messages up to the end
+bool MAVLinkLogManagerTest::_parseULog(const QByteArray& log, int& cMessages, int& cDropouts)
+{
+    cMessages = 0;
+    cDropouts = 0;
+
+    if (!log.startsWith(QByteArray("ULog"))) {
+        return false;
+    }
+
+    int offset = _ulogHeaderSize;
+    while (log.length() - offset >= 3) {
+        const uint8_t* ptr = reinterpret_cast<const uint8_t*>(log.constData() + offset);
+        int messageLength = ptr[0] + (ptr[1] * 256) + 3;
+        if (ptr[2] == _ulogDropoutType) {
+            cDropouts++;
+        }
+        cMessages++;
+        offset += messageLength;
+    }
+
+    return offset == log.length();
+}
+
+QByteArray MAVLinkLogManagerTest::_readFile(const QString& fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+void MAVLinkLogManagerTest::_processStreamData(void)
+{
+    QList<int>          messageStarts;
+    QByteArray          stream      = _ulogStream(2000, messageStarts);
+    QList<LogPacket>    rgPackets   = _packetize(stream, messageStarts);
+    MAVLinkLogManager*  logManager  = qgcApp()->toolbox()->mavlinkLogManager();
+
+    MAVLinkLogProcessor logProcessor;
+    QVERIFY(logProcessor.create(logManager, _tempDir.path(), 1));
+    for (const LogPacket& packet: rgPackets) {
+        QVERIFY(logProcessor.processStreamData(packet.sequence, packet.firstMessage, packet.data, packet.sequence == 0 /* acked */));
+    }
+    logProcessor.close();
+
+    QCOMPARE(logProcessor.numDrops(),   0);
+    QCOMPARE(logProcessor.numAcked(),   1);
+    QCOMPARE(logProcessor.written(),    static_cast<quint32>(stream.length()));
+    QCOMPARE(logProcessor.record()->size(), static_cast<quint32>(stream.length()));
+    QVERIFY(_readFile(logProcessor.fileName()) == stream);
+
+    delete logProcessor.record();
+}
+
+void MAVLinkLogManagerTest::_processStreamDataGaps(void)
+{
+    QList<int>          messageStarts;
+    QByteArray          stream      = _ulogStream(500, messageStarts);
+    QList<LogPacket>    rgPackets   = _packetize(stream, messageStarts);
+    MAVLinkLogManager*  logManager  = qgcApp()->toolbox()->mavlinkLogManager();
+
+    QVERIFY(rgPackets.count() > 40);
+    rgPackets.removeAt(10);                     // Lost
+    rgPackets.insert(20, rgPackets[19]);        // Retransmit
+    rgPackets.swapItemsAt(31, 32);              // Reordered, the late one is discarded and counted as lost
+
+    MAVLinkLogProcessor logProcessor;
+    QVERIFY(logProcessor.create(logManager, _tempDir.path(), 2));
+    for (const LogPacket& packet: rgPackets) {
+        QVERIFY(logProcessor.processStreamData(packet.sequence, packet.firstMessage, packet.data));
+    }
+    logProcessor.close();
+
+    QCOMPARE(logProcessor.numDrops(),       2);
+    QCOMPARE(logProcessor.numGaps(),        2);
+    QCOMPARE(logProcessor.numDuplicates(),  1);
+    QCOMPARE(logProcessor.numReordered(),   1);
+
+    // Partial messages around the gaps are dropped, everything else must still be intact
+    int cMessages, cDropouts;
+    QVERIFY(_parseULog(_readFile(logProcessor.fileName()), cMessages, cDropouts));
+    QCOMPARE(cDropouts, 2);
+    QVERIFY(cMessages > 490);
+
+    delete logProcessor.record();
+}
+
+/// Time to process one second worth of log data streamed at 500 kB/s
+void MAVLinkLogManagerTest::_processStreamDataBenchmark(void)
+{
+    QList<int>          messageStarts;
+    int                 messageCount = _ulogStreamRate / (3 + 200);
+    QByteArray          stream      = _ulogStream(messageCount, messageStarts);
+    QList<LogPacket>    rgPackets   = _packetize(stream, messageStarts);
+    MAVLinkLogManager*  logManager  = qgcApp()->toolbox()->mavlinkLogManager();
+
+    QBENCHMARK {
+        MAVLinkLogProcessor logProcessor;
+        QVERIFY(logProcessor.create(logManager, _tempDir.path(), 3));
+        for (const LogPacket& packet: rgPackets) {
+            logProcessor.processStreamData(packet.sequence, packet.firstMessage, packet.data);
+        }
+        logProcessor.close();
+        QCOMPARE(logProcessor.written(), static_cast<quint32>(stream.length()));
+        QFile::remove(logProcessor.fileName());
+        delete logProcessor.record();
+    }
+}
+
+/// Streams from MockLink at 500 kB/s through Vehicle and MAVLinkLogManager
+void MAVLinkLogManagerTest::_mockLinkStream(void)
+{
+    // About a second worth of stream, the log record size follows each batch written to disk
+    const quint32 streamBytes = _ulogStreamRate;
+
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+    _mockLink->setULogStreamRate(_ulogStreamRate);
+
+    MAVLinkLogManager* logManager = qgcApp()->toolbox()->mavlinkLogManager();
+    logManager->setEnableAutoUpload(false);
+    QVERIFY(logManager->canStartLog());
+
+    QDir logDir(qgcApp()->toolbox()->settingsManager()->appSettings()->logSavePath());
+    QStringList nameFilter(QStringLiteral("*") + logManager->logExtension());
+    QStringList rgExistingLogs = logDir.entryList(nameFilter, QDir::Files);
+
+    logManager->startLogging();
+    QVERIFY(logManager->logRunning());
+
+    MAVLinkLogFiles* record = nullptr;
+    for (int i=0; i<logManager->logFiles()->count(); i++) {
+        MAVLinkLogFiles* logFile = logManager->logFiles()->value<MAVLinkLogFiles*>(i);
+        if (logFile->writing()) {
+            record = logFile;
+        }
+    }
+    QVERIFY(record);
+
+    QSignalSpy sizeSpy(record, &MAVLinkLogFiles::sizeChanged);
+    while (record->size() < streamBytes) {
+        QVERIFY(sizeSpy.wait(5000));
+    }
+    logManager->stopLogging();
+    QVERIFY(!logManager->logRunning());
+
+    QStringList rgNewLogs = logDir.entryList(nameFilter, QDir::Files);
+    for (const QString& existingLog: rgExistingLogs) {
+        rgNewLogs.removeAll(existingLog);
+    }
+    QCOMPARE(rgNewLogs.count(), 1);
+
+    QString     logFile = logDir.filePath(rgNewLogs[0]);
+    QByteArray  log     = _readFile(logFile);
+    int         cMessages, cDropouts;
+    QVERIFY(_parseULog(log, cMessages, cDropouts));
+    QCOMPARE(cDropouts, 0);
+    QVERIFY(cMessages > 0);
+    QVERIFY(static_cast<quint32>(log.length()) >= streamBytes);
+
+    QFile::remove(logFile);
+}
@@ -0,0 +1,41 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QTemporaryDir>
+
+class MAVLinkLogProcessor;
+
+class MAVLinkLogManagerTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _processStreamData         (void);
+    void _processStreamDataGaps     (void);
+    void _processStreamDataBenchmark(void);
+    void _mockLinkStream            (void);
+
+private:
+    struct LogPacket {
+        uint16_t    sequence;
+        uint8_t     firstMessage;
+        QByteArray  data;
+    };
+
+    QByteArray          _ulogStream     (int messageCount, QList<int>& messageStarts);
+    QList<LogPacket>    _packetize      (const QByteArray& stream, const QList<int>& messageStarts);
+    bool                _parseULog      (const QByteArray& log, int& cMessages, int& cDropouts);
+    QByteArray          _readFile       (const QString& fileName);
+
+    QTemporaryDir _tempDir;
+};
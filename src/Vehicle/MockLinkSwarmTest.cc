@@ -0,0 +1,84 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MockLinkSwarmTest.h"
+#include "MockLinkSwarm.h"
+#include "MultiVehicleManager.h"
+#include "ParameterManager.h"
+#include "FactSystem.h"
+#include "QGCApplication.h"
+#include "LinkManager.h"
+#include "Vehicle.h"
+
+void MockLinkSwarmTest::_initialConnect(void)
+{
+    MultiVehicleManager* mvm = qgcApp()->toolbox()->multiVehicleManager();
+
+    MockLinkSwarm* swarm = MockLinkSwarm::startSwarm(_vehicleCount);
+    QVERIFY(swarm);
+    QCOMPARE(swarm->vehicleCount(), static_cast<int>(_vehicleCount));
+
+    QTRY_COMPARE_WITH_TIMEOUT(mvm->vehicles()->count(), static_cast<int>(_vehicleCount), 10000);
+
+    QList<int> vehicleIds;
+    for (int i = 0; i < mvm->vehicles()->count(); i++) {
+        Vehicle* vehicle = mvm->vehicles()->value<Vehicle*>(i);
+        QTRY_VERIFY_WITH_TIMEOUT(vehicle->isInitialConnectComplete(), 30000);
+        QVERIFY(vehicle->parameterManager()->parametersReady());
+        vehicleIds.append(vehicle->id());
+    }
+    std::sort(vehicleIds.begin(), vehicleIds.end());
+    for (int i = 0; i < vehicleIds.count(); i++) {
+        QCOMPARE(vehicleIds[i], swarm->firstVehicleId() + i);
+    }
+
+    // Wait for a sample which covers telemetry from every vehicle
+    QSignalSpy sampleSpy(swarm, &MockLinkSwarm::throughputSampled);
+    QVERIFY(sampleSpy.wait(2 * MockLinkSwarm::throughputSampleMSecs));
+    MockLinkSwarm::Throughput_t totals = swarm->throughputTotals();
+    QVERIFY(totals.messagesSent > 0);
+    QVERIFY(totals.messagesReceived > 0);
+    QCOMPARE(totals.messagesDropped, static_cast<quint64>(0));
+    QVERIFY(swarm->throughputPerSecond().messagesSent >= static_cast<quint64>(_vehicleCount));
+
+    _linkManager->disconnectAll();
+    QTRY_COMPARE_WITH_TIMEOUT(mvm->vehicles()->count(), 0, 10000);
+}
+
+void MockLinkSwarmTest::_paramCopyOnWrite(void)
+{
+    MultiVehicleManager* mvm = qgcApp()->toolbox()->multiVehicleManager();
+
+    QVERIFY(MockLinkSwarm::startSwarm(2));
+    QTRY_COMPARE_WITH_TIMEOUT(mvm->vehicles()->count(), 2, 10000);
+
+    Vehicle* vehicle1 = mvm->vehicles()->value<Vehicle*>(0);
+    Vehicle* vehicle2 = mvm->vehicles()->value<Vehicle*>(1);
+    QTRY_VERIFY_WITH_TIMEOUT(vehicle1->isInitialConnectComplete() && vehicle2->isInitialConnectComplete(), 30000);
+
+    const QString paramName("MIS_TAKEOFF_ALT");
+    Fact* fact1 = vehicle1->parameterManager()->getParameter(FactSystem::defaultComponentId, paramName);
+    Fact* fact2 = vehicle2->parameterManager()->getParameter(FactSystem::defaultComponentId, paramName);
+    const double originalValue = fact2->rawValue().toDouble();
+
+    // Write on one vehicle
+    QSignalSpy updated1Spy(fact1, &Fact::vehicleUpdated);
+    fact1->setRawValue(originalValue + 10);
+    QVERIFY(updated1Spy.wait(5000));
+    QCOMPARE(updated1Spy.last()[0].toDouble(), originalValue + 10);
+
+    // The other vehicle still reports the shared value
+    QSignalSpy updated2Spy(fact2, &Fact::vehicleUpdated);
+    vehicle2->parameterManager()->refreshParameter(vehicle2->defaultComponentId(), paramName);
+    QVERIFY(updated2Spy.wait(5000));
+    QCOMPARE(updated2Spy.last()[0].toDouble(), originalValue);
+
+    _linkManager->disconnectAll();
+    QTRY_COMPARE_WITH_TIMEOUT(mvm->vehicles()->count(), 0, 10000);
+}
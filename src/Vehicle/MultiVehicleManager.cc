@@ -354,6 +354,21 @@ Vehicle* MultiVehicleManager::getVehicleById(int vehicleId)
     return nullptr;
 }
 
+FleetPlanUploader* MultiVehicleManager::sendPlanToAllVehicles(const QString& planFile)
+{
+    QList<Vehicle*> vehicles;
+    for (int i=0; i< _vehicles.count(); i++) {
+        vehicles.append(qobject_cast<Vehicle*>(_vehicles[i]));
+    }
+
+    FleetPlanUploader* uploader = FleetPlanUploader::sendPlanToVehicles(vehicles, planFile);
+    if (uploader) {
+        // Deletes itself when complete, QML must not garbage collect it before then
+        QQmlEngine::setObjectOwnership(uploader, QQmlEngine::CppOwnership);
+    }
+    return uploader;
+}
+
 void MultiVehicleManager::setGcsHeartbeatEnabled(bool gcsHeartBeatEnabled)
 {
     if (gcsHeartBeatEnabled != _gcsHeartbeatEnabled) {
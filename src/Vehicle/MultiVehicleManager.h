@@ -19,6 +19,7 @@
 #include "QmlObjectListModel.h"
 #include "QGCToolbox.h"
 #include "QGCLoggingCategory.h"
+#include "FleetPlanUploader.h"
 
 class FirmwarePluginManager;
 class FollowMe;
@@ -50,6 +51,10 @@ public:
 
     Q_INVOKABLE Vehicle* getVehicleById(int vehicleId);
 
+    /// Sends a plan file to all vehicles at once, see FleetPlanUploader
+    /// @return Uploader reporting progress and completion, deletes itself once complete. nullptr if there are no vehicles.
+    Q_INVOKABLE FleetPlanUploader* sendPlanToAllVehicles(const QString& planFile);
+
     UAS* activeUas(void) { return _activeVehicle ? _activeVehicle->uas() : nullptr; }
 
     // Property accessors
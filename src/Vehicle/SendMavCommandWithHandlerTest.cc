@@ -46,8 +46,8 @@ void SendMavCommandWithHandlerTest::_testCaseWorker(TestCase_t& testCase)
     _mockLink->clearSendMavCommandCounts();
     vehicle->sendMavCommandWithHandler(_mavCmdResultHandler, &testCase, MAV_COMP_ID_AUTOPILOT1, testCase.command);
     QVERIFY(QTest::qWaitFor([&]() { return _handlerCalled; }, 10000));
-    QCOMPARE(vehicle->_findMavCommandListEntryIndex(MAV_COMP_ID_AUTOPILOT1, testCase.command),  -1);
-    QCOMPARE(_mockLink->sendMavCommandCount(testCase.command),                  testCase.expectedSendCount);
+    QCOMPARE(vehicle->isMavCommandPending(MAV_COMP_ID_AUTOPILOT1, testCase.command),    false);
+    QCOMPARE(_mockLink->sendMavCommandCount(testCase.command),                          testCase.expectedSendCount);
 
     _disconnectMockLink();
 }
@@ -81,7 +81,7 @@ void SendMavCommandWithHandlerTest::_duplicateCommand(void)
 
     // Duplicate command response should happen immediately
     QVERIFY(_handlerCalled);
-    QVERIFY(vehicle->_findMavCommandListEntryIndex(MAV_COMP_ID_AUTOPILOT1, testCase.command) != -1);
+    QVERIFY(vehicle->isMavCommandPending(MAV_COMP_ID_AUTOPILOT1, testCase.command));
     QCOMPARE(_mockLink->sendMavCommandCount(testCase.command), 1);
 }
 
@@ -110,8 +110,52 @@ void SendMavCommandWithHandlerTest::_compIdAllFailure(void)
     _mockLink->clearSendMavCommandCounts();
     vehicle->sendMavCommandWithHandler(_compIdAllMavCmdResultHandler, nullptr, MAV_COMP_ID_ALL, testCase.command);
     QCOMPARE(_handlerCalled,                                                            true);
-    QCOMPARE(vehicle->_findMavCommandListEntryIndex(MAV_COMP_ID_ALL, testCase.command), -1);
+    QCOMPARE(vehicle->isMavCommandPending(MAV_COMP_ID_ALL, testCase.command),           false);
     QCOMPARE(_mockLink->sendMavCommandCount(testCase.command),                          testCase.expectedSendCount);
 
     _disconnectMockLink();
 }
+
+void SendMavCommandWithHandlerTest::_latencyHistogram(void)
+{
+    _connectMockLinkNoInitialConnectSequence();
+
+    MultiVehicleManager*    vehicleMgr  = qgcApp()->toolbox()->multiVehicleManager();
+    Vehicle*                vehicle     = vehicleMgr->activeVehicle();
+
+    QCOMPARE(vehicle->mavCommandLatency(MockLink::MAV_CMD_MOCKLINK_ALWAYS_RESULT_ACCEPTED).count, 0);
+
+    TestCase_t& acceptedCase = _rgTestCases[0];
+    for (int i=0; i<3; i++) {
+        _handlerCalled = false;
+        vehicle->sendMavCommandWithHandler(_mavCmdResultHandler, &acceptedCase, MAV_COMP_ID_AUTOPILOT1, acceptedCase.command);
+        QVERIFY(QTest::qWaitFor([&]() { return _handlerCalled; }, 10000));
+    }
+
+    TestCase_t& retryCase = _rgTestCases[2];
+    _handlerCalled = false;
+    _mockLink->clearSendMavCommandCounts();
+    vehicle->sendMavCommandWithHandler(_mavCmdResultHandler, &retryCase, MAV_COMP_ID_AUTOPILOT1, retryCase.command);
+    QVERIFY(QTest::qWaitFor([&]() { return _handlerCalled; }, 10000));
+
+    Vehicle::MavCommandLatency_t latency = vehicle->mavCommandLatency(acceptedCase.command);
+    QCOMPARE(latency.count,         3);
+    QCOMPARE(latency.retriedCount,  0);
+    QVERIFY(latency.minMSecs <= latency.maxMSecs);
+    int bucketTotal = 0;
+    for (int count: latency.buckets) {
+        bucketTotal += count;
+    }
+    QCOMPARE(bucketTotal, 3);
+
+    // The retried command waited out at least one ack timeout
+    latency = vehicle->mavCommandLatency(retryCase.command);
+    QCOMPARE(latency.count,         1);
+    QCOMPARE(latency.retriedCount,  1);
+    QVERIFY(latency.minMSecs >= Vehicle::_mavCommandAckTimeoutMSecs);
+
+    QVariantList histograms = vehicle->mavCommandLatencyHistograms();
+    QVERIFY(histograms.count() >= 2);
+
+    _disconnectMockLink();
+}
@@ -20,6 +20,7 @@ private slots:
     void _performTestCases(void);
     void _compIdAllFailure(void);
     void _duplicateCommand(void);
+    void _latencyHistogram(void);
 
 private:
     typedef struct {
@@ -17,6 +17,9 @@ TerrainFactGroup::TerrainFactGroup(QObject* parent)
     , _blocksPendingFact(0, _blocksPendingFactName, FactMetaData::valueTypeDouble)
     , _blocksLoadedFact (0, _blocksLoadedFactName,  FactMetaData::valueTypeDouble)
 {
+    // Values are filled in from outside handleMessage
+    _setHandledMessageIds({});
+
     _addFact(&_blocksPendingFact,        _blocksPendingFactName);
     _addFact(&_blocksLoadedFact,       _blocksLoadedFactName);
 }
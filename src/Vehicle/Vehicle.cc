@@ -11,6 +11,9 @@
 #include <QDateTime>
 #include <QLocale>
 #include <QQuaternion>
+#include <QMetaMethod>
+
+#include <climits>
 
 #include <Eigen/Eigen>
 
@@ -71,6 +74,8 @@ const QString guided_mode_not_supported_by_vehicle = QObject::tr("Guided mode no
 const char* Vehicle::_settingsGroup =               "Vehicle%1";        // %1 replaced with mavlink system id
 const char* Vehicle::_joystickEnabledSettingsKey =  "JoystickEnabled";
 
+const int Vehicle::mavCommandLatencyBucketLimitsMSecs[Vehicle::MavCommandLatency_t::bucketCount] = { 50, 100, 250, 500, 1000, 2500, 5000, INT_MAX };
+
 const char* Vehicle::_rollFactName =                "roll";
 const char* Vehicle::_pitchFactName =               "pitch";
 const char* Vehicle::_headingFactName =             "heading";
@@ -228,10 +233,11 @@ Vehicle::Vehicle(LinkInterface*             link,
     _prearmErrorTimer.setInterval(_prearmErrorTimeoutMSecs);
     _prearmErrorTimer.setSingleShot(true);
 
-    // Send MAV_CMD ack timer
+    // Send MAV_CMD ack timer, only runs while commands are pending
+    _mavCommandTimerWheel.resize(_mavCommandTimerWheelSlots);
     _mavCommandResponseCheckTimer.setSingleShot(false);
+    _mavCommandResponseCheckTimer.setTimerType(Qt::PreciseTimer);   // Coarse timers can fire early, retries must not
     _mavCommandResponseCheckTimer.setInterval(_mavCommandResponseCheckTimeoutMSecs);
-    _mavCommandResponseCheckTimer.start();
     connect(&_mavCommandResponseCheckTimer, &QTimer::timeout, this, &Vehicle::_sendMavCommandResponseTimeoutCheck);
 
     // Chunked status text timeout timer
@@ -445,6 +451,10 @@ void Vehicle::_commonInit()
     _hobbsFact.setRawValue(QVariant(QString("0000:00:00")));
     _addFact(&_hobbsFact,               _hobbsFactName);
 
+    // Battery groups come and go while connected
+    connect(this, &FactGroup::factGroupNamesChanged, this, [this]() { _factGroupDispatchDirty = true; });
+    _factGroupDispatchClock.start();
+
     _addFactGroup(&_gpsFactGroup,               _gpsFactGroupName);
     _addFactGroup(&_gps2FactGroup,              _gps2FactGroupName);
     _addFactGroup(&_windFactGroup,              _windFactGroupName);
@@ -669,9 +679,7 @@ void Vehicle::_mavlinkMessageReceived(LinkInterface* link, mavlink_message_t mes
     VehicleBatteryFactGroup::handleMessageForFactGroupCreation(this, message);
 
     // Let the fact groups take a whack at the mavlink traffic
-    for (FactGroup* factGroup : factGroups()) {
-        factGroup->handleMessage(this, message);
-    }
+    _dispatchFactGroupMessage(message);
 
     switch (message.msgid) {
     case MAVLINK_MSG_ID_HOME_POSITION:
@@ -818,7 +826,7 @@ void Vehicle::_handleRangefinder(mavlink_message_t& message)
 {
     mavlink_rangefinder_t rangefinder;
     mavlink_msg_rangefinder_decode(&message, &rangefinder);
-    _rangeFinderDistFact.setRawValue(qIsNaN(rangefinder.distance) ? 0 : rangefinder.distance);
+    _rangeFinderDistFact.setTelemetryRawValue(qIsNaN(rangefinder.distance) ? 0 : rangefinder.distance);
 }
 #endif
 
@@ -1001,14 +1009,14 @@ void Vehicle::_handleVfrHud(mavlink_message_t& message)
     mavlink_vfr_hud_t vfrHud;
     mavlink_msg_vfr_hud_decode(&message, &vfrHud);
 
-    _airSpeedFact.setRawValue(qIsNaN(vfrHud.airspeed) ? 0 : vfrHud.airspeed);
-    _groundSpeedFact.setRawValue(qIsNaN(vfrHud.groundspeed) ? 0 : vfrHud.groundspeed);
-    _climbRateFact.setRawValue(qIsNaN(vfrHud.climb) ? 0 : vfrHud.climb);
-    _throttlePctFact.setRawValue(static_cast<int16_t>(vfrHud.throttle));
+    _airSpeedFact.setTelemetryRawValue(qIsNaN(vfrHud.airspeed) ? 0 : vfrHud.airspeed);
+    _groundSpeedFact.setTelemetryRawValue(qIsNaN(vfrHud.groundspeed) ? 0 : vfrHud.groundspeed);
+    _climbRateFact.setTelemetryRawValue(qIsNaN(vfrHud.climb) ? 0 : vfrHud.climb);
+    _throttlePctFact.setTelemetryRawValue(static_cast<int16_t>(vfrHud.throttle));
     if (qIsNaN(_altitudeTuningOffset)) {
         _altitudeTuningOffset = vfrHud.alt;
     }
-    _altitudeTuningFact.setRawValue(vfrHud.alt - _altitudeTuningOffset);
+    _altitudeTuningFact.setTelemetryRawValue(vfrHud.alt - _altitudeTuningOffset);
 }
 
 void Vehicle::_handleNavControllerOutput(mavlink_message_t& message)
@@ -1016,10 +1024,10 @@ void Vehicle::_handleNavControllerOutput(mavlink_message_t& message)
     mavlink_nav_controller_output_t navControllerOutput;
     mavlink_msg_nav_controller_output_decode(&message, &navControllerOutput);
 
-    _altitudeTuningSetpointFact.setRawValue(_altitudeTuningFact.rawValue().toDouble() - navControllerOutput.alt_error);
-    _xTrackErrorFact.setRawValue(navControllerOutput.xtrack_error);
-    _airSpeedSetpointFact.setRawValue(_airSpeedFact.rawValue().toDouble() - navControllerOutput.aspd_error);
-    _distanceToNextWPFact.setRawValue(navControllerOutput.wp_dist);
+    _altitudeTuningSetpointFact.setTelemetryRawValue(_altitudeTuningFact.rawValue().toDouble() - navControllerOutput.alt_error);
+    _xTrackErrorFact.setTelemetryRawValue(navControllerOutput.xtrack_error);
+    _airSpeedSetpointFact.setTelemetryRawValue(_airSpeedFact.rawValue().toDouble() - navControllerOutput.aspd_error);
+    _distanceToNextWPFact.setTelemetryRawValue(navControllerOutput.wp_dist);
 }
 
 // Ignore warnings from mavlink headers for both GCC/Clang and MSVC
@@ -1058,9 +1066,9 @@ void Vehicle::_handleAttitudeWorker(double rollRadians, double pitchRadians, dou
     // truncate to integer so widget never displays 360
     yaw = trunc(yaw);
 
-    _rollFact.setRawValue(roll);
-    _pitchFact.setRawValue(pitch);
-    _headingFact.setRawValue(yaw);
+    _rollFact.setTelemetryRawValue(roll);
+    _pitchFact.setTelemetryRawValue(pitch);
+    _headingFact.setTelemetryRawValue(yaw);
 }
 
 void Vehicle::_handleAttitude(mavlink_message_t& message)
@@ -1128,7 +1136,7 @@ void Vehicle::_handleGpsRawInt(mavlink_message_t& message)
                 emit coordinateChanged(_coordinate);
             }
             if (!_altitudeMessageAvailable) {
-                _altitudeAMSLFact.setRawValue(gpsRawInt.alt / 1000.0);
+                _altitudeAMSLFact.setTelemetryRawValue(gpsRawInt.alt / 1000.0);
             }
         }
     }
@@ -1140,8 +1148,8 @@ void Vehicle::_handleGlobalPositionInt(mavlink_message_t& message)
     mavlink_msg_global_position_int_decode(&message, &globalPositionInt);
 
     if (!_altitudeMessageAvailable) {
-        _altitudeRelativeFact.setRawValue(globalPositionInt.relative_alt / 1000.0);
-        _altitudeAMSLFact.setRawValue(globalPositionInt.alt / 1000.0);
+        _altitudeRelativeFact.setTelemetryRawValue(globalPositionInt.relative_alt / 1000.0);
+        _altitudeAMSLFact.setTelemetryRawValue(globalPositionInt.alt / 1000.0);
     }
 
     // ArduPilot sends bogus GLOBAL_POSITION_INT messages with lat/lat 0/0 even when it has no gps signal
@@ -1196,12 +1204,12 @@ void Vehicle::_handleHighLatency(mavlink_message_t& message)
     _coordinate.setAltitude(coordinate.altitude);
     emit coordinateChanged(_coordinate);
 
-    _airSpeedFact.setRawValue((double)highLatency.airspeed / 5.0);
-    _groundSpeedFact.setRawValue((double)highLatency.groundspeed / 5.0);
-    _climbRateFact.setRawValue((double)highLatency.climb_rate / 10.0);
-    _headingFact.setRawValue((double)highLatency.heading * 2.0);
-    _altitudeRelativeFact.setRawValue(qQNaN());
-    _altitudeAMSLFact.setRawValue(coordinate.altitude);
+    _airSpeedFact.setTelemetryRawValue((double)highLatency.airspeed / 5.0);
+    _groundSpeedFact.setTelemetryRawValue((double)highLatency.groundspeed / 5.0);
+    _climbRateFact.setTelemetryRawValue((double)highLatency.climb_rate / 10.0);
+    _headingFact.setTelemetryRawValue((double)highLatency.heading * 2.0);
+    _altitudeRelativeFact.setTelemetryRawValue(qQNaN());
+    _altitudeAMSLFact.setTelemetryRawValue(coordinate.altitude);
 }
 
 void Vehicle::_handleHighLatency2(mavlink_message_t& message)
@@ -1232,12 +1240,12 @@ void Vehicle::_handleHighLatency2(mavlink_message_t& message)
     _coordinate.setAltitude(highLatency2.altitude);
     emit coordinateChanged(_coordinate);
 
-    _airSpeedFact.setRawValue((double)highLatency2.airspeed / 5.0);
-    _groundSpeedFact.setRawValue((double)highLatency2.groundspeed / 5.0);
-    _climbRateFact.setRawValue((double)highLatency2.climb_rate / 10.0);
-    _headingFact.setRawValue((double)highLatency2.heading * 2.0);
-    _altitudeRelativeFact.setRawValue(qQNaN());
-    _altitudeAMSLFact.setRawValue(highLatency2.altitude);
+    _airSpeedFact.setTelemetryRawValue((double)highLatency2.airspeed / 5.0);
+    _groundSpeedFact.setTelemetryRawValue((double)highLatency2.groundspeed / 5.0);
+    _climbRateFact.setTelemetryRawValue((double)highLatency2.climb_rate / 10.0);
+    _headingFact.setTelemetryRawValue((double)highLatency2.heading * 2.0);
+    _altitudeRelativeFact.setTelemetryRawValue(qQNaN());
+    _altitudeAMSLFact.setTelemetryRawValue(highLatency2.altitude);
 
     struct failure2Sensor_s {
         HL_FAILURE_FLAG         failureBit;
@@ -1276,8 +1284,8 @@ void Vehicle::_handleAltitude(mavlink_message_t& message)
 
     // Data from ALTITUDE message takes precedence over gps messages
     _altitudeMessageAvailable = true;
-    _altitudeRelativeFact.setRawValue(altitude.altitude_relative);
-    _altitudeAMSLFact.setRawValue(altitude.altitude_amsl);
+    _altitudeRelativeFact.setTelemetryRawValue(altitude.altitude_relative);
+    _altitudeAMSLFact.setTelemetryRawValue(altitude.altitude_amsl);
 }
 
 void Vehicle::_setCapabilities(uint64_t capabilityBits)
@@ -1905,6 +1913,11 @@ QString Vehicle::formattedMessages()
     return messages;
 }
 
+QAbstractListModel* Vehicle::messageModel()
+{
+    return _toolbox->uasMessageHandler()->messageModel();
+}
+
 void Vehicle::clearMessages()
 {
     _toolbox->uasMessageHandler()->clearMessages();
@@ -1912,7 +1925,8 @@ void Vehicle::clearMessages()
 
 void Vehicle::_handletextMessageReceived(UASMessage* message)
 {
-    if (message) {
+    // Only pay for formatting when a message view is listening
+    if (message && isSignalConnected(QMetaMethod::fromSignal(&Vehicle::newFormattedMessage))) {
         emit newFormattedMessage(message->getFormatedText());
     }
 }
@@ -2807,19 +2821,201 @@ void Vehicle::sendMavCommandInt(int compId, MAV_CMD command, MAV_FRAME frame, bo
 
 bool Vehicle::isMavCommandPending(int targetCompId, MAV_CMD command)
 {
-    return ((-1) < _findMavCommandListEntryIndex(targetCompId, command));
+    return _findMavCommandListEntry(targetCompId, command) != nullptr;
+}
+
+/// @return Oldest pending entry for the command, nullptr if none
+Vehicle::MavCommandListEntry_t* Vehicle::_findMavCommandListEntry(int targetCompId, MAV_CMD command)
+{
+    auto iter = _mavCommandTable.find(_mavCommandKey(targetCompId, command));
+    if (iter == _mavCommandTable.end() || iter->isEmpty()) {
+        return nullptr;
+    }
+    MavCommandListEntry_t& entry = iter->first();
+    // The key only holds the low 8 bits of the component id
+    return entry.targetCompId == targetCompId ? &entry : nullptr;
+}
+
+Vehicle::MavCommandListEntry_t* Vehicle::_findMavCommandListEntry(quint32 key, quint32 sequence)
+{
+    auto iter = _mavCommandTable.find(key);
+    if (iter != _mavCommandTable.end()) {
+        for (MavCommandListEntry_t& entry: *iter) {
+            if (entry.sequence == sequence) {
+                return &entry;
+            }
+        }
+    }
+    return nullptr;
+}
+
+/// Removes the entry from the pending table. Outstanding timers for it are dropped when they fire.
+Vehicle::MavCommandListEntry_t Vehicle::_takeMavCommandListEntry(quint32 key, quint32 sequence)
+{
+    MavCommandListEntry_t   entry;
+    auto                    iter = _mavCommandTable.find(key);
+
+    if (iter != _mavCommandTable.end()) {
+        for (int i=0; i<iter->count(); i++) {
+            if (iter->at(i).sequence == sequence) {
+                entry = iter->takeAt(i);
+                _mavCommandPendingCount--;
+                break;
+            }
+        }
+        if (iter->isEmpty()) {
+            _mavCommandTable.erase(iter);
+        }
+    }
+
+    return entry;
+}
+
+void Vehicle::_scheduleMavCommandTimer(quint32 key, quint32 sequence, int delayMSecs)
+{
+    // A timer placed n ticks ahead fires on the n'th tick from now. The first tick comes when the running check timer
+    // next times out, every following tick is a full interval later. Round up so a timer never fires before its delay.
+    int firstTickMSecs  = _mavCommandResponseCheckTimeoutMSecs;
+    if (_mavCommandResponseCheckTimer.isActive()) {
+        firstTickMSecs = qMax(0, _mavCommandResponseCheckTimer.remainingTime());
+    }
+    int ticks           = 1;
+    if (delayMSecs > firstTickMSecs) {
+        ticks += (delayMSecs - firstTickMSecs + _mavCommandResponseCheckTimeoutMSecs - 1) / _mavCommandResponseCheckTimeoutMSecs;
+    }
+    int slot            = (_mavCommandTimerWheelPos + ticks) % _mavCommandTimerWheelSlots;
+
+    _mavCommandTimerWheel[slot].append({ key, sequence, (ticks - 1) / _mavCommandTimerWheelSlots });
+
+    if (!_mavCommandResponseCheckTimer.isActive()) {
+        _mavCommandResponseCheckTimer.start();
+    }
+}
+
+void Vehicle::_recordMavCommandLatency(const MavCommandListEntry_t& entry)
+{
+    qint64                  latencyMSecs    = entry.elapsedTimer.elapsed();
+    MavCommandLatency_t&    latency         = _mavCommandLatency[entry.command];
+
+    if (latency.count == 0 || latencyMSecs < latency.minMSecs) {
+        latency.minMSecs = latencyMSecs;
+    }
+    if (latencyMSecs > latency.maxMSecs) {
+        latency.maxMSecs = latencyMSecs;
+    }
+    latency.count++;
+    latency.totalMSecs += latencyMSecs;
+    if (entry.tryCount > 1) {
+        latency.retriedCount++;
+    }
+
+    int bucket = 0;
+    while (bucket < MavCommandLatency_t::bucketCount - 1 && latencyMSecs > mavCommandLatencyBucketLimitsMSecs[bucket]) {
+        bucket++;
+    }
+    latency.buckets[bucket]++;
+}
+
+QVariantList Vehicle::mavCommandLatencyHistograms() const
+{
+    QVariantList bucketLimits;
+    for (int limit: mavCommandLatencyBucketLimitsMSecs) {
+        bucketLimits.append(limit);
+    }
+
+    QVariantList histograms;
+    for (auto iter = _mavCommandLatency.constBegin(); iter != _mavCommandLatency.constEnd(); iter++) {
+        const MavCommandLatency_t&  latency = iter.value();
+        QVariantList                buckets;
+        QVariantMap                 histogram;
+
+        for (int count: latency.buckets) {
+            buckets.append(count);
+        }
+        histogram[QStringLiteral("command")]            = _toolbox->missionCommandTree()->rawName(static_cast<MAV_CMD>(iter.key()));
+        histogram[QStringLiteral("count")]              = latency.count;
+        histogram[QStringLiteral("retriedCount")]       = latency.retriedCount;
+        histogram[QStringLiteral("minMSecs")]           = latency.minMSecs;
+        histogram[QStringLiteral("maxMSecs")]           = latency.maxMSecs;
+        histogram[QStringLiteral("meanMSecs")]          = latency.count ? static_cast<double>(latency.totalMSecs) / latency.count : 0.0;
+        histogram[QStringLiteral("buckets")]            = buckets;
+        histogram[QStringLiteral("bucketLimitsMSecs")]  = bucketLimits;
+        histograms.append(histogram);
+    }
+
+    return histograms;
+}
+
+QVariantList Vehicle::factGroupMessageCosts() const
+{
+    QVariantList costs;
+    for (const FactGroupDispatch_t& entry: _factGroupDispatch) {
+        QVariantMap cost;
+
+        cost[QStringLiteral("name")]            = entry.name;
+        cost[QStringLiteral("messageCount")]    = entry.messageCount;
+        cost[QStringLiteral("totalUSecs")]      = entry.totalNSecs / 1000;
+        cost[QStringLiteral("meanUSecs")]       = entry.messageCount ? static_cast<double>(entry.totalNSecs) / 1000.0 / entry.messageCount : 0.0;
+        costs.append(cost);
+    }
+
+    return costs;
 }
 
-int Vehicle::_findMavCommandListEntryIndex(int targetCompId, MAV_CMD command)
+void Vehicle::_rebuildFactGroupDispatch(void)
 {
-    for (int i=0; i<_mavCommandList.count(); i++) {
-        const MavCommandListEntry_t& entry = _mavCommandList[i];
-        if (entry.targetCompId == targetCompId && entry.command == command) {
-            return i;
+    // Keep the costs collected so far for groups which are still around
+    QHash<FactGroup*, FactGroupDispatch_t> previous;
+    for (const FactGroupDispatch_t& entry: _factGroupDispatch) {
+        previous[entry.factGroup] = entry;
+    }
+
+    _factGroupDispatch.clear();
+    _factGroupDispatchTable.clear();
+    _factGroupDispatchAllMessages.clear();
+
+    for (auto iter = factGroups().constBegin(); iter != factGroups().constEnd(); iter++) {
+        FactGroup*  factGroup   = iter.value();
+        const int   index       = _factGroupDispatch.count();
+
+        _factGroupDispatch.append(previous.value(factGroup, { factGroup, iter.key(), 0, 0 }));
+
+        if (factGroup->handlesAllMessages()) {
+            _factGroupDispatchAllMessages.append(index);
+        } else {
+            for (uint32_t msgId: factGroup->handledMessageIds()) {
+                _factGroupDispatchTable[msgId].append(index);
+            }
         }
     }
 
-    return -1;
+    _factGroupDispatchDirty = false;
+}
+
+void Vehicle::_dispatchFactGroupMessage(mavlink_message_t& message)
+{
+    if (_factGroupDispatchDirty) {
+        _rebuildFactGroupDispatch();
+    }
+
+    auto dispatch = [this, &message](int index) {
+        FactGroupDispatch_t&    entry = _factGroupDispatch[index];
+        const qint64            start = _factGroupDispatchClock.nsecsElapsed();
+
+        entry.factGroup->handleMessage(this, message);
+        entry.totalNSecs += _factGroupDispatchClock.nsecsElapsed() - start;
+        entry.messageCount++;
+    };
+
+    auto iter = _factGroupDispatchTable.constFind(message.msgid);
+    if (iter != _factGroupDispatchTable.constEnd()) {
+        for (int index: iter.value()) {
+            dispatch(index);
+        }
+    }
+    for (int index: _factGroupDispatchAllMessages) {
+        dispatch(index);
+    }
 }
 
 bool Vehicle::_sendMavCommandShouldRetry(MAV_CMD command)
@@ -2913,21 +3109,30 @@ void Vehicle::_sendMavCommandWorker(bool commandInt, bool showError, MavCmdResul
     entry.rgParam[6]        = param7;
     entry.maxTries          = _sendMavCommandShouldRetry(command) ? _mavCommandMaxRetryCount : 1;
     entry.ackTimeoutMSecs   = sharedLink->linkConfiguration()->isHighLatency() ? _mavCommandAckTimeoutMSecsHighLatency : _mavCommandAckTimeoutMSecs;
+    entry.sequence          = _mavCommandNextSequence++;
     entry.elapsedTimer.start();
 
-    _mavCommandList.append(entry);
-    _sendMavCommandFromList(_mavCommandList.count() - 1);
+    quint32 key = _mavCommandKey(targetCompId, command);
+    _mavCommandTable[key].append(entry);
+    _mavCommandPendingCount++;
+    _sendMavCommandFromList(key, entry.sequence);
 }
 
-void Vehicle::_sendMavCommandFromList(int index)
+void Vehicle::_sendMavCommandFromList(quint32 key, quint32 sequence)
 {
-    MavCommandListEntry_t commandEntry = _mavCommandList[index];
+    MavCommandListEntry_t* pEntry = _findMavCommandListEntry(key, sequence);
+    if (!pEntry) {
+        // Acked since the timer was scheduled
+        return;
+    }
+
+    MavCommandListEntry_t commandEntry = *pEntry;
 
     QString rawCommandName  = _toolbox->missionCommandTree()->rawName(commandEntry.command);
 
-    if (++_mavCommandList[index].tryCount > commandEntry.maxTries) {
+    if (++pEntry->tryCount > commandEntry.maxTries) {
         qCDebug(VehicleLog) << "_sendMavCommandFromList giving up after max retries" << rawCommandName;
-        _mavCommandList.removeAt(index);
+        _takeMavCommandListEntry(key, sequence);
         if (commandEntry.resultHandler) {
             (*commandEntry.resultHandler)(commandEntry.resultHandlerData, commandEntry.targetCompId, MAV_RESULT_FAILED, 0, MavCmdResultFailureNoResponseToCommand);
         } else {
@@ -2938,6 +3143,10 @@ void Vehicle::_sendMavCommandFromList(int index)
         }
         return;
     }
+    commandEntry.tryCount = pEntry->tryCount;
+
+    // First wait out the full ack timeout, after that keep retrying every tick until out of tries
+    _scheduleMavCommandTimer(key, sequence, commandEntry.tryCount == 1 ? commandEntry.ackTimeoutMSecs : _mavCommandResponseCheckTimeoutMSecs);
 
     if (commandEntry.tryCount > 1 && !px4Firmware() && commandEntry.command == MAV_CMD_START_RX_PAIR) {
         // The implementation of this command comes from the IO layer and is shared across stacks. So for other firmwares
@@ -3002,16 +3211,27 @@ void Vehicle::_sendMavCommandFromList(int index)
 
 void Vehicle::_sendMavCommandResponseTimeoutCheck(void)
 {
-    if (_mavCommandList.isEmpty()) {
-        return;
-    }
+    _mavCommandTimerWheelPos = (_mavCommandTimerWheelPos + 1) % _mavCommandTimerWheelSlots;
+
+    // Retries schedule new timers, possibly into this same slot, so take the slot contents first
+    QList<MavCommandTimer_t> timers;
+    timers.swap(_mavCommandTimerWheel[_mavCommandTimerWheelPos]);
 
-    // Walk the list backwards since _sendMavCommandFromList can remove entries
-    for (int i=_mavCommandList.count()-1; i>=0; i--) {
-        MavCommandListEntry_t& commandEntry = _mavCommandList[i];
-        if (commandEntry.elapsedTimer.elapsed() > commandEntry.ackTimeoutMSecs) {
+    for (MavCommandTimer_t& timer: timers) {
+        if (timer.rounds > 0) {
+            timer.rounds--;
+            _mavCommandTimerWheel[_mavCommandTimerWheelPos].append(timer);
+        } else {
             // Try sending command again
-            _sendMavCommandFromList(i);
+            _sendMavCommandFromList(timer.key, timer.sequence);
+        }
+    }
+
+    if (_mavCommandPendingCount == 0) {
+        // Timers left in the wheel belong to acked commands
+        _mavCommandResponseCheckTimer.stop();
+        for (QList<MavCommandTimer_t>& slot: _mavCommandTimerWheel) {
+            slot.clear();
         }
     }
 }
@@ -3049,40 +3269,35 @@ void Vehicle::_handleCommandAck(mavlink_message_t& message)
     }
 #endif
 
-    int entryIndex = _findMavCommandListEntryIndex(message.compid, static_cast<MAV_CMD>(ack.command));
-    bool commandInList = false;
-    if (entryIndex != -1) {
-        MavCommandListEntry_t commandEntry = _mavCommandList.takeAt(entryIndex);
-        if (commandEntry.command == ack.command) {
-            if (commandEntry.resultHandler) {
-                (*commandEntry.resultHandler)(commandEntry.resultHandlerData, message.compid, static_cast<MAV_RESULT>(ack.result), ack.progress, MavCmdResultCommandResultOnly);
-            } else {
-                if (commandEntry.showError) {
-                    switch (ack.result) {
-                    case MAV_RESULT_TEMPORARILY_REJECTED:
-                        qgcApp()->showAppMessage(tr("%1 command temporarily rejected").arg(rawCommandName));
-                        break;
-                    case MAV_RESULT_DENIED:
-                        qgcApp()->showAppMessage(tr("%1 command denied").arg(rawCommandName));
-                        break;
-                    case MAV_RESULT_UNSUPPORTED:
-                        qgcApp()->showAppMessage(tr("%1 command not supported").arg(rawCommandName));
-                        break;
-                    case MAV_RESULT_FAILED:
-                        qgcApp()->showAppMessage(tr("%1 command failed").arg(rawCommandName));
-                        break;
-                    default:
-                        // Do nothing
-                        break;
-                    }
+    MavCommandListEntry_t* pEntry = _findMavCommandListEntry(message.compid, static_cast<MAV_CMD>(ack.command));
+    if (pEntry) {
+        MavCommandListEntry_t commandEntry = _takeMavCommandListEntry(_mavCommandKey(message.compid, static_cast<MAV_CMD>(ack.command)), pEntry->sequence);
+        _recordMavCommandLatency(commandEntry);
+        if (commandEntry.resultHandler) {
+            (*commandEntry.resultHandler)(commandEntry.resultHandlerData, message.compid, static_cast<MAV_RESULT>(ack.result), ack.progress, MavCmdResultCommandResultOnly);
+        } else {
+            if (commandEntry.showError) {
+                switch (ack.result) {
+                case MAV_RESULT_TEMPORARILY_REJECTED:
+                    qgcApp()->showAppMessage(tr("%1 command temporarily rejected").arg(rawCommandName));
+                    break;
+                case MAV_RESULT_DENIED:
+                    qgcApp()->showAppMessage(tr("%1 command denied").arg(rawCommandName));
+                    break;
+                case MAV_RESULT_UNSUPPORTED:
+                    qgcApp()->showAppMessage(tr("%1 command not supported").arg(rawCommandName));
+                    break;
+                case MAV_RESULT_FAILED:
+                    qgcApp()->showAppMessage(tr("%1 command failed").arg(rawCommandName));
+                    break;
+                default:
+                    // Do nothing
+                    break;
                 }
-                emit mavCommandResult(_id, message.compid, ack.command, ack.result, MavCmdResultCommandResultOnly);
             }
-            commandInList = true;
+            emit mavCommandResult(_id, message.compid, ack.command, ack.result, MavCmdResultCommandResultOnly);
         }
-    }
-
-    if (!commandInList) {
+    } else {
         qCDebug(VehicleLog) << "_handleCommandAck Ack not in list" << rawCommandName;
     }
 
@@ -3487,7 +3702,7 @@ void Vehicle::_handleMavlinkLoggingDataAcked(mavlink_message_t& message)
         qWarning() << "Invalid length for LOGGING_DATA_ACKED, discarding." << log.length;
     } else {
         emit mavlinkLogData(this, log.target_system, log.target_component, log.sequence,
-                            log.first_message_offset, QByteArray((const char*)log.data, log.length), false);
+                            log.first_message_offset, QByteArray((const char*)log.data, log.length), true);
     }
 }
 
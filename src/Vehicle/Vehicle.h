@@ -15,6 +15,7 @@
 #include <QGeoCoordinate>
 #include <QTime>
 #include <QQueue>
+#include <QHash>
 #include <QSharedPointer>
 
 #include "FactGroup.h"
@@ -95,6 +96,7 @@ class Vehicle : public FactGroup
     friend class SendMavCommandWithSignallingTest;  // Unit test
     friend class SendMavCommandWithHandlerTest;     // Unit test
     friend class RequestMessageTest;                // Unit test
+    friend class MissionManagerTest;                // Unit test
 
 
 public:
@@ -178,6 +180,7 @@ public:
     Q_PROPERTY(int                  newMessageCount             READ newMessageCount                                                NOTIFY newMessageCountChanged)
     Q_PROPERTY(int                  messageCount                READ messageCount                                                   NOTIFY messageCountChanged)
     Q_PROPERTY(QString              formattedMessages           READ formattedMessages                                              NOTIFY formattedMessagesChanged)
+    Q_PROPERTY(QAbstractListModel*  messageModel                READ messageModel                                                   CONSTANT)
     Q_PROPERTY(QString              latestError                 READ latestError                                                    NOTIFY latestErrorChanged)
     Q_PROPERTY(bool                 joystickEnabled             READ joystickEnabled            WRITE setJoystickEnabled            NOTIFY joystickEnabledChanged)
     Q_PROPERTY(int                  flowImageIndex              READ flowImageIndex                                                 NOTIFY flowImageIndexChanged)
@@ -546,6 +549,7 @@ public:
     int             newMessageCount             () const{ return _currentMessageCount; }
     int             messageCount                () const{ return _messageCount; }
     QString         formattedMessages           ();
+    QAbstractListModel* messageModel            ();
     QString         latestError                 () { return _latestError; }
     float           latitude                    () { return static_cast<float>(_coordinate.latitude()); }
     float           longitude                   () { return static_cast<float>(_coordinate.longitude()); }
@@ -726,6 +730,30 @@ public:
     ///     @param resultHandleData Opaque data passed through callback
     void sendMavCommandWithHandler(MavCmdResultHandler resultHandler, void* resultHandlerData, int compId, MAV_CMD command, float param1 = 0.0f, float param2 = 0.0f, float param3 = 0.0f, float param4 = 0.0f, float param5 = 0.0f, float param6 = 0.0f, float param7 = 0.0f);
 
+    /// Histogram of the time from first sending a command to receiving its COMMAND_ACK
+    typedef struct MavCommandLatency {
+        static const int    bucketCount         = 8;
+        int                 count               = 0;
+        int                 retriedCount        = 0;    ///< Acks which needed more than one try
+        qint64              totalMSecs          = 0;
+        qint64              minMSecs            = 0;
+        qint64              maxMSecs            = 0;
+        int                 buckets[bucketCount] = { 0 };  ///< Upper limits in mavCommandLatencyBucketLimitsMSecs
+    } MavCommandLatency_t;
+
+    static const int mavCommandLatencyBucketLimitsMSecs[MavCommandLatency_t::bucketCount];
+
+    /// @return Ack latency histogram for the command, empty if no ack has been received for it
+    MavCommandLatency_t mavCommandLatency(MAV_CMD command) const { return _mavCommandLatency.value(command); }
+
+    /// Ack latency histograms for all acked commands, for diagnostics display
+    ///     @return List of maps with command, count, retriedCount, minMSecs, maxMSecs, meanMSecs, buckets and bucketLimitsMSecs
+    Q_INVOKABLE QVariantList mavCommandLatencyHistograms() const;
+
+    /// Time spent in FactGroup::handleMessage for each fact group, for diagnostics display
+    ///     @return List of maps with name, messageCount, totalUSecs and meanUSecs
+    Q_INVOKABLE QVariantList factGroupMessageCosts() const;
+
     typedef enum {
         RequestMessageNoFailure,
         RequestMessageFailureCommandError,
@@ -1236,6 +1264,24 @@ private:
 
     void _waitForMavlinkMessageMessageReceived(const mavlink_message_t& message);
 
+    // Fact group message dispatch. Groups declare the message ids they handle, so each message only goes to
+    // the groups which want it instead of through every group's handleMessage.
+    typedef struct FactGroupDispatch {
+        FactGroup*  factGroup;
+        QString     name;
+        quint64     messageCount;
+        qint64      totalNSecs;
+    } FactGroupDispatch_t;
+
+    void _dispatchFactGroupMessage      (mavlink_message_t& message);
+    void _rebuildFactGroupDispatch      (void);
+
+    QVector<FactGroupDispatch_t>        _factGroupDispatch;
+    QHash<uint32_t, QVector<int>>       _factGroupDispatchTable;        ///< msgid -> indices into _factGroupDispatch
+    QVector<int>                        _factGroupDispatchAllMessages;  ///< Groups which have not declared their message ids
+    bool                                _factGroupDispatchDirty         = true;
+    QElapsedTimer                       _factGroupDispatchClock;
+
     // requestMessage handling
     typedef struct RequestMessageInfo {
         Vehicle*                    vehicle             = nullptr;
@@ -1262,20 +1308,44 @@ private:
         void*               resultHandlerData   = nullptr;
         int                 maxTries            = _mavCommandMaxRetryCount;
         int                 tryCount            = 0;
-        QElapsedTimer       elapsedTimer;
+        QElapsedTimer       elapsedTimer;                   ///< Started on first send, used for latency
         int                 ackTimeoutMSecs     = _mavCommandAckTimeoutMSecs;
+        quint32             sequence            = 0;        ///< Unique id, timer wheel entries refer to commands by (key, sequence)
     } MavCommandListEntry_t;
 
-    QList<MavCommandListEntry_t>    _mavCommandList;
-    QTimer                          _mavCommandResponseCheckTimer;
-    static const int                _mavCommandMaxRetryCount                = 3;
-    static const int                _mavCommandResponseCheckTimeoutMSecs    = 500;
-    static const int                _mavCommandAckTimeoutMSecs              = 3000;
-    static const int                _mavCommandAckTimeoutMSecsHighLatency   = 120000;
+    typedef struct MavCommandTimer {
+        quint32             key;
+        quint32             sequence;
+        int                 rounds;                         ///< Full turns of the wheel left before the timer fires
+    } MavCommandTimer_t;
+
+    typedef QList<MavCommandListEntry_t> MavCommandEntryList_t;
+
+    // Pending commands are hashed by (compId, command). Commands which can be duplicated (see _commandCanBeDuplicated)
+    // are kept in send order under the same key. Retries and timeouts are driven by a timer wheel with one slot per
+    // _mavCommandResponseCheckTimeoutMSecs tick, so a tick only looks at the commands which are due.
+    QHash<quint32, MavCommandEntryList_t>   _mavCommandTable;
+    int                                     _mavCommandPendingCount = 0;
+    quint32                                 _mavCommandNextSequence = 0;
+    QVector<QList<MavCommandTimer_t>>       _mavCommandTimerWheel;
+    int                                     _mavCommandTimerWheelPos = 0;
+    QMap<int /* MAV_CMD */, MavCommandLatency_t> _mavCommandLatency;
+    QTimer                                  _mavCommandResponseCheckTimer;
+    static const int                        _mavCommandMaxRetryCount                = 3;
+    static const int                        _mavCommandResponseCheckTimeoutMSecs    = 500;
+    static const int                        _mavCommandAckTimeoutMSecs              = 3000;
+    static const int                        _mavCommandAckTimeoutMSecsHighLatency   = 120000;
+    static const int                        _mavCommandTimerWheelSlots              = 64;
+
+    static quint32 _mavCommandKey(int compId, MAV_CMD command) { return (static_cast<quint32>(compId & 0xFF) << 16) | static_cast<quint16>(command); }
 
     void _sendMavCommandWorker  (bool commandInt, bool showError, MavCmdResultHandler resultHandler, void* resultHandlerData, int compId, MAV_CMD command, MAV_FRAME frame, float param1, float param2, float param3, float param4, float param5, float param6, float param7);
-    void _sendMavCommandFromList(int index);
-    int  _findMavCommandListEntryIndex(int targetCompId, MAV_CMD command);
+    void _sendMavCommandFromList(quint32 key, quint32 sequence);
+    MavCommandListEntry_t*  _findMavCommandListEntry    (int targetCompId, MAV_CMD command);
+    MavCommandListEntry_t*  _findMavCommandListEntry    (quint32 key, quint32 sequence);
+    MavCommandListEntry_t   _takeMavCommandListEntry    (quint32 key, quint32 sequence);
+    void                    _scheduleMavCommandTimer    (quint32 key, quint32 sequence, int delayMSecs);
+    void                    _recordMavCommandLatency    (const MavCommandListEntry_t& entry);
     bool _sendMavCommandShouldRetry(MAV_CMD command);
     bool _commandCanBeDuplicated(MAV_CMD command);
 
@@ -43,6 +43,8 @@ VehicleBatteryFactGroup::VehicleBatteryFactGroup(uint8_t batteryId, QObject* par
     , _chargeStateFact      (0, _chargeStateFactName,               FactMetaData::valueTypeUint8)
     , _instantPowerFact     (0, _instantPowerFactName,              FactMetaData::valueTypeDouble)
 {
+    _setHandledMessageIds({ MAVLINK_MSG_ID_HIGH_LATENCY, MAVLINK_MSG_ID_HIGH_LATENCY2, MAVLINK_MSG_ID_BATTERY_STATUS });
+
     _addFact(&_batteryIdFact,               _batteryIdFactName);
     _addFact(&_batteryFunctionFact,         _batteryFunctionFactName);
     _addFact(&_batteryTypeFact,             _batteryTypeFactName);
@@ -109,7 +111,7 @@ void VehicleBatteryFactGroup::_handleHighLatency(Vehicle* vehicle, mavlink_messa
     mavlink_msg_high_latency_decode(&message, &highLatency);
 
     VehicleBatteryFactGroup* group = _findOrAddBatteryGroupById(vehicle, 0);
-    group->percentRemaining()->setRawValue(highLatency.battery_remaining == UINT8_MAX ? qQNaN() : highLatency.battery_remaining);
+    group->percentRemaining()->setTelemetryRawValue(highLatency.battery_remaining == UINT8_MAX ? qQNaN() : highLatency.battery_remaining);
     group->_setTelemetryAvailable(true);
 }
 
@@ -119,7 +121,7 @@ void VehicleBatteryFactGroup::_handleHighLatency2(Vehicle* vehicle, mavlink_mess
     mavlink_msg_high_latency2_decode(&message, &highLatency2);
 
     VehicleBatteryFactGroup* group = _findOrAddBatteryGroupById(vehicle, 0);
-    group->percentRemaining()->setRawValue(highLatency2.battery == -1 ? qQNaN() : highLatency2.battery);
+    group->percentRemaining()->setTelemetryRawValue(highLatency2.battery == -1 ? qQNaN() : highLatency2.battery);
     group->_setTelemetryAvailable(true);
 }
 
@@ -150,16 +152,16 @@ void VehicleBatteryFactGroup::_handleBatteryStatus(Vehicle* vehicle, mavlink_mes
         totalVoltage += cellVoltage;
     }
 
-    group->function()->setRawValue          (batteryStatus.battery_function);
-    group->type()->setRawValue              (batteryStatus.type);
-    group->temperature()->setRawValue       (batteryStatus.temperature == INT16_MAX ?   qQNaN() : static_cast<double>(batteryStatus.temperature) / 100.0);
-    group->voltage()->setRawValue           (totalVoltage);
-    group->current()->setRawValue           (batteryStatus.current_battery == -1 ?      qQNaN() : static_cast<double>(batteryStatus.current_battery) / 100.0);
-    group->mahConsumed()->setRawValue       (batteryStatus.current_consumed == -1  ?    qQNaN() : batteryStatus.current_consumed);
-    group->percentRemaining()->setRawValue  (batteryStatus.battery_remaining == -1 ?    qQNaN() : batteryStatus.battery_remaining);
-    group->timeRemaining()->setRawValue     (batteryStatus.time_remaining == 0 ?        qQNaN() : batteryStatus.time_remaining);
-    group->chargeState()->setRawValue       (batteryStatus.charge_state);
-    group->instantPower()->setRawValue      (totalVoltage * group->current()->rawValue().toDouble());
+    group->function()->setTelemetryRawValue          (batteryStatus.battery_function);
+    group->type()->setTelemetryRawValue              (batteryStatus.type);
+    group->temperature()->setTelemetryRawValue       (batteryStatus.temperature == INT16_MAX ?   qQNaN() : static_cast<double>(batteryStatus.temperature) / 100.0);
+    group->voltage()->setTelemetryRawValue           (totalVoltage);
+    group->current()->setTelemetryRawValue           (batteryStatus.current_battery == -1 ?      qQNaN() : static_cast<double>(batteryStatus.current_battery) / 100.0);
+    group->mahConsumed()->setTelemetryRawValue       (batteryStatus.current_consumed == -1  ?    qQNaN() : batteryStatus.current_consumed);
+    group->percentRemaining()->setTelemetryRawValue  (batteryStatus.battery_remaining == -1 ?    qQNaN() : batteryStatus.battery_remaining);
+    group->timeRemaining()->setTelemetryRawValue     (batteryStatus.time_remaining == 0 ?        qQNaN() : batteryStatus.time_remaining);
+    group->chargeState()->setTelemetryRawValue       (batteryStatus.charge_state);
+    group->instantPower()->setTelemetryRawValue      (totalVoltage * group->current()->rawValue().toDouble());
     group->_setTelemetryAvailable(true);
 }
 
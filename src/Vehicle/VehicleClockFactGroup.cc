@@ -18,19 +18,23 @@ VehicleClockFactGroup::VehicleClockFactGroup(QObject* parent)
     , _currentTimeFact  (0, _currentTimeFactName,    FactMetaData::valueTypeString)
     , _currentDateFact  (0, _currentDateFactName,    FactMetaData::valueTypeString)
 {
+    // Values are filled in from outside handleMessage
+    _setHandledMessageIds({});
+
     _addFact(&_currentTimeFact, _currentTimeFactName);
     _addFact(&_currentDateFact, _currentDateFactName);
 
     // Start out as not available "--.--"
     _currentTimeFact.setRawValue(std::numeric_limits<float>::quiet_NaN());
     _currentDateFact.setRawValue(std::numeric_limits<float>::quiet_NaN());
+
+    connect(&_clockTimer, &QTimer::timeout, this, &VehicleClockFactGroup::_updateClock);
+    _clockTimer.start(_updateRateMSecs);
 }
 
-void VehicleClockFactGroup::_updateAllValues()
+void VehicleClockFactGroup::_updateClock()
 {
     _currentTimeFact.setRawValue(QTime::currentTime().toString());
     _currentDateFact.setRawValue(QDateTime::currentDateTime().toString(QLocale::system().dateFormat(QLocale::ShortFormat)));
     _setTelemetryAvailable(true);
-
-    FactGroup::_updateAllValues();
 }
@@ -33,9 +33,10 @@ public:
     static const char* _settingsGroup;
 
 private slots:
-    void _updateAllValues() override;
+    void _updateClock();
 
 private:
     Fact            _currentTimeFact;
     Fact            _currentDateFact;
+    QTimer          _clockTimer;
 };
@@ -38,6 +38,8 @@ VehicleDistanceSensorFactGroup::VehicleDistanceSensorFactGroup(QObject* parent)
     , _minDistanceFact      (0, _minDistanceFactName,       FactMetaData::valueTypeDouble)
     , _maxDistanceFact      (0, _maxDistanceFactName,       FactMetaData::valueTypeDouble)
 {
+    _setHandledMessageIds({ MAVLINK_MSG_ID_DISTANCE_SENSOR });
+
     _addFact(&_rotationNoneFact,        _rotationNoneFactName);
     _addFact(&_rotationYaw45Fact,       _rotationYaw45FactName);
     _addFact(&_rotationYaw90Fact,       _rotationYaw90FactName);
@@ -84,10 +86,10 @@ void VehicleDistanceSensorFactGroup::handleMessage(Vehicle* /* vehicle */, mavli
     for (size_t i=0; i<sizeof(rgOrientation2Fact)/sizeof(rgOrientation2Fact[0]); i++) {
         const orientation2Fact_s& orientation2Fact = rgOrientation2Fact[i];
         if (orientation2Fact.orientation == distanceSensor.orientation) {
-            orientation2Fact.fact->setRawValue(distanceSensor.current_distance / 100.0); // cm to meters
+            orientation2Fact.fact->setTelemetryRawValue(distanceSensor.current_distance / 100.0); // cm to meters
         }
     }
 
-    maxDistance()->setRawValue(distanceSensor.max_distance / 100.0);
+    maxDistance()->setTelemetryRawValue(distanceSensor.max_distance / 100.0);
     _setTelemetryAvailable(true);
 }
@@ -46,6 +46,8 @@ VehicleEscStatusFactGroup::VehicleEscStatusFactGroup(QObject* parent)
     , _voltageThirdFact                 (0, _voltageThirdFactName,                  FactMetaData::valueTypeFloat)
     , _voltageFourthFact                (0, _voltageFourthFactName,                 FactMetaData::valueTypeFloat)
 {
+    _setHandledMessageIds({ MAVLINK_MSG_ID_ESC_STATUS });
+
     _addFact(&_indexFact,                       _indexFactName);
 
     _addFact(&_rpmFirstFact,                    _rpmFirstFactName);
@@ -73,20 +75,20 @@ void VehicleEscStatusFactGroup::handleMessage(Vehicle* /* vehicle */, mavlink_me
     mavlink_esc_status_t content;
     mavlink_msg_esc_status_decode(&message, &content);
 
-    index()->setRawValue                        (content.index);
+    index()->setTelemetryRawValue                        (content.index);
 
-    rpmFirst()->setRawValue                     (content.rpm[0]);
-    rpmSecond()->setRawValue                    (content.rpm[1]);
-    rpmThird()->setRawValue                     (content.rpm[2]);
-    rpmFourth()->setRawValue                    (content.rpm[3]);
+    rpmFirst()->setTelemetryRawValue                     (content.rpm[0]);
+    rpmSecond()->setTelemetryRawValue                    (content.rpm[1]);
+    rpmThird()->setTelemetryRawValue                     (content.rpm[2]);
+    rpmFourth()->setTelemetryRawValue                    (content.rpm[3]);
 
-    currentFirst()->setRawValue                 (content.current[0]);
-    currentSecond()->setRawValue                (content.current[1]);
-    currentThird()->setRawValue                 (content.current[2]);
-    currentFourth()->setRawValue                (content.current[3]);
+    currentFirst()->setTelemetryRawValue                 (content.current[0]);
+    currentSecond()->setTelemetryRawValue                (content.current[1]);
+    currentThird()->setTelemetryRawValue                 (content.current[2]);
+    currentFourth()->setTelemetryRawValue                (content.current[3]);
 
-    voltageFirst()->setRawValue                 (content.voltage[0]);
-    voltageSecond()->setRawValue                (content.voltage[1]);
-    voltageThird()->setRawValue                 (content.voltage[2]);
-    voltageFourth()->setRawValue                (content.voltage[3]);
+    voltageFirst()->setTelemetryRawValue                 (content.voltage[0]);
+    voltageSecond()->setTelemetryRawValue                (content.voltage[1]);
+    voltageThird()->setTelemetryRawValue                 (content.voltage[2]);
+    voltageFourth()->setTelemetryRawValue                (content.voltage[3]);
 }
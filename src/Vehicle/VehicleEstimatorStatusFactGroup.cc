@@ -54,6 +54,8 @@ VehicleEstimatorStatusFactGroup::VehicleEstimatorStatusFactGroup(QObject* parent
     , _horizPosAccuracyFact             (0, _horizPosAccuracyFactName,              FactMetaData::valueTypeFloat)
     , _vertPosAccuracyFact              (0, _vertPosAccuracyFactName,               FactMetaData::valueTypeFloat)
 {
+    _setHandledMessageIds({ MAVLINK_MSG_ID_ESTIMATOR_STATUS });
+
     _addFact(&_goodAttitudeEstimateFact,        _goodAttitudeEstimateFactName);
     _addFact(&_goodHorizVelEstimateFact,        _goodHorizVelEstimateFactName);
     _addFact(&_goodVertVelEstimateFact,         _goodVertVelEstimateFactName);
@@ -85,26 +87,26 @@ void VehicleEstimatorStatusFactGroup::handleMessage(Vehicle* /* vehicle */, mavl
     mavlink_estimator_status_t estimatorStatus;
     mavlink_msg_estimator_status_decode(&message, &estimatorStatus);
 
-    goodAttitudeEstimate()->setRawValue         (!!(estimatorStatus.flags & ESTIMATOR_ATTITUDE));
-    goodHorizVelEstimate()->setRawValue         (!!(estimatorStatus.flags & ESTIMATOR_VELOCITY_HORIZ));
-    goodVertVelEstimate()->setRawValue          (!!(estimatorStatus.flags & ESTIMATOR_VELOCITY_VERT));
-    goodHorizPosRelEstimate()->setRawValue      (!!(estimatorStatus.flags & ESTIMATOR_POS_HORIZ_REL));
-    goodHorizPosAbsEstimate()->setRawValue      (!!(estimatorStatus.flags & ESTIMATOR_POS_HORIZ_ABS));
-    goodVertPosAbsEstimate()->setRawValue       (!!(estimatorStatus.flags & ESTIMATOR_POS_VERT_ABS));
-    goodVertPosAGLEstimate()->setRawValue       (!!(estimatorStatus.flags & ESTIMATOR_POS_VERT_AGL));
-    goodConstPosModeEstimate()->setRawValue     (!!(estimatorStatus.flags & ESTIMATOR_CONST_POS_MODE));
-    goodPredHorizPosRelEstimate()->setRawValue  (!!(estimatorStatus.flags & ESTIMATOR_PRED_POS_HORIZ_REL));
-    goodPredHorizPosAbsEstimate()->setRawValue  (!!(estimatorStatus.flags & ESTIMATOR_PRED_POS_HORIZ_ABS));
-    gpsGlitch()->setRawValue                    (estimatorStatus.flags & ESTIMATOR_GPS_GLITCH ? true : false);
-    accelError()->setRawValue                   (!!(estimatorStatus.flags & ESTIMATOR_ACCEL_ERROR));
-    velRatio()->setRawValue                     (estimatorStatus.vel_ratio);
-    horizPosRatio()->setRawValue                (estimatorStatus.pos_horiz_ratio);
-    vertPosRatio()->setRawValue                 (estimatorStatus.pos_vert_ratio);
-    magRatio()->setRawValue                     (estimatorStatus.mag_ratio);
-    haglRatio()->setRawValue                    (estimatorStatus.hagl_ratio);
-    tasRatio()->setRawValue                     (estimatorStatus.tas_ratio);
-    horizPosAccuracy()->setRawValue             (estimatorStatus.pos_horiz_accuracy);
-    vertPosAccuracy()->setRawValue              (estimatorStatus.pos_vert_accuracy);
+    goodAttitudeEstimate()->setTelemetryRawValue         (!!(estimatorStatus.flags & ESTIMATOR_ATTITUDE));
+    goodHorizVelEstimate()->setTelemetryRawValue         (!!(estimatorStatus.flags & ESTIMATOR_VELOCITY_HORIZ));
+    goodVertVelEstimate()->setTelemetryRawValue          (!!(estimatorStatus.flags & ESTIMATOR_VELOCITY_VERT));
+    goodHorizPosRelEstimate()->setTelemetryRawValue      (!!(estimatorStatus.flags & ESTIMATOR_POS_HORIZ_REL));
+    goodHorizPosAbsEstimate()->setTelemetryRawValue      (!!(estimatorStatus.flags & ESTIMATOR_POS_HORIZ_ABS));
+    goodVertPosAbsEstimate()->setTelemetryRawValue       (!!(estimatorStatus.flags & ESTIMATOR_POS_VERT_ABS));
+    goodVertPosAGLEstimate()->setTelemetryRawValue       (!!(estimatorStatus.flags & ESTIMATOR_POS_VERT_AGL));
+    goodConstPosModeEstimate()->setTelemetryRawValue     (!!(estimatorStatus.flags & ESTIMATOR_CONST_POS_MODE));
+    goodPredHorizPosRelEstimate()->setTelemetryRawValue  (!!(estimatorStatus.flags & ESTIMATOR_PRED_POS_HORIZ_REL));
+    goodPredHorizPosAbsEstimate()->setTelemetryRawValue  (!!(estimatorStatus.flags & ESTIMATOR_PRED_POS_HORIZ_ABS));
+    gpsGlitch()->setTelemetryRawValue                    (estimatorStatus.flags & ESTIMATOR_GPS_GLITCH ? true : false);
+    accelError()->setTelemetryRawValue                   (!!(estimatorStatus.flags & ESTIMATOR_ACCEL_ERROR));
+    velRatio()->setTelemetryRawValue                     (estimatorStatus.vel_ratio);
+    horizPosRatio()->setTelemetryRawValue                (estimatorStatus.pos_horiz_ratio);
+    vertPosRatio()->setTelemetryRawValue                 (estimatorStatus.pos_vert_ratio);
+    magRatio()->setTelemetryRawValue                     (estimatorStatus.mag_ratio);
+    haglRatio()->setTelemetryRawValue                    (estimatorStatus.hagl_ratio);
+    tasRatio()->setTelemetryRawValue                     (estimatorStatus.tas_ratio);
+    horizPosAccuracy()->setTelemetryRawValue             (estimatorStatus.pos_horiz_accuracy);
+    vertPosAccuracy()->setTelemetryRawValue              (estimatorStatus.pos_vert_accuracy);
 
     _setTelemetryAvailable(true);
 }
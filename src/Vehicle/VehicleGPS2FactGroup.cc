@@ -12,7 +12,10 @@
 #include "QGCGeo.h"
 
 VehicleGPS2FactGroup::VehicleGPS2FactGroup(QObject* parent)
-    : VehicleGPSFactGroup(parent) {}
+    : VehicleGPSFactGroup(parent)
+{
+    _setHandledMessageIds({ MAVLINK_MSG_ID_GPS2_RAW });
+}
 
 void VehicleGPS2FactGroup::handleMessage(Vehicle* /* vehicle */, mavlink_message_t& message)
 {
@@ -30,12 +33,12 @@ void VehicleGPS2FactGroup::_handleGps2Raw(mavlink_message_t& message)
     mavlink_gps2_raw_t gps2Raw;
     mavlink_msg_gps2_raw_decode(&message, &gps2Raw);
 
-    lat()->setRawValue              (gps2Raw.lat * 1e-7);
-    lon()->setRawValue              (gps2Raw.lon * 1e-7);
-    mgrs()->setRawValue             (convertGeoToMGRS(QGeoCoordinate(gps2Raw.lat * 1e-7, gps2Raw.lon * 1e-7)));
-    count()->setRawValue            (gps2Raw.satellites_visible == 255 ? 0 : gps2Raw.satellites_visible);
-    hdop()->setRawValue             (gps2Raw.eph == UINT16_MAX ? qQNaN() : gps2Raw.eph / 100.0);
-    vdop()->setRawValue             (gps2Raw.epv == UINT16_MAX ? qQNaN() : gps2Raw.epv / 100.0);
-    courseOverGround()->setRawValue (gps2Raw.cog == UINT16_MAX ? qQNaN() : gps2Raw.cog / 100.0);
-    lock()->setRawValue             (gps2Raw.fix_type);
+    lat()->setTelemetryRawValue              (gps2Raw.lat * 1e-7);
+    lon()->setTelemetryRawValue              (gps2Raw.lon * 1e-7);
+    mgrs()->setRawValue                      (convertGeoToMGRS(QGeoCoordinate(gps2Raw.lat * 1e-7, gps2Raw.lon * 1e-7)));
+    count()->setTelemetryRawValue            (gps2Raw.satellites_visible == 255 ? 0 : gps2Raw.satellites_visible);
+    hdop()->setTelemetryRawValue             (gps2Raw.eph == UINT16_MAX ? qQNaN() : gps2Raw.eph / 100.0);
+    vdop()->setTelemetryRawValue             (gps2Raw.epv == UINT16_MAX ? qQNaN() : gps2Raw.epv / 100.0);
+    courseOverGround()->setTelemetryRawValue (gps2Raw.cog == UINT16_MAX ? qQNaN() : gps2Raw.cog / 100.0);
+    lock()->setTelemetryRawValue             (gps2Raw.fix_type);
 }
\ No newline at end of file
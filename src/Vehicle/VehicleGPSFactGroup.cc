@@ -31,6 +31,8 @@ VehicleGPSFactGroup::VehicleGPSFactGroup(QObject* parent)
     , _countFact            (0, _countFactName,             FactMetaData::valueTypeInt32)
     , _lockFact             (0, _lockFactName,              FactMetaData::valueTypeInt32)
 {
+    _setHandledMessageIds({ MAVLINK_MSG_ID_GPS_RAW_INT, MAVLINK_MSG_ID_HIGH_LATENCY, MAVLINK_MSG_ID_HIGH_LATENCY2 });
+
     _addFact(&_latFact,                 _latFactName);
     _addFact(&_lonFact,                 _lonFactName);
     _addFact(&_mgrsFact,                _mgrsFactName);
@@ -70,14 +72,14 @@ void VehicleGPSFactGroup::_handleGpsRawInt(mavlink_message_t& message)
     mavlink_gps_raw_int_t gpsRawInt;
     mavlink_msg_gps_raw_int_decode(&message, &gpsRawInt);
 
-    lat()->setRawValue              (gpsRawInt.lat * 1e-7);
-    lon()->setRawValue              (gpsRawInt.lon * 1e-7);
-    mgrs()->setRawValue             (convertGeoToMGRS(QGeoCoordinate(gpsRawInt.lat * 1e-7, gpsRawInt.lon * 1e-7)));
-    count()->setRawValue            (gpsRawInt.satellites_visible == 255 ? 0 : gpsRawInt.satellites_visible);
-    hdop()->setRawValue             (gpsRawInt.eph == UINT16_MAX ? qQNaN() : gpsRawInt.eph / 100.0);
-    vdop()->setRawValue             (gpsRawInt.epv == UINT16_MAX ? qQNaN() : gpsRawInt.epv / 100.0);
-    courseOverGround()->setRawValue (gpsRawInt.cog == UINT16_MAX ? qQNaN() : gpsRawInt.cog / 100.0);
-    lock()->setRawValue             (gpsRawInt.fix_type);
+    lat()->setTelemetryRawValue              (gpsRawInt.lat * 1e-7);
+    lon()->setTelemetryRawValue              (gpsRawInt.lon * 1e-7);
+    mgrs()->setRawValue                      (convertGeoToMGRS(QGeoCoordinate(gpsRawInt.lat * 1e-7, gpsRawInt.lon * 1e-7)));
+    count()->setTelemetryRawValue            (gpsRawInt.satellites_visible == 255 ? 0 : gpsRawInt.satellites_visible);
+    hdop()->setTelemetryRawValue             (gpsRawInt.eph == UINT16_MAX ? qQNaN() : gpsRawInt.eph / 100.0);
+    vdop()->setTelemetryRawValue             (gpsRawInt.epv == UINT16_MAX ? qQNaN() : gpsRawInt.epv / 100.0);
+    courseOverGround()->setTelemetryRawValue (gpsRawInt.cog == UINT16_MAX ? qQNaN() : gpsRawInt.cog / 100.0);
+    lock()->setTelemetryRawValue             (gpsRawInt.fix_type);
 }
 
 void VehicleGPSFactGroup::_handleHighLatency(mavlink_message_t& message)
@@ -95,10 +97,10 @@ void VehicleGPSFactGroup::_handleHighLatency(mavlink_message_t& message)
                 static_cast<double>(highLatency.altitude_amsl)
     };
 
-    lat()->setRawValue  (coordinate.latitude);
-    lon()->setRawValue  (coordinate.longitude);
-    mgrs()->setRawValue (convertGeoToMGRS(QGeoCoordinate(coordinate.latitude, coordinate.longitude)));
-    count()->setRawValue(0);
+    lat()->setTelemetryRawValue   (coordinate.latitude);
+    lon()->setTelemetryRawValue   (coordinate.longitude);
+    mgrs()->setRawValue           (convertGeoToMGRS(QGeoCoordinate(coordinate.latitude, coordinate.longitude)));
+    count()->setTelemetryRawValue (0);
 }
 
 void VehicleGPSFactGroup::_handleHighLatency2(mavlink_message_t& message)
@@ -106,10 +108,10 @@ void VehicleGPSFactGroup::_handleHighLatency2(mavlink_message_t& message)
     mavlink_high_latency2_t highLatency2;
     mavlink_msg_high_latency2_decode(&message, &highLatency2);
 
-    lat()->setRawValue  (highLatency2.latitude * 1e-7);
-    lon()->setRawValue  (highLatency2.longitude * 1e-7);
-    mgrs()->setRawValue (convertGeoToMGRS(QGeoCoordinate(highLatency2.latitude * 1e-7, highLatency2.longitude * 1e-7)));
-    count()->setRawValue(0);
-    hdop()->setRawValue (highLatency2.eph == UINT8_MAX ? qQNaN() : highLatency2.eph / 10.0);
-    vdop()->setRawValue (highLatency2.epv == UINT8_MAX ? qQNaN() : highLatency2.epv / 10.0);
+    lat()->setTelemetryRawValue   (highLatency2.latitude * 1e-7);
+    lon()->setTelemetryRawValue   (highLatency2.longitude * 1e-7);
+    mgrs()->setRawValue           (convertGeoToMGRS(QGeoCoordinate(highLatency2.latitude * 1e-7, highLatency2.longitude * 1e-7)));
+    count()->setTelemetryRawValue (0);
+    hdop()->setTelemetryRawValue  (highLatency2.eph == UINT8_MAX ? qQNaN() : highLatency2.eph / 10.0);
+    vdop()->setTelemetryRawValue  (highLatency2.epv == UINT8_MAX ? qQNaN() : highLatency2.epv / 10.0);
 }
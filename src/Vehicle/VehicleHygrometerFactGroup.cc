@@ -21,6 +21,8 @@ VehicleHygrometerFactGroup::VehicleHygrometerFactGroup(QObject* parent)
     , _hygroHumiFact             (0, _hygroHumiFactName,         FactMetaData::valueTypeDouble)
     , _hygroIDFact               (0, _hygroIDFactName,           FactMetaData::valueTypeUint16)
 {   
+    _setHandledMessageIds({ MAVLINK_MSG_ID_HYGROMETER_SENSOR });
+
     _addFact(&_hygroTempFact,               _hygroTempFactName);
     _addFact(&_hygroHumiFact,               _hygroHumiFactName);
     _addFact(&_hygroIDFact,                 _hygroIDFactName);
@@ -46,7 +48,7 @@ void VehicleHygrometerFactGroup::_handleHygrometerSensor(mavlink_message_t& mess
     mavlink_hygrometer_sensor_t hygrometer;
     mavlink_msg_hygrometer_sensor_decode(&message, &hygrometer);
 
-    _hygroTempFact.setRawValue(hygrometer.temperature);
-    _hygroHumiFact.setRawValue(hygrometer.humidity);
-    _hygroIDFact.setRawValue(hygrometer.id);
+    _hygroTempFact.setTelemetryRawValue(hygrometer.temperature);
+    _hygroHumiFact.setTelemetryRawValue(hygrometer.humidity);
+    _hygroIDFact.setTelemetryRawValue(hygrometer.id);
 }
@@ -28,6 +28,8 @@ VehicleLocalPositionFactGroup::VehicleLocalPositionFactGroup(QObject* parent)
     , _vyFact   (0, _vyFactName,    FactMetaData::valueTypeDouble)
     , _vzFact   (0, _vzFactName,    FactMetaData::valueTypeDouble)
 {
+    _setHandledMessageIds({ MAVLINK_MSG_ID_LOCAL_POSITION_NED });
+
     _addFact(&_xFact,      _xFactName);
     _addFact(&_yFact,      _yFactName);
     _addFact(&_zFact,      _zFactName);
@@ -53,13 +55,13 @@ void VehicleLocalPositionFactGroup::handleMessage(Vehicle* /* vehicle */, mavlin
     mavlink_local_position_ned_t localPosition;
     mavlink_msg_local_position_ned_decode(&message, &localPosition);
 
-    x()->setRawValue(localPosition.x);
-    y()->setRawValue(localPosition.y);
-    z()->setRawValue(localPosition.z);
+    x()->setTelemetryRawValue(localPosition.x);
+    y()->setTelemetryRawValue(localPosition.y);
+    z()->setTelemetryRawValue(localPosition.z);
 
-    vx()->setRawValue(localPosition.vx);
-    vy()->setRawValue(localPosition.vy);
-    vz()->setRawValue(localPosition.vz);
+    vx()->setTelemetryRawValue(localPosition.vx);
+    vy()->setTelemetryRawValue(localPosition.vy);
+    vz()->setTelemetryRawValue(localPosition.vz);
 
     _setTelemetryAvailable(true);
 }
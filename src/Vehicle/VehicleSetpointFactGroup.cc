@@ -28,6 +28,8 @@ VehicleSetpointFactGroup::VehicleSetpointFactGroup(QObject* parent)
     , _pitchRateFact(0, _pitchRateFactName, FactMetaData::valueTypeDouble)
     , _yawRateFact  (0, _yawRateFactName,   FactMetaData::valueTypeDouble)
 {
+    _setHandledMessageIds({ MAVLINK_MSG_ID_ATTITUDE_TARGET });
+
     _addFact(&_rollFact,        _rollFactName);
     _addFact(&_pitchFact,       _pitchFactName);
     _addFact(&_yawFact,         _yawFactName);
@@ -57,14 +59,14 @@ void VehicleSetpointFactGroup::handleMessage(Vehicle* /* vehicle */, mavlink_mes
     float roll, pitch, yaw;
     mavlink_quaternion_to_euler(attitudeTarget.q, &roll, &pitch, &yaw);
 
-    this->roll()->setRawValue   (qRadiansToDegrees(roll));
-    this->pitch()->setRawValue  (qRadiansToDegrees(pitch));
+    this->roll()->setTelemetryRawValue   (qRadiansToDegrees(roll));
+    this->pitch()->setTelemetryRawValue  (qRadiansToDegrees(pitch));
     if (yaw < 0.f) yaw += 2.f * (float)M_PI; // bring to range [0, 2pi] to match the heading angle
-    this->yaw()->setRawValue    (qRadiansToDegrees(yaw));
+    this->yaw()->setTelemetryRawValue    (qRadiansToDegrees(yaw));
 
-    rollRate()->setRawValue (qRadiansToDegrees(attitudeTarget.body_roll_rate));
-    pitchRate()->setRawValue(qRadiansToDegrees(attitudeTarget.body_pitch_rate));
-    yawRate()->setRawValue  (qRadiansToDegrees(attitudeTarget.body_yaw_rate));
+    rollRate()->setTelemetryRawValue (qRadiansToDegrees(attitudeTarget.body_roll_rate));
+    pitchRate()->setTelemetryRawValue(qRadiansToDegrees(attitudeTarget.body_pitch_rate));
+    yawRate()->setTelemetryRawValue  (qRadiansToDegrees(attitudeTarget.body_yaw_rate));
 
     _setTelemetryAvailable(true);
 }
@@ -20,6 +20,8 @@ VehicleTemperatureFactGroup::VehicleTemperatureFactGroup(QObject* parent)
     , _temperature2Fact    (0, _temperature2FactName,     FactMetaData::valueTypeDouble)
     , _temperature3Fact    (0, _temperature3FactName,     FactMetaData::valueTypeDouble)
 {
+    _setHandledMessageIds({ MAVLINK_MSG_ID_SCALED_PRESSURE, MAVLINK_MSG_ID_SCALED_PRESSURE2, MAVLINK_MSG_ID_SCALED_PRESSURE3, MAVLINK_MSG_ID_HIGH_LATENCY, MAVLINK_MSG_ID_HIGH_LATENCY2 });
+
     _addFact(&_temperature1Fact,       _temperature1FactName);
     _addFact(&_temperature2Fact,       _temperature2FactName);
     _addFact(&_temperature3Fact,       _temperature3FactName);
@@ -57,7 +59,7 @@ void VehicleTemperatureFactGroup::_handleHighLatency(mavlink_message_t& message)
 {
     mavlink_high_latency_t highLatency;
     mavlink_msg_high_latency_decode(&message, &highLatency);
-    temperature1()->setRawValue(highLatency.temperature_air);
+    temperature1()->setTelemetryRawValue(highLatency.temperature_air);
     _setTelemetryAvailable(true);
 }
 
@@ -65,7 +67,7 @@ void VehicleTemperatureFactGroup::_handleHighLatency2(mavlink_message_t& message
 {
     mavlink_high_latency2_t highLatency2;
     mavlink_msg_high_latency2_decode(&message, &highLatency2);
-    temperature1()->setRawValue(highLatency2.temperature_air);
+    temperature1()->setTelemetryRawValue(highLatency2.temperature_air);
     _setTelemetryAvailable(true);
 }
 
@@ -73,7 +75,7 @@ void VehicleTemperatureFactGroup::_handleScaledPressure(mavlink_message_t& messa
 {
     mavlink_scaled_pressure_t pressure;
     mavlink_msg_scaled_pressure_decode(&message, &pressure);
-    temperature1()->setRawValue(pressure.temperature / 100.0);
+    temperature1()->setTelemetryRawValue(pressure.temperature / 100.0);
     _setTelemetryAvailable(true);
 }
 
@@ -81,7 +83,7 @@ void VehicleTemperatureFactGroup::_handleScaledPressure2(mavlink_message_t& mess
 {
     mavlink_scaled_pressure2_t pressure;
     mavlink_msg_scaled_pressure2_decode(&message, &pressure);
-    temperature2()->setRawValue(pressure.temperature / 100.0);
+    temperature2()->setTelemetryRawValue(pressure.temperature / 100.0);
     _setTelemetryAvailable(true);
 }
 
@@ -89,6 +91,6 @@ void VehicleTemperatureFactGroup::_handleScaledPressure3(mavlink_message_t& mess
 {
     mavlink_scaled_pressure3_t pressure;
     mavlink_msg_scaled_pressure3_decode(&message, &pressure);
-    temperature3()->setRawValue(pressure.temperature / 100.0);
+    temperature3()->setTelemetryRawValue(pressure.temperature / 100.0);
     _setTelemetryAvailable(true);
 }
@@ -26,6 +26,8 @@ VehicleVibrationFactGroup::VehicleVibrationFactGroup(QObject* parent)
     , _clipCount2Fact   (0, _clipCount2FactName,    FactMetaData::valueTypeUint32)
     , _clipCount3Fact   (0, _clipCount3FactName,    FactMetaData::valueTypeUint32)
 {
+    _setHandledMessageIds({ MAVLINK_MSG_ID_VIBRATION });
+
     _addFact(&_xAxisFact,       _xAxisFactName);
     _addFact(&_yAxisFact,       _yAxisFactName);
     _addFact(&_zAxisFact,       _zAxisFactName);
@@ -48,12 +50,12 @@ void VehicleVibrationFactGroup::handleMessage(Vehicle* /* vehicle */, mavlink_me
     mavlink_vibration_t vibration;
     mavlink_msg_vibration_decode(&message, &vibration);
 
-    xAxis()->setRawValue(vibration.vibration_x);
-    yAxis()->setRawValue(vibration.vibration_y);
-    zAxis()->setRawValue(vibration.vibration_z);
-    clipCount1()->setRawValue(vibration.clipping_0);
-    clipCount2()->setRawValue(vibration.clipping_1);
-    clipCount3()->setRawValue(vibration.clipping_2);
+    xAxis()->setTelemetryRawValue(vibration.vibration_x);
+    yAxis()->setTelemetryRawValue(vibration.vibration_y);
+    zAxis()->setTelemetryRawValue(vibration.vibration_z);
+    clipCount1()->setTelemetryRawValue(vibration.clipping_0);
+    clipCount2()->setTelemetryRawValue(vibration.clipping_1);
+    clipCount3()->setTelemetryRawValue(vibration.clipping_2);
     _setTelemetryAvailable(true);
 }
 
@@ -22,6 +22,8 @@ VehicleWindFactGroup::VehicleWindFactGroup(QObject* parent)
     , _speedFact        (0, _speedFactName,         FactMetaData::valueTypeDouble)
     , _verticalSpeedFact(0, _verticalSpeedFactName, FactMetaData::valueTypeDouble)
 {
+    _setHandledMessageIds({ MAVLINK_MSG_ID_WIND_COV, MAVLINK_MSG_ID_WIND, MAVLINK_MSG_ID_HIGH_LATENCY, MAVLINK_MSG_ID_HIGH_LATENCY2 });
+
     _addFact(&_directionFact,       _directionFactName);
     _addFact(&_speedFact,           _speedFactName);
     _addFact(&_verticalSpeedFact,   _verticalSpeedFactName);
@@ -58,7 +60,7 @@ void VehicleWindFactGroup::_handleHighLatency(mavlink_message_t& message)
 {
     mavlink_high_latency_t highLatency;
     mavlink_msg_high_latency_decode(&message, &highLatency);
-    speed()->setRawValue((double)highLatency.airspeed / 5.0);
+    speed()->setTelemetryRawValue((double)highLatency.airspeed / 5.0);
     _setTelemetryAvailable(true);
 }
 
@@ -66,8 +68,8 @@ void VehicleWindFactGroup::_handleHighLatency2(mavlink_message_t& message)
 {
     mavlink_high_latency2_t highLatency2;
     mavlink_msg_high_latency2_decode(&message, &highLatency2);
-    direction()->setRawValue((double)highLatency2.wind_heading * 2.0);
-    speed()->setRawValue((double)highLatency2.windspeed / 5.0);
+    direction()->setTelemetryRawValue((double)highLatency2.wind_heading * 2.0);
+    speed()->setTelemetryRawValue((double)highLatency2.windspeed / 5.0);
     _setTelemetryAvailable(true);
 }
 
@@ -83,9 +85,9 @@ void VehicleWindFactGroup::_handleWindCov(mavlink_message_t& message)
         direction += 360;
     }
 
-    this->direction()->setRawValue(direction);
-    this->speed()->setRawValue(speed);
-    verticalSpeed()->setRawValue(0);
+    this->direction()->setTelemetryRawValue(direction);
+    this->speed()->setTelemetryRawValue(speed);
+    verticalSpeed()->setTelemetryRawValue(0);
     _setTelemetryAvailable(true);
 }
 
@@ -100,9 +102,9 @@ void VehicleWindFactGroup::_handleWind(mavlink_message_t& message)
     if (direction < 0) {
         direction += 360;
     }
-    this->direction()->setRawValue(direction);
-    speed()->setRawValue(wind.speed);
-    verticalSpeed()->setRawValue(wind.speed_z);
+    this->direction()->setTelemetryRawValue(direction);
+    speed()->setTelemetryRawValue(wind.speed);
+    verticalSpeed()->setTelemetryRawValue(wind.speed_z);
     _setTelemetryAvailable(true);
 }
 #endif
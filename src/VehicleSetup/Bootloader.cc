@@ -14,6 +14,9 @@
 #include <QSerialPortInfo>
 #include <QDebug>
 #include <QElapsedTimer>
+#include <QQueue>
+
+#include <string.h>
 
 #include "QGC.h"
 
@@ -343,6 +346,16 @@ Error:
     return false;
 }
 
+/// Number of PROG_MULTI commands which can be sent before waiting for the first response.
+/// Older bootloaders and SiK radios get one command at a time.
+int Bootloader::_programWindowSize(void) const
+{
+    if (_sikRadio || _bootloaderVersion < _bootloaderVersionPipelined) {
+        return 1;
+    }
+    return _pipelinedProgramWindow;
+}
+
 bool Bootloader::_binProgram(const FirmwareImage* image)
 {
     QFile firmwareFile(image->binFilename());
@@ -352,59 +365,113 @@ bool Bootloader::_binProgram(const FirmwareImage* image)
     }
     uint32_t imageSize = (uint32_t)firmwareFile.size();
     
-    uint8_t imageBuf[PROG_MULTI_MAX];
-    uint32_t bytesSent = 0;
-    _imageCRC = 0;
+    // PROTO_PROG_MULTI, length, data, PROTO_EOC
+    uint8_t     commandBuf[PROG_MULTI_MAX + 3];
+    uint8_t*    imageBuf        = &commandBuf[2];
+    uint32_t    bytesSent       = 0;
+    uint32_t    bytesAcked      = 0;
+    int         windowSize      = _programWindowSize();
+    QQueue<int> inFlightSizes;  // Sizes of the PROG_MULTI commands still waiting for a response
+
+    _imageCRC   = 0;
+    _imageSize  = 0;
     
     Q_ASSERT(PROG_MULTI_MAX <= 0x8F);
+
+    qCDebug(FirmwareUpgradeLog) << "_binProgram window size:" << windowSize;
     
-    while (bytesSent < imageSize) {
-        int bytesToSend = imageSize - bytesSent;
-        if (bytesToSend > (int)sizeof(imageBuf)) {
-            bytesToSend = (int)sizeof(imageBuf);
-        }
-        
-        Q_ASSERT((bytesToSend % 4) == 0);
-        
-        int bytesRead = firmwareFile.read((char *)imageBuf, bytesToSend);
-        if (bytesRead == -1 || bytesRead != bytesToSend) {
-            _errorString = tr("Firmware file read failed: %1").arg(firmwareFile.errorString());
-            return false;
-        }
-        
-        Q_ASSERT(bytesToSend <= 0x8F);
-        
-        bool failed = true;
-        if (_write(PROTO_PROG_MULTI) &&
-                _write((uint8_t)bytesToSend) &&
-                _write(imageBuf, bytesToSend) &&
-                _write(PROTO_EOC)) {
-            if (_getCommandResponse()) {
-                failed = false;
+    while (bytesAcked < imageSize) {
+        if (bytesSent < imageSize && inFlightSizes.count() < windowSize) {
+            int bytesToSend = imageSize - bytesSent;
+            if (bytesToSend > PROG_MULTI_MAX) {
+                bytesToSend = PROG_MULTI_MAX;
+            }
+
+            Q_ASSERT((bytesToSend % 4) == 0);
+
+            int bytesRead = firmwareFile.read((char *)imageBuf, bytesToSend);
+            if (bytesRead == -1 || bytesRead != bytesToSend) {
+                _errorString = tr("Firmware file read failed: %1").arg(firmwareFile.errorString());
+                return false;
+            }
+
+            Q_ASSERT(bytesToSend <= 0x8F);
+
+            commandBuf[0]               = PROTO_PROG_MULTI;
+            commandBuf[1]               = (uint8_t)bytesToSend;
+            commandBuf[bytesToSend + 2] = PROTO_EOC;
+            if (!_write(commandBuf, bytesToSend + 3)) {
+                _errorString = tr("Flash failed: %1 at address 0x%2").arg(_errorString).arg(bytesSent, 8, 16, QLatin1Char('0'));
+                return false;
+            }
+            _port.flush();
+
+            // Calculate the CRC now so we can test it after the board is flashed.
+            _imageCRC = QGC::crc32(imageBuf, bytesToSend, _imageCRC);
+
+            bytesSent += bytesToSend;
+            inFlightSizes.enqueue(bytesToSend);
+            if (inFlightSizes.count() < windowSize && bytesSent < imageSize) {
+                // Keep filling the window before waiting on responses
+                continue;
             }
         }
-        if (failed) {
-            _errorString = tr("Flash failed: %1 at address 0x%2").arg(_errorString).arg(bytesSent, 8, 16, QLatin1Char('0'));
+
+        // Responses come back in command order
+        if (!_getCommandResponse()) {
+            _errorString = tr("Flash failed: %1 at address 0x%2").arg(_errorString).arg(bytesAcked, 8, 16, QLatin1Char('0'));
             return false;
         }
+        bytesAcked += inFlightSizes.dequeue();
 
-        bytesSent += bytesToSend;
+        emit updateProgress(bytesAcked, imageSize);
+    }
+    firmwareFile.close();
 
-        // Calculate the CRC now so we can test it after the board is flashed.
-        _imageCRC = QGC::crc32((uint8_t *)imageBuf, bytesToSend, _imageCRC);
+    // The board calculates the CRC using the entire flash size, the remainder filled with 0xFF is accounted for in _verifyCRC.
+    _imageSize = bytesSent;
 
-        emit updateProgress(bytesSent, imageSize);
+    return true;
+}
+
+/// Feeding one fill byte into the CRC is an affine map over GF(2): crc' = A * crc ^ b, where A is the
+/// effect of a zero byte and b the CRC of the fill byte from a zero state. The map for count bytes is
+/// built by repeated squaring, with matrices stored as the images of each of the 32 state bits.
+uint32_t Bootloader::crc32Fill(uint32_t state, uint8_t fillByte, uint32_t count)
+{
+    auto matrixTimes = [](const uint32_t* matrix, uint32_t vector) {
+        uint32_t sum = 0;
+        for (int bit=0; vector; bit++, vector >>= 1) {
+            if (vector & 1) {
+                sum ^= matrix[bit];
+            }
+        }
+        return sum;
+    };
+
+    const uint8_t   zeroByte = 0;
+    uint32_t        powerMatrix[32];
+    uint32_t        powerVector = QGC::crc32(&fillByte, 1, 0);
+    for (int bit=0; bit<32; bit++) {
+        powerMatrix[bit] = QGC::crc32(&zeroByte, 1, 1u << bit);
     }
-    firmwareFile.close();
 
-    // We calculate the CRC using the entire flash size, filling the remainder with 0xFF.
-    while (bytesSent < _boardFlashSize) {
-        const uint8_t fill = 0xFF;
-        _imageCRC = QGC::crc32(&fill, 1, _imageCRC);
-        bytesSent++;
+    while (count) {
+        if (count & 1) {
+            state = matrixTimes(powerMatrix, state) ^ powerVector;
+        }
+        count >>= 1;
+        if (count) {
+            uint32_t squareMatrix[32];
+            for (int bit=0; bit<32; bit++) {
+                squareMatrix[bit] = matrixTimes(powerMatrix, powerMatrix[bit]);
+            }
+            powerVector = matrixTimes(powerMatrix, powerVector) ^ powerVector;
+            memcpy(powerMatrix, squareMatrix, sizeof(powerMatrix));
+        }
     }
 
-    return true;
+    return state;
 }
 
 bool Bootloader::_ihxProgram(const FirmwareImage* image)
@@ -685,8 +752,14 @@ bool Bootloader::_verifyCRC(void)
         return false;
     }
 
-    if (_imageCRC != flashCRC) {
-        _errorString = tr("CRC mismatch: board(0x%1) file(0x%2)").arg(flashCRC, 4, 16, QLatin1Char('0')).arg(_imageCRC, 4, 16, QLatin1Char('0'));
+    // The board calculates the CRC over the entire flash size, with the remainder filled with 0xFF
+    uint32_t imageCRC = _imageCRC;
+    if (_boardFlashSize > _imageSize) {
+        imageCRC = crc32Fill(imageCRC, 0xFF, _boardFlashSize - _imageSize);
+    }
+
+    if (imageCRC != flashCRC) {
+        _errorString = tr("CRC mismatch: board(0x%1) file(0x%2)").arg(flashCRC, 4, 16, QLatin1Char('0')).arg(imageCRC, 4, 16, QLatin1Char('0'));
         return false;
     }
     
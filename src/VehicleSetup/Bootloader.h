@@ -43,6 +43,10 @@ public:
     static const int boardIDPX4FMUV2 = 9;        ///< PX4 V2 board, as from USB PID
     static const int boardIDPX4FMUV3 = 255;
 
+    /// Returns the CRC state after feeding count copies of fillByte into QGC::crc32 starting from state.
+    /// Runs in O(log count) instead of one crc32 step per byte.
+    static uint32_t crc32Fill(uint32_t state, uint8_t fillByte, uint32_t count);
+
 signals:
     /// @brief Signals progress indicator for long running bootloader utility routines
     void updateProgress(int curr, int total);
@@ -63,6 +67,7 @@ private:
     bool    _binVerifyBytes     (const FirmwareImage* image);
     bool    _ihxVerifyBytes     (const FirmwareImage* image);
     bool    _verifyCRC          (void);
+    int     _programWindowSize  (void) const;
     QString _getNextLine        (int timeoutMsecs);
     bool    _get3DRRadioBoardId (uint32_t& boardID);
 
@@ -108,6 +113,7 @@ private:
     uint32_t    _boardFlashSize     = 0;        ///< flash size for currently connected board
     uint32_t    _bootloaderVersion  = 0;        ///< Bootloader version
     uint32_t    _imageCRC           = 0;        ///< CRC for image in currently selected firmware file
+    uint32_t    _imageSize          = 0;        ///< Number of bytes covered by _imageCRC
     QString     _firmwareFilename;              ///< Currently selected firmware file to flash
     QString     _errorString;                   ///< Last error
     
@@ -118,4 +124,6 @@ private:
     static const int _responseTimeout                   = 2000;     ///< Msecs to wait for command response bytes
     static const int _flashSizeSmall                    = 1032192;  ///< Flash size for boards with silicon error
     static const int _bootloaderVersionV2CorrectFlash   = 5;        ///< Anything below this bootloader version on V2 boards cannot trust flash size
+    static const int _bootloaderVersionPipelined        = 5;        ///< Bootloader versions from this one on reliably queue PROG_MULTI commands received while flashing
+    static const int _pipelinedProgramWindow            = 8;        ///< Number of PROG_MULTI commands kept in flight when pipelining
 };
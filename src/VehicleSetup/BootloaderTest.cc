@@ -0,0 +1,325 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "BootloaderTest.h"
+#include "Bootloader.h"
+#include "FirmwareImage.h"
+#include "QGC.h"
+
+#include <QElapsedTimer>
+#include <QThread>
+#include <QRandomGenerator>
+
+#include <atomic>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/// Minimal PX4 bootloader protocol implementation on the master side of a pseudo terminal. Responses are
+/// held back for a fixed latency to simulate the USB round trip, without stalling command processing.
+class FakeBootloader : public QThread
+{
+public:
+    FakeBootloader(uint32_t bootloaderVersion, uint32_t flashSize)
+        : _bootloaderVersion(bootloaderVersion)
+        , _flash            (static_cast<int>(flashSize), static_cast<char>(0xFF))
+    {
+        _masterFd = posix_openpt(O_RDWR | O_NOCTTY);
+        if (_masterFd != -1 && grantpt(_masterFd) == 0 && unlockpt(_masterFd) == 0) {
+            _slaveName = QString::fromLocal8Bit(ptsname(_masterFd));
+        }
+    }
+
+    ~FakeBootloader()
+    {
+        _stop = true;
+        wait();
+        if (_masterFd != -1) {
+            ::close(_masterFd);
+        }
+    }
+
+    QString     portName            (void) const { return _slaveName; }
+    QByteArray  flash               (void) const { return _flash; }
+    void        setProgramFailAddress(int address) { _programFailAddress = address; }
+
+    static const int responseLatencyUsecs = 1000;
+    static const int programUsecsPerChunk = 50;
+
+protected:
+    void run(void) final
+    {
+        QElapsedTimer clock;
+        clock.start();
+
+        while (!_stop) {
+            // Send responses which are due
+            while (!_responses.isEmpty() && _responses.first().first <= clock.nsecsElapsed() / 1000) {
+                QByteArray response = _responses.takeFirst().second;
+                if (::write(_masterFd, response.constData(), static_cast<size_t>(response.length())) != response.length()) {
+                    return;
+                }
+            }
+
+            int timeoutMsecs = _responses.isEmpty() ? 10 : 1;
+            struct pollfd pfd = { _masterFd, POLLIN, 0 };
+            if (poll(&pfd, 1, timeoutMsecs) > 0 && (pfd.revents & POLLIN)) {
+                char buf[512];
+                ssize_t cBytes = ::read(_masterFd, buf, sizeof(buf));
+                if (cBytes > 0) {
+                    _rx.append(buf, static_cast<int>(cBytes));
+                }
+            }
+
+            QByteArray response;
+            while (_nextCommand(response)) {
+                _responses.append(qMakePair(clock.nsecsElapsed() / 1000 + responseLatencyUsecs, response));
+            }
+        }
+    }
+
+private:
+    enum {
+        PROTO_INSYNC        = 0x12,
+        PROTO_EOC           = 0x20,
+        PROTO_OK            = 0x10,
+        PROTO_FAILED        = 0x11,
+        PROTO_INVALID       = 0x13,
+        PROTO_GET_SYNC      = 0x21,
+        PROTO_GET_DEVICE    = 0x22,
+        PROTO_CHIP_ERASE    = 0x23,
+        PROTO_PROG_MULTI    = 0x27,
+        PROTO_GET_CRC       = 0x29,
+        PROTO_BOOT          = 0x30,
+        INFO_BL_REV         = 1,
+        INFO_BOARD_ID       = 2,
+        INFO_FLASH_SIZE     = 4,
+    };
+
+    static QByteArray _uint32(uint32_t value) { return QByteArray(reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+    /// Processes the next complete command in the receive buffer
+    bool _nextCommand(QByteArray& response)
+    {
+        static const QByteArray ok      = QByteArray(1, PROTO_INSYNC) + QByteArray(1, PROTO_OK);
+        static const QByteArray failed  = QByteArray(1, PROTO_INSYNC) + QByteArray(1, PROTO_FAILED);
+        static const QByteArray invalid = QByteArray(1, PROTO_INSYNC) + QByteArray(1, PROTO_INVALID);
+
+        if (_rx.isEmpty()) {
+            return false;
+        }
+
+        uint8_t command = static_cast<uint8_t>(_rx[0]);
+        int     commandLength;
+        switch (command) {
+        case PROTO_GET_DEVICE:
+            commandLength = 3;
+            break;
+        case PROTO_PROG_MULTI:
+            if (_rx.length() < 2) {
+                return false;
+            }
+            commandLength = 3 + static_cast<uint8_t>(_rx[1]);
+            break;
+        default:
+            commandLength = 2;
+            break;
+        }
+        if (_rx.length() < commandLength) {
+            return false;
+        }
+        QByteArray commandBytes = _rx.left(commandLength);
+        _rx.remove(0, commandLength);
+
+        if (static_cast<uint8_t>(commandBytes[commandLength - 1]) != PROTO_EOC) {
+            response = invalid;
+            return true;
+        }
+
+        switch (command) {
+        case PROTO_GET_SYNC:
+        case PROTO_BOOT:
+            response = ok;
+            break;
+        case PROTO_GET_DEVICE:
+            switch (commandBytes[1]) {
+            case INFO_BL_REV:
+                response = _uint32(_bootloaderVersion) + ok;
+                break;
+            case INFO_BOARD_ID:
+                response = _uint32(Bootloader::boardIDPX4FMUV2) + ok;
+                break;
+            case INFO_FLASH_SIZE:
+                response = _uint32(static_cast<uint32_t>(_flash.length())) + ok;
+                break;
+            default:
+                response = invalid;
+                break;
+            }
+            break;
+        case PROTO_CHIP_ERASE:
+            _flash.fill(static_cast<char>(0xFF));
+            _programAddress = 0;
+            response = ok;
+            break;
+        case PROTO_PROG_MULTI:
+        {
+            int length = commandLength - 3;
+            if (_programFailAddress >= _programAddress && _programFailAddress < _programAddress + length) {
+                response = failed;
+            } else if (_programAddress + length > _flash.length()) {
+                response = failed;
+            } else {
+                memcpy(_flash.data() + _programAddress, commandBytes.constData() + 2, static_cast<size_t>(length));
+                usleep(programUsecsPerChunk);
+                response = ok;
+            }
+            _programAddress += length;
+            break;
+        }
+        case PROTO_GET_CRC:
+            response = _uint32(QGC::crc32(reinterpret_cast<const quint8*>(_flash.constData()), static_cast<unsigned>(_flash.length()), 0)) + ok;
+            break;
+        default:
+            response = invalid;
+            break;
+        }
+
+        return true;
+    }
+
+    int                             _masterFd           = -1;
+    QString                         _slaveName;
+    uint32_t                        _bootloaderVersion;
+    QByteArray                      _flash;
+    int                             _programAddress     = 0;
+    int                             _programFailAddress = -1;
+    QByteArray                      _rx;
+    QList<QPair<qint64, QByteArray>> _responses;         ///< Due time in usecs, response bytes
+    std::atomic<bool>               _stop               { false };
+};
+
+static const uint32_t _flashSize = 2 * 1024 * 1024;
+
+QString BootloaderTest::_createFirmwareFile(uint32_t size)
+{
+    QFile file(_tempDir.filePath(QStringLiteral("firmware%1.bin").arg(size)));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return QString();
+    }
+    QByteArray bytes(static_cast<int>(size), Qt::Uninitialized);
+    for (uint32_t i=0; i<size; i++) {
+        bytes[i] = static_cast<char>(QRandomGenerator::global()->bounded(256));
+    }
+    file.write(bytes);
+    return file.fileName();
+}
+
+/// Runs the full flash sequence against a fake bootloader
+///     @return Msecs taken to program the image, -1 if the fake bootloader could not be set up
+qint64 BootloaderTest::_flash(uint32_t bootloaderVersion, uint32_t imageSize, int programFailAddress, bool& success, QString& errorString)
+{
+    success = false;
+
+    QString firmwareFilename = _createFirmwareFile(imageSize);
+    if (firmwareFilename.isEmpty()) {
+        return -1;
+    }
+    FirmwareImage image;
+    if (!image.load(firmwareFilename, Bootloader::boardIDPX4FMUV2)) {
+        return -1;
+    }
+
+    FakeBootloader fakeBootloader(bootloaderVersion, _flashSize);
+    if (fakeBootloader.portName().isEmpty()) {
+        return -1;
+    }
+    fakeBootloader.setProgramFailAddress(programFailAddress);
+    fakeBootloader.start();
+
+    Bootloader  bootloader(false /* sikRadio */);
+    uint32_t    blVersion, boardID, flashSize;
+    if (!bootloader.open(fakeBootloader.portName()) || !bootloader.getBoardInfo(blVersion, boardID, flashSize) || !bootloader.erase()) {
+        errorString = bootloader.errorString();
+        return -1;
+    }
+
+    QElapsedTimer programTimer;
+    programTimer.start();
+    success = bootloader.program(&image);
+    qint64 programMsecs = programTimer.elapsed();
+
+    if (success) {
+        success = bootloader.verify(&image);
+        QFile firmwareFile(firmwareFilename);
+        if (success && firmwareFile.open(QIODevice::ReadOnly)) {
+            success = fakeBootloader.flash().startsWith(firmwareFile.readAll());
+        }
+    }
+    errorString = bootloader.errorString();
+    bootloader.close();
+
+    return programMsecs;
+}
+
+void BootloaderTest::_crc32Fill(void)
+{
+    const uint8_t fill = 0xFF;
+
+    for (uint32_t count: { 0u, 1u, 2u, 3u, 64u, 1000u, 65537u, _flashSize - 1234u }) {
+        uint32_t state = 0x12345678u + count;
+        uint32_t expected = state;
+        for (uint32_t i=0; i<count; i++) {
+            expected = QGC::crc32(&fill, 1, expected);
+        }
+        QCOMPARE(Bootloader::crc32Fill(state, fill, count), expected);
+    }
+
+    // Other fill values
+    const uint8_t zero = 0;
+    uint32_t expected = 0xFFFFFFFFu;
+    for (int i=0; i<100; i++) {
+        expected = QGC::crc32(&zero, 1, expected);
+    }
+    QCOMPARE(Bootloader::crc32Fill(0xFFFFFFFFu, zero, 100), expected);
+}
+
+void BootloaderTest::_programPipelined(void)
+{
+    const uint32_t imageSize = 64 * 1024;
+
+    bool    success;
+    QString errorString;
+
+    // Bootloader version 4 gets one PROG_MULTI at a time
+    qint64 serialMsecs = _flash(4, imageSize, -1, success, errorString);
+    QVERIFY2(serialMsecs >= 0, qPrintable(errorString));
+    QVERIFY2(success, qPrintable(errorString));
+
+    qint64 pipelinedMsecs = _flash(5, imageSize, -1, success, errorString);
+    QVERIFY2(pipelinedMsecs >= 0, qPrintable(errorString));
+    QVERIFY2(success, qPrintable(errorString));
+
+    qDebug() << "Program" << imageSize << "bytes: serial" << serialMsecs << "msecs, pipelined" << pipelinedMsecs << "msecs";
+    QVERIFY(pipelinedMsecs < serialMsecs);
+}
+
+void BootloaderTest::_programFailure(void)
+{
+    bool    success;
+    QString errorString;
+
+    // A failed chunk in the middle of the window must be reported at its own address
+    const int failAddress = 64 * 20;
+    QVERIFY(_flash(5, 16 * 1024, failAddress, success, errorString) >= 0);
+    QVERIFY(!success);
+    QVERIFY2(errorString.contains(QStringLiteral("%1").arg(failAddress, 8, 16, QLatin1Char('0'))), qPrintable(errorString));
+}
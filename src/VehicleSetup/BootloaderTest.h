@@ -0,0 +1,31 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QTemporaryDir>
+
+/// Flashes firmware through Bootloader against a fake PX4 bootloader running on a pseudo terminal
+class BootloaderTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _crc32Fill         (void);
+    void _programPipelined  (void);
+    void _programFailure    (void);
+
+private:
+    QString _createFirmwareFile (uint32_t size);
+    qint64  _flash              (uint32_t bootloaderVersion, uint32_t imageSize, int programFailAddress, bool& success, QString& errorString);
+
+    QTemporaryDir _tempDir;
+};
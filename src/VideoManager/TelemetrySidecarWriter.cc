@@ -0,0 +1,387 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+/**
+ * @file
+ *   @brief QGC Video Telemetry Sidecar Writer
+ */
+
+#include "TelemetrySidecarWriter.h"
+#include "VideoReceiver.h"
+#include "QGCApplication.h"
+#include "MultiVehicleManager.h"
+#include "Vehicle.h"
+#include "VehicleDistanceSensorFactGroup.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QtEndian>
+
+#include <cmath>
+#include <limits>
+
+QGC_LOGGING_CATEGORY(TelemetrySidecarWriterLog, "TelemetrySidecarWriterLog")
+
+namespace {
+
+// MISB ST 0601 UAS Datalink Local Set universal key
+const uchar _klvUasLocalSetKey[16] = { 0x06, 0x0E, 0x2B, 0x34, 0x02, 0x0B, 0x01, 0x01, 0x0E, 0x01, 0x03, 0x01, 0x01, 0x00, 0x00, 0x00 };
+
+// Version of ST 0601 the packets follow, sent in the mandatory UAS LS version number item
+const quint8 _klvUasLsVersion = 19;
+
+enum KlvTag {
+    KlvTagChecksum                  = 1,
+    KlvTagPrecisionTimeStamp        = 2,
+    KlvTagPlatformHeading           = 5,
+    KlvTagPlatformPitch             = 6,
+    KlvTagPlatformRoll              = 7,
+    KlvTagSensorLatitude            = 13,
+    KlvTagSensorLongitude           = 14,
+    KlvTagSensorTrueAltitude        = 15,
+    KlvTagSensorRelativeAzimuth     = 18,
+    KlvTagSensorRelativeElevation   = 19,
+    KlvTagSensorRelativeRoll        = 20,
+    KlvTagSlantRange                = 21,
+    KlvTagUasLsVersionNumber        = 65,
+};
+
+void _appendBerLength(QByteArray& bytes, int length)
+{
+    if (length < 128) {
+        bytes.append(static_cast<char>(length));
+    } else if (length < 256) {
+        bytes.append(static_cast<char>(0x81));
+        bytes.append(static_cast<char>(length));
+    } else {
+        bytes.append(static_cast<char>(0x82));
+        bytes.append(static_cast<char>(length >> 8));
+        bytes.append(static_cast<char>(length & 0xFF));
+    }
+}
+
+template<typename T>
+void _appendItem(QByteArray& bytes, KlvTag tag, T value)
+{
+    uchar bigEndian[sizeof(T)];
+    qToBigEndian(value, bigEndian);
+    bytes.append(static_cast<char>(tag));
+    bytes.append(static_cast<char>(sizeof(T)));
+    bytes.append(reinterpret_cast<const char*>(bigEndian), sizeof(T));
+}
+
+double _wrap360(double degrees)
+{
+    degrees = std::fmod(degrees, 360.0);
+    return degrees < 0 ? degrees + 360.0 : degrees;
+}
+
+// Unsigned ST 0601 mapping of [0, max] onto the full range of T
+template<typename T>
+void _appendUnsigned(QByteArray& bytes, KlvTag tag, double value, double max)
+{
+    if (std::isnan(value)) {
+        return;
+    }
+    const double scale = static_cast<double>(std::numeric_limits<T>::max()) / max;
+    _appendItem<T>(bytes, tag, static_cast<T>(std::llround(qBound(0.0, value, max) * scale)));
+}
+
+// Signed ST 0601 mapping of [-range, range] onto +/-(2^n-1), out of range values use the reserved error value
+template<typename T>
+void _appendSigned(QByteArray& bytes, KlvTag tag, double value, double range)
+{
+    if (std::isnan(value)) {
+        return;
+    }
+    if (value < -range || value > range) {
+        _appendItem<T>(bytes, tag, std::numeric_limits<T>::min());
+        return;
+    }
+    const double scale = static_cast<double>(std::numeric_limits<T>::max()) / range;
+    _appendItem<T>(bytes, tag, static_cast<T>(std::llround(value * scale)));
+}
+
+QByteArray _csvField(double value, int precision)
+{
+    return std::isnan(value) ? QByteArray() : QByteArray::number(value, 'f', precision);
+}
+
+double _factValue(Fact* fact)
+{
+    bool ok = false;
+    const double value = fact->rawValue().toDouble(&ok);
+    return ok ? value : qQNaN();
+}
+
+}
+
+//-----------------------------------------------------------------------------
+TelemetrySidecarFileWriter::TelemetrySidecarFileWriter(const QString& csvPath, const QString& klvPath)
+    : _csvFile  (csvPath)
+    , _klvFile  (klvPath)
+    , _stop     (false)
+    , _error    (false)
+{
+    setObjectName("TelemetrySidecarFileWriter");
+}
+
+TelemetrySidecarFileWriter::~TelemetrySidecarFileWriter()
+{
+    stop();
+}
+
+bool TelemetrySidecarFileWriter::open()
+{
+    if (!_csvFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        QMutexLocker lock(&_mutex);
+        _errorString = _csvFile.errorString();
+        return false;
+    }
+    if (!_klvFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        QMutexLocker lock(&_mutex);
+        _errorString = _klvFile.errorString();
+        return false;
+    }
+    const QByteArray header = TelemetrySidecarWriter::csvHeader();
+    if (_csvFile.write(header) != header.length()) {
+        QMutexLocker lock(&_mutex);
+        _errorString = _csvFile.errorString();
+        return false;
+    }
+    return true;
+}
+
+void TelemetrySidecarFileWriter::write(const TelemetrySidecarSample& sample)
+{
+    QMutexLocker lock(&_mutex);
+    _queue.append(sample);
+    _queueCondition.wakeOne();
+}
+
+void TelemetrySidecarFileWriter::stop()
+{
+    {
+        QMutexLocker lock(&_mutex);
+        _stop = true;
+        _queueCondition.wakeOne();
+    }
+    wait();
+}
+
+QString TelemetrySidecarFileWriter::errorString()
+{
+    QMutexLocker lock(&_mutex);
+    return _errorString;
+}
+
+void TelemetrySidecarFileWriter::run()
+{
+    QVector<TelemetrySidecarSample> samples;
+
+    while (true) {
+        {
+            QMutexLocker lock(&_mutex);
+            while (_queue.isEmpty() && !_stop) {
+                _queueCondition.wait(&_mutex);
+            }
+            if (_queue.isEmpty()) {
+                break;
+            }
+            samples.swap(_queue);
+        }
+        if (_error) {
+            samples.clear();
+            continue;
+        }
+
+        QByteArray csv;
+        QByteArray klv;
+        for (const TelemetrySidecarSample& sample: samples) {
+            csv.append(TelemetrySidecarWriter::csvRow(sample));
+            klv.append(TelemetrySidecarWriter::klvPacket(sample));
+        }
+        samples.clear();
+
+        if (_csvFile.write(csv) != csv.length() || !_csvFile.flush()) {
+            QMutexLocker lock(&_mutex);
+            _errorString = _csvFile.errorString();
+            _error = true;
+        } else if (_klvFile.write(klv) != klv.length() || !_klvFile.flush()) {
+            QMutexLocker lock(&_mutex);
+            _errorString = _klvFile.errorString();
+            _error = true;
+        }
+    }
+
+    _csvFile.close();
+    _klvFile.close();
+}
+
+//-----------------------------------------------------------------------------
+TelemetrySidecarWriter::TelemetrySidecarWriter(QObject* parent)
+    : QObject   (parent)
+    , _writer   (nullptr)
+{
+    _timer.setTimerType(Qt::PreciseTimer);
+    _timer.setInterval(1000 / _sampleRateHz);
+    connect(&_timer, &QTimer::timeout, this, &TelemetrySidecarWriter::_captureTelemetry);
+}
+
+TelemetrySidecarWriter::~TelemetrySidecarWriter()
+{
+    stopCapturingTelemetry();
+}
+
+void TelemetrySidecarWriter::startCapturingTelemetry(const QString& videoFile, VideoReceiver* receiver)
+{
+    stopCapturingTelemetry();
+
+    const QFileInfo videoFileInfo(videoFile);
+    const QString   basePath = QStringLiteral("%1/%2").arg(videoFileInfo.path(), videoFileInfo.completeBaseName());
+
+    qCDebug(TelemetrySidecarWriterLog) << "Writing telemetry sidecar to:" << basePath;
+
+    _writer = new TelemetrySidecarFileWriter(basePath + QStringLiteral(".csv"), basePath + QStringLiteral(".klv"));
+    if (!_writer->open()) {
+        qCWarning(TelemetrySidecarWriterLog) << "Unable to write telemetry sidecar:" << _writer->errorString();
+        delete _writer;
+        _writer = nullptr;
+        return;
+    }
+    _writer->start(QThread::LowPriority);
+
+    _receiver = receiver;
+    _timer.start();
+    _captureTelemetry();
+}
+
+void TelemetrySidecarWriter::stopCapturingTelemetry()
+{
+    _timer.stop();
+    _receiver = nullptr;
+
+    if (_writer) {
+        qCDebug(TelemetrySidecarWriterLog) << "Stopping writing telemetry sidecar";
+        _writer->stop();
+        if (_writer->error()) {
+            qCWarning(TelemetrySidecarWriterLog) << "Telemetry sidecar write failed:" << _writer->errorString();
+        }
+        delete _writer;
+        _writer = nullptr;
+    }
+}
+
+void TelemetrySidecarWriter::_captureTelemetry()
+{
+    if (!_writer) {
+        return;
+    }
+
+    Vehicle* vehicle = qgcApp()->toolbox()->multiVehicleManager()->activeVehicle();
+    if (!vehicle) {
+        return;
+    }
+
+    // Until the first keyframe reaches the file there is no position to put the sample at
+    const qint64 videoTimeNsecs = _receiver ? _receiver->recordingPosition() : -1;
+    if (videoTimeNsecs < 0) {
+        return;
+    }
+
+    const QGeoCoordinate coordinate = vehicle->coordinate();
+    const bool haveGimbal = vehicle->gimbalData();
+
+    VehicleDistanceSensorFactGroup* distanceSensors = qobject_cast<VehicleDistanceSensorFactGroup*>(vehicle->distanceSensorFactGroup());
+
+    TelemetrySidecarSample sample;
+    sample.videoTimeNsecs   = videoTimeNsecs;
+    sample.utcMSecs         = QDateTime::currentMSecsSinceEpoch();
+    sample.latitude         = coordinate.isValid() ? coordinate.latitude() : qQNaN();
+    sample.longitude        = coordinate.isValid() ? coordinate.longitude() : qQNaN();
+    sample.altitudeAMSL     = _factValue(vehicle->altitudeAMSL());
+    sample.altitudeRelative = _factValue(vehicle->altitudeRelative());
+    sample.roll             = _factValue(vehicle->roll());
+    sample.pitch            = _factValue(vehicle->pitch());
+    sample.heading          = _factValue(vehicle->heading());
+    sample.gimbalRoll       = haveGimbal ? vehicle->gimbalRoll() : qQNaN();
+    sample.gimbalPitch      = haveGimbal ? vehicle->gimbalPitch() : qQNaN();
+    sample.gimbalYaw        = haveGimbal ? vehicle->gimbalYaw() : qQNaN();
+    sample.rangeForward     = distanceSensors ? _factValue(distanceSensors->rotationNone()) : qQNaN();
+    sample.rangeDown        = distanceSensors ? _factValue(distanceSensors->rotationPitch270()) : qQNaN();
+
+    _writer->write(sample);
+}
+
+QByteArray TelemetrySidecarWriter::csvHeader()
+{
+    return QByteArrayLiteral("video_time_s,utc_ms,latitude,longitude,altitude_amsl_m,altitude_relative_m,roll_deg,pitch_deg,heading_deg,"
+                             "gimbal_roll_deg,gimbal_pitch_deg,gimbal_yaw_deg,range_forward_m,range_down_m\n");
+}
+
+QByteArray TelemetrySidecarWriter::csvRow(const TelemetrySidecarSample& sample)
+{
+    QByteArray row;
+    row.reserve(192);
+    row.append(QByteArray::number(static_cast<double>(sample.videoTimeNsecs) / 1e9, 'f', 6)).append(',');
+    row.append(QByteArray::number(sample.utcMSecs)).append(',');
+    row.append(_csvField(sample.latitude, 8)).append(',');
+    row.append(_csvField(sample.longitude, 8)).append(',');
+    row.append(_csvField(sample.altitudeAMSL, 2)).append(',');
+    row.append(_csvField(sample.altitudeRelative, 2)).append(',');
+    row.append(_csvField(sample.roll, 2)).append(',');
+    row.append(_csvField(sample.pitch, 2)).append(',');
+    row.append(_csvField(sample.heading, 2)).append(',');
+    row.append(_csvField(sample.gimbalRoll, 2)).append(',');
+    row.append(_csvField(sample.gimbalPitch, 2)).append(',');
+    row.append(_csvField(sample.gimbalYaw, 2)).append(',');
+    row.append(_csvField(sample.rangeForward, 2)).append(',');
+    row.append(_csvField(sample.rangeDown, 2)).append('\n');
+    return row;
+}
+
+QByteArray TelemetrySidecarWriter::klvPacket(const TelemetrySidecarSample& sample)
+{
+    // Precision time stamp must be the first item, checksum the last
+    QByteArray items;
+    _appendItem<quint64>(items, KlvTagPrecisionTimeStamp, static_cast<quint64>(sample.utcMSecs) * 1000);
+    _appendUnsigned<quint16>(items, KlvTagPlatformHeading,          std::isnan(sample.heading) ? sample.heading : _wrap360(sample.heading), 360.0);
+    _appendSigned<qint16>   (items, KlvTagPlatformPitch,            sample.pitch,           20.0);
+    _appendSigned<qint16>   (items, KlvTagPlatformRoll,             sample.roll,            50.0);
+    _appendSigned<qint32>   (items, KlvTagSensorLatitude,           sample.latitude,        90.0);
+    _appendSigned<qint32>   (items, KlvTagSensorLongitude,          sample.longitude,       180.0);
+    if (!std::isnan(sample.altitudeAMSL)) {
+        _appendUnsigned<quint16>(items, KlvTagSensorTrueAltitude,   sample.altitudeAMSL + 900.0, 19900.0);
+    }
+    _appendUnsigned<quint32>(items, KlvTagSensorRelativeAzimuth,    std::isnan(sample.gimbalYaw) ? sample.gimbalYaw : _wrap360(sample.gimbalYaw), 360.0);
+    _appendSigned<qint32>   (items, KlvTagSensorRelativeElevation,  sample.gimbalPitch,     180.0);
+    _appendUnsigned<quint32>(items, KlvTagSensorRelativeRoll,       std::isnan(sample.gimbalRoll) ? sample.gimbalRoll : _wrap360(sample.gimbalRoll), 360.0);
+    _appendUnsigned<quint32>(items, KlvTagSlantRange,               sample.rangeForward,    5000000.0);
+    _appendItem<quint8>     (items, KlvTagUasLsVersionNumber,       _klvUasLsVersion);
+
+    // Checksum tag and length are part of the value length and the checksummed bytes
+    const int checksumItemLength = 4;
+
+    QByteArray packet;
+    packet.reserve(sizeof(_klvUasLocalSetKey) + 3 + items.length() + checksumItemLength);
+    packet.append(reinterpret_cast<const char*>(_klvUasLocalSetKey), sizeof(_klvUasLocalSetKey));
+    _appendBerLength(packet, items.length() + checksumItemLength);
+    packet.append(items);
+    packet.append(static_cast<char>(KlvTagChecksum));
+    packet.append(static_cast<char>(2));
+
+    quint16 checksum = 0;
+    for (int i = 0; i < packet.length(); i++) {
+        checksum += static_cast<quint16>(static_cast<uchar>(packet[i]) << (8 * ((i + 1) % 2)));
+    }
+    packet.append(static_cast<char>(checksum >> 8));
+    packet.append(static_cast<char>(checksum & 0xFF));
+
+    return packet;
+}
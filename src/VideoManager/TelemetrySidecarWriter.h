@@ -0,0 +1,111 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+/**
+ * @file
+ *   @brief QGC Video Telemetry Sidecar Writer
+ */
+
+#pragma once
+
+#include "QGCLoggingCategory.h"
+
+#include <QObject>
+#include <QTimer>
+#include <QPointer>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QVector>
+#include <QFile>
+
+#include <atomic>
+
+Q_DECLARE_LOGGING_CATEGORY(TelemetrySidecarWriterLog)
+
+class VideoReceiver;
+
+/// Single telemetry sample, stamped with the position in the recorded video at which it was read. Unknown values are NaN.
+struct TelemetrySidecarSample
+{
+    qint64  videoTimeNsecs;
+    qint64  utcMSecs;
+    double  latitude;
+    double  longitude;
+    double  altitudeAMSL;
+    double  altitudeRelative;
+    double  roll;
+    double  pitch;
+    double  heading;
+    double  gimbalRoll;
+    double  gimbalPitch;
+    double  gimbalYaw;
+    double  rangeForward;
+    double  rangeDown;
+};
+
+/// Formats and writes samples to the sidecar files from its own thread
+class TelemetrySidecarFileWriter : public QThread
+{
+public:
+    TelemetrySidecarFileWriter(const QString& csvPath, const QString& klvPath);
+    ~TelemetrySidecarFileWriter();
+
+    bool    open        ();                                 ///< Must be called before starting the thread
+    void    write       (const TelemetrySidecarSample& sample);
+    void    stop        ();                                 ///< Writes out all queued samples and waits for the thread to finish
+    bool    error       () const { return _error; }
+    QString errorString ();
+
+protected:
+    void    run         () final;
+
+private:
+    QFile                           _csvFile;
+    QFile                           _klvFile;
+    QMutex                          _mutex;
+    QWaitCondition                  _queueCondition;
+    QVector<TelemetrySidecarSample> _queue;
+    bool                            _stop;
+    std::atomic<bool>               _error;
+    QString                         _errorString;
+};
+
+/// Records vehicle telemetry at video frame rate next to a video recording:
+///     <video>.csv - one row per sample, keyed by the position in the video file
+///     <video>.klv - MISB ST 0601 UAS Datalink local set packets, one per sample
+/// Samples are stamped with the recording position of the receiver pipeline clock at the time the gui thread
+/// reads the telemetry, so they can lag the frames they describe by the gui and telemetry latency. Nothing is
+/// written until the first keyframe has reached the file.
+class TelemetrySidecarWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TelemetrySidecarWriter(QObject* parent = nullptr);
+    ~TelemetrySidecarWriter();
+
+    void startCapturingTelemetry(const QString& videoFile, VideoReceiver* receiver);
+    void stopCapturingTelemetry();
+
+    static QByteArray csvHeader ();
+    static QByteArray csvRow    (const TelemetrySidecarSample& sample);
+    static QByteArray klvPacket (const TelemetrySidecarSample& sample);
+
+private slots:
+    // Copies the current telemetry values, everything else is left to the writer thread
+    void _captureTelemetry();
+
+private:
+    QTimer                          _timer;
+    QPointer<VideoReceiver>         _receiver;
+    TelemetrySidecarFileWriter*     _writer;
+
+    static const int _sampleRateHz = 30;
+};
@@ -0,0 +1,106 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TelemetrySidecarWriterTest.h"
+
+// MISB ST 0601 UAS Datalink Local Set universal key
+static const QByteArray _uasLocalSetKey = QByteArray::fromHex("060e2b34020b01010e01030101000000");
+
+TelemetrySidecarSample TelemetrySidecarWriterTest::_knownSample(void)
+{
+    TelemetrySidecarSample sample;
+
+    sample.videoTimeNsecs   = 1500000000;
+    sample.utcMSecs         = 1600000000123;
+    sample.latitude         = 47.3977419;
+    sample.longitude        = 8.5455938;
+    sample.altitudeAMSL     = 488.25;
+    sample.altitudeRelative = 10.5;
+    sample.roll             = 0;
+    sample.pitch            = -5;
+    sample.heading          = 90;
+    sample.gimbalRoll       = qQNaN();
+    sample.gimbalPitch      = -45;
+    sample.gimbalYaw        = qQNaN();
+    sample.rangeForward     = qQNaN();
+    sample.rangeDown        = qQNaN();
+
+    return sample;
+}
+
+/// ST 0601 checksum: 16 bit sum of big endian words, from the start of the key through the checksum length byte
+quint16 TelemetrySidecarWriterTest::_klvChecksum(const QByteArray& packet)
+{
+    quint16 checksum = 0;
+    for (int i = 0; i < packet.length() - 2; i++) {
+        checksum += static_cast<quint16>(static_cast<uchar>(packet[i]) << (i % 2 == 0 ? 8 : 0));
+    }
+    return checksum;
+}
+
+void TelemetrySidecarWriterTest::_testCsv(void)
+{
+    const QList<QByteArray> columns = TelemetrySidecarWriter::csvHeader().trimmed().split(',');
+    QCOMPARE(columns.count(), 14);
+    QCOMPARE(columns.first(), QByteArray("video_time_s"));
+    QCOMPARE(columns.last(), QByteArray("range_down_m"));
+
+    // Unknown values are left empty rather than written as nan
+    QCOMPARE(TelemetrySidecarWriter::csvRow(_knownSample()),
+             QByteArray("1.500000,1600000000123,47.39774190,8.54559380,488.25,10.50,0.00,-5.00,90.00,,-45.00,,,\n"));
+    QCOMPARE(TelemetrySidecarWriter::csvRow(_knownSample()).split(',').count(), columns.count());
+}
+
+void TelemetrySidecarWriterTest::_testKlv(void)
+{
+    const QByteArray packet = TelemetrySidecarWriter::klvPacket(_knownSample());
+
+    QCOMPARE(packet.left(16), _uasLocalSetKey);
+
+    // Short form BER length covering everything after it, checksum item included
+    QCOMPARE(static_cast<int>(static_cast<uchar>(packet[16])), 51);
+    QCOMPARE(packet.length(), 16 + 1 + 51);
+
+    const QByteArray expectedItems = QByteArray::fromHex(
+                "02080005af3107a5e078"  // Precision time stamp: microseconds
+                "05024000"              // Platform heading: 90 deg
+                "0602e000"              // Platform pitch: -5 deg
+                "07020000"              // Platform roll: 0 deg
+                "0d044368fdbe"          // Sensor latitude: 47.3977419 deg
+                "0e040613ad89"          // Sensor longitude: 8.5455938 deg
+                "0f0211dc"              // Sensor true altitude: 488.25 m
+                "1304e0000000"          // Sensor relative elevation: -45 deg
+                "410113"                // UAS LS version number: 19
+                "0102");                // Checksum tag and length
+    QCOMPARE(packet.mid(17, expectedItems.length()), expectedItems);
+
+    QCOMPARE(packet.right(2), QByteArray::fromHex("8e91"));
+    QCOMPARE(static_cast<quint16>((static_cast<uchar>(packet[packet.length() - 2]) << 8) | static_cast<uchar>(packet[packet.length() - 1])), _klvChecksum(packet));
+}
+
+void TelemetrySidecarWriterTest::_testKlvNoData(void)
+{
+    TelemetrySidecarSample sample = _knownSample();
+    sample.latitude     = qQNaN();
+    sample.longitude    = qQNaN();
+    sample.altitudeAMSL = qQNaN();
+    sample.roll         = qQNaN();
+    sample.pitch        = qQNaN();
+    sample.heading      = qQNaN();
+    sample.gimbalPitch  = qQNaN();
+
+    // Only the mandatory time stamp, version number and checksum are left
+    const QByteArray packet = TelemetrySidecarWriter::klvPacket(sample);
+    QCOMPARE(packet.left(16), _uasLocalSetKey);
+    QCOMPARE(static_cast<int>(static_cast<uchar>(packet[16])), 17);
+    QCOMPARE(packet.mid(17, 15), QByteArray::fromHex("02080005af3107a5e0784101130102"));
+    QCOMPARE(packet.length(), 16 + 1 + 17);
+    QCOMPARE(packet.right(2), QByteArray::fromHex("b63e"));
+    QCOMPARE(static_cast<quint16>((static_cast<uchar>(packet[packet.length() - 2]) << 8) | static_cast<uchar>(packet[packet.length() - 1])), _klvChecksum(packet));
+}
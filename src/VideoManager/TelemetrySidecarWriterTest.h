@@ -0,0 +1,28 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+#include "TelemetrySidecarWriter.h"
+
+/// Checks the CSV and KLV formatting of TelemetrySidecarWriter against known samples
+class TelemetrySidecarWriterTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testCsv       (void);
+    void _testKlv       (void);
+    void _testKlvNoData (void);
+
+private:
+    TelemetrySidecarSample  _knownSample    (void);
+    quint16                 _klvChecksum    (const QByteArray& packet);
+};
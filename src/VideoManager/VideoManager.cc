@@ -74,6 +74,10 @@ VideoManager::VideoManager(QGCApplication* app, QGCToolbox* toolbox)
 //-----------------------------------------------------------------------------
 VideoManager::~VideoManager()
 {
+    // Pool receivers may hold the display sink
+    delete _receiverPool;
+    _receiverPool = nullptr;
+
     for (int i = 0; i < 2; i++) {
         if (_videoReceiver[i] != nullptr) {
             delete _videoReceiver[i];
@@ -137,7 +141,7 @@ VideoManager::setToolbox(QGCToolbox *toolbox)
     connect(_videoReceiver[0], &VideoReceiver::onStartComplete, this, [this](VideoReceiver::STATUS status) {
         if (status == VideoReceiver::STATUS_OK) {
             _videoStarted[0] = true;
-            if (_videoSink[0] != nullptr) {
+            if (_videoSink[0] != nullptr && _primaryShown()) {
                 // It is absolytely ok to have video receiver active (streaming) and decoding not active
                 // It should be handy for cases when you have many streams and want to show only some of them
                 // NOTE that even if decoder did not start it is still possible to record video
@@ -162,17 +166,7 @@ VideoManager::setToolbox(QGCToolbox *toolbox)
         emit decodingChanged();
     });
 
-    connect(_videoReceiver[0], &VideoReceiver::recordingChanged, this, [this](bool active){
-        _recording = active;
-        if (!active) {
-            _subtitleWriter.stopCapturingTelemetry();
-        }
-        emit recordingChanged();
-    });
-
-    connect(_videoReceiver[0], &VideoReceiver::recordingStarted, this, [this](){
-        _subtitleWriter.startCapturingTelemetry(_videoFile);
-    });
+    _setRecordingReceiver(_videoReceiver[0]);
 
     connect(_videoReceiver[0], &VideoReceiver::videoSizeChanged, this, [this](QSize size){
         _videoSize = ((quint32)size.width() << 16) | (quint32)size.height();
@@ -207,6 +201,11 @@ VideoManager::setToolbox(QGCToolbox *toolbox)
             _startReceiver(1);
         });
     }
+
+    // Additional camera streams, each in its own receiver sharing the main display with the primary one
+    _receiverPool = new VideoReceiverPool(toolbox->corePlugin(), this);
+    _receiverPool->setPrimaryReceiver(_videoReceiver[0]);
+    _syncReceiverPool();
 #endif
     _updateSettings(0);
     _updateSettings(1);
@@ -275,6 +274,11 @@ VideoManager::startVideo()
 
     _startReceiver(0);
     _startReceiver(1);
+
+    if (_receiverPool) {
+        _receiverPool->setTimeout(_videoSettings->rtspTimeout()->rawValue().toUInt());
+        _receiverPool->start();
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -285,6 +289,10 @@ VideoManager::stopVideo()
         return;
     }
 
+    if (_receiverPool) {
+        _receiverPool->stop();
+    }
+
     _stopReceiver(1);
     _stopReceiver(0);
 }
@@ -325,8 +333,18 @@ VideoManager::startRecording(const QString& videoFile)
     QString videoFile2 = _videoFile + "2." + ext;
     _videoFile += ext;
 
-    if (_videoReceiver[0] && _videoStarted[0]) {
-        _videoReceiver[0]->startRecording(_videoFile, fileFormat);
+    // Record the stream which is on screen, the pool keeps the other streams running in the background
+    if (_primaryShown()) {
+        if (_videoStarted[0]) {
+            _setRecordingReceiver(_videoReceiver[0]);
+            _videoReceiver[0]->startRecording(_videoFile, fileFormat);
+        }
+    } else {
+        VideoReceiver* receiver = _receiverPool->receiver(_receiverPool->shownStream());
+        if (receiver) {
+            _setRecordingReceiver(receiver);
+            receiver->startRecording(_videoFile, fileFormat);
+        }
     }
     if (_videoReceiver[1] && _videoStarted[1]) {
         _videoReceiver[1]->startRecording(videoFile2, fileFormat);
@@ -350,9 +368,42 @@ VideoManager::stopRecording()
             _videoReceiver[i]->stopRecording();
         }
     }
+    if (_recordingReceiver && _recordingReceiver != _videoReceiver[0]) {
+        _recordingReceiver->stopRecording();
+    }
 #endif
 }
 
+void
+VideoManager::_setRecordingReceiver(VideoReceiver* receiver)
+{
+    if (receiver == _recordingReceiver) {
+        return;
+    }
+
+    // Only one receiver records at a time. The previous one has stopped, so its signals are not needed any more.
+    if (_recordingReceiver) {
+        disconnect(_recordingReceiver, &VideoReceiver::recordingChanged, this, nullptr);
+        disconnect(_recordingReceiver, &VideoReceiver::recordingStarted, this, nullptr);
+    }
+
+    _recordingReceiver = receiver;
+
+    connect(receiver, &VideoReceiver::recordingChanged, this, [this](bool active){
+        _recording = active;
+        if (!active) {
+            _subtitleWriter.stopCapturingTelemetry();
+            _telemetrySidecarWriter.stopCapturingTelemetry();
+        }
+        emit recordingChanged();
+    });
+
+    connect(receiver, &VideoReceiver::recordingStarted, this, [this, receiver](){
+        _subtitleWriter.startCapturingTelemetry(_videoFile);
+        _telemetrySidecarWriter.startCapturingTelemetry(_videoFile, receiver);
+    });
+}
+
 void
 VideoManager::grabImage(const QString& imageFile)
 {
@@ -516,6 +567,7 @@ QVariantList VideoManager::streamsVar() const
         QVariantMap m;
         m["ip"]    = si.ip;
         m["alias"] = si.alias;
+        m["latency"] = si.latency;
         list.append(m);
     }
     return list;
@@ -525,6 +577,7 @@ void VideoManager::addStream(const QString& ip, const QString& alias)
 {
     _streams.append({ip, alias});
     saveStreams();
+    _syncReceiverPool();
     emit streamsChanged();
 }
 
@@ -535,6 +588,7 @@ void VideoManager::addStream(int index, const QString& ip, const QString& alias)
     } else {
         _streams.insert(index, {ip, alias});
         saveStreams();
+        _syncReceiverPool();
         emit streamsChanged();
     }
 }
@@ -542,8 +596,10 @@ void VideoManager::addStream(int index, const QString& ip, const QString& alias)
 void VideoManager::updateStream(int index, const QString& ip, const QString& alias)
 {
     if (index < 0 || index >= _streams.size()) return;
-    _streams[index] = {ip, alias};
+    _streams[index].ip    = ip;
+    _streams[index].alias = alias;
     saveStreams();
+    _syncReceiverPool();
     emit streamsChanged();
 }
 
@@ -552,9 +608,45 @@ void VideoManager::removeStream(int index)
     if (index < 0 || index >= _streams.size()) return;
     _streams.removeAt(index);
     saveStreams();
+    _syncReceiverPool();
     emit streamsChanged();
 }
 
+void VideoManager::setStreamLatency(int index, int latency)
+{
+    if (index < 0 || index >= _streams.size()) return;
+    _streams[index].latency = qMax(-1, latency);
+    saveStreams();
+    _syncReceiverPool();
+    emit streamsChanged();
+}
+
+void VideoManager::showStream(int index)
+{
+    if (!_receiverPool || index < -1 || index >= _streams.size()) {
+        return;
+    }
+    // Streams which are the primary source anyway don't get a receiver of their own
+    if (index >= 0 && _streams[index].ip == _videoUri[0]) {
+        index = -1;
+    }
+    _receiverPool->showStream(index);
+}
+
+void VideoManager::_syncReceiverPool()
+{
+    if (!_receiverPool) {
+        return;
+    }
+
+    QVector<VideoReceiverPool::StreamConfig> configs;
+    for (const StreamInfo& si: _streams) {
+        // An empty uri keeps the slot without running a receiver for it
+        configs.append({ si.ip == _videoUri[0] ? QString() : si.ip, si.latency });
+    }
+    _receiverPool->setStreams(configs);
+}
+
 void VideoManager::loadStreams()
 {
     QSettings s;
@@ -566,6 +658,7 @@ void VideoManager::loadStreams()
         StreamInfo si;
         si.ip    = s.value("ip"   ).toString();
         si.alias = s.value("alias").toString();
+        si.latency = s.value("latency", 0).toInt();
         _streams.append(si);
     }
     s.endArray();
@@ -581,6 +674,7 @@ void VideoManager::saveStreams()
         s.setArrayIndex(i);
         s.setValue("ip"   , _streams[i].ip);
         s.setValue("alias", _streams[i].alias);
+        s.setValue("latency", _streams[i].latency);
     }
     s.endArray();
     s.endGroup();
@@ -671,8 +765,11 @@ VideoManager::_initVideo()
 
     if (widget != nullptr && _videoReceiver[0] != nullptr) {
         _videoSink[0] = qgcApp()->toolbox()->corePlugin()->createVideoSink(this, widget);
+        if (_receiverPool) {
+            _receiverPool->setDisplaySink(_videoSink[0]);
+        }
         if (_videoSink[0] != nullptr) {
-            if (_videoStarted[0]) {
+            if (_videoStarted[0] && _primaryShown()) {
                 _videoReceiver[0]->startDecoding(_videoSink[0]);
             }
         } else {
@@ -824,6 +921,10 @@ VideoManager::_updateVideoUri(unsigned id, const QString& uri)
 
     _videoUri[id] = uri;
 
+    if (id == 0) {
+        _syncReceiverPool();
+    }
+
     return true;
 }
 
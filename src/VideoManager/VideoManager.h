@@ -15,12 +15,15 @@
 #include <QTimer>
 #include <QTime>
 #include <QUrl>
+#include <QPointer>
 
 #include "QGCMAVLink.h"
 #include "QGCLoggingCategory.h"
 #include "VideoReceiver.h"
 #include "QGCToolbox.h"
 #include "SubtitleWriter.h"
+#include "TelemetrySidecarWriter.h"
+#include "VideoReceiverPool.h"
 
 Q_DECLARE_LOGGING_CATEGORY(VideoManagerLog)
 
@@ -118,6 +121,10 @@ public:
     Q_INVOKABLE void addStream(const QString& ip, const QString& alias);
     Q_INVOKABLE void updateStream(int index, const QString& ip, const QString& alias);
     Q_INVOKABLE void removeStream(int index);
+    Q_INVOKABLE void setStreamLatency(int index, int latency);
+
+    /// Shows one of the configured streams on the main video display, -1 for the primary video source
+    Q_INVOKABLE void showStream(int index);
 
 signals:
     void hasVideoChanged            ();
@@ -158,13 +165,18 @@ protected:
     void _restartVideo              (unsigned id);
     void _startReceiver             (unsigned id);
     void _stopReceiver              (unsigned id);
+    void _syncReceiverPool          ();
+    bool _primaryShown              () const { return !_receiverPool || _receiverPool->shownStream() == -1; }
+    void _setRecordingReceiver      (VideoReceiver* receiver);
 
 protected:
     QString                 _videoFile;
     QString                 _imageFile;
     SubtitleWriter          _subtitleWriter;
+    TelemetrySidecarWriter  _telemetrySidecarWriter;
     bool                    _isTaisync              = false;
     VideoReceiver*          _videoReceiver[2]       = { nullptr, nullptr };
+    QPointer<VideoReceiver> _recordingReceiver;                         ///< Receiver of the stream which was on screen when recording started
     void*                   _videoSink[2]           = { nullptr, nullptr };
     QString                 _videoUri[2];
     // FIXME: AV: _videoStarted seems to be access from 3 different threads, from time to time
@@ -182,7 +194,8 @@ protected:
     QString                 _videoSourceID;
     bool                    _fullScreen             = false;
     Vehicle*                _activeVehicle          = nullptr;
-    struct StreamInfo { QString ip; QString alias; };
+    VideoReceiverPool*      _receiverPool           = nullptr;
+    struct StreamInfo { QString ip; QString alias; int latency = 0; };  ///< latency: -1 low latency, 0 default, N ms
     QVector<StreamInfo> _streams;
 
 private:
@@ -0,0 +1,388 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "VideoReceiverPool.h"
+#include "QGCCorePlugin.h"
+
+#include <QThread>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+QGC_LOGGING_CATEGORY(VideoReceiverPoolLog, "VideoReceiverPoolLog")
+
+namespace {
+    // Shown stream value while the display sink is not attached to any receiver
+    const int _noStream = -2;
+}
+
+VideoReceiverPool::VideoReceiverPool(QGCCorePlugin* corePlugin, QObject* parent)
+    : QObject       (parent)
+    , _corePlugin   (corePlugin)
+{
+    _cpuTimer.setInterval(cpuSampleIntervalMSecs);
+    connect(&_cpuTimer, &QTimer::timeout, this, &VideoReceiverPool::_sampleCpuLoad);
+}
+
+VideoReceiverPool::~VideoReceiverPool()
+{
+    for (Member_t* member: _members) {
+        delete member->receiver;
+        delete member;
+    }
+    _members.clear();
+}
+
+void VideoReceiverPool::setPrimaryReceiver(VideoReceiver* receiver)
+{
+    if (_primary) {
+        disconnect(_primary, nullptr, this, nullptr);
+    }
+
+    _primary        = receiver;
+    _primaryRunning = false;
+
+    if (_primary) {
+        connect(_primary, &VideoReceiver::onStartComplete, this, [this](VideoReceiver::STATUS status) {
+            _primaryRunning = status == VideoReceiver::STATUS_OK || status == VideoReceiver::STATUS_INVALID_STATE;
+            if (_primaryRunning && _shownStream != -1) {
+                _updateOffscreen(_primary);
+            }
+        });
+        connect(_primary, &VideoReceiver::onStopComplete, this, [this](VideoReceiver::STATUS) {
+            _primaryRunning = false;
+            _warm.remove(_primary);
+        });
+        connect(_primary, &VideoReceiver::onSwitchVideoSinkComplete, this, [this](VideoReceiver::STATUS status) {
+            _switchComplete(_primary, status);
+        });
+    }
+}
+
+void VideoReceiverPool::setStreams(const QVector<StreamConfig>& streams)
+{
+    while (_members.count() > streams.count()) {
+        Member_t* member = _members.takeLast();
+        _releaseMember(member);
+        delete member;
+    }
+
+    for (int i = 0; i < streams.count(); i++) {
+        if (i < _members.count()) {
+            Member_t* member = _members[i];
+            if (member->config.uri == streams[i].uri && member->config.buffer == streams[i].buffer) {
+                continue;
+            }
+            qCDebug(VideoReceiverPoolLog) << "Stream changed" << i << streams[i].uri << streams[i].buffer;
+            _releaseMember(member);
+            member->config = streams[i];
+        } else {
+            qCDebug(VideoReceiverPoolLog) << "Stream added" << i << streams[i].uri << streams[i].buffer;
+            _members.append(new Member_t{ streams[i], nullptr, false });
+        }
+
+        if (_started) {
+            _startMember(_members[i]);
+        }
+    }
+
+    if (_targetStream >= _members.count()) {
+        showStream(-1);
+    }
+
+    if (_started && !_members.isEmpty() && !_cpuTimer.isActive()) {
+        _cpuTimer.start();
+    } else if (_members.isEmpty()) {
+        _cpuTimer.stop();
+    }
+}
+
+void VideoReceiverPool::start()
+{
+    _started = true;
+
+    for (Member_t* member: _members) {
+        _startMember(member);
+    }
+
+    if (!_members.isEmpty()) {
+        _lastCpuTimeMSecs = -1;
+        _cpuClock.start();
+        _cpuTimer.start();
+    }
+}
+
+void VideoReceiverPool::stop()
+{
+    _started = false;
+    _cpuTimer.stop();
+
+    for (Member_t* member: _members) {
+        _releaseMember(member);
+    }
+}
+
+VideoReceiver* VideoReceiverPool::receiver(int index) const
+{
+    if (index == -1) {
+        return _primary;
+    }
+    if (index >= 0 && index < _members.count()) {
+        return _members[index]->receiver;
+    }
+    return nullptr;
+}
+
+void VideoReceiverPool::showStream(int index)
+{
+    if (index < -1 || index >= _members.count()) {
+        qCWarning(VideoReceiverPoolLog) << "Invalid stream index" << index;
+        return;
+    }
+
+    qCDebug(VideoReceiverPoolLog) << "Show stream" << index;
+
+    _targetStream = index;
+    _continueSwitch();
+}
+
+void VideoReceiverPool::_startMember(Member_t* member)
+{
+    if (member->receiver || member->config.uri.isEmpty()) {
+        return;
+    }
+
+    VideoReceiver* receiver = _corePlugin->createVideoReceiver(this);
+    if (!receiver) {
+        return;
+    }
+    member->receiver = receiver;
+
+    connect(receiver, &VideoReceiver::onStartComplete, this, [this, receiver](VideoReceiver::STATUS status) {
+        _memberStarted(receiver, status);
+    });
+    connect(receiver, &VideoReceiver::onStopComplete, this, [this, receiver](VideoReceiver::STATUS) {
+        // Receivers stop themselves on stream errors, keep trying for as long as the stream is configured
+        const int index = _indexOf(receiver);
+        if (index >= 0) {
+            _members[index]->running = false;
+            _warm.remove(receiver);
+            if (_started) {
+                receiver->start(_members[index]->config.uri, _timeout, _members[index]->config.buffer);
+            }
+        }
+    });
+    connect(receiver, &VideoReceiver::onSwitchVideoSinkComplete, this, [this, receiver](VideoReceiver::STATUS status) {
+        _switchComplete(receiver, status);
+    });
+
+    receiver->start(member->config.uri, _timeout, member->config.buffer);
+}
+
+void VideoReceiverPool::_releaseMember(Member_t* member)
+{
+    VideoReceiver* receiver = member->receiver;
+
+    if (!receiver) {
+        return;
+    }
+
+    member->receiver    = nullptr;
+    member->running     = false;
+    _warm.remove(receiver);
+
+    disconnect(receiver, nullptr, this, nullptr);
+
+    // Stopping tears down the decoding branch, which is what frees the display sink for the next stream
+    if (receiver == _switchingReceiver || (_shownStream >= 0 && _members.value(_shownStream) == member)) {
+        _shownStream        = _noStream;
+        _switchingReceiver  = receiver;
+    }
+
+    connect(receiver, &VideoReceiver::onStopComplete, this, [this, receiver](VideoReceiver::STATUS) {
+        receiver->deleteLater();
+        if (_switchingReceiver == receiver) {
+            _switchingReceiver = nullptr;
+            _continueSwitch();
+        }
+    });
+
+    receiver->stop();
+}
+
+void VideoReceiverPool::_memberStarted(VideoReceiver* receiver, VideoReceiver::STATUS status)
+{
+    const int index = _indexOf(receiver);
+    if (index < 0) {
+        return;
+    }
+
+    Member_t* member = _members[index];
+
+    if (status == VideoReceiver::STATUS_OK || status == VideoReceiver::STATUS_INVALID_STATE) {
+        member->running = true;
+        if (index == _shownStream && _displaySink && !_switchingReceiver) {
+            _switchingReceiver = receiver;
+            receiver->setKeyframesOnly(false);
+            receiver->switchVideoSink(_displaySink);
+        } else if (index != _shownStream) {
+            _updateOffscreen(receiver);
+        }
+    } else if (status != VideoReceiver::STATUS_INVALID_URL) {
+        QTimer::singleShot(1000, receiver, [this, receiver]() {
+            const int index = _indexOf(receiver);
+            if (_started && index >= 0) {
+                receiver->start(_members[index]->config.uri, _timeout, _members[index]->config.buffer);
+            }
+        });
+    }
+}
+
+void VideoReceiverPool::_continueSwitch()
+{
+    // Picked up again once the receiver we are waiting on reports back
+    if (_switchingReceiver || _shownStream == _targetStream) {
+        return;
+    }
+
+    // The display sink has to leave the old pipeline before it can join the new one
+    if (_shownStream != _noStream) {
+        VideoReceiver* from = receiver(_shownStream);
+        _shownStream = _noStream;
+        if (from) {
+            _switchingReceiver = from;
+            _warm.insert(from);
+            from->setKeyframesOnly(true);
+            from->switchVideoSink(nullptr);
+            return;
+        }
+    }
+
+    _shownStream = _targetStream;
+
+    VideoReceiver* to = receiver(_shownStream);
+    const bool running = _shownStream == -1 ? _primaryRunning : (to && _members[_shownStream]->running);
+
+    if (to && running && _displaySink) {
+        _switchingReceiver = to;
+        _warm.remove(to);
+        to->setKeyframesOnly(false);
+        to->switchVideoSink(_displaySink);
+    }
+
+    emit shownStreamChanged(_shownStream);
+}
+
+void VideoReceiverPool::_switchComplete(VideoReceiver* receiver, VideoReceiver::STATUS status)
+{
+    if (receiver != _switchingReceiver) {
+        return;
+    }
+
+    _switchingReceiver = nullptr;
+
+    if (status != VideoReceiver::STATUS_OK) {
+        qCWarning(VideoReceiverPoolLog) << "Video sink switch failed" << _indexOf(receiver) << status;
+    }
+
+    if (_warm.contains(receiver) && !_offscreenDecoding) {
+        _warm.remove(receiver);
+        receiver->stopDecoding();
+    }
+
+    _continueSwitch();
+}
+
+void VideoReceiverPool::_updateOffscreen(VideoReceiver* receiver)
+{
+    if (receiver == _switchingReceiver) {
+        return;
+    }
+
+    if (_offscreenDecoding && !_warm.contains(receiver)) {
+        _warm.insert(receiver);
+        receiver->setKeyframesOnly(true);
+        receiver->switchVideoSink(nullptr);
+    } else if (!_offscreenDecoding && _warm.contains(receiver)) {
+        _warm.remove(receiver);
+        receiver->stopDecoding();
+    }
+}
+
+int VideoReceiverPool::_indexOf(VideoReceiver* receiver) const
+{
+    if (receiver == _primary) {
+        return -1;
+    }
+    for (int i = 0; i < _members.count(); i++) {
+        if (_members[i]->receiver == receiver) {
+            return i;
+        }
+    }
+    return _noStream;
+}
+
+void VideoReceiverPool::_sampleCpuLoad()
+{
+    const qint64 cpuTimeMSecs   = _processCpuTimeMSecs();
+    const qint64 elapsedMSecs   = _cpuClock.restart();
+
+    if (cpuTimeMSecs < 0) {
+        return;
+    }
+
+    if (_lastCpuTimeMSecs >= 0 && elapsedMSecs > 0) {
+        _cpuLoadPercent = static_cast<int>((cpuTimeMSecs - _lastCpuTimeMSecs) * 100 / (elapsedMSecs * qMax(1, QThread::idealThreadCount())));
+
+        // Separate thresholds so we don't flap around a single limit
+        const bool offscreenDecoding = _offscreenDecoding ? _cpuLoadPercent < coolDownLoadPercent : _cpuLoadPercent < warmUpLoadPercent;
+
+        if (offscreenDecoding != _offscreenDecoding) {
+            qCDebug(VideoReceiverPoolLog) << "Off-screen decoding" << offscreenDecoding << "cpu load" << _cpuLoadPercent;
+            _offscreenDecoding = offscreenDecoding;
+
+            if (_primary && _primaryRunning && _shownStream != -1) {
+                _updateOffscreen(_primary);
+            }
+            for (int i = 0; i < _members.count(); i++) {
+                if (_members[i]->running && i != _shownStream) {
+                    _updateOffscreen(_members[i]->receiver);
+                }
+            }
+        }
+    }
+
+    _lastCpuTimeMSecs = cpuTimeMSecs;
+}
+
+qint64 VideoReceiverPool::_processCpuTimeMSecs()
+{
+#if defined(Q_OS_WIN)
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return -1;
+    }
+    ULARGE_INTEGER kernel, user;
+    kernel.LowPart  = kernelTime.dwLowDateTime;
+    kernel.HighPart = kernelTime.dwHighDateTime;
+    user.LowPart    = userTime.dwLowDateTime;
+    user.HighPart   = userTime.dwHighDateTime;
+    // 100ns units
+    return static_cast<qint64>((kernel.QuadPart + user.QuadPart) / 10000);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+    return static_cast<qint64>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000 + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000;
+#endif
+}
@@ -0,0 +1,111 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QSet>
+
+#include "QGCLoggingCategory.h"
+#include "VideoReceiver.h"
+
+Q_DECLARE_LOGGING_CATEGORY(VideoReceiverPoolLog)
+
+class QGCCorePlugin;
+
+/// Runs one receiver per configured camera stream and moves a single display sink between them.
+///
+/// Every stream keeps its pipeline running, so switching the display never waits on an RTSP handshake.
+/// While the process has CPU to spare, streams which are not on screen also keep decoding key frames into
+/// an off-screen sink; showing one of those only swaps the sink on an already warm decoder. Under load the
+/// off-screen decoders are stopped and streams fall back to receiving only.
+///
+/// Stream index -1 is the primary receiver owned by VideoManager, which the pool never starts or stops.
+class VideoReceiverPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef struct {
+        QString uri;
+        int     buffer;         ///< As for VideoReceiver::start(): -1 low latency, 0 default, N jitter buffer ms
+    } StreamConfig;
+
+    VideoReceiverPool(QGCCorePlugin* corePlugin, QObject* parent = nullptr);
+    ~VideoReceiverPool();
+
+    void setPrimaryReceiver (VideoReceiver* receiver);
+    void setDisplaySink     (void* sink) { _displaySink = sink; }
+    void setTimeout         (unsigned timeout) { _timeout = timeout; }
+
+    /// Streams with an unchanged config keep their running receiver
+    void setStreams         (const QVector<StreamConfig>& streams);
+    int  count              () const { return _members.count(); }
+
+    void start              ();
+    void stop               ();
+
+    /// Moves the display sink to the stream, -1 for the primary receiver
+    void showStream         (int index);
+    int  shownStream        () const { return _shownStream; }
+
+    VideoReceiver* receiver (int index) const;
+
+    int  cpuLoad            () const { return _cpuLoadPercent; }   ///< Percent of all cores, -1 if not yet known
+    bool offscreenDecoding  () const { return _offscreenDecoding; }
+
+    static const int cpuSampleIntervalMSecs = 2000;
+    static const int coolDownLoadPercent    = 75;     ///< Stop off-screen decoders above this
+    static const int warmUpLoadPercent      = 50;     ///< Restart off-screen decoders below this
+
+signals:
+    void shownStreamChanged(int index);
+
+private slots:
+    void _sampleCpuLoad     ();
+
+private:
+    typedef struct {
+        StreamConfig    config;
+        VideoReceiver*  receiver;
+        bool            running;
+    } Member_t;
+
+    void            _startMember            (Member_t* member);
+    void            _releaseMember          (Member_t* member);
+    void            _continueSwitch         ();
+    void            _switchComplete         (VideoReceiver* receiver, VideoReceiver::STATUS status);
+    void            _memberStarted          (VideoReceiver* receiver, VideoReceiver::STATUS status);
+    void            _updateOffscreen        (VideoReceiver* receiver);
+    int             _indexOf                (VideoReceiver* receiver) const;
+
+    static qint64   _processCpuTimeMSecs    ();
+
+    QGCCorePlugin*          _corePlugin;
+    VideoReceiver*          _primary            = nullptr;
+    bool                    _primaryRunning     = false;
+    void*                   _displaySink        = nullptr;
+    unsigned                _timeout            = 2;
+    QVector<Member_t*>      _members;
+    bool                    _started            = false;
+
+    int                     _shownStream        = -1;
+    int                     _targetStream       = -1;
+    VideoReceiver*          _switchingReceiver  = nullptr;  ///< Receiver we are waiting on to finish a sink switch
+    QSet<VideoReceiver*>    _warm;                          ///< Off-screen receivers decoding key frames
+
+    QTimer                  _cpuTimer;
+    QElapsedTimer           _cpuClock;
+    qint64                  _lastCpuTimeMSecs   = -1;
+    int                     _cpuLoadPercent     = -1;
+    bool                    _offscreenDecoding  = true;
+};
@@ -132,14 +132,33 @@ GStreamer::blacklist(VideoSettings::VideoDecoderOptions option)
     // Set rank for specific features
     changeRank("bcmdec", GST_RANK_NONE);
 
+    // Hardware decoder plugins only register the features for codecs the hardware can actually decode, so raising
+    // their rank never hides the software decoders (still at their normal rank) for anything else.
+    const auto vaapiDecoders    = {"vaapimpeg2dec", "vaapimpeg4dec", "vaapih263dec", "vaapih264dec", "vaapih265dec", "vaapivc1dec"};
+    const auto v4l2Decoders     = {"v4l2h264dec", "v4l2h265dec", "v4l2slh264dec", "v4l2slh265dec", "v4l2mpeg2dec", "v4l2mpeg4dec"};
+
     switch (option) {
         case VideoSettings::ForceVideoDecoderDefault:
             break;
         case VideoSettings::ForceVideoDecoderSoftware:
             changeRank("avdec_h264", GST_RANK_PRIMARY + 1);
+            changeRank("avdec_h265", GST_RANK_PRIMARY + 1);
             break;
         case VideoSettings::ForceVideoDecoderVAAPI:
-            for(auto name : {"vaapimpeg2dec", "vaapimpeg4dec", "vaapih263dec", "vaapih264dec", "vaapivc1dec"}) {
+            for(auto name : vaapiDecoders) {
+                changeRank(name, GST_RANK_PRIMARY + 1);
+            }
+            break;
+        case VideoSettings::ForceVideoDecoderV4L2:
+            for(auto name : v4l2Decoders) {
+                changeRank(name, GST_RANK_PRIMARY + 1);
+            }
+            break;
+        case VideoSettings::PreferHardwareVideoDecoder:
+            for(auto name : vaapiDecoders) {
+                changeRank(name, GST_RANK_PRIMARY + 2);
+            }
+            for(auto name : v4l2Decoders) {
                 changeRank(name, GST_RANK_PRIMARY + 1);
             }
             break;
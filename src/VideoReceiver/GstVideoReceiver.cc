@@ -46,16 +46,29 @@ GstVideoReceiver::GstVideoReceiver(QObject* parent)
     , _recorderValve(nullptr)
     , _decoder(nullptr)
     , _videoSink(nullptr)
+    , _pendingVideoSink(nullptr)
     , _fileSink(nullptr)
+    , _frameTap(nullptr)
     , _pipeline(nullptr)
     , _lastSourceFrameTime(0)
     , _lastVideoFrameTime(0)
     , _resetVideoSink(true)
     , _videoSinkProbeId(0)
+    , _videoSinkSwapPad(nullptr)
+    , _videoSinkSwapProbeId(0)
+    , _videoSinkSwapQueued(false)
     , _udpReconnect_us(5000000)
     , _signalDepth(0)
     , _endOfStream(false)
+    , _recordingClock(nullptr)
+    , _recordingBaseTime(GST_CLOCK_TIME_NONE)
+    , _recordingStartTime(GST_CLOCK_TIME_NONE)
+    , _nextFrameTapId(0)
+    , _decoderInputProbeId(0)
+    , _keyframesOnly(false)
+    , _waitForKeyframe(false)
 {
+    _resetDecoderStats();
     _slotHandler.start();
     connect(&_watchdogTimer, &QTimer::timeout, this, &GstVideoReceiver::_watchdog);
     _watchdogTimer.start(1000);
@@ -64,6 +77,174 @@ GstVideoReceiver::GstVideoReceiver(QObject* parent)
 GstVideoReceiver::~GstVideoReceiver(void)
 {
     _slotHandler.shutdown();
+    _clearRecordingClock();
+}
+
+qint64
+GstVideoReceiver::recordingPosition(void)
+{
+    QMutexLocker lock(&_recordingClockMutex);
+
+    if (_recordingClock == nullptr || !GST_CLOCK_TIME_IS_VALID(_recordingBaseTime) || !GST_CLOCK_TIME_IS_VALID(_recordingStartTime)) {
+        return -1;
+    }
+
+    // Running time now, less the running time which became t=0 in the file
+    const GstClockTime now = gst_clock_get_time(_recordingClock);
+
+    return static_cast<qint64>(now - _recordingBaseTime) - static_cast<qint64>(_recordingStartTime);
+}
+
+void
+GstVideoReceiver::_setRecordingClock(GstPad* pad, GstClockTime pts)
+{
+    GstClockTime startTime = pts;
+
+    // Buffer timestamps are in segment time, the clock runs in running time
+    GstEvent* segmentEvent = gst_pad_get_sticky_event(pad, GST_EVENT_SEGMENT, 0);
+
+    if (segmentEvent != nullptr) {
+        const GstSegment* segment = nullptr;
+        gst_event_parse_segment(segmentEvent, &segment);
+        if (segment != nullptr && segment->format == GST_FORMAT_TIME) {
+            startTime = gst_segment_to_running_time(segment, GST_FORMAT_TIME, pts);
+        }
+        gst_event_unref(segmentEvent);
+        segmentEvent = nullptr;
+    }
+
+    GstClock* clock = gst_element_get_clock(_pipeline);
+
+    QMutexLocker lock(&_recordingClockMutex);
+
+    if (_recordingClock != nullptr) {
+        gst_object_unref(_recordingClock);
+    }
+
+    _recordingClock     = clock;
+    _recordingBaseTime  = gst_element_get_base_time(_pipeline);
+    _recordingStartTime = startTime;
+}
+
+VideoReceiver::DecoderStats
+GstVideoReceiver::decoderStats(void)
+{
+    QMutexLocker lock(&_decoderStatsMutex);
+    return _decoderStats;
+}
+
+int
+GstVideoReceiver::addFrameTap(FrameTapCallback callback)
+{
+    QMutexLocker lock(&_frameTapMutex);
+    const int tapId = ++_nextFrameTapId;
+    _frameTapCallbacks[tapId] = callback;
+    return tapId;
+}
+
+void
+GstVideoReceiver::removeFrameTap(int tapId)
+{
+    // Callbacks run outside the lock, so a delivery already under way may still call this one once after it returns
+    QMutexLocker lock(&_frameTapMutex);
+    _frameTapCallbacks.remove(tapId);
+}
+
+void
+GstVideoReceiver::_deliverFrameTapSample(GstSample* sample)
+{
+    // Consumers may take their time or add/remove taps from inside the callback, neither may block the others on the lock
+    QList<FrameTapCallback> callbacks;
+    {
+        QMutexLocker lock(&_frameTapMutex);
+        callbacks = _frameTapCallbacks.values();
+    }
+
+    for (const FrameTapCallback& callback: callbacks) {
+        callback(gst_sample_ref(sample));
+    }
+}
+
+void
+GstVideoReceiver::_resetDecoderStats(void)
+{
+    QMutexLocker lock(&_decoderStatsMutex);
+    _decoderPendingFrames.clear();
+    _decoderStats = DecoderStats{ 0, 0, -1, -1 };
+}
+
+void
+GstVideoReceiver::_noteDecoderInput(GstClockTime pts)
+{
+    if (!GST_CLOCK_TIME_IS_VALID(pts)) {
+        return;
+    }
+
+    const GstClockTime now = gst_util_get_timestamp();
+
+    QMutexLocker lock(&_decoderStatsMutex);
+
+    // A frame may arrive split over several buffers
+    if (!_decoderPendingFrames.isEmpty() && _decoderPendingFrames.last().pts == pts) {
+        return;
+    }
+
+    if (_decoderPendingFrames.count() >= _maxDecoderPendingFrames) {
+        _decoderPendingFrames.dequeue();
+        _decoderStats.droppedFrames++;
+    }
+
+    _decoderPendingFrames.enqueue({ pts, now });
+}
+
+void
+GstVideoReceiver::_noteDecoderOutput(GstClockTime pts)
+{
+    const GstClockTime now = gst_util_get_timestamp();
+
+    QMutexLocker lock(&_decoderStatsMutex);
+
+    _decoderStats.decodedFrames++;
+
+    if (!GST_CLOCK_TIME_IS_VALID(pts)) {
+        return;
+    }
+
+    // Frames leave the decoder in presentation order, so anything still pending with an earlier pts was dropped
+    int i = 0;
+    while (i < _decoderPendingFrames.count()) {
+        const PendingDecoderFrame_t& frame = _decoderPendingFrames[i];
+
+        if (frame.pts == pts) {
+            const qint64 latency = static_cast<qint64>(now - frame.arrival);
+            if (_decoderStats.decodeLatencyNsecs < 0) {
+                _decoderStats.decodeLatencyNsecs = latency;
+            } else {
+                _decoderStats.decodeLatencyNsecs += (latency - _decoderStats.decodeLatencyNsecs) / _decodeLatencyAverageWeight;
+            }
+            _decoderStats.maxDecodeLatencyNsecs = qMax(_decoderStats.maxDecodeLatencyNsecs, latency);
+            _decoderPendingFrames.removeAt(i);
+        } else if (frame.pts < pts) {
+            _decoderStats.droppedFrames++;
+            _decoderPendingFrames.removeAt(i);
+        } else {
+            i++;
+        }
+    }
+}
+
+void
+GstVideoReceiver::_clearRecordingClock(void)
+{
+    QMutexLocker lock(&_recordingClockMutex);
+
+    if (_recordingClock != nullptr) {
+        gst_object_unref(_recordingClock);
+        _recordingClock = nullptr;
+    }
+
+    _recordingBaseTime  = GST_CLOCK_TIME_NONE;
+    _recordingStartTime = GST_CLOCK_TIME_NONE;
 }
 
 void
@@ -288,6 +469,9 @@ GstVideoReceiver::stop(void)
     qCDebug(VideoReceiverLog) << "Stopping" << _uri;
 
     if (_pipeline != nullptr) {
+        // A blocked decoder pad would hold back the EOS we are about to wait for
+        _cancelVideoSinkSwap();
+
         GstBus* bus;
 
         if ((bus = gst_pipeline_get_bus(GST_PIPELINE(_pipeline))) != nullptr) {
@@ -482,6 +666,126 @@ GstVideoReceiver::stopDecoding(void)
     });
 }
 
+void
+GstVideoReceiver::switchVideoSink(void* sink)
+{
+    if (_needDispatch()) {
+        GstElement* videoSink = sink != nullptr ? GST_ELEMENT(sink) : nullptr;
+        if (videoSink != nullptr) {
+            gst_object_ref(videoSink);
+        }
+        _slotHandler.dispatch([this, videoSink]() mutable {
+            switchVideoSink(videoSink);
+            if (videoSink != nullptr) {
+                gst_object_unref(videoSink);
+            }
+        });
+        return;
+    }
+
+    qCDebug(VideoReceiverLog) << "Switching video sink" << _uri;
+
+    if (_pendingVideoSink != nullptr) {
+        qCDebug(VideoReceiverLog) << "Already switching video sink!" << _uri;
+        _dispatchSignal([this](){
+            emit onSwitchVideoSinkComplete(STATUS_INVALID_STATE);
+        });
+        return;
+    }
+
+    GstElement* videoSink;
+
+    if (sink != nullptr) {
+        videoSink = GST_ELEMENT(sink);
+        gst_object_ref(videoSink);
+    } else if ((videoSink = _makeOffscreenVideoSink()) == nullptr) {
+        qCCritical(VideoReceiverLog) << "_makeOffscreenVideoSink() failed" << _uri;
+        _dispatchSignal([this](){
+            emit onSwitchVideoSinkComplete(STATUS_FAIL);
+        });
+        return;
+    }
+
+    if (videoSink == _videoSink) {
+        gst_object_unref(videoSink);
+        _dispatchSignal([this](){
+            emit onSwitchVideoSinkComplete(STATUS_OK);
+        });
+        return;
+    }
+
+    GstPad* peer = nullptr;
+
+    if (_videoSink != nullptr) {
+        GstPad* sinkpad;
+        if ((sinkpad = gst_element_get_static_pad(_videoSink, "sink")) != nullptr) {
+            peer = gst_pad_get_peer(sinkpad);
+            gst_object_unref(sinkpad);
+            sinkpad = nullptr;
+        }
+    }
+
+    if (peer == nullptr) {
+        // Nothing is flowing into the current sink (if any), a plain decoding restart does the job
+        if (_pipeline != nullptr && _videoSink != nullptr) {
+            _shutdownDecodingBranch();
+        }
+
+        startDecoding(videoSink);
+
+        const bool ok = _videoSink == videoSink;
+
+        gst_object_unref(videoSink);
+        videoSink = nullptr;
+
+        _dispatchSignal([this, ok](){
+            emit onSwitchVideoSinkComplete(ok ? STATUS_OK : STATUS_FAIL);
+        });
+        return;
+    }
+
+    // Swap the sinks once the decoder is between frames, it stays linked and warm throughout.
+    // The idle probe keeps the pad blocked and hands the swap over to this thread, so it never races stop().
+    _pendingVideoSink = videoSink;
+    _videoSinkSwapPad = peer;
+    _videoSinkSwapQueued = false;
+    _videoSinkSwapProbeId = gst_pad_add_probe(peer, GST_PAD_PROBE_TYPE_IDLE, _swapVideoSinkProbe, this, nullptr);
+    peer = nullptr;
+}
+
+void
+GstVideoReceiver::setKeyframesOnly(bool keyframesOnly)
+{
+    if (_needDispatch()) {
+        _slotHandler.dispatch([this, keyframesOnly]() {
+            setKeyframesOnly(keyframesOnly);
+        });
+        return;
+    }
+
+    if (keyframesOnly == _keyframesOnly) {
+        return;
+    }
+
+    qCDebug(VideoReceiverLog) << "Key frames only" << keyframesOnly << _uri;
+
+    if (!keyframesOnly) {
+        _waitForKeyframe = true;
+
+        // Ask the source for a key frame instead of waiting out the rest of the GOP
+        if (_decoderValve != nullptr) {
+            GstPad* srcpad;
+            if ((srcpad = gst_element_get_static_pad(_decoderValve, "src")) != nullptr) {
+                gst_pad_send_event(srcpad, gst_event_new_custom(GST_EVENT_CUSTOM_UPSTREAM, gst_structure_new("GstForceKeyUnit", "all-headers", G_TYPE_BOOLEAN, TRUE, nullptr)));
+                gst_object_unref(srcpad);
+                srcpad = nullptr;
+            }
+        }
+    }
+
+    _keyframesOnly = keyframesOnly;
+}
+
 void
 GstVideoReceiver::startRecording(const QString& videoFile, FILE_FORMAT format)
 {
@@ -861,6 +1165,116 @@ GstVideoReceiver::_makeDecoder(GstCaps* caps, GstElement* videoSink)
     return decoder;
 }
 
+GstElement*
+GstVideoReceiver::_makeOffscreenVideoSink(void)
+{
+    GstElement* sink;
+
+    if ((sink = gst_element_factory_make("fakesink", nullptr)) == nullptr) {
+        qCCritical(VideoReceiverLog) << "gst_element_factory_make('fakesink') failed";
+        return nullptr;
+    }
+
+    g_object_set(sink, "async", FALSE, "enable-last-sample", FALSE, nullptr);
+
+    return sink;
+}
+
+GstElement*
+GstVideoReceiver::_makeFrameTap(void)
+{
+    GstElement* frameTap = nullptr;
+    GstElement* tee = nullptr;
+    GstElement* queue = nullptr;
+    GstElement* appsink = nullptr;
+    GstElement* bin = nullptr;
+    bool releaseElements = true;
+
+    do {
+        if ((tee = gst_element_factory_make("tee", nullptr)) == nullptr) {
+            qCCritical(VideoReceiverLog) << "gst_element_factory_make('tee') failed";
+            break;
+        }
+
+        if ((queue = gst_element_factory_make("queue", nullptr)) == nullptr) {
+            qCCritical(VideoReceiverLog) << "gst_element_factory_make('queue') failed";
+            break;
+        }
+
+        if ((appsink = gst_element_factory_make("appsink", nullptr)) == nullptr) {
+            qCCritical(VideoReceiverLog) << "gst_element_factory_make('appsink') failed";
+            break;
+        }
+
+        // Slow consumers lose frames instead of stalling the display
+        g_object_set(queue, "leaky", 2, "max-size-buffers", 2, "max-size-bytes", 0, "max-size-time", G_GUINT64_CONSTANT(0), nullptr);
+        g_object_set(appsink, "emit-signals", TRUE, "drop", TRUE, "max-buffers", 1, "sync", FALSE, "async", FALSE, "enable-last-sample", FALSE, nullptr);
+        g_signal_connect(appsink, "new-sample", G_CALLBACK(_onFrameTapSample), this);
+
+        if ((bin = gst_bin_new("frametapbin")) == nullptr) {
+            qCCritical(VideoReceiverLog) << "gst_bin_new('frametapbin') failed";
+            break;
+        }
+
+        gst_bin_add_many(GST_BIN(bin), tee, queue, appsink, nullptr);
+
+        releaseElements = false;
+
+        if (!gst_element_link_many(tee, queue, appsink, nullptr)) {
+            qCCritical(VideoReceiverLog) << "gst_element_link_many() failed";
+            break;
+        }
+
+        GstPad* pad;
+
+        if ((pad = gst_element_get_static_pad(tee, "sink")) == nullptr) {
+            qCCritical(VideoReceiverLog) << "gst_element_get_static_pad(tee) failed";
+            break;
+        }
+
+        gst_element_add_pad(bin, gst_ghost_pad_new("sink", pad));
+        gst_object_unref(pad);
+        pad = nullptr;
+
+        // The display branch leaves through a tee pad so decoded buffers are shared, not copied
+        if ((pad = gst_element_get_request_pad(tee, "src_%u")) == nullptr) {
+            qCCritical(VideoReceiverLog) << "gst_element_get_request_pad(tee) failed";
+            break;
+        }
+
+        gst_element_add_pad(bin, gst_ghost_pad_new("src", pad));
+        gst_object_unref(pad);
+        pad = nullptr;
+
+        frameTap = bin;
+        bin = nullptr;
+    } while(0);
+
+    if (releaseElements) {
+        if (appsink != nullptr) {
+            gst_object_unref(appsink);
+            appsink = nullptr;
+        }
+
+        if (queue != nullptr) {
+            gst_object_unref(queue);
+            queue = nullptr;
+        }
+
+        if (tee != nullptr) {
+            gst_object_unref(tee);
+            tee = nullptr;
+        }
+    }
+
+    if (bin != nullptr) {
+        gst_object_unref(bin);
+        bin = nullptr;
+    }
+
+    return frameTap;
+}
+
 GstElement*
 GstVideoReceiver::_makeFileSink(const QString& videoFile, FILE_FORMAT format)
 {
@@ -1040,6 +1454,14 @@ GstVideoReceiver::_addDecoder(GstElement* src)
         return false;
     }
 
+    _resetDecoderStats();
+
+    if ((srcpad = gst_element_get_static_pad(src, "src")) != nullptr) {
+        _decoderInputProbeId = gst_pad_add_probe(srcpad, GST_PAD_PROBE_TYPE_BUFFER, _decoderInputProbe, this, nullptr);
+        gst_object_unref(srcpad);
+        srcpad = nullptr;
+    }
+
     GstPad* srcPad = nullptr;
 
     GstIterator* it;
@@ -1077,7 +1499,34 @@ GstVideoReceiver::_addVideoSink(GstPad* pad)
 
     gst_bin_add(GST_BIN(_pipeline), _videoSink);
 
-    if(!gst_element_link(_decoder, _videoSink)) {
+    GstElement* videoSinkPeer = _decoder;
+
+    bool frameTapWanted;
+    {
+        QMutexLocker lock(&_frameTapMutex);
+        frameTapWanted = !_frameTapCallbacks.isEmpty();
+    }
+
+    if (frameTapWanted) {
+        if ((_frameTap = _makeFrameTap()) == nullptr) {
+            qCWarning(VideoReceiverLog) << "_makeFrameTap() failed, decoding without frame tap";
+        } else {
+            gst_object_ref(_frameTap); // gst_bin_add() will steal one reference
+
+            gst_bin_add(GST_BIN(_pipeline), _frameTap);
+
+            if (gst_element_link(_decoder, _frameTap)) {
+                videoSinkPeer = _frameTap;
+            } else {
+                qCWarning(VideoReceiverLog) << "Unable to link frame tap, decoding without frame tap";
+                gst_bin_remove(GST_BIN(_pipeline), _frameTap);
+                gst_object_unref(_frameTap);
+                _frameTap = nullptr;
+            }
+        }
+    }
+
+    if(!gst_element_link(videoSinkPeer, _videoSink)) {
         gst_bin_remove(GST_BIN(_pipeline), _videoSink);
         qCCritical(VideoReceiverLog) << "Unable to link video sink";
         if (caps != nullptr) {
@@ -1089,6 +1538,10 @@ GstVideoReceiver::_addVideoSink(GstPad* pad)
 
     gst_element_sync_state_with_parent(_videoSink);
 
+    if (_frameTap != nullptr) {
+        gst_element_sync_state_with_parent(_frameTap);
+    }
+
     g_object_set(_videoSink, "sync", _buffer >= 0, NULL);
 
     GST_DEBUG_BIN_TO_DOT_FILE(GST_BIN(_pipeline), GST_DEBUG_GRAPH_SHOW_ALL, "pipeline-with-videosink");
@@ -1119,6 +1572,90 @@ GstVideoReceiver::_addVideoSink(GstPad* pad)
     return true;
 }
 
+void
+GstVideoReceiver::_swapVideoSink(GstPad* pad)
+{
+    GstElement* oldSink = _videoSink;
+    GstPad* sinkpad;
+
+    if ((sinkpad = gst_element_get_static_pad(oldSink, "sink")) != nullptr) {
+        if (_videoSinkProbeId != 0) {
+            gst_pad_remove_probe(sinkpad, _videoSinkProbeId);
+            _videoSinkProbeId = 0;
+        }
+        gst_pad_unlink(pad, sinkpad);
+        gst_object_unref(sinkpad);
+        sinkpad = nullptr;
+    }
+
+    gst_bin_remove(GST_BIN(_pipeline), oldSink);
+    gst_element_set_state(oldSink, GST_STATE_NULL);
+    gst_object_unref(oldSink);
+    oldSink = nullptr;
+
+    _videoSink = _pendingVideoSink;
+    _pendingVideoSink = nullptr;
+
+    gst_object_ref(_videoSink); // gst_bin_add() will steal one reference
+
+    gst_bin_add(GST_BIN(_pipeline), _videoSink);
+
+    bool ok = false;
+
+    if ((sinkpad = gst_element_get_static_pad(_videoSink, "sink")) != nullptr) {
+        ok = gst_pad_link(pad, sinkpad) == GST_PAD_LINK_OK;
+        if (ok) {
+            _videoSinkProbeId = gst_pad_add_probe(sinkpad, GST_PAD_PROBE_TYPE_BUFFER, _videoSinkProbe, this, nullptr);
+        }
+        gst_object_unref(sinkpad);
+        sinkpad = nullptr;
+    }
+
+    if (ok) {
+        g_object_set(_videoSink, "sync", _buffer >= 0, NULL);
+        gst_element_sync_state_with_parent(_videoSink);
+        qCDebug(VideoReceiverLog) << "Video sink switched" << _uri;
+    } else {
+        qCCritical(VideoReceiverLog) << "Unable to link switched video sink" << _uri;
+    }
+
+    GST_DEBUG_BIN_TO_DOT_FILE(GST_BIN(_pipeline), GST_DEBUG_GRAPH_SHOW_ALL, "pipeline-video-sink-switched");
+
+    _dispatchSignal([this, ok](){
+        emit onSwitchVideoSinkComplete(ok ? STATUS_OK : STATUS_FAIL);
+    });
+}
+
+void
+GstVideoReceiver::_completeVideoSinkSwap(GstPad* pad)
+{
+    // The swap was cancelled (and the probe removed) while this was queued
+    if (pad != _videoSinkSwapPad || !_videoSinkSwapQueued) {
+        return;
+    }
+
+    if (_pendingVideoSink != nullptr && _videoSink != nullptr) {
+        _swapVideoSink(pad);
+    }
+
+    _cancelVideoSinkSwap();
+}
+
+void
+GstVideoReceiver::_cancelVideoSinkSwap(void)
+{
+    if (_videoSinkSwapPad == nullptr) {
+        return;
+    }
+
+    // Unblocks the decoder src pad
+    gst_pad_remove_probe(_videoSinkSwapPad, _videoSinkSwapProbeId);
+    gst_object_unref(_videoSinkSwapPad);
+    _videoSinkSwapPad = nullptr;
+    _videoSinkSwapProbeId = 0;
+    _videoSinkSwapQueued = false;
+}
+
 void
 GstVideoReceiver::_noteTeeFrame(void)
 {
@@ -1196,6 +1733,8 @@ GstVideoReceiver::_unlinkBranch(GstElement* from)
 void
 GstVideoReceiver::_shutdownDecodingBranch(void)
 {
+    _cancelVideoSinkSwap();
+
     if (_decoder != nullptr) {
         GstObject* parent;
 
@@ -1210,6 +1749,30 @@ GstVideoReceiver::_shutdownDecodingBranch(void)
         _decoder = nullptr;
     }
 
+    if (_frameTap != nullptr) {
+        GstObject* parent;
+
+        if ((parent = gst_element_get_parent(_frameTap)) != nullptr) {
+            gst_bin_remove(GST_BIN(_pipeline), _frameTap);
+            gst_element_set_state(_frameTap, GST_STATE_NULL);
+            gst_object_unref(parent);
+            parent = nullptr;
+        }
+
+        gst_object_unref(_frameTap);
+        _frameTap = nullptr;
+    }
+
+    if (_decoderInputProbeId != 0) {
+        GstPad* srcpad;
+        if (_decoderValve != nullptr && (srcpad = gst_element_get_static_pad(_decoderValve, "src")) != nullptr) {
+            gst_pad_remove_probe(srcpad, _decoderInputProbeId);
+            gst_object_unref(srcpad);
+            srcpad = nullptr;
+        }
+        _decoderInputProbeId = 0;
+    }
+
     if (_videoSinkProbeId != 0) {
         GstPad* sinkpad;
         if ((sinkpad = gst_element_get_static_pad(_videoSink, "sink")) != nullptr) {
@@ -1234,6 +1797,16 @@ GstVideoReceiver::_shutdownDecodingBranch(void)
     gst_object_unref(_videoSink);
     _videoSink = nullptr;
 
+    if (_pendingVideoSink != nullptr) {
+        gst_object_unref(_pendingVideoSink);
+        _pendingVideoSink = nullptr;
+        _dispatchSignal([this](){
+            emit onSwitchVideoSinkComplete(STATUS_FAIL);
+        });
+    }
+
+    _waitForKeyframe = false;
+
     _removingDecoder = false;
 
     if (_decoding) {
@@ -1250,6 +1823,8 @@ GstVideoReceiver::_shutdownDecodingBranch(void)
 void
 GstVideoReceiver::_shutdownRecordingBranch(void)
 {
+    _clearRecordingClock();
+
     gst_bin_remove(GST_BIN(_pipeline), _fileSink);
     gst_element_set_state(_fileSink, GST_STATE_NULL);
     gst_object_unref(_fileSink);
@@ -1464,11 +2039,16 @@ GstPadProbeReturn
 GstVideoReceiver::_videoSinkProbe(GstPad* pad, GstPadProbeInfo* info, gpointer user_data)
 {
     Q_UNUSED(pad)
-    Q_UNUSED(info)
 
     if(user_data != nullptr) {
         GstVideoReceiver* pThis = static_cast<GstVideoReceiver*>(user_data);
 
+        GstBuffer* buf;
+
+        if (info != nullptr && (buf = gst_pad_probe_info_get_buffer(info)) != nullptr) {
+            pThis->_noteDecoderOutput(buf->pts);
+        }
+
         if (pThis->_resetVideoSink) {
             pThis->_resetVideoSink = false;
 
@@ -1502,6 +2082,75 @@ GstVideoReceiver::_videoSinkProbe(GstPad* pad, GstPadProbeInfo* info, gpointer u
     return GST_PAD_PROBE_OK;
 }
 
+GstPadProbeReturn
+GstVideoReceiver::_decoderInputProbe(GstPad* pad, GstPadProbeInfo* info, gpointer user_data)
+{
+    Q_UNUSED(pad)
+
+    if (info != nullptr && user_data != nullptr) {
+        GstBuffer* buf;
+
+        if ((buf = gst_pad_probe_info_get_buffer(info)) != nullptr) {
+            GstVideoReceiver* pThis = static_cast<GstVideoReceiver*>(user_data);
+
+            if (pThis->_keyframesOnly || pThis->_waitForKeyframe) {
+                if (GST_BUFFER_FLAG_IS_SET(buf, GST_BUFFER_FLAG_DELTA_UNIT)) {
+                    return GST_PAD_PROBE_DROP;
+                }
+                pThis->_waitForKeyframe = false;
+            }
+
+            pThis->_noteDecoderInput(buf->pts);
+        }
+    }
+
+    return GST_PAD_PROBE_OK;
+}
+
+GstPadProbeReturn
+GstVideoReceiver::_swapVideoSinkProbe(GstPad* pad, GstPadProbeInfo* info, gpointer user_data)
+{
+    Q_UNUSED(info)
+    Q_ASSERT(user_data != nullptr);
+
+    GstVideoReceiver* pThis = static_cast<GstVideoReceiver*>(user_data);
+
+    // Called on a streaming thread (or from gst_pad_add_probe() when already idle), the branch is owned by
+    // the worker thread so we only queue the swap there. Returning OK keeps the pad blocked until then.
+    bool expected = false;
+
+    if (pThis->_videoSinkSwapQueued.compare_exchange_strong(expected, true)) {
+        pThis->_slotHandler.dispatch([pThis, pad]() {
+            pThis->_completeVideoSinkSwap(pad);
+        });
+    }
+
+    return GST_PAD_PROBE_OK;
+}
+
+GstFlowReturn
+GstVideoReceiver::_onFrameTapSample(GstElement* appsink, gpointer user_data)
+{
+    Q_ASSERT(user_data != nullptr);
+
+    GstSample* sample = nullptr;
+
+    // Signal based so we don't need to link against gstreamer-app
+    g_signal_emit_by_name(appsink, "pull-sample", &sample);
+
+    if (sample == nullptr) {
+        return GST_FLOW_OK;
+    }
+
+    GstVideoReceiver* pThis = static_cast<GstVideoReceiver*>(user_data);
+    pThis->_deliverFrameTapSample(sample);
+
+    gst_sample_unref(sample);
+    sample = nullptr;
+
+    return GST_FLOW_OK;
+}
+
 GstPadProbeReturn
 GstVideoReceiver::_eosProbe(GstPad* pad, GstPadProbeInfo* info, gpointer user_data)
 {
@@ -1539,6 +2188,8 @@ GstVideoReceiver::_keyframeWatch(GstPad* pad, GstPadProbeInfo* info, gpointer us
 
     GstVideoReceiver* pThis = static_cast<GstVideoReceiver*>(user_data);
 
+    pThis->_setRecordingClock(pad, buf->pts);
+
     qCDebug(VideoReceiverLog) << "Got keyframe, stop dropping buffers";
 
     pThis->_dispatchSignal([pThis]() {
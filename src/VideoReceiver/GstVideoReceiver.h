@@ -21,8 +21,11 @@
 #include <QWaitCondition>
 #include <QMutex>
 #include <QQueue>
+#include <QMap>
 #include <QQuickItem>
 
+#include <atomic>
+
 #include "VideoReceiver.h"
 
 #include <gst/gst.h>
@@ -88,6 +91,20 @@ public:
     explicit GstVideoReceiver(QObject* parent = nullptr);
     ~GstVideoReceiver(void);
 
+    qint64          recordingPosition   (void) override;
+    DecoderStats    decoderStats        (void) override;
+
+    /// Frame tap consumers are called on the frame tap streaming thread with their own reference to each
+    /// decoded frame, which they must release with gst_sample_unref(). Buffers are shared with the display,
+    /// never copied. Frames are dropped for consumers which fall behind. A callback may still be called once after
+    /// removeFrameTap() returns, so anything it uses must stay valid until decoding stops.
+    typedef std::function<void(GstSample* sample)> FrameTapCallback;
+
+    /// The frame tap branch is only built when decoding starts with at least one tap added, so streams without
+    /// consumers pay nothing for it. A tap added while decoding gets frames once decoding restarts.
+    int  addFrameTap        (FrameTapCallback callback);    ///< Returns id to pass to removeFrameTap
+    void removeFrameTap     (int tapId);
+
 public slots:
     virtual void start(const QString& uri, unsigned timeout, int buffer = 0);
     virtual void stop(void);
@@ -96,6 +113,8 @@ public slots:
     virtual void startRecording(const QString& videoFile, FILE_FORMAT format);
     virtual void stopRecording(void);
     virtual void takeScreenshot(const QString& imageFile);
+    virtual void switchVideoSink(void* sink);
+    virtual void setKeyframesOnly(bool keyframesOnly);
 
 protected slots:
     virtual void _watchdog(void);
@@ -105,6 +124,8 @@ protected:
     virtual GstElement* _makeSource(const QString& uri);
     virtual GstElement* _makeDecoder(GstCaps* caps = nullptr, GstElement* videoSink = nullptr);
     virtual GstElement* _makeFileSink(const QString& videoFile, FILE_FORMAT format);
+    virtual GstElement* _makeFrameTap(void);
+    virtual GstElement* _makeOffscreenVideoSink(void);
 
     virtual void _onNewSourcePad(GstPad* pad);
     virtual void _onNewDecoderPad(GstPad* pad);
@@ -117,6 +138,17 @@ protected:
     virtual void _shutdownDecodingBranch (void);
     virtual void _shutdownRecordingBranch(void);
 
+    void _setRecordingClock(GstPad* pad, GstClockTime pts);
+    void _clearRecordingClock(void);
+
+    void _resetDecoderStats(void);
+    void _noteDecoderInput(GstClockTime pts);
+    void _noteDecoderOutput(GstClockTime pts);
+    void _deliverFrameTapSample(GstSample* sample);
+    void _swapVideoSink(GstPad* pad);
+    void _completeVideoSinkSwap(GstPad* pad);
+    void _cancelVideoSinkSwap(void);
+
     bool _needDispatch(void);
     void _dispatchSignal(std::function<void()> emitter);
 
@@ -129,6 +161,9 @@ protected:
     static GstPadProbeReturn _videoSinkProbe(GstPad* pad, GstPadProbeInfo* info, gpointer user_data);
     static GstPadProbeReturn _eosProbe(GstPad* pad, GstPadProbeInfo* info, gpointer user_data);
     static GstPadProbeReturn _keyframeWatch(GstPad* pad, GstPadProbeInfo* info, gpointer user_data);
+    static GstPadProbeReturn _decoderInputProbe(GstPad* pad, GstPadProbeInfo* info, gpointer user_data);
+    static GstPadProbeReturn _swapVideoSinkProbe(GstPad* pad, GstPadProbeInfo* info, gpointer user_data);
+    static GstFlowReturn _onFrameTapSample(GstElement* appsink, gpointer user_data);
 
     bool                _streaming;
     bool                _decoding;
@@ -141,7 +176,9 @@ protected:
     GstElement*         _recorderValve;
     GstElement*         _decoder;
     GstElement*         _videoSink;
+    GstElement*         _pendingVideoSink;      ///< Waiting for the decoder src pad to go idle
     GstElement*         _fileSink;
+    GstElement*         _frameTap;
     GstElement*         _pipeline;
 
     qint64              _lastSourceFrameTime;
@@ -149,6 +186,11 @@ protected:
     bool                _resetVideoSink;
     gulong              _videoSinkProbeId;
 
+    // Decoder src pad held blocked by the idle probe until the worker has swapped the sinks
+    GstPad*             _videoSinkSwapPad;
+    gulong              _videoSinkSwapProbeId;
+    std::atomic<bool>   _videoSinkSwapQueued;
+
     QTimer              _watchdogTimer;
 
     //-- RTSP UDP reconnect timeout
@@ -163,6 +205,33 @@ protected:
 
     bool                _endOfStream;
 
+    // Maps the pipeline clock onto the recorded file timeline, set once the first keyframe was recorded
+    QMutex              _recordingClockMutex;
+    GstClock*           _recordingClock;
+    GstClockTime        _recordingBaseTime;
+    GstClockTime        _recordingStartTime;    ///< Running time of the first recorded frame
+
+    QMutex                          _frameTapMutex;
+    QMap<int, FrameTapCallback>     _frameTapCallbacks;
+    int                             _nextFrameTapId;
+
+    // Encoded frames are matched by pts on their way out of the decoder
+    typedef struct {
+        GstClockTime pts;
+        GstClockTime arrival;
+    } PendingDecoderFrame_t;
+
+    gulong                          _decoderInputProbeId;
+    QMutex                          _decoderStatsMutex;
+    QQueue<PendingDecoderFrame_t>   _decoderPendingFrames;
+    DecoderStats                    _decoderStats;
+
+    std::atomic<bool>               _keyframesOnly;
+    std::atomic<bool>               _waitForKeyframe;       ///< Deltas after a key frames only period reference dropped frames
+
+    static const int    _maxDecoderPendingFrames    = 64;
+    static const int    _decodeLatencyAverageWeight = 16;   ///< Moving average over roughly this many frames
+
     static const char*  _kFileMux[FILE_FORMAT_MAX - FILE_FORMAT_MIN];
 };
 
@@ -0,0 +1,295 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "GstVideoReceiverTest.h"
+#include "GstVideoReceiver.h"
+#include "VideoReceiverPool.h"
+#include "QGCApplication.h"
+#include "QGCToolbox.h"
+
+#include <QAtomicInt>
+
+static const char* _frameCountKey = "qgc-test-frame-count";
+
+void GstVideoReceiverTest::init(void)
+{
+    UnitTest::init();
+
+    static const char* requiredElements[] = { "videotestsrc", "x264enc", "rtph264pay", "udpsink", "rtph264depay", "h264parse", "fakesink" };
+
+    for (const char* element: requiredElements) {
+        GstElementFactory* factory = gst_element_factory_find(element);
+        if (factory == nullptr) {
+            QSKIP(qPrintable(QStringLiteral("GStreamer element %1 not available").arg(element)));
+        }
+        gst_object_unref(factory);
+    }
+}
+
+void GstVideoReceiverTest::cleanup(void)
+{
+    for (GstElement* sender: _senders) {
+        gst_element_set_state(sender, GST_STATE_NULL);
+        gst_object_unref(sender);
+    }
+    _senders.clear();
+
+    UnitTest::cleanup();
+}
+
+GstElement* GstVideoReceiverTest::_startSender(quint16 port)
+{
+    const QString description = QStringLiteral(
+                "videotestsrc is-live=true pattern=ball ! video/x-raw,width=320,height=240,framerate=30/1 ! "
+                "x264enc tune=zerolatency speed-preset=ultrafast key-int-max=15 ! rtph264pay config-interval=1 pt=96 ! "
+                "udpsink host=127.0.0.1 port=%1").arg(port);
+
+    GError* error = nullptr;
+    GstElement* sender = gst_parse_launch(description.toUtf8().constData(), &error);
+    if (error != nullptr) {
+        qWarning() << "gst_parse_launch() failed" << error->message;
+        g_error_free(error);
+    }
+    if (sender == nullptr) {
+        return nullptr;
+    }
+
+    _senders.append(sender);
+    gst_element_set_state(sender, GST_STATE_PLAYING);
+
+    return sender;
+}
+
+GstElement* GstVideoReceiverTest::_makeCountingSink(void)
+{
+    GstElement* sink = gst_element_factory_make("fakesink", nullptr);
+    if (sink == nullptr) {
+        return nullptr;
+    }
+
+    g_object_set(sink, "async", FALSE, "sync", FALSE, "signal-handoffs", TRUE, nullptr);
+    g_object_set_data_full(G_OBJECT(sink), _frameCountKey, new QAtomicInt(0), [](gpointer data) { delete static_cast<QAtomicInt*>(data); });
+    g_signal_connect(sink, "handoff", G_CALLBACK(_onHandoff), nullptr);
+
+    // Floating reference is sunk here and released by the test, receivers take their own
+    gst_object_ref_sink(sink);
+
+    return sink;
+}
+
+void GstVideoReceiverTest::_onHandoff(GstElement* sink, GstBuffer* buffer, GstPad* pad, gpointer user_data)
+{
+    Q_UNUSED(buffer)
+    Q_UNUSED(pad)
+    Q_UNUSED(user_data)
+
+    static_cast<QAtomicInt*>(g_object_get_data(G_OBJECT(sink), _frameCountKey))->fetchAndAddOrdered(1);
+}
+
+int GstVideoReceiverTest::_frameCount(GstElement* sink)
+{
+    return static_cast<QAtomicInt*>(g_object_get_data(G_OBJECT(sink), _frameCountKey))->loadAcquire();
+}
+
+void GstVideoReceiverTest::_switchWhileStreaming(void)
+{
+    QVERIFY(_startSender(_basePort));
+
+    GstVideoReceiver receiver;
+
+    QList<VideoReceiver::STATUS> startStatus;
+    QList<VideoReceiver::STATUS> switchStatus;
+    connect(&receiver, &VideoReceiver::onStartComplete,             this, [&startStatus](VideoReceiver::STATUS status) { startStatus.append(status); });
+    connect(&receiver, &VideoReceiver::onSwitchVideoSinkComplete,   this, [&switchStatus](VideoReceiver::STATUS status) { switchStatus.append(status); });
+
+    GstElement* sinks[2] = { _makeCountingSink(), _makeCountingSink() };
+    QVERIFY(sinks[0] && sinks[1]);
+
+    receiver.start(QStringLiteral("udp://127.0.0.1:%1").arg(_basePort), 5);
+    QTRY_COMPARE_WITH_TIMEOUT(startStatus.count(), 1, 10000);
+    QCOMPARE(startStatus.first(), VideoReceiver::STATUS_OK);
+
+    receiver.startDecoding(sinks[0]);
+    QTRY_VERIFY_WITH_TIMEOUT(_frameCount(sinks[0]) > 0, 10000);
+
+    // Every switch lands on a decoder with frames in flight, which is when the idle probe has to block the pad
+    for (int i = 1; i <= 6; i++) {
+        GstElement* to = sinks[i % 2];
+        const int framesBefore = _frameCount(to);
+
+        receiver.switchVideoSink(to);
+        QTRY_COMPARE_WITH_TIMEOUT(switchStatus.count(), i, 5000);
+        QCOMPARE(switchStatus.last(), VideoReceiver::STATUS_OK);
+        QTRY_VERIFY_WITH_TIMEOUT(_frameCount(to) > framesBefore, 5000);
+    }
+
+    QList<VideoReceiver::STATUS> stopStatus;
+    connect(&receiver, &VideoReceiver::onStopComplete, this, [&stopStatus](VideoReceiver::STATUS status) { stopStatus.append(status); });
+    receiver.stop();
+    QTRY_COMPARE_WITH_TIMEOUT(stopStatus.count(), 1, 5000);
+
+    gst_object_unref(sinks[0]);
+    gst_object_unref(sinks[1]);
+}
+
+void GstVideoReceiverTest::_switchOverlappingStop(void)
+{
+    QVERIFY(_startSender(_basePort + 1));
+
+    GstVideoReceiver receiver;
+
+    QList<VideoReceiver::STATUS> startStatus;
+    QList<VideoReceiver::STATUS> switchStatus;
+    QList<VideoReceiver::STATUS> stopStatus;
+    bool decoding = false;
+    bool streaming = false;
+    connect(&receiver, &VideoReceiver::onStartComplete,             this, [&startStatus](VideoReceiver::STATUS status) { startStatus.append(status); });
+    connect(&receiver, &VideoReceiver::onSwitchVideoSinkComplete,   this, [&switchStatus](VideoReceiver::STATUS status) { switchStatus.append(status); });
+    connect(&receiver, &VideoReceiver::onStopComplete,              this, [&stopStatus](VideoReceiver::STATUS status) { stopStatus.append(status); });
+    connect(&receiver, &VideoReceiver::decodingChanged,             this, [&decoding](bool active) { decoding = active; });
+    connect(&receiver, &VideoReceiver::streamingChanged,            this, [&streaming](bool active) { streaming = active; });
+
+    GstElement* sink = _makeCountingSink();
+    QVERIFY(sink);
+
+    const QString uri = QStringLiteral("udp://127.0.0.1:%1").arg(_basePort + 1);
+
+    for (int i = 1; i <= 5; i++) {
+        receiver.start(uri, 5);
+        QTRY_COMPARE_WITH_TIMEOUT(startStatus.count(), i, 10000);
+        QCOMPARE(startStatus.last(), VideoReceiver::STATUS_OK);
+
+        const int framesBefore = _frameCount(sink);
+        receiver.startDecoding(sink);
+        QTRY_VERIFY_WITH_TIMEOUT(_frameCount(sink) > framesBefore, 10000);
+
+        // Both are queued back to back on the worker, the stop has to win cleanly whichever way the probe fires
+        receiver.switchVideoSink(nullptr);
+        receiver.stop();
+
+        QTRY_COMPARE_WITH_TIMEOUT(stopStatus.count(), i, 5000);
+        QTRY_COMPARE_WITH_TIMEOUT(switchStatus.count(), i, 5000);
+        QTRY_VERIFY(!decoding && !streaming);
+    }
+
+    gst_object_unref(sink);
+}
+
+void GstVideoReceiverTest::_poolShowStream(void)
+{
+    QVERIFY(_startSender(_basePort + 2));
+    QVERIFY(_startSender(_basePort + 3));
+
+    GstElement* displaySink = _makeCountingSink();
+    QVERIFY(displaySink);
+
+    {
+        VideoReceiverPool pool(qgcApp()->toolbox()->corePlugin());
+
+        QList<int> shownStreams;
+        connect(&pool, &VideoReceiverPool::shownStreamChanged, this, [&shownStreams](int index) { shownStreams.append(index); });
+
+        pool.setDisplaySink(displaySink);
+        pool.setTimeout(5);
+        pool.setStreams({
+            { QStringLiteral("udp://127.0.0.1:%1").arg(_basePort + 2), -1 },
+            { QStringLiteral("udp://127.0.0.1:%1").arg(_basePort + 3), -1 },
+        });
+        pool.start();
+
+        pool.showStream(0);
+        QTRY_COMPARE_WITH_TIMEOUT(pool.shownStream(), 0, 10000);
+        QTRY_VERIFY_WITH_TIMEOUT(_frameCount(displaySink) > 0, 10000);
+
+        // Back and forth between warm streams, the display sink has to keep receiving frames after each move
+        for (int i = 1; i <= 4; i++) {
+            const int index = i % 2;
+            const int framesBefore = _frameCount(displaySink);
+
+            pool.showStream(index);
+            QTRY_COMPARE_WITH_TIMEOUT(pool.shownStream(), index, 5000);
+            QTRY_VERIFY_WITH_TIMEOUT(_frameCount(displaySink) > framesBefore + 5, 5000);
+        }
+
+        QVERIFY(shownStreams.contains(0));
+        QVERIFY(shownStreams.contains(1));
+
+        // Released receivers delete themselves once their pipeline is down
+        pool.stop();
+        QTRY_VERIFY_WITH_TIMEOUT(pool.findChildren<VideoReceiver*>().isEmpty(), 10000);
+    }
+
+    gst_object_unref(displaySink);
+}
+
+void GstVideoReceiverTest::_frameTap(void)
+{
+    for (const char* element: { "tee", "queue", "appsink" }) {
+        GstElementFactory* factory = gst_element_factory_find(element);
+        if (factory == nullptr) {
+            QSKIP(qPrintable(QStringLiteral("GStreamer element %1 not available").arg(element)));
+        }
+        gst_object_unref(factory);
+    }
+
+    QVERIFY(_startSender(_basePort + 4));
+
+    GstVideoReceiver receiver;
+
+    QList<VideoReceiver::STATUS> startStatus;
+    QList<VideoReceiver::STATUS> stopStatus;
+    connect(&receiver, &VideoReceiver::onStartComplete, this, [&startStatus](VideoReceiver::STATUS status) { startStatus.append(status); });
+    connect(&receiver, &VideoReceiver::onStopComplete,  this, [&stopStatus](VideoReceiver::STATUS status) { stopStatus.append(status); });
+
+    QAtomicInt tapFrames(0);
+    QAtomicInt selfRemovingFrames(0);
+    QAtomicInt selfRemovingTapId(0);
+
+    // Taps are added before decoding starts, which is what builds the frame tap branch
+    const int tapId = receiver.addFrameTap([&tapFrames](GstSample* sample) {
+        if (gst_sample_get_buffer(sample) != nullptr) {
+            tapFrames.fetchAndAddOrdered(1);
+        }
+        gst_sample_unref(sample);
+    });
+
+    // Removing itself from inside the callback used to deadlock the frame tap thread on the tap lock
+    selfRemovingTapId.storeRelease(receiver.addFrameTap([&receiver, &selfRemovingFrames, &selfRemovingTapId](GstSample* sample) {
+        gst_sample_unref(sample);
+        if (selfRemovingFrames.fetchAndAddOrdered(1) == 0) {
+            receiver.removeFrameTap(selfRemovingTapId.loadAcquire());
+        }
+    }));
+
+    GstElement* sink = _makeCountingSink();
+    QVERIFY(sink);
+
+    receiver.start(QStringLiteral("udp://127.0.0.1:%1").arg(_basePort + 4), 5);
+    QTRY_COMPARE_WITH_TIMEOUT(startStatus.count(), 1, 10000);
+    QCOMPARE(startStatus.first(), VideoReceiver::STATUS_OK);
+
+    receiver.startDecoding(sink);
+
+    // The tap runs alongside the display, both have to keep getting frames
+    QTRY_VERIFY_WITH_TIMEOUT(tapFrames.loadAcquire() > 5, 10000);
+    QTRY_VERIFY_WITH_TIMEOUT(_frameCount(sink) > 5, 5000);
+    QCOMPARE(selfRemovingFrames.loadAcquire(), 1);
+
+    // No more frames once a tap is removed, apart from a delivery which was already under way
+    receiver.removeFrameTap(tapId);
+    const int framesAtRemoval = tapFrames.loadAcquire();
+    const int displayFrames = _frameCount(sink);
+    QTRY_VERIFY_WITH_TIMEOUT(_frameCount(sink) > displayFrames + 5, 5000);
+    QVERIFY(tapFrames.loadAcquire() <= framesAtRemoval + 1);
+
+    receiver.stop();
+    QTRY_COMPARE_WITH_TIMEOUT(stopStatus.count(), 1, 5000);
+
+    gst_object_unref(sink);
+}
@@ -0,0 +1,41 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <gst/gst.h>
+
+/// Runs GstVideoReceiver against local RTP/H.264 test streams sent over UDP
+class GstVideoReceiverTest : public UnitTest
+{
+    Q_OBJECT
+
+protected slots:
+    void init   (void) override;
+    void cleanup(void) override;
+
+private slots:
+    void _switchWhileStreaming      (void);
+    void _switchOverlappingStop     (void);
+    void _poolShowStream            (void);
+    void _frameTap                  (void);
+
+private:
+    GstElement* _startSender        (quint16 port);
+    GstElement* _makeCountingSink   (void);
+
+    static int  _frameCount         (GstElement* sink);
+    static void _onHandoff          (GstElement* sink, GstBuffer* buffer, GstPad* pad, gpointer user_data);
+
+    QList<GstElement*> _senders;
+
+    static const quint16 _basePort = 5640;
+};
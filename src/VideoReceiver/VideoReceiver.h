@@ -29,6 +29,20 @@ public:
 
     virtual ~VideoReceiver(void) {}
 
+    // Current position within the file being recorded, in nanoseconds, measured against the receiver's
+    // own pipeline clock. -1 if not recording or not supported. Thread safe.
+    virtual qint64 recordingPosition(void) { return -1; }
+
+    typedef struct {
+        quint64 decodedFrames;              ///< Frames which reached the video sink
+        quint64 droppedFrames;              ///< Frames which went into the decoder but never reached the video sink
+        qint64  decodeLatencyNsecs;         ///< Moving average time from decoder input to video sink, -1 if unknown
+        qint64  maxDecodeLatencyNsecs;      ///< -1 if unknown
+    } DecoderStats;
+
+    // Statistics for the current decoding session, reset each time decoding starts. Thread safe.
+    virtual DecoderStats decoderStats(void) { return DecoderStats{ 0, 0, -1, -1 }; }
+
     typedef enum {
         FILE_FORMAT_MIN = 0,
         FILE_FORMAT_MKV = FILE_FORMAT_MIN,
@@ -62,6 +76,7 @@ signals:
     void onStartRecordingComplete(STATUS status);
     void onStopRecordingComplete(STATUS status);
     void onTakeScreenshotComplete(STATUS status);
+    void onSwitchVideoSinkComplete(STATUS status);
 
 public slots:
     // buffer:
@@ -75,4 +90,16 @@ public slots:
     virtual void startRecording(const QString& videoFile, FILE_FORMAT format) = 0;
     virtual void stopRecording(void) = 0;
     virtual void takeScreenshot(const QString& imageFile) = 0;
+
+    // Moves decoding onto another sink without rebuilding the decoder. A null sink keeps decoding into an
+    // off-screen sink, so the previous sink can be handed to another receiver once this completes.
+    virtual void switchVideoSink(void* sink) {
+        Q_UNUSED(sink)
+        emit onSwitchVideoSinkComplete(STATUS_NOT_IMPLEMENTED);
+    }
+
+    // Only feed key frames to the decoder, for streams which are not on screen
+    virtual void setKeyframesOnly(bool keyframesOnly) {
+        Q_UNUSED(keyframesOnly)
+    }
 };
@@ -148,6 +148,14 @@ VideoEnabled {
         $$PWD/GStreamer.cc \
         $$PWD/GstVideoReceiver.cc
 
+    contains(DEFINES, UNITTEST_BUILD) {
+        HEADERS += \
+            $$PWD/GstVideoReceiverTest.h
+
+        SOURCES += \
+            $$PWD/GstVideoReceiverTest.cc
+    }
+
     include($$PWD/../../qmlglsink.pri)
 } else {
     LinuxBuild|MacBuild|iOSBuild|WindowsBuild|AndroidBuild {
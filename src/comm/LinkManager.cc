@@ -35,6 +35,7 @@
 
 #ifdef QT_DEBUG
 #include "MockLink.h"
+#include "MockLinkSwarm.h"
 #endif
 
 #include <qmdnsengine/browser.h>
@@ -135,7 +136,11 @@ bool LinkManager::createConnectedLink(SharedLinkConfigurationPtr& config, bool i
         break;
 #ifdef QT_DEBUG
     case LinkConfiguration::TypeMock:
-        link = std::make_shared<MockLink>(config);
+        if (qobject_cast<MockConfiguration*>(config.get())->swarmCount() > 0) {
+            link = std::make_shared<MockLinkSwarm>(config);
+        } else {
+            link = std::make_shared<MockLink>(config);
+        }
         break;
 #endif
     case LinkConfiguration::TypeLast:
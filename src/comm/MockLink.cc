@@ -48,6 +48,9 @@ const char* MockConfiguration::_vehicleTypeKey          = "VehicleType";
 const char* MockConfiguration::_sendStatusTextKey       = "SendStatusText";
 const char* MockConfiguration::_incrementVehicleIdKey   = "IncrementVehicleId";
 const char* MockConfiguration::_failureModeKey          = "FailureMode";
+const char* MockConfiguration::_swarmCountKey           = "SwarmCount";
+const char* MockConfiguration::_swarmLossPercentKey     = "SwarmLossPercent";
+const char* MockConfiguration::_swarmStreamRatesKey     = "SwarmStreamRates";
 
 constexpr MAV_CMD MockLink::MAV_CMD_MOCKLINK_ALWAYS_RESULT_ACCEPTED;
 constexpr MAV_CMD MockLink::MAV_CMD_MOCKLINK_ALWAYS_RESULT_FAILED;
@@ -276,19 +279,37 @@ void MockLink::_run500HzTasks(void)
     if (_mavlinkStarted && _connected) {
         _paramRequestListWorker();
         _logDownloadWorker();
+        _ulogStreamWorker();
     }
 }
 
 void MockLink::_loadParams(void)
+{
+    loadParamFile(_firmwareType, _vehicleType, _mapParamName2Value, _mapParamName2MavParamType);
+}
+
+uint32_t MockLink::manualCustomMode(MAV_AUTOPILOT firmwareType)
+{
+    if (firmwareType != MAV_AUTOPILOT_PX4) {
+        return 0;
+    }
+
+    union px4_custom_mode px4_cm;
+    px4_cm.data = 0;
+    px4_cm.main_mode = PX4_CUSTOM_MAIN_MODE_MANUAL;
+    return px4_cm.data;
+}
+
+void MockLink::loadParamFile(MAV_AUTOPILOT firmwareType, MAV_TYPE vehicleType, ParamValueMap_t& values, ParamTypeMap_t& types)
 {
     QFile paramFile;
 
-    if (_firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA) {
-        if (_vehicleType == MAV_TYPE_FIXED_WING) {
+    if (firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA) {
+        if (vehicleType == MAV_TYPE_FIXED_WING) {
             paramFile.setFileName(":/FirmwarePlugin/APM/Plane.OfflineEditing.params");
-        } else if (_vehicleType == MAV_TYPE_SUBMARINE ) {
+        } else if (vehicleType == MAV_TYPE_SUBMARINE ) {
             paramFile.setFileName(":/MockLink/APMArduSubMockLink.params");
-        } else if (_vehicleType == MAV_TYPE_GROUND_ROVER ) {
+        } else if (vehicleType == MAV_TYPE_GROUND_ROVER ) {
             paramFile.setFileName(":/FirmwarePlugin/APM/Rover.OfflineEditing.params");
         } else {
             paramFile.setFileName(":/FirmwarePlugin/APM/Copter.OfflineEditing.params");
@@ -350,8 +371,8 @@ void MockLink::_loadParams(void)
 
         qCDebug(MockLinkVerboseLog) << "Loading param" << paramName << paramValue;
 
-        _mapParamName2Value[compId][paramName] = paramValue;
-        _mapParamName2MavParamType[compId][paramName] = static_cast<MAV_PARAM_TYPE>(paramType);
+        values[compId][paramName] = paramValue;
+        types[compId][paramName] = static_cast<MAV_PARAM_TYPE>(paramType);
     }
 }
 
@@ -652,6 +673,9 @@ void MockLink::_handleIncomingMavlinkMsg(const mavlink_message_t &msg)
     case MAVLINK_MSG_ID_PARAM_MAP_RC:
         _handleParamMapRC(msg);
         break;
+    case MAVLINK_MSG_ID_LOGGING_ACK:
+        _handleLoggingAck(msg);
+        break;
     default:
         break;
     }
@@ -700,15 +724,21 @@ void MockLink::_handleManualControl(const mavlink_message_t& msg)
 
 void MockLink::_setParamFloatUnionIntoMap(int componentId, const QString& paramName, float paramFloat)
 {
-    mavlink_param_union_t   valueUnion;
-
     Q_ASSERT(_mapParamName2Value.contains(componentId));
     Q_ASSERT(_mapParamName2Value[componentId].contains(paramName));
     Q_ASSERT(_mapParamName2MavParamType[componentId].contains(paramName));
 
-    valueUnion.param_float = paramFloat;
+    QVariant paramVariant = paramValueForFloatUnion(_mapParamName2MavParamType[componentId][paramName], paramFloat);
+
+    qCDebug(MockLinkLog) << "_setParamFloatUnionIntoMap" << paramName << paramVariant;
+    _mapParamName2Value[componentId][paramName] = paramVariant;
+}
+
+QVariant MockLink::paramValueForFloatUnion(MAV_PARAM_TYPE paramType, float paramFloat)
+{
+    mavlink_param_union_t   valueUnion;
 
-    MAV_PARAM_TYPE paramType = _mapParamName2MavParamType[componentId][paramName];
+    valueUnion.param_float = paramFloat;
 
     QVariant paramVariant;
 
@@ -747,21 +777,22 @@ void MockLink::_setParamFloatUnionIntoMap(int componentId, const QString& paramN
         break;
     }
 
-    qCDebug(MockLinkLog) << "_setParamFloatUnionIntoMap" << paramName << paramVariant;
-    _mapParamName2Value[componentId][paramName] = paramVariant;
+    return paramVariant;
 }
 
 /// Convert from a parameter variant to the float value from mavlink_param_union_t
 float MockLink::_floatUnionForParam(int componentId, const QString& paramName)
 {
-    mavlink_param_union_t   valueUnion;
-
     Q_ASSERT(_mapParamName2Value.contains(componentId));
     Q_ASSERT(_mapParamName2Value[componentId].contains(paramName));
     Q_ASSERT(_mapParamName2MavParamType[componentId].contains(paramName));
 
-    MAV_PARAM_TYPE paramType = _mapParamName2MavParamType[componentId][paramName];
-    QVariant paramVar = _mapParamName2Value[componentId][paramName];
+    return floatUnionForParamValue(_firmwareType, _mapParamName2MavParamType[componentId][paramName], _mapParamName2Value[componentId][paramName]);
+}
+
+float MockLink::floatUnionForParamValue(MAV_AUTOPILOT firmwareType, MAV_PARAM_TYPE paramType, const QVariant& paramVar)
+{
+    mavlink_param_union_t   valueUnion;
 
     switch (paramType) {
     case MAV_PARAM_TYPE_REAL32:
@@ -769,7 +800,7 @@ float MockLink::_floatUnionForParam(int componentId, const QString& paramName)
         break;
 
     case MAV_PARAM_TYPE_UINT32:
-        if (_firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA) {
+        if (firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA) {
             valueUnion.param_float = paramVar.toUInt();
         } else {
             valueUnion.param_uint32 = paramVar.toUInt();
@@ -777,7 +808,7 @@ float MockLink::_floatUnionForParam(int componentId, const QString& paramName)
         break;
 
     case MAV_PARAM_TYPE_INT32:
-        if (_firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA) {
+        if (firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA) {
             valueUnion.param_float = paramVar.toInt();
         } else {
             valueUnion.param_int32 = paramVar.toInt();
@@ -785,7 +816,7 @@ float MockLink::_floatUnionForParam(int componentId, const QString& paramName)
         break;
 
     case MAV_PARAM_TYPE_UINT16:
-        if (_firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA) {
+        if (firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA) {
             valueUnion.param_float = paramVar.toUInt();
         } else {
             valueUnion.param_uint16 = paramVar.toUInt();
@@ -793,7 +824,7 @@ float MockLink::_floatUnionForParam(int componentId, const QString& paramName)
         break;
 
     case MAV_PARAM_TYPE_INT16:
-        if (_firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA) {
+        if (firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA) {
             valueUnion.param_float = paramVar.toInt();
         } else {
             valueUnion.param_int16 = paramVar.toInt();
@@ -801,7 +832,7 @@ float MockLink::_floatUnionForParam(int componentId, const QString& paramName)
         break;
 
     case MAV_PARAM_TYPE_UINT8:
-        if (_firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA) {
+        if (firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA) {
             valueUnion.param_float = paramVar.toUInt();
         } else {
             valueUnion.param_uint8 = paramVar.toUInt();
@@ -809,7 +840,7 @@ float MockLink::_floatUnionForParam(int componentId, const QString& paramName)
         break;
 
     case MAV_PARAM_TYPE_INT8:
-        if (_firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA) {
+        if (firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA) {
             valueUnion.param_float = (unsigned char)paramVar.toChar().toLatin1();
         } else {
             valueUnion.param_int8 = (unsigned char)paramVar.toChar().toLatin1();
@@ -817,7 +848,7 @@ float MockLink::_floatUnionForParam(int componentId, const QString& paramName)
         break;
 
     default:
-        if (_firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA) {
+        if (firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA) {
             valueUnion.param_float = paramVar.toInt();
         } else {
             valueUnion.param_int32 = paramVar.toInt();
@@ -1090,6 +1121,14 @@ void MockLink::_handleCommandLong(const mavlink_message_t& msg)
         commandResult = MAV_RESULT_ACCEPTED;
         _respondWithAutopilotVersion();
         break;
+    case MAV_CMD_LOGGING_START:
+        _startULogStream();
+        commandResult = MAV_RESULT_ACCEPTED;
+        break;
+    case MAV_CMD_LOGGING_STOP:
+        _ulogStreamActive = false;
+        commandResult = MAV_RESULT_ACCEPTED;
+        break;
     case MAV_CMD_REQUEST_MESSAGE:
         if (_handleRequestMessage(request, noAck)) {
             if (noAck) {
@@ -1363,6 +1402,9 @@ MockConfiguration::MockConfiguration(MockConfiguration* source)
     _sendStatusText     = source->_sendStatusText;
     _incrementVehicleId = source->_incrementVehicleId;
     _failureMode        = source->_failureMode;
+    _swarmCount         = source->_swarmCount;
+    _swarmLossPercent   = source->_swarmLossPercent;
+    _swarmStreamRates   = source->_swarmStreamRates;
 }
 
 void MockConfiguration::copyFrom(LinkConfiguration *source)
@@ -1380,6 +1422,9 @@ void MockConfiguration::copyFrom(LinkConfiguration *source)
     _sendStatusText     = usource->_sendStatusText;
     _incrementVehicleId = usource->_incrementVehicleId;
     _failureMode        = usource->_failureMode;
+    _swarmCount         = usource->_swarmCount;
+    _swarmLossPercent   = usource->_swarmLossPercent;
+    _swarmStreamRates   = usource->_swarmStreamRates;
 }
 
 void MockConfiguration::saveSettings(QSettings& settings, const QString& root)
@@ -1390,6 +1435,13 @@ void MockConfiguration::saveSettings(QSettings& settings, const QString& root)
     settings.setValue(_sendStatusTextKey,       _sendStatusText);
     settings.setValue(_incrementVehicleIdKey,   _incrementVehicleId);
     settings.setValue(_failureModeKey,          (int)_failureMode);
+    settings.setValue(_swarmCountKey,           _swarmCount);
+    settings.setValue(_swarmLossPercentKey,     _swarmLossPercent);
+    QVariantMap streamRates;
+    for (auto it = _swarmStreamRates.constBegin(); it != _swarmStreamRates.constEnd(); ++it) {
+        streamRates[QString::number(it.key())] = it.value();
+    }
+    settings.setValue(_swarmStreamRatesKey,     streamRates);
     settings.sync();
     settings.endGroup();
 }
@@ -1402,9 +1454,30 @@ void MockConfiguration::loadSettings(QSettings& settings, const QString& root)
     _sendStatusText     = settings.value(_sendStatusTextKey, false).toBool();
     _incrementVehicleId = settings.value(_incrementVehicleIdKey, true).toBool();
     _failureMode        = (FailureMode_t)settings.value(_failureModeKey, (int)FailNone).toInt();
+    _swarmCount         = settings.value(_swarmCountKey, 0).toInt();
+    _swarmLossPercent   = settings.value(_swarmLossPercentKey, 0).toInt();
+    _swarmStreamRates   = defaultSwarmStreamRates();
+    const QVariantMap streamRates = settings.value(_swarmStreamRatesKey).toMap();
+    for (auto it = streamRates.constBegin(); it != streamRates.constEnd(); ++it) {
+        _swarmStreamRates[it.key().toInt()] = it.value().toDouble();
+    }
     settings.endGroup();
 }
 
+QMap<int, double> MockConfiguration::defaultSwarmStreamRates(void)
+{
+    // Roughly what a PX4 vehicle sends on a telemetry radio
+    return {
+        { MAVLINK_MSG_ID_HEARTBEAT,             1 },
+        { MAVLINK_MSG_ID_SYS_STATUS,            1 },
+        { MAVLINK_MSG_ID_BATTERY_STATUS,        0.5 },
+        { MAVLINK_MSG_ID_GPS_RAW_INT,           1 },
+        { MAVLINK_MSG_ID_GLOBAL_POSITION_INT,   5 },
+        { MAVLINK_MSG_ID_ATTITUDE,              10 },
+        { MAVLINK_MSG_ID_VFR_HUD,               4 },
+    };
+}
+
 MockLink* MockLink::_startMockLink(MockConfiguration* mockConfig)
 {
     LinkManager* linkMgr = qgcApp()->toolbox()->linkManager();
@@ -1604,6 +1677,117 @@ void MockLink::_logDownloadWorker(void)
     }
 }
 
+void MockLink::_startULogStream(void)
+{
+    _ulogStreamActive       = true;
+    _ulogStreamSequence     = 0;
+    _ulogStreamBytesSent    = 0;
+    _ulogStreamPendingPos   = 0;
+    _ulogStreamMessageCount = 0;
+    _ulogStreamMessageStarts.clear();
+
+    // ULog file header: magic, version, timestamp. It goes out on its own as acked data.
+    const uint8_t ulogMagic[] = { 'U', 'L', 'o', 'g', 0x01, 0x12, 0x35, 0x01 };
+    quint64 timestamp = static_cast<quint64>(_runningTime.nsecsElapsed() / 1000);
+    _ulogStreamPending = QByteArray(reinterpret_cast<const char*>(ulogMagic), sizeof(ulogMagic));
+    _ulogStreamPending.append(reinterpret_cast<const char*>(&timestamp), sizeof(timestamp));
+    _sendULogStreamData(true /* acked */);
+
+    _ulogStreamTimer.start();
+}
+
+void MockLink::_handleLoggingAck(const mavlink_message_t& msg)
+{
+    mavlink_logging_ack_t ack;
+    mavlink_msg_logging_ack_decode(&msg, &ack);
+
+    if (_ulogStreamAckPending && ack.sequence == _ulogStreamAckedData.sequence) {
+        _ulogStreamAckPending = false;
+    }
+}
+
+void MockLink::_sendULogStreamData(bool acked)
+{
+    int length = qMin(_ulogStreamPending.length(), static_cast<int>(MAVLINK_MSG_LOGGING_DATA_FIELD_DATA_LEN));
+
+    // Offset of the first message which starts in this chunk, 255 for none
+    uint8_t firstMessageOffset = 255;
+    while (!_ulogStreamMessageStarts.isEmpty() && _ulogStreamMessageStarts.first() < _ulogStreamPendingPos + length) {
+        if (firstMessageOffset == 255) {
+            firstMessageOffset = static_cast<uint8_t>(_ulogStreamMessageStarts.first() - _ulogStreamPendingPos);
+        }
+        _ulogStreamMessageStarts.removeFirst();
+    }
+
+    mavlink_message_t msg;
+    if (acked) {
+        memset(&_ulogStreamAckedData, 0, sizeof(_ulogStreamAckedData));
+        _ulogStreamAckedData.sequence               = _ulogStreamSequence;
+        _ulogStreamAckedData.length                 = static_cast<uint8_t>(length);
+        _ulogStreamAckedData.first_message_offset   = firstMessageOffset;
+        memcpy(_ulogStreamAckedData.data, _ulogStreamPending.constData(), static_cast<size_t>(length));
+        mavlink_msg_logging_data_acked_encode_chan(_vehicleSystemId, _vehicleComponentId, mavlinkChannel(), &msg, &_ulogStreamAckedData);
+        _ulogStreamAckPending = true;
+        _ulogStreamAckTimer.start();
+    } else {
+        mavlink_msg_logging_data_pack_chan(_vehicleSystemId,
+                                           _vehicleComponentId,
+                                           mavlinkChannel(),
+                                           &msg,
+                                           0,                           // target_system
+                                           0,                           // target_component
+                                           _ulogStreamSequence,
+                                           static_cast<uint8_t>(length),
+                                           firstMessageOffset,
+                                           reinterpret_cast<const uint8_t*>(_ulogStreamPending.constData()));
+    }
+    respondWithMavlinkMessage(msg);
+
+    _ulogStreamSequence++;
+    _ulogStreamBytesSent    += length;
+    _ulogStreamPendingPos   += length;
+    _ulogStreamPending.remove(0, length);   // At most one message worth of data is pending
+}
+
+void MockLink::_ulogStreamWorker(void)
+{
+    if (!_ulogStreamActive) {
+        return;
+    }
+
+    if (_ulogStreamAckPending && _ulogStreamAckTimer.elapsed() > _ulogStreamAckTimeoutMsecs) {
+        qCDebug(MockLinkLog) << "_ulogStreamWorker resending acked data" << _ulogStreamAckedData.sequence;
+        mavlink_message_t msg;
+        mavlink_msg_logging_data_acked_encode_chan(_vehicleSystemId, _vehicleComponentId, mavlinkChannel(), &msg, &_ulogStreamAckedData);
+        respondWithMavlinkMessage(msg);
+        _ulogStreamAckTimer.start();
+    }
+
+    // Send whatever is due to keep up the configured rate, limited so a stalled timer does not cause a flood
+    const int   maxChunksPerTick    = 50;
+    qint64      bytesDue            = (_ulogStreamTimer.elapsed() * _ulogStreamBytesPerSecond / 1000) - _ulogStreamBytesSent;
+    for (int chunk=0; chunk<maxChunksPerTick && bytesDue > 0; chunk++) {
+        // Generate ULog data messages of varying length so they straddle LOGGING_DATA boundaries
+        while (_ulogStreamPending.length() < MAVLINK_MSG_LOGGING_DATA_FIELD_DATA_LEN) {
+            uint16_t payloadLength  = static_cast<uint16_t>(10 + ((_ulogStreamMessageCount * 37) % 300));
+            quint64  timestamp      = static_cast<quint64>(_runningTime.nsecsElapsed() / 1000);
+            uint16_t msgId          = 0;
+            QByteArray ulogMessage;
+            ulogMessage.reserve(3 + payloadLength);
+            ulogMessage.append(reinterpret_cast<const char*>(&payloadLength), sizeof(payloadLength));
+            ulogMessage.append('D');
+            ulogMessage.append(reinterpret_cast<const char*>(&msgId), sizeof(msgId));
+            ulogMessage.append(reinterpret_cast<const char*>(&timestamp), sizeof(timestamp));
+            ulogMessage.append(payloadLength - static_cast<int>(sizeof(msgId) + sizeof(timestamp)), static_cast<char>(_ulogStreamMessageCount));
+            _ulogStreamMessageStarts.append(_ulogStreamPendingPos + _ulogStreamPending.length());
+            _ulogStreamPending.append(ulogMessage);
+            _ulogStreamMessageCount++;
+        }
+        bytesDue -= qMin(_ulogStreamPending.length(), static_cast<int>(MAVLINK_MSG_LOGGING_DATA_FIELD_DATA_LEN));
+        _sendULogStreamData(false /* acked */);
+    }
+}
+
 void MockLink::_sendADSBVehicles(void)
 {
     _adsbAngle += 2;
@@ -36,6 +36,8 @@ public:
     Q_PROPERTY(int      vehicle             READ vehicle            WRITE setVehicle            NOTIFY vehicleChanged)
     Q_PROPERTY(bool     sendStatus          READ sendStatusText     WRITE setSendStatusText     NOTIFY sendStatusChanged)
     Q_PROPERTY(bool     incrementVehicleId  READ incrementVehicleId WRITE setIncrementVehicleId NOTIFY incrementVehicleIdChanged)
+    Q_PROPERTY(int      swarmCount          READ swarmCount         WRITE setSwarmCount         NOTIFY swarmCountChanged)
+    Q_PROPERTY(int      swarmLossPercent    READ swarmLossPercent   WRITE setSwarmLossPercent   NOTIFY swarmLossPercentChanged)
 
     int     firmware                (void)                      { return (int)_firmwareType; }
     void    setFirmware             (int type)                  { _firmwareType = (MAV_AUTOPILOT)type; emit firmwareChanged(); }
@@ -56,6 +58,20 @@ public:
     void            setVehicleType      (MAV_TYPE vehicleType)          { _vehicleType = vehicleType; emit vehicleChanged(); }
     void            setSendStatusText   (bool sendStatusText)           { _sendStatusText = sendStatusText; emit sendStatusChanged(); }
 
+    /// Number of vehicles simulated by a MockLinkSwarm on this link, 0 for a single vehicle MockLink
+    int             swarmCount          (void) const                    { return _swarmCount; }
+    void            setSwarmCount       (int swarmCount)                { _swarmCount = swarmCount; emit swarmCountChanged(); }
+
+    /// Percentage of swarm messages which are dropped before reaching QGC
+    int             swarmLossPercent    (void) const                    { return _swarmLossPercent; }
+    void            setSwarmLossPercent (int lossPercent)               { _swarmLossPercent = lossPercent; emit swarmLossPercentChanged(); }
+
+    /// Telemetry stream rates for each swarm vehicle: message id -> rate in Hz. A rate of 0 turns the stream off.
+    QMap<int, double> swarmStreamRates  (void) const                    { return _swarmStreamRates; }
+    void            setSwarmStreamRate  (int msgId, double rateHz)      { _swarmStreamRates[msgId] = rateHz; }
+
+    static QMap<int, double> defaultSwarmStreamRates(void);
+
     typedef enum {
         FailNone,                                                   // No failures
         FailParamNoReponseToRequestList,                            // Do no respond to PARAM_REQUEST_LIST
@@ -82,6 +98,8 @@ signals:
     void vehicleChanged             (void);
     void sendStatusChanged          (void);
     void incrementVehicleIdChanged  (void);
+    void swarmCountChanged          (void);
+    void swarmLossPercentChanged    (void);
 
 private:
     MAV_AUTOPILOT   _firmwareType       = MAV_AUTOPILOT_PX4;
@@ -91,12 +109,18 @@ private:
     bool            _incrementVehicleId = true;
     uint16_t        _boardVendorId      = 0;
     uint16_t        _boardProductId     = 0;
+    int             _swarmCount         = 0;
+    int             _swarmLossPercent   = 0;
+    QMap<int, double> _swarmStreamRates = defaultSwarmStreamRates();
 
     static const char* _firmwareTypeKey;
     static const char* _vehicleTypeKey;
     static const char* _sendStatusTextKey;
     static const char* _incrementVehicleIdKey;
     static const char* _failureModeKey;
+    static const char* _swarmCountKey;
+    static const char* _swarmLossPercentKey;
+    static const char* _swarmStreamRatesKey;
 };
 
 class MockLink : public LinkInterface
@@ -126,6 +150,8 @@ public:
 
     MockLinkFTP* mockLinkFTP(void) { return _mockLinkFTP; }
 
+    MockLinkMissionItemHandler* missionItemHandler(void) { return &_missionItemHandler; }
+
     // Overrides from LinkInterface
     bool isConnected(void) const override { return _connected; }
     void disconnect (void) override;
@@ -181,6 +207,22 @@ public:
     } RequestMessageFailureMode_t;
     void setRequestMessageFailureMode(RequestMessageFailureMode_t failureMode) { _requestMessageFailureMode = failureMode; }
 
+    /// Sets the rate of the simulated ULog stream (LOGGING_DATA) started by MAV_CMD_LOGGING_START
+    void setULogStreamRate(int bytesPerSecond) { _ulogStreamBytesPerSecond = bytesPerSecond; }
+
+    typedef QMap<int, QMap<QString, QVariant>>          ParamValueMap_t;    ///< Component id -> param name -> value
+    typedef QMap<int, QMap<QString, MAV_PARAM_TYPE>>    ParamTypeMap_t;     ///< Component id -> param name -> type
+
+    /// Loads the simulated parameter set for the specified firmware and vehicle type
+    static void     loadParamFile           (MAV_AUTOPILOT firmwareType, MAV_TYPE vehicleType, ParamValueMap_t& values, ParamTypeMap_t& types);
+
+    /// Converts a parameter value to/from the float value of a mavlink_param_union_t
+    static float    floatUnionForParamValue (MAV_AUTOPILOT firmwareType, MAV_PARAM_TYPE paramType, const QVariant& paramVar);
+    static QVariant paramValueForFloatUnion (MAV_PARAM_TYPE paramType, float paramFloat);
+
+    /// @return HEARTBEAT custom mode of a vehicle of the specified firmware which is in manual flight mode
+    static uint32_t manualCustomMode        (MAV_AUTOPILOT firmwareType);
+
 signals:
     void writeBytesQueuedSignal                 (const QByteArray bytes);
     void highLatencyTransmissionEnabledChanged  (bool highLatencyTransmissionEnabled);
@@ -224,6 +266,7 @@ private:
     void _handleLogRequestList          (const mavlink_message_t& msg);
     void _handleLogRequestData          (const mavlink_message_t& msg);
     void _handleParamMapRC              (const mavlink_message_t& msg);
+    void _handleLoggingAck              (const mavlink_message_t& msg);
     bool _handleRequestMessage          (const mavlink_command_long_t& request, bool& noAck);
     float _floatUnionForParam           (int componentId, const QString& paramName);
     void _setParamFloatUnionIntoMap     (int componentId, const QString& paramName, float paramFloat);
@@ -238,6 +281,9 @@ private:
     void _sendRCChannels                (void);
     void _paramRequestListWorker        (void);
     void _logDownloadWorker             (void);
+    void _startULogStream               (void);
+    void _ulogStreamWorker              (void);
+    void _sendULogStreamData            (bool acked);
     void _sendADSBVehicles              (void);
     void _moveADSBVehicle               (void);
     void _sendGeneralMetaData           (void);
@@ -305,14 +351,30 @@ private:
     uint32_t    _logDownloadCurrentOffset;  ///< Current offset we are sending from
     uint32_t    _logDownloadBytesRemaining; ///< Number of bytes still to send, 0 = send inactive
 
+    static const int _ulogStreamAckTimeoutMsecs = 100;  ///< Acked ULog data is resent if not acked within this time
+
+    int             _ulogStreamBytesPerSecond   = 500 * 1024;
+    bool            _ulogStreamActive           = false;
+    uint16_t        _ulogStreamSequence         = 0;
+    QElapsedTimer   _ulogStreamTimer;
+    qint64          _ulogStreamBytesSent        = 0;
+    QByteArray      _ulogStreamPending;             ///< Generated ULog data which has not been sent yet
+    qint64          _ulogStreamPendingPos       = 0;    ///< Stream position of the start of _ulogStreamPending
+    QList<qint64>   _ulogStreamMessageStarts;       ///< Stream positions of ULog message starts in _ulogStreamPending
+    quint32         _ulogStreamMessageCount     = 0;
+    bool            _ulogStreamAckPending       = false;
+    QElapsedTimer   _ulogStreamAckTimer;
+
+    mavlink_logging_data_acked_t _ulogStreamAckedData;  ///< Last acked data sent, for resend
+
     QGeoCoordinate  _adsbVehicleCoordinate;
     double          _adsbAngle;
 
     RequestMessageFailureMode_t _requestMessageFailureMode = FailRequestMessageNone;
 
     QMap<MAV_CMD, int>  _sendMavCommandCountMap;
-    QMap<int, QMap<QString, QVariant>>          _mapParamName2Value;
-    QMap<int, QMap<QString, MAV_PARAM_TYPE>>    _mapParamName2MavParamType;
+    ParamValueMap_t     _mapParamName2Value;
+    ParamTypeMap_t      _mapParamName2MavParamType;
 
     static double       _defaultVehicleLatitude;
     static double       _defaultVehicleLongitude;
@@ -103,6 +103,7 @@ void MockLinkFTP::_openCommand(uint8_t senderSystemId, uint8_t senderComponentId
     QString             path;
     uint16_t            outgoingSeqNumber = _nextSeqNumber(seqNumber);
     QString             tmpFilename;
+    MAV_MISSION_TYPE    missionType;
     
     ensureNullTemination(request);
 
@@ -117,6 +118,8 @@ void MockLinkFTP::_openCommand(uint8_t senderSystemId, uint8_t senderComponentId
     if (path.startsWith(sizePrefix)) {
         QString sizeString = path.right(path.length() - sizePrefix.length());
         tmpFilename = _createTestTempFile(sizeString.toInt());
+    } else if (_missionTypeFromPath(path, missionType)) {
+        tmpFilename = _createMissionTempFile(missionType);
     } else if (path == "/general.json") {
         tmpFilename = ":MockLink/General.MetaData.json";
     } else if (path == "/general.json.xz") {
@@ -239,6 +242,58 @@ void MockLinkFTP::_burstReadCommand(uint8_t senderSystemId, uint8_t senderCompon
     }
 }
 
+/// @brief Handles CreateFile requests. Only the plan files can be written.
+void MockLinkFTP::_createCommand(uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request* request, uint16_t seqNumber)
+{
+    uint16_t            outgoingSeqNumber = _nextSeqNumber(seqNumber);
+    MAV_MISSION_TYPE    missionType;
+
+    ensureNullTemination(request);
+
+    QString path = (char *)request->data;
+    if (!_missionTypeFromPath(path, missionType)) {
+        _sendNak(senderSystemId, senderComponentId, MavlinkFTP::kErrFailFileProtected, outgoingSeqNumber, MavlinkFTP::kCmdCreateFile);
+        return;
+    }
+
+    _uploadFile.close();
+    _uploadFile.setFileName(_createTestTempFile(0));
+    if (!_uploadFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        _sendNakErrno(senderSystemId, senderComponentId, _uploadFile.error(), outgoingSeqNumber, MavlinkFTP::kCmdCreateFile);
+        return;
+    }
+    _uploadMissionType = missionType;
+
+    _sendAck(senderSystemId, senderComponentId, outgoingSeqNumber, MavlinkFTP::kCmdCreateFile);
+}
+
+void MockLinkFTP::_writeCommand(uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request* request, uint16_t seqNumber)
+{
+    uint16_t outgoingSeqNumber = _nextSeqNumber(seqNumber);
+
+    if (request->hdr.session != _sessionId || !_uploadFile.isOpen()) {
+        _sendNak(senderSystemId, senderComponentId, MavlinkFTP::kErrInvalidSession, outgoingSeqNumber, MavlinkFTP::kCmdWriteFile);
+        return;
+    }
+
+    if (request->hdr.offset != 0) {
+        if (_errMode == errModeNakSecondResponse) {
+            _sendNak(senderSystemId, senderComponentId, MavlinkFTP::kErrFail, outgoingSeqNumber, MavlinkFTP::kCmdWriteFile);
+            return;
+        } else if (_errMode == errModeNoSecondResponse) {
+            return;
+        }
+    }
+
+    _uploadFile.seek(request->hdr.offset);
+    if (_uploadFile.write((const char*)request->data, request->hdr.size) != request->hdr.size) {
+        _sendNakErrno(senderSystemId, senderComponentId, _uploadFile.error(), outgoingSeqNumber, MavlinkFTP::kCmdWriteFile);
+        return;
+    }
+
+    _sendAck(senderSystemId, senderComponentId, outgoingSeqNumber, MavlinkFTP::kCmdWriteFile);
+}
+
 void MockLinkFTP::_terminateCommand(uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request* request, uint16_t seqNumber)
 {
     uint16_t outgoingSeqNumber = _nextSeqNumber(seqNumber);
@@ -247,6 +302,22 @@ void MockLinkFTP::_terminateCommand(uint8_t senderSystemId, uint8_t senderCompon
         _sendNak(senderSystemId, senderComponentId, MavlinkFTP::kErrInvalidSession, outgoingSeqNumber, MavlinkFTP::kCmdTerminateSession);
         return;
     }
+
+    if (_uploadFile.isOpen()) {
+        // Plan upload is complete, vehicle takes the new plan into use
+        _uploadFile.close();
+        _uploadFile.open(QIODevice::ReadOnly);
+        QByteArray bytes = _uploadFile.readAll();
+        _uploadFile.close();
+        _uploadFile.remove();
+
+        QList<mavlink_mission_item_int_t> items;
+        if (!MavlinkFTP::unpackMissionFile(bytes, _uploadMissionType, items)) {
+            _sendNak(senderSystemId, senderComponentId, MavlinkFTP::kErrFail, outgoingSeqNumber, MavlinkFTP::kCmdTerminateSession);
+            return;
+        }
+        _mockLink->missionItemHandler()->setPlanItems(_uploadMissionType, items);
+    }
     
     _sendAck(senderSystemId, senderComponentId, outgoingSeqNumber, MavlinkFTP::kCmdTerminateSession);
 
@@ -281,8 +352,8 @@ void MockLinkFTP::mavlinkMessageReceived(const mavlink_message_t& message)
 
     MavlinkFTP::Request* request = (MavlinkFTP::Request*)&requestFTP.payload[0];
 
-    // kCmdOpenFileRO and kCmdResetSessions don't support retry so we can't drop those
-    if (_randomDropsEnabled && request->hdr.opcode != MavlinkFTP::kCmdOpenFileRO && request->hdr.opcode != MavlinkFTP::kCmdResetSessions) {
+    // kCmdOpenFileRO, kCmdCreateFile and kCmdResetSessions don't support retry so we can't drop those
+    if (_randomDropsEnabled && request->hdr.opcode != MavlinkFTP::kCmdOpenFileRO && request->hdr.opcode != MavlinkFTP::kCmdCreateFile && request->hdr.opcode != MavlinkFTP::kCmdResetSessions) {
         if ((rand() % 5) == 0) {
             qDebug() << "MockLinkFTP: Random drop of incoming packet";
             return;
@@ -336,6 +407,14 @@ void MockLinkFTP::mavlinkMessageReceived(const mavlink_message_t& message)
         _burstReadCommand(message.sysid, message.compid, request, incomingSeqNumber);
         break;
 
+    case MavlinkFTP::kCmdCreateFile:
+        _createCommand(message.sysid, message.compid, request, incomingSeqNumber);
+        break;
+
+    case MavlinkFTP::kCmdWriteFile:
+        _writeCommand(message.sysid, message.compid, request, incomingSeqNumber);
+        break;
+
     case MavlinkFTP::kCmdTerminateSession:
         _terminateCommand(message.sysid, message.compid, request, incomingSeqNumber);
         break;
@@ -407,8 +486,8 @@ void MockLinkFTP::_sendResponse(uint8_t targetSystemId, uint8_t targetComponentI
                                                  targetComponentId,
                                                  (uint8_t*)request);            // Payload
 
-    // kCmdOpenFileRO and kCmdResetSessions don't support retry so we can't drop those
-    if (_randomDropsEnabled && request->hdr.req_opcode != MavlinkFTP::kCmdOpenFileRO && request->hdr.req_opcode != MavlinkFTP::kCmdResetSessions) {
+    // kCmdOpenFileRO, kCmdCreateFile and kCmdResetSessions don't support retry so we can't drop those
+    if (_randomDropsEnabled && request->hdr.req_opcode != MavlinkFTP::kCmdOpenFileRO && request->hdr.req_opcode != MavlinkFTP::kCmdCreateFile && request->hdr.req_opcode != MavlinkFTP::kCmdResetSessions) {
         if ((rand() % 5) == 0) {
             qDebug() << "MockLinkFTP: Random drop of outgoing packet";
             return;
@@ -440,3 +519,25 @@ QString MockLinkFTP::_createTestTempFile(int size)
     tmpFile.close();
     return tmpFile.fileName();
 }
+
+QString MockLinkFTP::_createMissionTempFile(MAV_MISSION_TYPE missionType)
+{
+    QGCTemporaryFile tmpFile("MockLinkFTPMission");
+    tmpFile.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    tmpFile.write(MavlinkFTP::packMissionFile(missionType, _mockLink->missionItemHandler()->planItems(missionType)));
+    tmpFile.close();
+    return tmpFile.fileName();
+}
+
+bool MockLinkFTP::_missionTypeFromPath(const QString& path, MAV_MISSION_TYPE& missionType)
+{
+    static const MAV_MISSION_TYPE rgMissionTypes[] = { MAV_MISSION_TYPE_MISSION, MAV_MISSION_TYPE_FENCE, MAV_MISSION_TYPE_RALLY };
+
+    for (MAV_MISSION_TYPE type: rgMissionTypes) {
+        if (path == MavlinkFTP::missionFilePath(type)) {
+            missionType = type;
+            return true;
+        }
+    }
+    return false;
+}
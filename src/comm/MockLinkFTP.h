@@ -18,6 +18,10 @@
 class MockLink;
 
 /// Mock implementation of Mavlink FTP server.
+///
+/// Besides test files of arbitrary size and the component metadata, the plans held by the MockLink mission item
+/// handler are served as ArduPilot style @MISSION/mission.dat, fence.dat and rally.dat files. Uploading one of these
+/// files replaces the plan on the vehicle once the session is terminated.
 class MockLinkFTP : public QObject
 {
     Q_OBJECT
@@ -73,10 +77,14 @@ private:
     void        _openCommand            (uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request* request, uint16_t seqNumber);
     void        _readCommand            (uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request* request, uint16_t seqNumber);
     void        _burstReadCommand          (uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request* request, uint16_t seqNumber);
+    void        _createCommand          (uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request* request, uint16_t seqNumber);
+    void        _writeCommand           (uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request* request, uint16_t seqNumber);
     void        _terminateCommand       (uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request* request, uint16_t seqNumber);
     void        _resetCommand           (uint8_t senderSystemId, uint8_t senderComponentId, uint16_t seqNumber);
     uint16_t    _nextSeqNumber          (uint16_t seqNumber);
     QString     _createTestTempFile     (int size);
+    QString     _createMissionTempFile  (MAV_MISSION_TYPE missionType);
+    bool        _missionTypeFromPath    (const QString& path, MAV_MISSION_TYPE& missionType);
     
     /// if request is a string, this ensures it's null-terminated
     static void ensureNullTemination(MavlinkFTP::Request* request);
@@ -92,6 +100,8 @@ private:
     uint16_t                _lastReplySequence  = 0;
     mavlink_message_t       _lastReply;
     bool                    _randomDropsEnabled = false;
+    QFile                   _uploadFile;                        ///< File being written by CreateFile/WriteFile
+    MAV_MISSION_TYPE        _uploadMissionType  = MAV_MISSION_TYPE_ALL;
 
     static const uint8_t    _sessionId          = 1;    ///< We only support a single fixed session
 };
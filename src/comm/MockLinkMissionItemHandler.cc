@@ -61,6 +61,10 @@ bool MockLinkMissionItemHandler::handleMessage(const mavlink_message_t& msg)
         _handleMissionCount(msg);
         break;
 
+    case MAVLINK_MSG_ID_MISSION_WRITE_PARTIAL_LIST:
+        _handleMissionWritePartialList(msg);
+        break;
+
     case MAVLINK_MSG_ID_MISSION_ACK:
         // Acks are received back for each MISSION_ITEM message
         break;
@@ -284,6 +288,30 @@ void MockLinkMissionItemHandler::_handleMissionCount(const mavlink_message_t& ms
     }
 }
 
+/// Replaces the items start_index through end_index in place, the item count can't change
+void MockLinkMissionItemHandler::_handleMissionWritePartialList(const mavlink_message_t& msg)
+{
+    mavlink_mission_write_partial_list_t partialList;
+
+    mavlink_msg_mission_write_partial_list_decode(&msg, &partialList);
+    Q_ASSERT(partialList.target_system == _mockLink->vehicleId());
+
+    _requestType = (MAV_MISSION_TYPE)partialList.mission_type;
+
+    qCDebug(MockLinkMissionItemHandlerLog) << "_handleMissionWritePartialList write sequence start:end" << partialList.start_index << partialList.end_index;
+
+    MissionItemList_t* itemList = _itemListForType(_requestType);
+    if (!itemList || partialList.start_index < 0 || partialList.end_index < partialList.start_index || partialList.end_index >= itemList->count()) {
+        _sendAck(MAV_MISSION_ERROR);
+        return;
+    }
+
+    _partialWriteCount++;
+    _writeSequenceCount = partialList.end_index + 1;
+    _writeSequenceIndex = partialList.start_index;
+    _requestNextMissionItem(_writeSequenceIndex);
+}
+
 void MockLinkMissionItemHandler::_requestNextMissionItem(int sequenceNumber)
 {
     qCDebug(MockLinkMissionItemHandlerLog) << "_requestNextMissionItem write sequence sequenceNumber:" << sequenceNumber << "_failureMode:" << _failureMode;
@@ -426,3 +454,38 @@ void MockLinkMissionItemHandler::shutdown(void)
         delete _missionItemResponseTimer;
     }
 }
+
+MockLinkMissionItemHandler::MissionItemList_t* MockLinkMissionItemHandler::_itemListForType(MAV_MISSION_TYPE missionType)
+{
+    switch (missionType) {
+    case MAV_MISSION_TYPE_MISSION:
+        return &_missionItems;
+    case MAV_MISSION_TYPE_FENCE:
+        return &_fenceItems;
+    case MAV_MISSION_TYPE_RALLY:
+        return &_rallyItems;
+    default:
+        return nullptr;
+    }
+}
+
+QList<mavlink_mission_item_int_t> MockLinkMissionItemHandler::planItems(MAV_MISSION_TYPE missionType)
+{
+    MissionItemList_t* itemList = _itemListForType(missionType);
+
+    return itemList ? itemList->values() : QList<mavlink_mission_item_int_t>();
+}
+
+void MockLinkMissionItemHandler::setPlanItems(MAV_MISSION_TYPE missionType, const QList<mavlink_mission_item_int_t>& items)
+{
+    MissionItemList_t* itemList = _itemListForType(missionType);
+    if (!itemList) {
+        qWarning() << "Internal error";
+        return;
+    }
+
+    itemList->clear();
+    for (const mavlink_mission_item_int_t& item: items) {
+        (*itemList)[item.seq] = item;
+    }
+}
@@ -80,6 +80,15 @@ public:
 
     void setSendHomePositionOnEmptyList(bool sendHomePositionOnEmptyList) { _sendHomePositionOnEmptyList = sendHomePositionOnEmptyList; }
 
+    /// Items of the specified type in sequence order, used by MockLinkFTP to serve the plan files
+    QList<mavlink_mission_item_int_t> planItems(MAV_MISSION_TYPE missionType);
+
+    /// Replaces all items of the specified type, used by MockLinkFTP when a plan file is uploaded
+    void setPlanItems(MAV_MISSION_TYPE missionType, const QList<mavlink_mission_item_int_t>& items);
+
+    /// Number of MISSION_WRITE_PARTIAL_LIST writes started
+    int partialWriteCount(void) const { return _partialWriteCount; }
+
 private slots:
     void _missionItemResponseTimeout(void);
 
@@ -88,19 +97,22 @@ private:
     void _handleMissionRequest          (const mavlink_message_t& msg);
     void _handleMissionItem             (const mavlink_message_t& msg);
     void _handleMissionCount            (const mavlink_message_t& msg);
+    void _handleMissionWritePartialList (const mavlink_message_t& msg);
     void _handleMissionClearAll         (const mavlink_message_t& msg);
     void _requestNextMissionItem        (int sequenceNumber);
     void _sendAck                       (MAV_MISSION_RESULT ackType);
     void _startMissionItemResponseTimer (void);
 
+    typedef QMap<uint16_t, mavlink_mission_item_int_t> MissionItemList_t;
+
+    MissionItemList_t* _itemListForType (MAV_MISSION_TYPE missionType);
+
 private:
     MockLink* _mockLink;
     
     int _writeSequenceCount;    ///< Numbers of items about to be written
     int _writeSequenceIndex;    ///< Current index being reqested
 
-    typedef QMap<uint16_t, mavlink_mission_item_int_t> MissionItemList_t;
-
     MAV_MISSION_TYPE    _requestType;
     MissionItemList_t   _missionItems;
     MissionItemList_t   _fenceItems;
@@ -114,5 +126,6 @@ private:
     bool                _failReadRequestListFirstResponse;
     bool                _failReadRequest1FirstResponse;
     bool                _failWriteMissionCountFirstResponse;
+    int                 _partialWriteCount = 0;
 };
 
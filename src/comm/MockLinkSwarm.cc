@@ -0,0 +1,907 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MockLinkSwarm.h"
+#include "QGCLoggingCategory.h"
+#include "QGCApplication.h"
+#include "LinkManager.h"
+
+#include <QMutexLocker>
+#include <QTimer>
+#include <QtMath>
+
+#include <string.h>
+
+QGC_LOGGING_CATEGORY(MockLinkSwarmLog, "MockLinkSwarmLog")
+
+double MockLinkSwarm::_orbitRadiusMeters =      20.0;
+double MockLinkSwarm::_orbitSpeedMetersPerSec = 5.0;
+
+namespace {
+    // Same home area as MockLink, swarm vehicles are laid out on a grid from here
+    const double _swarmLatitude     = 47.397;
+    const double _swarmLongitude    = 8.5455;
+    const double _swarmAltitude     = 488.056;
+    const double _gridSpacingDeg    = 0.001;
+
+    bool _streamSupported(int msgId)
+    {
+        switch (msgId) {
+        case MAVLINK_MSG_ID_HEARTBEAT:
+        case MAVLINK_MSG_ID_SYS_STATUS:
+        case MAVLINK_MSG_ID_BATTERY_STATUS:
+        case MAVLINK_MSG_ID_GPS_RAW_INT:
+        case MAVLINK_MSG_ID_GLOBAL_POSITION_INT:
+        case MAVLINK_MSG_ID_ATTITUDE:
+        case MAVLINK_MSG_ID_VFR_HUD:
+            return true;
+        default:
+            return false;
+        }
+    }
+}
+
+MockLinkSwarm::MockLinkSwarm(SharedLinkConfigurationPtr& config)
+    : LinkInterface (config)
+    , _random       (1)     // Fixed seed so loss patterns repeat between runs
+{
+    MockConfiguration* mockConfig = qobject_cast<MockConfiguration*>(_config.get());
+    _firmwareType   = mockConfig->firmwareType();
+    _vehicleType    = mockConfig->vehicleType();
+    _lossPercent    = qBound(0, mockConfig->swarmLossPercent(), 100);
+
+    const int vehicleCount = qBound(1, mockConfig->swarmCount(), static_cast<int>(maxVehicleCount));
+
+    qCDebug(MockLinkSwarmLog) << "MockLinkSwarm" << this << vehicleCount << "vehicles" << _lossPercent << "% loss";
+
+    const QMap<int, double> streamRates = mockConfig->swarmStreamRates();
+    for (auto it = streamRates.constBegin(); it != streamRates.constEnd(); ++it) {
+        if (it.value() <= 0) {
+            continue;
+        }
+        if (!_streamSupported(it.key())) {
+            qCWarning(MockLinkSwarmLog) << "Unsupported stream message id" << it.key();
+            continue;
+        }
+        _streams.append({ static_cast<uint32_t>(it.key()), qMax(static_cast<int>(tickMSecs), qRound(1000.0 / it.value())) });
+    }
+
+    // Loaded once, every vehicle starts out referencing these same maps
+    MockLink::loadParamFile(_firmwareType, _vehicleType, _params, _paramTypes);
+    for (auto it = _params.constBegin(); it != _params.constEnd(); ++it) {
+        _paramNames[it.key()] = it.value().keys();
+    }
+    _paramComponentIds = _paramNames.keys();
+
+    const uint32_t customMode = MockLink::manualCustomMode(_firmwareType);
+
+    const int gridColumns = qCeil(qSqrt(vehicleCount));
+
+    _vehicles.resize(vehicleCount);
+    for (int i = 0; i < vehicleCount; i++) {
+        Vehicle_t& vehicle = _vehicles[i];
+
+        vehicle.systemId                = static_cast<uint8_t>(_firstVehicleId + i);
+        memset(&vehicle.txStatus, 0, sizeof(vehicle.txStatus));
+        vehicle.baseMode                = MAV_MODE_FLAG_MANUAL_INPUT_ENABLED | MAV_MODE_FLAG_CUSTOM_MODE_ENABLED;
+        vehicle.customMode              = customMode;
+        vehicle.homeLatitude            = _swarmLatitude + ((i / gridColumns) * _gridSpacingDeg);
+        vehicle.homeLongitude           = _swarmLongitude + ((i % gridColumns) * _gridSpacingDeg);
+        vehicle.latitude                = vehicle.homeLatitude;
+        vehicle.longitude               = vehicle.homeLongitude;
+        vehicle.altitude                = _swarmAltitude;
+        vehicle.orbitAngle              = 0;
+        vehicle.params                  = _params;
+        vehicle.paramListComponentIndex = -1;
+        vehicle.paramListParamIndex     = -1;
+        vehicle.missionUploadCount      = -1;
+
+        // Spread each stream over its interval so the vehicles don't all send on the same tick
+        vehicle.nextStreamMSecs.resize(_streams.count());
+        for (int j = 0; j < _streams.count(); j++) {
+            vehicle.nextStreamMSecs[j] = (static_cast<qint64>(i) * _streams[j].intervalMSecs) / vehicleCount;
+        }
+    }
+
+    QObject::connect(this, &MockLinkSwarm::writeBytesQueuedSignal, this, &MockLinkSwarm::_writeBytesQueued, Qt::QueuedConnection);
+
+    moveToThread(this);
+}
+
+MockLinkSwarm::~MockLinkSwarm(void)
+{
+    disconnect();
+    qCDebug(MockLinkSwarmLog) << "~MockLinkSwarm" << this;
+}
+
+bool MockLinkSwarm::_connect(void)
+{
+    if (!_connected) {
+        _connected = true;
+        // Swarm vehicles use Mavlink 2.0
+        mavlink_status_t* mavlinkStatus = mavlink_get_channel_status(mavlinkChannel());
+        mavlinkStatus->flags &= ~MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+        mavlink_status_t* auxStatus = mavlink_get_channel_status(_mavlinkAuxChannel);
+        auxStatus->flags &= ~MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+        start();
+        emit connected();
+    }
+
+    return true;
+}
+
+void MockLinkSwarm::disconnect(void)
+{
+    if (_connected) {
+        _connected = false;
+        quit();
+        wait();
+        emit disconnected();
+    }
+}
+
+bool MockLinkSwarm::_allocateMavlinkChannel()
+{
+    if (!LinkInterface::_allocateMavlinkChannel()) {
+        qCWarning(MockLinkSwarmLog) << "LinkInterface::_allocateMavlinkChannel failed";
+        return false;
+    }
+
+    // Incoming messages from QGC are parsed on a channel of our own
+    _mavlinkAuxChannel = qgcApp()->toolbox()->linkManager()->allocateMavlinkChannel();
+    if (_mavlinkAuxChannel == LinkManager::invalidMavlinkChannel()) {
+        qCWarning(MockLinkSwarmLog) << "_allocateMavlinkChannel failed";
+        LinkInterface::_freeMavlinkChannel();
+        return false;
+    }
+    return true;
+}
+
+void MockLinkSwarm::_freeMavlinkChannel()
+{
+    if (_mavlinkAuxChannel == LinkManager::invalidMavlinkChannel()) {
+        return;
+    }
+
+    qgcApp()->toolbox()->linkManager()->freeMavlinkChannel(_mavlinkAuxChannel);
+    _mavlinkAuxChannel = LinkManager::invalidMavlinkChannel();
+    LinkInterface::_freeMavlinkChannel();
+}
+
+void MockLinkSwarm::run(void)
+{
+    QTimer tickTimer;
+
+    QObject::connect(&tickTimer, &QTimer::timeout, this, &MockLinkSwarm::_runTick);
+
+    _runningTime.start();
+    _lastTickMSecs      = 0;
+    _lastSampleMSecs    = 0;
+    tickTimer.start(tickMSecs);
+
+    _runTick();
+
+    exec();
+
+    QObject::disconnect(&tickTimer, &QTimer::timeout, this, &MockLinkSwarm::_runTick);
+}
+
+MockLinkSwarm::Throughput_t MockLinkSwarm::throughputTotals(void)
+{
+    QMutexLocker locker(&_throughputMutex);
+    return _sampledTotals;
+}
+
+MockLinkSwarm::Throughput_t MockLinkSwarm::throughputPerSecond(void)
+{
+    QMutexLocker locker(&_throughputMutex);
+    return _perSecond;
+}
+
+void MockLinkSwarm::_runTick(void)
+{
+    if (!_connected) {
+        return;
+    }
+
+    const qint64 nowMSecs = _runningTime.elapsed();
+    const double elapsedSecs = (nowMSecs - _lastTickMSecs) / 1000.0;
+    _lastTickMSecs = nowMSecs;
+
+    for (Vehicle_t& vehicle: _vehicles) {
+        _moveVehicle(vehicle, elapsedSecs);
+
+        for (int i = 0; i < _streams.count(); i++) {
+            qint64& nextMSecs = vehicle.nextStreamMSecs[i];
+            if (nowMSecs >= nextMSecs) {
+                _sendStream(vehicle, _streams[i].msgId);
+                nextMSecs += _streams[i].intervalMSecs;
+                if (nextMSecs <= nowMSecs) {
+                    // We fell behind, skip ahead rather than send a burst
+                    nextMSecs = nowMSecs + _streams[i].intervalMSecs;
+                }
+            }
+        }
+
+        _paramRequestListWorker(vehicle);
+    }
+
+    _flushMessages();
+
+    if (nowMSecs - _lastSampleMSecs >= throughputSampleMSecs) {
+        _sampleThroughput();
+    }
+}
+
+void MockLinkSwarm::_moveVehicle(Vehicle_t& vehicle, double elapsedSecs)
+{
+    vehicle.orbitAngle = fmod(vehicle.orbitAngle + ((_orbitSpeedMetersPerSec / _orbitRadiusMeters) * elapsedSecs), 2.0 * M_PI);
+
+    const double northMeters    = _orbitRadiusMeters * qCos(vehicle.orbitAngle);
+    const double eastMeters     = _orbitRadiusMeters * qSin(vehicle.orbitAngle);
+
+    vehicle.latitude    = vehicle.homeLatitude + (northMeters / 111319.5);
+    vehicle.longitude   = vehicle.homeLongitude + (eastMeters / (111319.5 * qCos(qDegreesToRadians(vehicle.homeLatitude))));
+}
+
+void MockLinkSwarm::_sampleThroughput(void)
+{
+    const qint64 nowMSecs       = _runningTime.elapsed();
+    const qint64 elapsedMSecs   = qMax(static_cast<qint64>(1), nowMSecs - _lastSampleMSecs);
+
+    auto perSecond = [elapsedMSecs](quint64 current, quint64 last) {
+        return static_cast<quint64>((current - last) * 1000 / elapsedMSecs);
+    };
+
+    Throughput_t sample;
+    sample.messagesSent     = perSecond(_counters.messagesSent,     _lastSampleCounters.messagesSent);
+    sample.bytesSent        = perSecond(_counters.bytesSent,        _lastSampleCounters.bytesSent);
+    sample.messagesDropped  = perSecond(_counters.messagesDropped,  _lastSampleCounters.messagesDropped);
+    sample.messagesReceived = perSecond(_counters.messagesReceived, _lastSampleCounters.messagesReceived);
+    sample.bytesReceived    = perSecond(_counters.bytesReceived,    _lastSampleCounters.bytesReceived);
+
+    _lastSampleCounters = _counters;
+    _lastSampleMSecs    = nowMSecs;
+
+    {
+        QMutexLocker locker(&_throughputMutex);
+        _sampledTotals  = _counters;
+        _perSecond      = sample;
+    }
+
+    qCDebug(MockLinkSwarmLog) << "vehicles" << _vehicles.count()
+                              << "sent msgs/s" << sample.messagesSent << "bytes/s" << sample.bytesSent
+                              << "dropped msgs/s" << sample.messagesDropped
+                              << "received msgs/s" << sample.messagesReceived << "bytes/s" << sample.bytesReceived;
+
+    emit throughputSampled();
+}
+
+/// Called when QGC wants to write bytes to the swarm
+void MockLinkSwarm::_writeBytes(const QByteArray bytes)
+{
+    // Handled on the swarm thread, responses go out after _writeBytes returns
+    emit writeBytesQueuedSignal(bytes);
+}
+
+void MockLinkSwarm::_writeBytesQueued(const QByteArray bytes)
+{
+    _counters.bytesReceived += static_cast<quint64>(bytes.count());
+
+    mavlink_message_t   msg;
+    mavlink_status_t    comm;
+
+    for (int i = 0; i < bytes.count(); i++) {
+        if (mavlink_parse_char(_mavlinkAuxChannel, static_cast<uint8_t>(bytes[i]), &msg, &comm)) {
+            _counters.messagesReceived++;
+            _handleIncomingMavlinkMsg(msg);
+        }
+    }
+
+    _flushMessages();
+}
+
+MockLinkSwarm::Vehicle_t* MockLinkSwarm::_vehicleForMessage(const mavlink_message_t& msg)
+{
+    const mavlink_msg_entry_t* entry = mavlink_get_msg_entry(msg.msgid);
+    if (!entry || !(entry->flags & MAV_MSG_ENTRY_FLAG_HAVE_TARGET_SYSTEM)) {
+        return nullptr;
+    }
+
+    const int index = static_cast<uint8_t>(_MAV_PAYLOAD(&msg)[entry->target_system_ofs]) - _firstVehicleId;
+    if (index < 0 || index >= _vehicles.count()) {
+        return nullptr;
+    }
+    return &_vehicles[index];
+}
+
+void MockLinkSwarm::_handleIncomingMavlinkMsg(const mavlink_message_t& msg)
+{
+    Vehicle_t* vehicle = _vehicleForMessage(msg);
+    if (!vehicle) {
+        // Heartbeats from QGC and anything not addressed to one of our vehicles
+        return;
+    }
+
+    switch (msg.msgid) {
+    case MAVLINK_MSG_ID_COMMAND_LONG:
+        _handleCommandLong(*vehicle, msg);
+        break;
+    case MAVLINK_MSG_ID_COMMAND_INT:
+        _handleCommandInt(*vehicle, msg);
+        break;
+    case MAVLINK_MSG_ID_SET_MODE:
+        _handleSetMode(*vehicle, msg);
+        break;
+    case MAVLINK_MSG_ID_PARAM_REQUEST_LIST:
+        vehicle->paramListComponentIndex    = 0;
+        vehicle->paramListParamIndex        = 0;
+        break;
+    case MAVLINK_MSG_ID_PARAM_REQUEST_READ:
+        _handleParamRequestRead(*vehicle, msg);
+        break;
+    case MAVLINK_MSG_ID_PARAM_SET:
+        _handleParamSet(*vehicle, msg);
+        break;
+    case MAVLINK_MSG_ID_MISSION_REQUEST_LIST:
+        _handleMissionRequestList(*vehicle, msg);
+        break;
+    case MAVLINK_MSG_ID_MISSION_REQUEST_INT:
+        _handleMissionRequestInt(*vehicle, msg);
+        break;
+    case MAVLINK_MSG_ID_MISSION_COUNT:
+        _handleMissionCount(*vehicle, msg);
+        break;
+    case MAVLINK_MSG_ID_MISSION_ITEM_INT:
+        _handleMissionItemInt(*vehicle, msg);
+        break;
+    case MAVLINK_MSG_ID_MISSION_CLEAR_ALL:
+        _handleMissionClearAll(*vehicle, msg);
+        break;
+    default:
+        break;
+    }
+}
+
+void MockLinkSwarm::_handleCommandLong(Vehicle_t& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_command_long_t request;
+    mavlink_msg_command_long_decode(&msg, &request);
+
+    uint8_t commandResult = MAV_RESULT_UNSUPPORTED;
+
+    switch (request.command) {
+    case MAV_CMD_COMPONENT_ARM_DISARM:
+        if (request.param1 == 0.0f) {
+            vehicle.baseMode &= ~MAV_MODE_FLAG_SAFETY_ARMED;
+        } else {
+            vehicle.baseMode |= MAV_MODE_FLAG_SAFETY_ARMED;
+        }
+        commandResult = MAV_RESULT_ACCEPTED;
+        break;
+    case MAV_CMD_REQUEST_AUTOPILOT_CAPABILITIES:
+        _sendAutopilotVersion(vehicle);
+        commandResult = MAV_RESULT_ACCEPTED;
+        break;
+    case MAV_CMD_REQUEST_MESSAGE:
+        switch (static_cast<int>(request.param1)) {
+        case MAVLINK_MSG_ID_AUTOPILOT_VERSION:
+            _sendAutopilotVersion(vehicle);
+            commandResult = MAV_RESULT_ACCEPTED;
+            break;
+        case MAVLINK_MSG_ID_PROTOCOL_VERSION:
+            _sendProtocolVersion(vehicle);
+            commandResult = MAV_RESULT_ACCEPTED;
+            break;
+        default:
+            break;
+        }
+        break;
+    case MAV_CMD_SET_MESSAGE_INTERVAL:
+        // Stream rates come from the configuration, so the measurement isn't skewed by what QGC asks for
+        commandResult = MAV_RESULT_ACCEPTED;
+        break;
+    default:
+        break;
+    }
+
+    _sendCommandAck(vehicle, request.command, commandResult);
+}
+
+void MockLinkSwarm::_handleCommandInt(Vehicle_t& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_command_int_t request;
+    mavlink_msg_command_int_decode(&msg, &request);
+
+    _sendCommandAck(vehicle, request.command, MAV_RESULT_UNSUPPORTED);
+}
+
+void MockLinkSwarm::_handleSetMode(Vehicle_t& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_set_mode_t request;
+    mavlink_msg_set_mode_decode(&msg, &request);
+
+    vehicle.baseMode    = request.base_mode;
+    vehicle.customMode  = request.custom_mode;
+}
+
+void MockLinkSwarm::_sendCommandAck(Vehicle_t& vehicle, uint16_t command, uint8_t result)
+{
+    mavlink_message_t commandAck;
+    mavlink_msg_command_ack_pack_chan(vehicle.systemId,
+                                      MAV_COMP_ID_AUTOPILOT1,
+                                      mavlinkChannel(),
+                                      &commandAck,
+                                      command,
+                                      result,
+                                      0,    // progress
+                                      0,    // result_param2
+                                      0,    // target_system
+                                      0);   // target_component
+    _sendMessage(vehicle, commandAck);
+}
+
+void MockLinkSwarm::_sendAutopilotVersion(Vehicle_t& vehicle)
+{
+    mavlink_message_t msg;
+
+    uint8_t customVersion[8] = { };
+    uint32_t flightVersion = FIRMWARE_VERSION_TYPE_DEV;
+    if (_firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA) {
+        flightVersion |= 4 << (8*3);
+    } else {
+        flightVersion |= (1 << (8*3)) | (4 << (8*2)) | (1 << (8*1));
+    }
+
+    // No fence or rally support, so QGC skips those on initial connect
+    const uint64_t capabilities = MAV_PROTOCOL_CAPABILITY_MAVLINK2 | MAV_PROTOCOL_CAPABILITY_MISSION_INT;
+
+    mavlink_msg_autopilot_version_pack_chan(vehicle.systemId,
+                                            MAV_COMP_ID_AUTOPILOT1,
+                                            mavlinkChannel(),
+                                            &msg,
+                                            capabilities,
+                                            flightVersion,                   // flight_sw_version,
+                                            0,                               // middleware_sw_version,
+                                            0,                               // os_sw_version,
+                                            0,                               // board_version,
+                                            (uint8_t *)&customVersion,       // flight_custom_version,
+                                            (uint8_t *)&customVersion,       // middleware_custom_version,
+                                            (uint8_t *)&customVersion,       // os_custom_version,
+                                            0,                               // vendor_id
+                                            0,                               // product_id
+                                            vehicle.systemId,                // uid
+                                            0);                              // uid2
+    _sendMessage(vehicle, msg);
+}
+
+void MockLinkSwarm::_sendProtocolVersion(Vehicle_t& vehicle)
+{
+    uint8_t             nullHash[8] = { 0 };
+    mavlink_message_t   msg;
+
+    mavlink_msg_protocol_version_pack_chan(vehicle.systemId,
+                                           MAV_COMP_ID_AUTOPILOT1,
+                                           mavlinkChannel(),
+                                           &msg,
+                                           200,
+                                           100,
+                                           200,
+                                           nullHash,
+                                           nullHash);
+    _sendMessage(vehicle, msg);
+}
+
+void MockLinkSwarm::_sendParamValue(Vehicle_t& vehicle, int componentId, const QString& paramName, int paramIndex)
+{
+    // Read through const accessors only, a non-const lookup would detach the vehicle from the shared set
+    const MAV_PARAM_TYPE    paramType   = _paramTypes.value(componentId).value(paramName);
+    const QVariant          paramValue  = vehicle.params.value(componentId).value(paramName);
+
+    char paramId[MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN + 1] = { };
+    strncpy(paramId, paramName.toLocal8Bit().constData(), MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN);
+
+    mavlink_message_t msg;
+    mavlink_msg_param_value_pack_chan(vehicle.systemId,
+                                      static_cast<uint8_t>(componentId),
+                                      mavlinkChannel(),
+                                      &msg,
+                                      paramId,
+                                      MockLink::floatUnionForParamValue(_firmwareType, paramType, paramValue),
+                                      paramType,
+                                      static_cast<uint16_t>(_paramNames.value(componentId).count()),
+                                      static_cast<uint16_t>(paramIndex));
+    _sendMessage(vehicle, msg);
+}
+
+void MockLinkSwarm::_paramRequestListWorker(Vehicle_t& vehicle)
+{
+    for (int i = 0; i < paramsPerTick && vehicle.paramListComponentIndex != -1; i++) {
+        const int           componentId = _paramComponentIds[vehicle.paramListComponentIndex];
+        const QStringList&  names       = _paramNames[componentId];
+
+        _sendParamValue(vehicle, componentId, names[vehicle.paramListParamIndex], vehicle.paramListParamIndex);
+
+        if (++vehicle.paramListParamIndex >= names.count()) {
+            vehicle.paramListParamIndex = 0;
+            if (++vehicle.paramListComponentIndex >= _paramComponentIds.count()) {
+                vehicle.paramListComponentIndex = -1;
+            }
+        }
+    }
+}
+
+void MockLinkSwarm::_handleParamRequestRead(Vehicle_t& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_param_request_read_t request;
+    mavlink_msg_param_request_read_decode(&msg, &request);
+
+    const QString paramName(QString::fromLocal8Bit(request.param_id, static_cast<int>(strnlen(request.param_id, MAVLINK_MSG_PARAM_REQUEST_READ_FIELD_PARAM_ID_LEN))));
+
+    if (request.target_component == MAV_COMP_ID_ALL && paramName == "_HASH_CHECK") {
+        mavlink_param_union_t valueUnion;
+        valueUnion.type         = MAV_PARAM_TYPE_UINT32;
+        valueUnion.param_uint32 = 0;
+
+        mavlink_message_t responseMsg;
+        mavlink_msg_param_value_pack_chan(vehicle.systemId,
+                                          request.target_component,
+                                          mavlinkChannel(),
+                                          &responseMsg,
+                                          request.param_id,
+                                          valueUnion.param_float,
+                                          MAV_PARAM_TYPE_UINT32,
+                                          0,
+                                          static_cast<uint16_t>(-1));
+        _sendMessage(vehicle, responseMsg);
+        return;
+    }
+
+    const int componentId = request.target_component;
+    if (!_paramNames.contains(componentId)) {
+        return;
+    }
+
+    const QStringList& names = _paramNames[componentId];
+    int paramIndex = request.param_index;
+    if (paramIndex == -1) {
+        paramIndex = names.indexOf(paramName);
+    }
+    if (paramIndex < 0 || paramIndex >= names.count()) {
+        qCDebug(MockLinkSwarmLog) << "Unknown param" << vehicle.systemId << componentId << paramName << request.param_index;
+        return;
+    }
+
+    _sendParamValue(vehicle, componentId, names[paramIndex], paramIndex);
+}
+
+void MockLinkSwarm::_handleParamSet(Vehicle_t& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_param_set_t request;
+    mavlink_msg_param_set_decode(&msg, &request);
+
+    const int       componentId = request.target_component;
+    const QString   paramName(QString::fromLocal8Bit(request.param_id, static_cast<int>(strnlen(request.param_id, MAVLINK_MSG_PARAM_SET_FIELD_PARAM_ID_LEN))));
+
+    const int paramIndex = _paramNames.value(componentId).indexOf(paramName);
+    if (paramIndex == -1) {
+        qCDebug(MockLinkSwarmLog) << "Unknown param" << vehicle.systemId << componentId << paramName;
+        return;
+    }
+
+    // First write gives this vehicle its own copy of the component's parameters
+    vehicle.params[componentId][paramName] = MockLink::paramValueForFloatUnion(_paramTypes.value(componentId).value(paramName), request.param_value);
+
+    _sendParamValue(vehicle, componentId, paramName, paramIndex);
+}
+
+void MockLinkSwarm::_handleMissionRequestList(Vehicle_t& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_mission_request_list_t request;
+    mavlink_msg_mission_request_list_decode(&msg, &request);
+
+    const int count = request.mission_type == MAV_MISSION_TYPE_MISSION ? vehicle.missionItems.count() : 0;
+
+    mavlink_message_t responseMsg;
+    mavlink_msg_mission_count_pack_chan(vehicle.systemId,
+                                        MAV_COMP_ID_AUTOPILOT1,
+                                        mavlinkChannel(),
+                                        &responseMsg,
+                                        msg.sysid,
+                                        msg.compid,
+                                        static_cast<uint16_t>(count),
+                                        request.mission_type);
+    _sendMessage(vehicle, responseMsg);
+}
+
+void MockLinkSwarm::_handleMissionRequestInt(Vehicle_t& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_mission_request_int_t request;
+    mavlink_msg_mission_request_int_decode(&msg, &request);
+
+    if (request.mission_type != MAV_MISSION_TYPE_MISSION || request.seq >= vehicle.missionItems.count()) {
+        _sendMissionAck(vehicle, msg, request.mission_type, MAV_MISSION_INVALID_SEQUENCE);
+        return;
+    }
+
+    mavlink_mission_item_int_t item = vehicle.missionItems[request.seq];
+    item.target_system      = msg.sysid;
+    item.target_component   = msg.compid;
+
+    mavlink_message_t responseMsg;
+    mavlink_msg_mission_item_int_encode_chan(vehicle.systemId,
+                                             MAV_COMP_ID_AUTOPILOT1,
+                                             mavlinkChannel(),
+                                             &responseMsg,
+                                             &item);
+    _sendMessage(vehicle, responseMsg);
+}
+
+void MockLinkSwarm::_handleMissionCount(Vehicle_t& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_mission_count_t request;
+    mavlink_msg_mission_count_decode(&msg, &request);
+
+    if (request.mission_type != MAV_MISSION_TYPE_MISSION) {
+        // Fence and rally aren't advertised, accept and drop anything which comes anyway
+        _sendMissionAck(vehicle, msg, request.mission_type, MAV_MISSION_ACCEPTED);
+        return;
+    }
+
+    vehicle.missionItems.clear();
+    if (request.count == 0) {
+        vehicle.missionUploadCount = -1;
+        _sendMissionAck(vehicle, msg, request.mission_type, MAV_MISSION_ACCEPTED);
+        return;
+    }
+
+    vehicle.missionUploadCount = request.count;
+    vehicle.missionItems.reserve(request.count);
+    _sendMissionRequest(vehicle, msg.sysid, msg.compid, 0);
+}
+
+void MockLinkSwarm::_handleMissionItemInt(Vehicle_t& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_mission_item_int_t item;
+    mavlink_msg_mission_item_int_decode(&msg, &item);
+
+    if (vehicle.missionUploadCount == -1 || item.mission_type != MAV_MISSION_TYPE_MISSION) {
+        return;
+    }
+
+    // Items which don't match the next sequence number are resends after a lost request, ask again for the one we need
+    if (item.seq == vehicle.missionItems.count()) {
+        vehicle.missionItems.append(item);
+    }
+
+    if (vehicle.missionItems.count() == vehicle.missionUploadCount) {
+        vehicle.missionUploadCount = -1;
+        _sendMissionAck(vehicle, msg, MAV_MISSION_TYPE_MISSION, MAV_MISSION_ACCEPTED);
+    } else {
+        _sendMissionRequest(vehicle, msg.sysid, msg.compid, static_cast<uint16_t>(vehicle.missionItems.count()));
+    }
+}
+
+void MockLinkSwarm::_handleMissionClearAll(Vehicle_t& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_mission_clear_all_t request;
+    mavlink_msg_mission_clear_all_decode(&msg, &request);
+
+    if (request.mission_type == MAV_MISSION_TYPE_MISSION || request.mission_type == MAV_MISSION_TYPE_ALL) {
+        vehicle.missionItems.clear();
+        vehicle.missionUploadCount = -1;
+    }
+    _sendMissionAck(vehicle, msg, request.mission_type, MAV_MISSION_ACCEPTED);
+}
+
+void MockLinkSwarm::_sendMissionAck(Vehicle_t& vehicle, const mavlink_message_t& request, uint8_t missionType, uint8_t result)
+{
+    mavlink_message_t msg;
+    mavlink_msg_mission_ack_pack_chan(vehicle.systemId,
+                                      MAV_COMP_ID_AUTOPILOT1,
+                                      mavlinkChannel(),
+                                      &msg,
+                                      request.sysid,
+                                      request.compid,
+                                      result,
+                                      missionType);
+    _sendMessage(vehicle, msg);
+}
+
+void MockLinkSwarm::_sendMissionRequest(Vehicle_t& vehicle, uint8_t targetSystem, uint8_t targetComponent, uint16_t seq)
+{
+    mavlink_message_t msg;
+    mavlink_msg_mission_request_int_pack_chan(vehicle.systemId,
+                                              MAV_COMP_ID_AUTOPILOT1,
+                                              mavlinkChannel(),
+                                              &msg,
+                                              targetSystem,
+                                              targetComponent,
+                                              seq,
+                                              MAV_MISSION_TYPE_MISSION);
+    _sendMessage(vehicle, msg);
+}
+
+void MockLinkSwarm::_sendStream(Vehicle_t& vehicle, uint32_t msgId)
+{
+    const uint32_t  timeBootMSecs       = static_cast<uint32_t>(_runningTime.elapsed());
+    const int8_t    batteryRemaining    = static_cast<int8_t>(qMax(10, 100 - static_cast<int>(timeBootMSecs / 30000)));
+    const double    heading             = fmod(qRadiansToDegrees(vehicle.orbitAngle) + 90.0, 360.0);
+    const int32_t   latitude            = static_cast<int32_t>(vehicle.latitude * 1E7);
+    const int32_t   longitude           = static_cast<int32_t>(vehicle.longitude * 1E7);
+    const int32_t   altitudeMM          = static_cast<int32_t>(vehicle.altitude * 1000);
+
+    mavlink_message_t msg;
+
+    switch (msgId) {
+    case MAVLINK_MSG_ID_HEARTBEAT:
+        mavlink_msg_heartbeat_pack_chan(vehicle.systemId,
+                                        MAV_COMP_ID_AUTOPILOT1,
+                                        mavlinkChannel(),
+                                        &msg,
+                                        _vehicleType,
+                                        _firmwareType,
+                                        vehicle.baseMode,
+                                        vehicle.customMode,
+                                        (vehicle.baseMode & MAV_MODE_FLAG_SAFETY_ARMED) ? MAV_STATE_ACTIVE : MAV_STATE_STANDBY);
+        break;
+    case MAVLINK_MSG_ID_SYS_STATUS:
+        mavlink_msg_sys_status_pack_chan(vehicle.systemId,
+                                         MAV_COMP_ID_AUTOPILOT1,
+                                         mavlinkChannel(),
+                                         &msg,
+                                         0, 0, 0,       // onboard_control_sensors_present/enabled/health
+                                         250,           // load
+                                         4200 * 4,      // voltage_battery
+                                         8000,          // current_battery
+                                         batteryRemaining,
+                                         0, 0, 0, 0, 0, 0);
+        break;
+    case MAVLINK_MSG_ID_BATTERY_STATUS:
+    {
+        uint16_t voltages[10];
+        uint16_t voltagesExt[4] = { };
+        for (int i = 0; i < 10; i++) {
+            voltages[i] = i < 4 ? 4200 : UINT16_MAX;
+        }
+        mavlink_msg_battery_status_pack_chan(vehicle.systemId,
+                                             MAV_COMP_ID_AUTOPILOT1,
+                                             mavlinkChannel(),
+                                             &msg,
+                                             0,                         // battery id
+                                             MAV_BATTERY_FUNCTION_ALL,
+                                             MAV_BATTERY_TYPE_LIPO,
+                                             INT16_MAX,                 // temperature unknown
+                                             voltages,
+                                             800,                       // current cA
+                                             -1,                        // current consumed unknown
+                                             -1,                        // energy consumed unknown
+                                             batteryRemaining,
+                                             0,                         // time remaining unknown
+                                             MAV_BATTERY_CHARGE_STATE_OK,
+                                             voltagesExt,
+                                             0,                         // MAV_BATTERY_MODE
+                                             0);                        // MAV_BATTERY_FAULT
+    }
+        break;
+    case MAVLINK_MSG_ID_GPS_RAW_INT:
+        mavlink_msg_gps_raw_int_pack_chan(vehicle.systemId,
+                                          MAV_COMP_ID_AUTOPILOT1,
+                                          mavlinkChannel(),
+                                          &msg,
+                                          static_cast<uint64_t>(timeBootMSecs) * 1000,
+                                          GPS_FIX_TYPE_3D_FIX,
+                                          latitude,
+                                          longitude,
+                                          altitudeMM,
+                                          300,                          // eph
+                                          300,                          // epv
+                                          static_cast<uint16_t>(_orbitSpeedMetersPerSec * 100),
+                                          static_cast<uint16_t>(heading * 100),
+                                          12,                           // satellites visible
+                                          0, 0, 0, 0, 0, 0);            // alt_ellipsoid, h_acc, v_acc, vel_acc, hdg_acc, yaw
+        break;
+    case MAVLINK_MSG_ID_GLOBAL_POSITION_INT:
+        mavlink_msg_global_position_int_pack_chan(vehicle.systemId,
+                                                  MAV_COMP_ID_AUTOPILOT1,
+                                                  mavlinkChannel(),
+                                                  &msg,
+                                                  timeBootMSecs,
+                                                  latitude,
+                                                  longitude,
+                                                  altitudeMM,
+                                                  0,                    // relative_alt
+                                                  static_cast<int16_t>(-_orbitSpeedMetersPerSec * 100 * qSin(vehicle.orbitAngle)),
+                                                  static_cast<int16_t>(_orbitSpeedMetersPerSec * 100 * qCos(vehicle.orbitAngle)),
+                                                  0,                    // vz
+                                                  static_cast<uint16_t>(heading * 100));
+        break;
+    case MAVLINK_MSG_ID_ATTITUDE:
+        mavlink_msg_attitude_pack_chan(vehicle.systemId,
+                                       MAV_COMP_ID_AUTOPILOT1,
+                                       mavlinkChannel(),
+                                       &msg,
+                                       timeBootMSecs,
+                                       0.1f,                            // roll into the orbit
+                                       0,                               // pitch
+                                       static_cast<float>(qDegreesToRadians(heading > 180 ? heading - 360 : heading)),
+                                       0, 0,
+                                       static_cast<float>(_orbitSpeedMetersPerSec / _orbitRadiusMeters));
+        break;
+    case MAVLINK_MSG_ID_VFR_HUD:
+        mavlink_msg_vfr_hud_pack_chan(vehicle.systemId,
+                                      MAV_COMP_ID_AUTOPILOT1,
+                                      mavlinkChannel(),
+                                      &msg,
+                                      static_cast<float>(_orbitSpeedMetersPerSec),
+                                      static_cast<float>(_orbitSpeedMetersPerSec),
+                                      static_cast<int16_t>(heading),
+                                      50,                               // throttle
+                                      static_cast<float>(vehicle.altitude),
+                                      0);                               // climb
+        break;
+    default:
+        return;
+    }
+
+    _sendMessage(vehicle, msg);
+}
+
+void MockLinkSwarm::_sendMessage(Vehicle_t& vehicle, mavlink_message_t& msg)
+{
+    const mavlink_msg_entry_t* entry = mavlink_get_msg_entry(msg.msgid);
+    if (!entry) {
+        return;
+    }
+
+    // The link channel has a single sequence counter, but QGC tracks sequence gaps per system id.
+    // Re-finalize from the vehicle's own status so loss statistics come out right for every vehicle.
+    mavlink_finalize_message_buffer(&msg, msg.sysid, msg.compid, &vehicle.txStatus, entry->min_msg_len, entry->max_msg_len, entry->crc_extra);
+
+    if (_lossPercent > 0 && static_cast<int>(_random.bounded(100)) < _lossPercent) {
+        _counters.messagesDropped++;
+        return;
+    }
+
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    const int cBuffer = mavlink_msg_to_send_buffer(buffer, &msg);
+
+    _outgoingBytes.append(reinterpret_cast<const char*>(buffer), cBuffer);
+    _counters.messagesSent++;
+    _counters.bytesSent += static_cast<quint64>(cBuffer);
+}
+
+void MockLinkSwarm::_flushMessages(void)
+{
+    // One signal per tick for the whole swarm rather than one per message
+    if (!_outgoingBytes.isEmpty()) {
+        emit bytesReceived(this, _outgoingBytes);
+        _outgoingBytes.clear();
+    }
+}
+
+MockLinkSwarm* MockLinkSwarm::startSwarm(int vehicleCount, MAV_AUTOPILOT firmwareType, int lossPercent)
+{
+    LinkManager*        linkMgr     = qgcApp()->toolbox()->linkManager();
+    MockConfiguration*  mockConfig  = new MockConfiguration(QStringLiteral("MockLink Swarm"));
+
+    mockConfig->setFirmwareType(firmwareType);
+    mockConfig->setVehicleType(MAV_TYPE_QUADROTOR);
+    mockConfig->setSwarmCount(vehicleCount);
+    mockConfig->setSwarmLossPercent(lossPercent);
+    mockConfig->setDynamic(true);
+
+    SharedLinkConfigurationPtr config = linkMgr->addConfiguration(mockConfig);
+
+    if (linkMgr->createConnectedLink(config)) {
+        return qobject_cast<MockLinkSwarm*>(config->link());
+    } else {
+        return nullptr;
+    }
+}
@@ -0,0 +1,169 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QRandomGenerator>
+#include <QVector>
+
+#include "MockLink.h"
+
+Q_DECLARE_LOGGING_CATEGORY(MockLinkSwarmLog)
+
+/// Simulates a swarm of vehicles on a single link, for load testing QGC with many vehicles.
+///
+/// A MockLink runs a thread and three timers per vehicle, each with its own copy of the parameter set.
+/// The swarm instead drives all of its vehicles from one thread and one timer. Vehicles are plain structs
+/// which start out sharing a single parameter set; a vehicle only gets its own copy of a component's
+/// parameters once one of them is written.
+///
+/// Only what is needed to bring vehicles up in QGC is simulated: heartbeat, the initial connect requests,
+/// parameters and the mission item protocol. Telemetry is sent at the per message rates from the
+/// configuration and outgoing messages are dropped at the configured loss rate. Aggregate throughput is
+/// sampled every second and logged to MockLinkSwarmLog, so the vehicle count scaling can be measured
+/// without a UI.
+class MockLinkSwarm : public LinkInterface
+{
+    Q_OBJECT
+
+public:
+    MockLinkSwarm(SharedLinkConfigurationPtr& config);
+    virtual ~MockLinkSwarm();
+
+    typedef struct {
+        quint64 messagesSent;
+        quint64 bytesSent;
+        quint64 messagesDropped;
+        quint64 messagesReceived;
+        quint64 bytesReceived;
+    } Throughput_t;
+
+    int             vehicleCount        (void) const { return _vehicles.count(); }
+    int             firstVehicleId      (void) const { return _firstVehicleId; }
+
+    /// Totals since the link connected up to the last sample, for all vehicles
+    Throughput_t    throughputTotals    (void);
+
+    /// Totals over the last sample interval, for all vehicles
+    Throughput_t    throughputPerSecond (void);
+
+    // Overrides from LinkInterface
+    bool isConnected(void) const override { return _connected; }
+    void disconnect (void) override;
+
+    /// Starts a swarm of PX4 or ArduPilot multi-rotors
+    static MockLinkSwarm* startSwarm(int vehicleCount, MAV_AUTOPILOT firmwareType = MAV_AUTOPILOT_PX4, int lossPercent = 0);
+
+    static const int maxVehicleCount        = 127;  ///< Swarm system ids are 1 through vehicle count, clear of single vehicle MockLinks
+    static const int tickMSecs              = 10;
+    static const int paramsPerTick          = 5;    ///< Per vehicle while sending the parameter list
+    static const int throughputSampleMSecs  = 1000;
+
+signals:
+    void writeBytesQueuedSignal (const QByteArray bytes);
+    void throughputSampled      (void);
+
+private slots:
+    // LinkInterface overrides
+    void _writeBytes(const QByteArray bytes) final;
+
+    void _writeBytesQueued  (const QByteArray bytes);
+    void _runTick           (void);
+
+private:
+    typedef struct {
+        uint32_t    msgId;
+        int         intervalMSecs;
+    } Stream_t;
+
+    typedef struct {
+        uint8_t                             systemId;
+        mavlink_status_t                    txStatus;               ///< Per vehicle outgoing sequence numbers
+        uint8_t                             baseMode;
+        uint32_t                            customMode;
+        double                              homeLatitude;
+        double                              homeLongitude;
+        double                              latitude;
+        double                              longitude;
+        double                              altitude;
+        double                              orbitAngle;             ///< Radians around home
+        MockLink::ParamValueMap_t           params;                 ///< Shared with the swarm until written
+        int                                 paramListComponentIndex;///< -1 for no PARAM_REQUEST_LIST in progress
+        int                                 paramListParamIndex;
+        QVector<qint64>                     nextStreamMSecs;        ///< Parallel to _streams
+        QVector<mavlink_mission_item_int_t> missionItems;
+        int                                 missionUploadCount;     ///< -1 for no upload in progress
+    } Vehicle_t;
+
+    // LinkInterface overrides
+    bool _connect                   (void) override;
+    bool _allocateMavlinkChannel    () override;
+    void _freeMavlinkChannel        () override;
+
+    // QThread override
+    void run(void) final;
+
+    Vehicle_t*  _vehicleForMessage          (const mavlink_message_t& msg);
+    void        _handleIncomingMavlinkMsg   (const mavlink_message_t& msg);
+    void        _handleCommandLong          (Vehicle_t& vehicle, const mavlink_message_t& msg);
+    void        _handleCommandInt           (Vehicle_t& vehicle, const mavlink_message_t& msg);
+    void        _handleSetMode              (Vehicle_t& vehicle, const mavlink_message_t& msg);
+    void        _handleParamRequestRead     (Vehicle_t& vehicle, const mavlink_message_t& msg);
+    void        _handleParamSet             (Vehicle_t& vehicle, const mavlink_message_t& msg);
+    void        _handleMissionRequestList   (Vehicle_t& vehicle, const mavlink_message_t& msg);
+    void        _handleMissionRequestInt    (Vehicle_t& vehicle, const mavlink_message_t& msg);
+    void        _handleMissionCount         (Vehicle_t& vehicle, const mavlink_message_t& msg);
+    void        _handleMissionItemInt       (Vehicle_t& vehicle, const mavlink_message_t& msg);
+    void        _handleMissionClearAll      (Vehicle_t& vehicle, const mavlink_message_t& msg);
+    void        _sendCommandAck             (Vehicle_t& vehicle, uint16_t command, uint8_t result);
+    void        _sendMissionAck             (Vehicle_t& vehicle, const mavlink_message_t& request, uint8_t missionType, uint8_t result);
+    void        _sendMissionRequest         (Vehicle_t& vehicle, uint8_t targetSystem, uint8_t targetComponent, uint16_t seq);
+    void        _sendAutopilotVersion       (Vehicle_t& vehicle);
+    void        _sendProtocolVersion        (Vehicle_t& vehicle);
+    void        _sendParamValue             (Vehicle_t& vehicle, int componentId, const QString& paramName, int paramIndex);
+    void        _paramRequestListWorker     (Vehicle_t& vehicle);
+    void        _sendStream                 (Vehicle_t& vehicle, uint32_t msgId);
+    void        _moveVehicle                (Vehicle_t& vehicle, double elapsedSecs);
+    void        _sendMessage                (Vehicle_t& vehicle, mavlink_message_t& msg);
+    void        _flushMessages              (void);
+    void        _sampleThroughput           (void);
+
+    uint8_t                         _mavlinkAuxChannel      = std::numeric_limits<uint8_t>::max();
+    bool                            _connected              = false;
+
+    MAV_AUTOPILOT                   _firmwareType;
+    MAV_TYPE                        _vehicleType;
+    int                             _lossPercent;
+    int                             _firstVehicleId         = 1;
+    QVector<Vehicle_t>              _vehicles;
+    QVector<Stream_t>               _streams;
+
+    MockLink::ParamValueMap_t       _params;                ///< Initial values, shared by all vehicles
+    MockLink::ParamTypeMap_t        _paramTypes;
+    QMap<int, QStringList>          _paramNames;            ///< Component id -> names in param index order
+    QList<int>                      _paramComponentIds;
+
+    QElapsedTimer                   _runningTime;
+    qint64                          _lastTickMSecs          = 0;
+    QRandomGenerator                _random;
+    QByteArray                      _outgoingBytes;         ///< Sent to QGC as one chunk at the end of each tick
+
+    Throughput_t                    _counters               = {};   ///< Only touched by the link thread
+    Throughput_t                    _lastSampleCounters     = {};
+    qint64                          _lastSampleMSecs        = 0;
+    QMutex                          _throughputMutex;
+    Throughput_t                    _sampledTotals          = {};   ///< Guarded by _throughputMutex
+    Throughput_t                    _perSecond              = {};   ///< Guarded by _throughputMutex
+
+    static double                   _orbitRadiusMeters;
+    static double                   _orbitSpeedMetersPerSec;
+};
@@ -310,3 +310,64 @@ QString MavlinkFTP::errorCodeToString(ErrorCode_t errorCode)
     return "Unknown Error";
 }
 
+
+QString MavlinkFTP::missionFilePath(MAV_MISSION_TYPE missionType)
+{
+    switch (missionType) {
+    case MAV_MISSION_TYPE_MISSION:
+        return QStringLiteral("@MISSION/mission.dat");
+    case MAV_MISSION_TYPE_FENCE:
+        return QStringLiteral("@MISSION/fence.dat");
+    case MAV_MISSION_TYPE_RALLY:
+        return QStringLiteral("@MISSION/rally.dat");
+    default:
+        return QString();
+    }
+}
+
+QByteArray MavlinkFTP::packMissionFile(MAV_MISSION_TYPE missionType, const QList<mavlink_mission_item_int_t>& items)
+{
+    MissionFileHeader header;
+
+    header.magic    = missionFileMagic;
+    header.dataType = missionType;
+    header.options  = 0;
+    header.start    = 0;
+    header.numItems = static_cast<uint16_t>(items.count());
+
+    QByteArray bytes;
+    bytes.reserve(static_cast<int>(sizeof(header) + (items.count() * sizeof(mavlink_mission_item_int_t))));
+    bytes.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const mavlink_mission_item_int_t& item: items) {
+        bytes.append(reinterpret_cast<const char*>(&item), sizeof(item));
+    }
+
+    return bytes;
+}
+
+bool MavlinkFTP::unpackMissionFile(const QByteArray& bytes, MAV_MISSION_TYPE missionType, QList<mavlink_mission_item_int_t>& items)
+{
+    items.clear();
+
+    MissionFileHeader header;
+    if (bytes.size() < static_cast<int>(sizeof(header))) {
+        return false;
+    }
+    memcpy(&header, bytes.constData(), sizeof(header));
+    if (header.magic != missionFileMagic || header.dataType != missionType || header.start != 0) {
+        return false;
+    }
+    if (bytes.size() != static_cast<int>(sizeof(header) + (header.numItems * sizeof(mavlink_mission_item_int_t)))) {
+        return false;
+    }
+
+    items.reserve(header.numItems);
+    const char* itemBytes = bytes.constData() + sizeof(header);
+    for (int i=0; i<header.numItems; i++) {
+        mavlink_mission_item_int_t item;
+        memcpy(&item, itemBytes + (i * sizeof(item)), sizeof(item));
+        items.append(item);
+    }
+
+    return true;
+}
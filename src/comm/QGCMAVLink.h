@@ -192,4 +192,25 @@ public:
 
     static QString opCodeToString   (OpCode_t opCode);
     static QString errorCodeToString(ErrorCode_t errorCode);
+
+    /// Mission, fence and rally points as whole files, in the layout ArduPilot serves from @MISSION/mission.dat,
+    /// @MISSION/fence.dat and @MISSION/rally.dat: a MissionFileHeader followed by num_items packed
+    /// mavlink_mission_item_int_t structures.
+    PACKED_STRUCT(
+            typedef struct MissionFileHeader {
+                uint16_t    magic;          ///< missionFileMagic
+                uint16_t    dataType;       ///< MAV_MISSION_TYPE
+                uint16_t    options;
+                uint16_t    start;          ///< Sequence number of the first item in the file
+                uint16_t    numItems;
+            }) MissionFileHeader;
+
+    static const uint16_t missionFileMagic = 0x763d;
+
+    /// @return Path of the file for the plan type, empty if there is none
+    static QString      missionFilePath     (MAV_MISSION_TYPE missionType);
+    static QByteArray   packMissionFile     (MAV_MISSION_TYPE missionType, const QList<mavlink_mission_item_int_t>& items);
+
+    /// @return false: bytes are not a complete mission file of the specified type
+    static bool         unpackMissionFile   (const QByteArray& bytes, MAV_MISSION_TYPE missionType, QList<mavlink_mission_item_int_t>& items);
 };
@@ -0,0 +1,110 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "CRC32Test.h"
+#include "QGC.h"
+
+#include <QRandomGenerator>
+
+QByteArray CRC32Test::_randomBuffer(int size)
+{
+    QRandomGenerator    generator(1234);
+    QByteArray          buffer(size, 0);
+
+    for (int i = 0; i < size; i++) {
+        buffer[i] = static_cast<char>(generator.bounded(256));
+    }
+    return buffer;
+}
+
+void CRC32Test::_knownValues(void)
+{
+    // QGC::crc32 has no pre/post inversion, so the usual check value is obtained by inverting around it
+    const QByteArray    check("123456789");
+    const quint8*       data = reinterpret_cast<const quint8*>(check.constData());
+
+    QCOMPARE(~QGC::crc32(data, static_cast<unsigned>(check.length()), 0xFFFFFFFF), 0xCBF43926u);
+    QCOMPARE(~QGC::crc32SliceBy8(data, static_cast<unsigned>(check.length()), 0xFFFFFFFF), 0xCBF43926u);
+    QCOMPARE(~QGC::crc32Reference(data, static_cast<unsigned>(check.length()), 0xFFFFFFFF), 0xCBF43926u);
+    QCOMPARE(QGC::crc32(data, 0, 0x12345678), 0x12345678u);
+}
+
+void CRC32Test::_crossCheck(void)
+{
+    qDebug() << "crc32 implementation" << QGC::crc32ImplementationName();
+
+    const QByteArray    buffer  = _randomBuffer(64 * 1024 + 64);
+    const quint8*       base    = reinterpret_cast<const quint8*>(buffer.constData());
+    QRandomGenerator    generator(5678);
+
+    // Every length around the block boundaries of each implementation, at every alignment
+    for (unsigned offset = 0; offset < 16; offset++) {
+        for (unsigned len = 0; len <= 300; len++) {
+            const quint32 state     = generator.generate();
+            const quint32 expected  = QGC::crc32Reference(base + offset, len, state);
+            QCOMPARE(QGC::crc32SliceBy8(base + offset, len, state), expected);
+            QCOMPARE(QGC::crc32(base + offset, len, state), expected);
+        }
+    }
+
+    // Random large buffers
+    for (int i = 0; i < 200; i++) {
+        const unsigned offset   = generator.bounded(64);
+        const unsigned len      = generator.bounded(64 * 1024);
+        const quint32  state    = generator.generate();
+        const quint32  expected = QGC::crc32Reference(base + offset, len, state);
+        QCOMPARE(QGC::crc32SliceBy8(base + offset, len, state), expected);
+        QCOMPARE(QGC::crc32(base + offset, len, state), expected);
+    }
+
+    // Chained calls must match a single call over the whole buffer
+    const unsigned  len     = static_cast<unsigned>(buffer.length());
+    quint32         state   = 0;
+    for (unsigned pos = 0; pos < len; ) {
+        const unsigned chunk = qMin(len - pos, static_cast<unsigned>(generator.bounded(1, 1000)));
+        state = QGC::crc32(base + pos, chunk, state);
+        pos += chunk;
+    }
+    QCOMPARE(state, QGC::crc32Reference(base, len, 0));
+}
+
+void CRC32Test::_benchmark_data(void)
+{
+    QTest::addColumn<int>("implementation");
+
+    QTest::newRow("reference")  << 0;
+    QTest::newRow("sliceBy8")   << 1;
+    QTest::newRow("dispatched") << 2;
+}
+
+void CRC32Test::_benchmark(void)
+{
+    QFETCH(int, implementation);
+
+    // Roughly the size of a firmware image
+    const QByteArray    buffer  = _randomBuffer(1024 * 1024);
+    const quint8*       data    = reinterpret_cast<const quint8*>(buffer.constData());
+    const unsigned      len     = static_cast<unsigned>(buffer.length());
+    quint32             crc     = 0;
+
+    QBENCHMARK {
+        switch (implementation) {
+        case 0:
+            crc = QGC::crc32Reference(data, len, crc);
+            break;
+        case 1:
+            crc = QGC::crc32SliceBy8(data, len, crc);
+            break;
+        default:
+            crc = QGC::crc32(data, len, crc);
+            break;
+        }
+    }
+    Q_UNUSED(crc)
+}
@@ -0,0 +1,27 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Cross checks the QGC::crc32 implementations against the byte at a time reference
+class CRC32Test : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _knownValues              (void);
+    void _crossCheck               (void);
+    void _benchmark_data           (void);
+    void _benchmark                (void);
+
+private:
+    QByteArray _randomBuffer(int size);
+};
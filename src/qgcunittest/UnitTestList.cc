@@ -12,8 +12,11 @@
 // ones are enabled/disabled
 
 #include "ComponentInformationCacheTest.h"
+#include "CompInfoParamTest.h"
+#include "CRC32Test.h"
 #include "FactSystemTestGeneric.h"
 #include "FactSystemTestPX4.h"
+#include "FactValueTest.h"
 //#include "FileDialogTest.h"
 #include "GeoTest.h"
 //#include "MessageBoxTest.h"
@@ -42,6 +45,8 @@
 #include "QGCMapPolylineTest.h"
 #include "CorridorScanComplexItemTest.h"
 #include "TransectStyleComplexItemTest.h"
+#include "TerrainQueryTest.h"
+#include "TelemetrySidecarWriterTest.h"
 #include "CameraCalcTest.h"
 #include "FWLandingPatternTest.h"
 #include "RequestMessageTest.h"
@@ -50,10 +55,23 @@
 #include "VehicleLinkManagerTest.h"
 #include "LandingComplexItemTest.h"
 #include "InitialConnectTest.h"
+#include "MockLinkSwarmTest.h"
+#include "MAVLinkLogManagerTest.h"
+#include "UASMessageHandlerTest.h"
+#include "SiYi/SiYiTcpClientTest.h"
+#if !defined(NO_SERIAL_LINK) && defined(Q_OS_UNIX)
+#include "BootloaderTest.h"
+#endif
+#if defined(QGC_GST_STREAMING)
+#include "GstVideoReceiverTest.h"
+#endif
 
 UT_REGISTER_TEST(ComponentInformationCacheTest)
+UT_REGISTER_TEST(CompInfoParamTest)
+UT_REGISTER_TEST(CRC32Test)
 UT_REGISTER_TEST(FactSystemTestGeneric)
 UT_REGISTER_TEST(FactSystemTestPX4)
+UT_REGISTER_TEST(FactValueTest)
 //UT_REGISTER_TEST(FileDialogTest)
 UT_REGISTER_TEST(GeoTest)
 UT_REGISTER_TEST(VehicleLinkManagerTest)
@@ -63,6 +81,16 @@ UT_REGISTER_TEST(SendMavCommandWithHandlerTest)
 UT_REGISTER_TEST(RequestMessageTest)
 UT_REGISTER_TEST(FTPManagerTest)
 UT_REGISTER_TEST(InitialConnectTest)
+UT_REGISTER_TEST(MockLinkSwarmTest)
+UT_REGISTER_TEST(MAVLinkLogManagerTest)
+UT_REGISTER_TEST(UASMessageHandlerTest)
+UT_REGISTER_TEST(SiYiTcpClientTest)
+#if !defined(NO_SERIAL_LINK) && defined(Q_OS_UNIX)
+UT_REGISTER_TEST(BootloaderTest)
+#endif
+#if defined(QGC_GST_STREAMING)
+UT_REGISTER_TEST(GstVideoReceiverTest)
+#endif
 UT_REGISTER_TEST(MissionItemTest)
 UT_REGISTER_TEST(SimpleMissionItemTest)
 UT_REGISTER_TEST(MissionControllerTest)
@@ -82,6 +110,8 @@ UT_REGISTER_TEST(AudioOutputTest)
 UT_REGISTER_TEST(StructureScanComplexItemTest)
 UT_REGISTER_TEST(CorridorScanComplexItemTest)
 UT_REGISTER_TEST(TransectStyleComplexItemTest)
+UT_REGISTER_TEST(TerrainQueryTest)
+UT_REGISTER_TEST(TelemetrySidecarWriterTest)
 UT_REGISTER_TEST(QGCMapPolylineTest)
 UT_REGISTER_TEST(CameraCalcTest)
 UT_REGISTER_TEST(FWLandingPatternTest)
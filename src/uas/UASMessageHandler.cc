@@ -19,11 +19,47 @@
 #include "MultiVehicleManager.h"
 #include "Vehicle.h"
 
-UASMessage::UASMessage(int componentid, int severity, QString text)
+static QString _severityText(int severity)
 {
-    _compId   = componentid;
-    _severity = severity;
-    _text     = text;
+    switch (severity)
+    {
+    case MAV_SEVERITY_EMERGENCY:
+        return QObject::tr(" EMERGENCY:");
+    case MAV_SEVERITY_ALERT:
+        return QObject::tr(" ALERT:");
+    case MAV_SEVERITY_CRITICAL:
+        return QObject::tr(" Critical:");
+    case MAV_SEVERITY_ERROR:
+        return QObject::tr(" Error:");
+    case MAV_SEVERITY_WARNING:
+        return QObject::tr(" Warning:");
+    case MAV_SEVERITY_NOTICE:
+        return QObject::tr(" Notice:");
+    case MAV_SEVERITY_INFO:
+        return QObject::tr(" Info:");
+    case MAV_SEVERITY_DEBUG:
+        return QObject::tr(" Debug:");
+    default:
+        return QString();
+    }
+}
+
+UASMessage::UASMessage(int componentid, int severity, QString text, bool showCompId)
+    : _compId       (componentid)
+    , _severity     (severity)
+    , _text         (text)
+    , _timestamp    (QDateTime::currentDateTime())
+    , _repeatCount  (1)
+    , _showCompId   (showCompId)
+{
+
+}
+
+void UASMessage::_repeated()
+{
+    _repeatCount++;
+    _timestamp = QDateTime::currentDateTime();
+    _formatedText.clear();
 }
 
 bool UASMessage::severityIsError() const
@@ -39,11 +75,221 @@ bool UASMessage::severityIsError() const
     }
 }
 
+QString UASMessage::getFormatedText()
+{
+    if (!_formatedText.isEmpty()) {
+        return _formatedText;
+    }
+
+    // Color the output depending on the message severity. We have 3 distinct cases:
+    // 1: If we have an ERROR or worse, make it bigger, bolder, and highlight it red.
+    // 2: If we have a warning or notice, just make it bold and color it orange.
+    // 3: Otherwise color it the standard color, white.
+    QString style;
+    switch (_severity)
+    {
+    case MAV_SEVERITY_EMERGENCY:
+    case MAV_SEVERITY_ALERT:
+    case MAV_SEVERITY_CRITICAL:
+    case MAV_SEVERITY_ERROR:
+        style = QString("<#E>");
+        break;
+    case MAV_SEVERITY_NOTICE:
+    case MAV_SEVERITY_WARNING:
+        style = QString("<#I>");
+        break;
+    default:
+        style = QString("<#N>");
+        break;
+    }
+
+    // Finally preppend the properly-styled text with a timestamp.
+    QString dateString = _timestamp.toString("hh:mm:ss.zzz");
+    QString compString;
+    if (_showCompId) {
+        compString = QString(" COMP:%1").arg(_compId);
+    }
+    QString repeatString;
+    if (_repeatCount > 1) {
+        repeatString = QString(" x%1").arg(_repeatCount);
+    }
+    _formatedText = QString("<font style=\"%1\">[%2%3]%4 %5%6</font><br/>").arg(style).arg(dateString).arg(compString).arg(_severityText(_severity)).arg(_text).arg(repeatString);
+
+    return _formatedText;
+}
+
+UASMessageStore::UASMessageStore(int maxMessages)
+    : _maxMessages(qMax(1, maxMessages))
+{
+
+}
+
+UASMessageStore::~UASMessageStore()
+{
+    clear();
+}
+
+UASMessage* UASMessageStore::add(int compId, int severity, const QString& text, bool showCompId, bool* repeated)
+{
+    DedupKey_t  key((compId << 8) | (severity & 0xff), text);
+    UASMessage* message = _dedupIndex.value(key, nullptr);
+
+    if (repeated) {
+        *repeated = message != nullptr;
+    }
+    if (message) {
+        message->_repeated();
+        return message;
+    }
+
+    if (_messages.count() >= _maxMessages) {
+        _removeOldest();
+    }
+
+    message = new UASMessage(compId, severity, text, showCompId);
+    _messages.append(message);
+    _dedupIndex.insert(key, message);
+    _componentIndex[compId].append(message);
+    if (severity >= 0 && severity < 8) {
+        _severityIndex[severity].append(message);
+    }
+
+    return message;
+}
+
+UASMessage* UASMessageStore::find(int compId, int severity, const QString& text) const
+{
+    return _dedupIndex.value(DedupKey_t((compId << 8) | (severity & 0xff), text), nullptr);
+}
+
+void UASMessageStore::_removeOldest()
+{
+    // Messages are appended to every index in the same order, so the oldest message is first in each of them
+    UASMessage* message = _messages.takeFirst();
+
+    _dedupIndex.remove(DedupKey_t((message->_compId << 8) | (message->_severity & 0xff), message->_text));
+
+    QList<UASMessage*>& componentMessages = _componentIndex[message->_compId];
+    componentMessages.removeFirst();
+    if (componentMessages.isEmpty()) {
+        _componentIndex.remove(message->_compId);
+    }
+
+    if (message->_severity >= 0 && message->_severity < 8) {
+        _severityIndex[message->_severity].removeFirst();
+    }
+
+    delete message;
+}
+
+void UASMessageStore::clear()
+{
+    qDeleteAll(_messages);
+    _messages.clear();
+    _dedupIndex.clear();
+    _componentIndex.clear();
+    for (QList<UASMessage*>& severityMessages: _severityIndex) {
+        severityMessages.clear();
+    }
+}
+
+QList<UASMessage*> UASMessageStore::messagesForSeverity(int severity) const
+{
+    if (severity < 0 || severity >= 8) {
+        return QList<UASMessage*>();
+    }
+    return _severityIndex[severity];
+}
+
+UASMessageModel::UASMessageModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+
+}
+
+int UASMessageModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid() || !_store) {
+        return 0;
+    }
+    return _store->count();
+}
+
+QVariant UASMessageModel::data(const QModelIndex& index, int role) const
+{
+    if (!_store || index.row() < 0 || index.row() >= _store->count()) {
+        return QVariant();
+    }
+
+    UASMessage* message = _store->messages()[index.row()];
+    switch (role) {
+    case Qt::DisplayRole:
+    case FormattedTextRole:
+        return message->getFormatedText();
+    case SeverityRole:
+        return message->getSeverity();
+    case RepeatCountRole:
+        return message->getRepeatCount();
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> UASMessageModel::roleNames(void) const
+{
+    QHash<int, QByteArray> roles;
+
+    roles[FormattedTextRole]    = "formattedText";
+    roles[SeverityRole]         = "severity";
+    roles[RepeatCountRole]      = "repeatCount";
+
+    return roles;
+}
+
+void UASMessageModel::_setStore(UASMessageStore* store)
+{
+    if (store != _store) {
+        beginResetModel();
+        _store = store;
+        endResetModel();
+    }
+}
+
+UASMessage* UASMessageModel::_add(int compId, int severity, const QString& text, bool showCompId, bool* repeated)
+{
+    if (_store->find(compId, severity, text)) {
+        UASMessage* message = _store->add(compId, severity, text, showCompId, repeated);
+        // Repeats are usually of recent messages, so search from the newest end
+        QModelIndex changed = index(_store->messages().lastIndexOf(message));
+        emit dataChanged(changed, changed, { FormattedTextRole, RepeatCountRole });
+        return message;
+    }
+
+    if (_store->count() >= _store->maxMessages()) {
+        beginRemoveRows(QModelIndex(), 0, 0);
+        _store->_removeOldest();
+        endRemoveRows();
+    }
+
+    int row = _store->count();
+    beginInsertRows(QModelIndex(), row, row);
+    UASMessage* message = _store->add(compId, severity, text, showCompId, repeated);
+    endInsertRows();
+
+    return message;
+}
+
+void UASMessageModel::_clear(void)
+{
+    beginResetModel();
+    _store->clear();
+    endResetModel();
+}
+
 UASMessageHandler::UASMessageHandler(QGCApplication* app, QGCToolbox* toolbox)
     : QGCTool(app, toolbox)
     , _activeVehicle(nullptr)
-    , _activeComponent(-1)
-    , _multiComp(false)
+    , _messageModel(new UASMessageModel(this))
     , _errorCount(0)
     , _errorCountTotal(0)
     , _warningCount(0)
@@ -56,7 +302,9 @@ UASMessageHandler::UASMessageHandler(QGCApplication* app, QGCToolbox* toolbox)
 
 UASMessageHandler::~UASMessageHandler()
 {
-    clearMessages();
+    _messageModel->_setStore(nullptr);
+    qDeleteAll(_messageStores);
+    _messageStores.clear();
 }
 
 void UASMessageHandler::setToolbox(QGCToolbox *toolbox)
@@ -65,17 +313,37 @@ void UASMessageHandler::setToolbox(QGCToolbox *toolbox)
 
    _multiVehicleManager = _toolbox->multiVehicleManager();
 
-   connect(_multiVehicleManager, &MultiVehicleManager::activeVehicleChanged, this, &UASMessageHandler::_activeVehicleChanged);
+   connect(_multiVehicleManager, &MultiVehicleManager::activeVehicleChanged,   this, &UASMessageHandler::_activeVehicleChanged);
+   connect(_multiVehicleManager, &MultiVehicleManager::vehicleAdded,           this, &UASMessageHandler::_vehicleAdded);
+   connect(_multiVehicleManager, &MultiVehicleManager::vehicleRemoved,         this, &UASMessageHandler::_vehicleRemoved);
    emit textMessageReceived(nullptr);
    emit textMessageCountChanged(0);
 }
 
+UASMessageStore* UASMessageHandler::_messageStore(int vehicleId)
+{
+    UASMessageStore* store = _messageStores.value(vehicleId, nullptr);
+    if (!store) {
+        store = new UASMessageStore();
+        _messageStores[vehicleId] = store;
+    }
+    return store;
+}
+
+const QList<UASMessage*>& UASMessageHandler::messages()
+{
+    UASMessageStore* store = _activeVehicle ? _messageStores.value(_activeVehicle->id(), nullptr) : nullptr;
+    return store ? store->messages() : _emptyMessages;
+}
+
 void UASMessageHandler::clearMessages()
 {
     _mutex.lock();
-    while(_messages.count()) {
-        delete _messages.last();
-        _messages.pop_back();
+    if (_activeVehicle) {
+        UASMessageStore* store = _messageStores.value(_activeVehicle->id(), nullptr);
+        if (store) {
+            _messageModel->_clear();
+        }
     }
     _errorCount   = 0;
     _warningCount = 0;
@@ -84,121 +352,112 @@ void UASMessageHandler::clearMessages()
     emit textMessageCountChanged(0);
 }
 
-void UASMessageHandler::_activeVehicleChanged(Vehicle* vehicle)
+void UASMessageHandler::_vehicleAdded(Vehicle* vehicle)
 {
-    // If we were already attached to an autopilot, disconnect it.
-    if (_activeVehicle) {
-        disconnect(_activeVehicle, &Vehicle::textMessageReceived, this, &UASMessageHandler::handleTextMessage);
+    connect(vehicle, &Vehicle::textMessageReceived, this, &UASMessageHandler::handleTextMessage);
+}
+
+void UASMessageHandler::_vehicleRemoved(Vehicle* vehicle)
+{
+    disconnect(vehicle, &Vehicle::textMessageReceived, this, &UASMessageHandler::handleTextMessage);
+
+    _mutex.lock();
+    if (_activeVehicle == vehicle) {
         _activeVehicle = nullptr;
-        clearMessages();
-        emit textMessageReceived(nullptr);
+        _messageModel->_setStore(nullptr);
     }
+    delete _messageStores.take(vehicle->id());
+    _activeComponent.remove(vehicle->id());
+    _multiComp.remove(vehicle->id());
+    _mutex.unlock();
+}
+
+void UASMessageHandler::_activeVehicleChanged(Vehicle* vehicle)
+{
+    // Messages for each vehicle are kept in their own store, only the new message counts are reset
+    _mutex.lock();
+    _activeVehicle = vehicle;
+    _errorCount   = 0;
+    _warningCount = 0;
+    _normalCount  = 0;
+    _messageModel->_setStore(vehicle ? _messageStore(vehicle->id()) : nullptr);
+    _mutex.unlock();
+
+    emit textMessageReceived(nullptr);
+    emit textMessageCountChanged(0);
 
-    // And now if there's an autopilot to follow, set up the UI.
     if (vehicle) {
-        // Connect to the new UAS.
-        clearMessages();
-        _activeVehicle = vehicle;
-        connect(_activeVehicle, &Vehicle::textMessageReceived, this, &UASMessageHandler::handleTextMessage);
+        UASMessageStore* store = _messageStores.value(vehicle->id(), nullptr);
+        if (store && store->count()) {
+            emit textMessageCountChanged(store->count());
+        }
     }
 }
 
-void UASMessageHandler::handleTextMessage(int, int compId, int severity, QString text)
+void UASMessageHandler::handleTextMessage(int uasid, int compId, int severity, QString text)
 {
-    // Hack to prevent calibration messages from cluttering things up
-    if (_activeVehicle->px4Firmware() && text.startsWith(QStringLiteral("[cal] "))) {
+    Vehicle* vehicle = _multiVehicleManager->getVehicleById(uasid);
+    if (!vehicle) {
         return;
     }
 
-    // Color the output depending on the message severity. We have 3 distinct cases:
-    // 1: If we have an ERROR or worse, make it bigger, bolder, and highlight it red.
-    // 2: If we have a warning or notice, just make it bold and color it orange.
-    // 3: Otherwise color it the standard color, white.
+    // Hack to prevent calibration messages from cluttering things up
+    if (vehicle->px4Firmware() && text.startsWith(QStringLiteral("[cal] "))) {
+        return;
+    }
 
     _mutex.lock();
 
-    if (_activeComponent < 0) {
-        _activeComponent = compId;
+    if (!_activeComponent.contains(uasid)) {
+        _activeComponent[uasid] = compId;
     }
-
-    if (compId != _activeComponent) {
-        _multiComp = true;
-    }
-
-    // So first determine the styling based on the severity.
-    QString style;
-    switch (severity)
-    {
-    case MAV_SEVERITY_EMERGENCY:
-    case MAV_SEVERITY_ALERT:
-    case MAV_SEVERITY_CRITICAL:
-    case MAV_SEVERITY_ERROR:
-        style = QString("<#E>");
-        _errorCount++;
-        _errorCountTotal++;
-        break;
-    case MAV_SEVERITY_NOTICE:
-    case MAV_SEVERITY_WARNING:
-        style = QString("<#I>");
-        _warningCount++;
-        break;
-    default:
-        style = QString("<#N>");
-        _normalCount++;
-        break;
+    if (compId != _activeComponent[uasid]) {
+        _multiComp[uasid] = true;
     }
 
-    // And determine the text for the severitie
-    QString severityText;
-    switch (severity)
-    {
-    case MAV_SEVERITY_EMERGENCY:
-        severityText = tr(" EMERGENCY:");
-        break;
-    case MAV_SEVERITY_ALERT:
-        severityText = tr(" ALERT:");
-        break;
-    case MAV_SEVERITY_CRITICAL:
-        severityText = tr(" Critical:");
-        break;
-    case MAV_SEVERITY_ERROR:
-        severityText = tr(" Error:");
-        break;
-    case MAV_SEVERITY_WARNING:
-        severityText = tr(" Warning:");
-        break;
-    case MAV_SEVERITY_NOTICE:
-        severityText = tr(" Notice:");
-        break;
-    case MAV_SEVERITY_INFO:
-        severityText = tr(" Info:");
-        break;
-    case MAV_SEVERITY_DEBUG:
-        severityText = tr(" Debug:");
-        break;
-    default:
-        break;
-    }
+    UASMessageStore*    store       = _messageStore(uasid);
+    bool                active      = vehicle == _activeVehicle;
+    bool                showCompId  = _multiComp.value(uasid, false);
+    bool                repeated    = false;
+    // Messages for the active vehicle go through the model so views see the row changes
+    UASMessage*         message     = active ? _messageModel->_add(compId, severity, text, showCompId, &repeated) : store->add(compId, severity, text, showCompId, &repeated);
+    int                 count       = store->count();
 
-    // Finally preppend the properly-styled text with a timestamp.
-    QString dateString = QDateTime::currentDateTime().toString("hh:mm:ss.zzz");
-    UASMessage* message = new UASMessage(compId, severity, text);
-    QString compString;
-    if (_multiComp) {
-        compString = QString(" COMP:%1").arg(compId);
-    }
-    message->_setFormatedText(QString("<font style=\"%1\">[%2%3]%4 %5</font><br/>").arg(style).arg(dateString).arg(compString).arg(severityText).arg(text));
+    if (active) {
+        switch (severity)
+        {
+        case MAV_SEVERITY_EMERGENCY:
+        case MAV_SEVERITY_ALERT:
+        case MAV_SEVERITY_CRITICAL:
+        case MAV_SEVERITY_ERROR:
+            _errorCount++;
+            _errorCountTotal++;
+            break;
+        case MAV_SEVERITY_NOTICE:
+        case MAV_SEVERITY_WARNING:
+            _warningCount++;
+            break;
+        default:
+            _normalCount++;
+            break;
+        }
 
-    if (message->severityIsError()) {
-        _latestError = severityText + " " + text;
+        if (message->severityIsError()) {
+            _latestError = _severityText(severity) + " " + text;
+        }
     }
 
     _mutex.unlock();
 
-    emit textMessageReceived(message);
+    if (!active) {
+        return;
+    }
 
-    _messages.append(message);
-    int count = _messages.count();
+    if (repeated) {
+        emit textMessageRepeated(message);
+    } else {
+        emit textMessageReceived(message);
+    }
     emit textMessageCountChanged(count);
 
     if (_showErrorsInToolbar && message->severityIsError()) {
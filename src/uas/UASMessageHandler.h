@@ -10,8 +10,12 @@
 #pragma once
 
 #include <QObject>
+#include <QAbstractListModel>
 #include <QVector>
 #include <QMutex>
+#include <QHash>
+#include <QMap>
+#include <QDateTime>
 
 #include "QGCToolbox.h"
 
@@ -27,6 +31,8 @@ class QGCApplication;
 class UASMessage
 {
     friend class UASMessageHandler;
+    friend class UASMessageStore;
+    friend class UASMessageModel;
 public:
     /**
      * @brief Get message source component ID
@@ -41,21 +47,102 @@ public:
      */
     QString getText()           { return _text; }
     /**
-     * @brief Get (html) formatted text (in the form: "[11:44:21.137 - COMP:50] Info: [pm] sending list")
+     * @brief Get (html) formatted text (in the form: "[11:44:21.137 - COMP:50] Info: [pm] sending list x37")
+     * The text is only formatted on first request after the message changes.
      */
-    QString getFormatedText()   { return _formatedText; }
+    QString getFormatedText();
+    /**
+     * @brief Number of times this message was received. Repeats of the same text are folded into a single message.
+     */
+    int getRepeatCount() const       { return _repeatCount; }
     /**
      * @return true: This message is a of a severity which is considered an error
      */
     bool severityIsError() const;
 
 private:
-    UASMessage(int componentid, int severity, QString text);
-    void _setFormatedText(const QString formatedText) { _formatedText = formatedText; }
-    int _compId;
-    int _severity;
-    QString _text;
-    QString _formatedText;
+    UASMessage(int componentid, int severity, QString text, bool showCompId);
+    void _repeated();
+
+    int         _compId;
+    int         _severity;
+    QString     _text;
+    QString     _formatedText;      ///< Empty until requested
+    QDateTime   _timestamp;         ///< Time of the most recent repeat
+    int         _repeatCount;
+    bool        _showCompId;
+};
+
+/*!
+ * @class UASMessageStore
+ * @brief Bounded message list for a single vehicle, indexed by severity and component
+ * Once full the oldest messages are discarded. Repeats of a (component, severity, text) message which is
+ * still in the store are folded into it rather than adding a new message.
+ */
+class UASMessageStore
+{
+    friend class UASMessageModel;
+public:
+    UASMessageStore(int maxMessages = defaultMaxMessages);
+    ~UASMessageStore();
+
+    /// Adds the message to the store
+    ///     @return The new message, or the existing message which was repeated
+    UASMessage* add(int compId, int severity, const QString& text, bool showCompId, bool* repeated = nullptr);
+    void        clear();
+    /// @return The message in the store with the same component, severity and text, nullptr if none
+    UASMessage* find(int compId, int severity, const QString& text) const;
+
+    const QList<UASMessage*>&   messages            () const { return _messages; }
+    QList<UASMessage*>          messagesForComponent(int compId) const { return _componentIndex.value(compId); }
+    QList<UASMessage*>          messagesForSeverity (int severity) const;
+    int                         count               () const { return _messages.count(); }
+    int                         maxMessages         () const { return _maxMessages; }
+
+    static const int defaultMaxMessages = 500;
+
+private:
+    typedef QPair<int /* compId << 8 | severity */, QString /* text */> DedupKey_t;
+
+    void _removeOldest();
+
+    int                                 _maxMessages;
+    QList<UASMessage*>                  _messages;              ///< Oldest first
+    QHash<DedupKey_t, UASMessage*>      _dedupIndex;
+    QHash<int, QList<UASMessage*>>      _componentIndex;
+    QList<UASMessage*>                  _severityIndex[8];      ///< Indexed by MAV_SEVERITY
+};
+
+/*!
+ * @class UASMessageModel
+ * @brief List model over the message store of the active vehicle, one row per message with the oldest first
+ * A repeated message only changes its own row, so views do not need to rebuild the whole message list.
+ */
+class UASMessageModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    friend class UASMessageHandler;
+public:
+    enum Roles {
+        FormattedTextRole = Qt::UserRole + 1,
+        SeverityRole,
+        RepeatCountRole,
+    };
+
+    UASMessageModel(QObject* parent = nullptr);
+
+    // Overrides from QAbstractListModel
+    int                     rowCount    (const QModelIndex& parent = QModelIndex()) const override;
+    QVariant                data        (const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray>  roleNames   (void) const override;
+
+private:
+    void        _setStore   (UASMessageStore* store);
+    UASMessage* _add        (int compId, int severity, const QString& text, bool showCompId, bool* repeated);
+    void        _clear      (void);
+
+    UASMessageStore* _store = nullptr;
 };
 
 class UASMessageHandler : public QGCTool
@@ -75,11 +162,19 @@ public:
      */
     void unlockAccess() {_mutex.unlock(); }
     /**
-     * @brief Access to the message list
+     * @brief Access to the message list for the active vehicle
      */
-    const QVector<UASMessage*>& messages() { return _messages; }
+    const QList<UASMessage*>& messages();
     /**
-     * @brief Clear messages
+     * @brief Message store for the specified vehicle, nullptr if none
+     */
+    const UASMessageStore* messageStore(int vehicleId) const { return _messageStores.value(vehicleId); }
+    /**
+     * @brief List model of the messages for the active vehicle
+     */
+    UASMessageModel* messageModel() { return _messageModel; }
+    /**
+     * @brief Clear messages for the active vehicle
      */
     void clearMessages();
     /**
@@ -121,10 +216,15 @@ public slots:
 
 signals:
     /**
-     * @brief Sent out when new message arrives
+     * @brief Sent out when new message arrives for the active vehicle
      * @param message A pointer to the message. NULL if resetting (new UAS assigned)
      */
     void textMessageReceived(UASMessage* message);
+    /**
+     * @brief Sent out when a message for the active vehicle is a repeat of a message already in the list
+     * @param message The message whose repeat count changed
+     */
+    void textMessageRepeated(UASMessage* message);
     /**
      * @brief Sent out when the message count changes
      * @param count The new message count
@@ -133,19 +233,25 @@ signals:
 
 private slots:
     void _activeVehicleChanged(Vehicle* vehicle);
+    void _vehicleAdded        (Vehicle* vehicle);
+    void _vehicleRemoved      (Vehicle* vehicle);
 
 private:
-    Vehicle*                _activeVehicle;
-    int                     _activeComponent;
-    bool                    _multiComp;
-    QVector<UASMessage*>    _messages;
-    QMutex                  _mutex;
-    int                     _errorCount;
-    int                     _errorCountTotal;
-    int                     _warningCount;
-    int                     _normalCount;
-    QString                 _latestError;
-    bool                    _showErrorsInToolbar;
-    MultiVehicleManager*    _multiVehicleManager;
+    UASMessageStore* _messageStore(int vehicleId);
+
+    Vehicle*                    _activeVehicle;
+    QMap<int, int>              _activeComponent;   ///< First component heard from, per vehicle id
+    QMap<int, bool>             _multiComp;         ///< Messages from more than one component, per vehicle id
+    QMap<int, UASMessageStore*> _messageStores;     ///< Per vehicle id
+    QList<UASMessage*>          _emptyMessages;
+    UASMessageModel*            _messageModel;
+    QMutex                      _mutex;
+    int                         _errorCount;
+    int                         _errorCountTotal;
+    int                         _warningCount;
+    int                         _normalCount;
+    QString                     _latestError;
+    bool                        _showErrorsInToolbar;
+    MultiVehicleManager*        _multiVehicleManager;
 };
 
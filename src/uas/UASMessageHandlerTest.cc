@@ -0,0 +1,165 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "UASMessageHandlerTest.h"
+#include "UASMessageHandler.h"
+#include "QGCApplication.h"
+#include "MultiVehicleManager.h"
+#include "Vehicle.h"
+
+#include <QSignalSpy>
+
+void UASMessageHandlerTest::_storeRepeats(void)
+{
+    UASMessageStore store;
+    bool            repeated = true;
+
+    UASMessage* message = store.add(1, MAV_SEVERITY_WARNING, QStringLiteral("Preflight Fail: Compass not calibrated"), false, &repeated);
+    QVERIFY(!repeated);
+    QVERIFY(message->getFormatedText().endsWith(QStringLiteral("Preflight Fail: Compass not calibrated</font><br/>")));
+
+    for (int i = 1; i < 37; i++) {
+        QCOMPARE(store.add(1, MAV_SEVERITY_WARNING, QStringLiteral("Preflight Fail: Compass not calibrated"), false, &repeated), message);
+        QVERIFY(repeated);
+    }
+    QCOMPARE(store.count(), 1);
+    QCOMPARE(message->getRepeatCount(), 37);
+    QVERIFY(message->getFormatedText().contains(QStringLiteral("Preflight Fail: Compass not calibrated x37")));
+
+    // Same text from a different component or at a different severity is a different message
+    QVERIFY(store.add(2, MAV_SEVERITY_WARNING, QStringLiteral("Preflight Fail: Compass not calibrated"), true, &repeated) != message);
+    QVERIFY(!repeated);
+    QVERIFY(store.add(1, MAV_SEVERITY_CRITICAL, QStringLiteral("Preflight Fail: Compass not calibrated"), true, &repeated) != message);
+    QVERIFY(!repeated);
+    QCOMPARE(store.count(), 3);
+    QCOMPARE(store.messagesForComponent(1).count(), 2);
+    QCOMPARE(store.messagesForComponent(2).count(), 1);
+    QCOMPARE(store.messagesForSeverity(MAV_SEVERITY_WARNING).count(), 2);
+    QCOMPARE(store.messagesForSeverity(MAV_SEVERITY_CRITICAL).count(), 1);
+}
+
+void UASMessageHandlerTest::_storeLimit(void)
+{
+    const int       maxMessages = 10;
+    UASMessageStore store(maxMessages);
+
+    for (int i = 0; i < 25; i++) {
+        store.add(i % 2, i % 8, QStringLiteral("Message %1").arg(i), false);
+    }
+    QCOMPARE(store.count(), maxMessages);
+    QCOMPARE(store.messages().first()->getText(), QStringLiteral("Message 15"));
+    QCOMPARE(store.messages().last()->getText(), QStringLiteral("Message 24"));
+
+    // Indices only reference messages still in the store
+    int componentTotal = 0;
+    int severityTotal = 0;
+    for (int i = 0; i < 8; i++) {
+        componentTotal += store.messagesForComponent(i).count();
+        severityTotal += store.messagesForSeverity(i).count();
+    }
+    QCOMPARE(componentTotal, maxMessages);
+    QCOMPARE(severityTotal, maxMessages);
+    for (UASMessage* message: store.messagesForComponent(0)) {
+        QVERIFY(store.messages().contains(message));
+    }
+
+    // A discarded message is added as new, not as a repeat
+    bool repeated = true;
+    store.add(0, 0, QStringLiteral("Message 0"), false, &repeated);
+    QVERIFY(!repeated);
+    QCOMPARE(store.count(), maxMessages);
+    QCOMPARE(store.messages().first()->getText(), QStringLiteral("Message 16"));
+}
+
+void UASMessageHandlerTest::_activeVehicle(void)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+
+    UASMessageHandler*  handler = qgcApp()->toolbox()->uasMessageHandler();
+    Vehicle*            vehicle = qgcApp()->toolbox()->multiVehicleManager()->activeVehicle();
+    QVERIFY(vehicle);
+
+    handler->clearMessages();
+    QCOMPARE(handler->messages().count(), 0);
+
+    QSignalSpy receivedSpy(handler, &UASMessageHandler::textMessageReceived);
+    QSignalSpy repeatedSpy(handler, &UASMessageHandler::textMessageRepeated);
+
+    for (int i = 0; i < 5; i++) {
+        handler->handleTextMessage(vehicle->id(), MAV_COMP_ID_AUTOPILOT1, MAV_SEVERITY_ERROR, QStringLiteral("Battery low"));
+    }
+    QCOMPARE(receivedSpy.count(), 1);
+    QCOMPARE(repeatedSpy.count(), 4);
+    QCOMPARE(handler->messages().count(), 1);
+    QCOMPARE(handler->messages().first()->getRepeatCount(), 5);
+    QCOMPARE(handler->getErrorCount(), 5);
+    QVERIFY(handler->messageStore(vehicle->id()));
+
+    // Messages for unknown vehicles are ignored
+    handler->handleTextMessage(vehicle->id() + 1, MAV_COMP_ID_AUTOPILOT1, MAV_SEVERITY_ERROR, QStringLiteral("Battery low"));
+    QCOMPARE(receivedSpy.count(), 1);
+    QCOMPARE(repeatedSpy.count(), 4);
+
+    _disconnectMockLink();
+    QVERIFY(!handler->messageStore(vehicle->id()));
+    QCOMPARE(handler->messages().count(), 0);
+}
+
+void UASMessageHandlerTest::_messageModel(void)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+
+    UASMessageHandler*  handler = qgcApp()->toolbox()->uasMessageHandler();
+    UASMessageModel*    model   = handler->messageModel();
+    Vehicle*            vehicle = qgcApp()->toolbox()->multiVehicleManager()->activeVehicle();
+    QVERIFY(vehicle);
+    QCOMPARE(vehicle->messageModel(), static_cast<QAbstractListModel*>(model));
+
+    handler->clearMessages();
+    QCOMPARE(model->rowCount(), 0);
+
+    QSignalSpy insertedSpy  (model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removedSpy   (model, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy changedSpy   (model, &QAbstractItemModel::dataChanged);
+
+    for (int i = 0; i < 3; i++) {
+        handler->handleTextMessage(vehicle->id(), MAV_COMP_ID_AUTOPILOT1, MAV_SEVERITY_INFO, QStringLiteral("Message %1").arg(i));
+    }
+    QCOMPARE(model->rowCount(), 3);
+    QCOMPARE(insertedSpy.count(), 3);
+    QCOMPARE(insertedSpy.last()[1].toInt(), 2);
+    QCOMPARE(changedSpy.count(), 0);
+
+    // A repeat only changes the row of the repeated message
+    handler->handleTextMessage(vehicle->id(), MAV_COMP_ID_AUTOPILOT1, MAV_SEVERITY_INFO, QStringLiteral("Message 1"));
+    QCOMPARE(model->rowCount(), 3);
+    QCOMPARE(insertedSpy.count(), 3);
+    QCOMPARE(changedSpy.count(), 1);
+    QCOMPARE(changedSpy[0][0].value<QModelIndex>().row(), 1);
+    QCOMPARE(changedSpy[0][1].value<QModelIndex>().row(), 1);
+    QVERIFY(model->data(model->index(1), UASMessageModel::FormattedTextRole).toString().contains(QStringLiteral("Message 1 x2")));
+    QVERIFY(!model->data(model->index(0), UASMessageModel::FormattedTextRole).toString().contains(QStringLiteral(" x2")));
+
+    // Once the store is full the oldest row is removed before the new one is added at the end
+    const int maxMessages = handler->messageStore(vehicle->id())->maxMessages();
+    for (int i = 3; i < maxMessages + 1; i++) {
+        handler->handleTextMessage(vehicle->id(), MAV_COMP_ID_AUTOPILOT1, MAV_SEVERITY_INFO, QStringLiteral("Message %1").arg(i));
+    }
+    QCOMPARE(model->rowCount(), maxMessages);
+    QCOMPARE(removedSpy.count(), 1);
+    QCOMPARE(removedSpy[0][1].toInt(), 0);
+    QVERIFY(model->data(model->index(0), UASMessageModel::FormattedTextRole).toString().contains(QStringLiteral("Message 1 x2")));
+    QVERIFY(model->data(model->index(maxMessages - 1), UASMessageModel::FormattedTextRole).toString().contains(QStringLiteral("Message %1").arg(maxMessages)));
+
+    handler->clearMessages();
+    QCOMPARE(model->rowCount(), 0);
+
+    _disconnectMockLink();
+    QCOMPARE(model->rowCount(), 0);
+}
@@ -345,6 +345,26 @@ Rectangle {
                                             onEditingFinished:
                                                 QGroundControl.videoManager.updateStream(index, modelData.ip, text)
                                         }
+                                        TextField {
+                                            style: TextFieldStyle {
+                                                background: Rectangle {
+                                                    implicitWidth:  ipField.implicitWidth
+                                                    implicitHeight: ipField.implicitHeight
+                                                    color:          "white"
+                                                    radius:         4
+                                                    border.color:   "#888"
+                                                    border.width:   1
+                                                }
+                                            }
+                                            text:             modelData.latency
+                                            height:           FactTextField.height
+                                            Layout.preferredWidth: ScreenTools.defaultFontPixelWidth * 8
+                                            placeholderText:  qsTr("ms")
+                                            validator:        IntValidator { bottom: -1 }
+                                            Layout.bottomMargin: 5
+                                            onEditingFinished:
+                                                QGroundControl.videoManager.setStreamLatency(index, parseInt(text))
+                                        }
                                         QGCColoredImage {
                                             source:         "/qmlimages/trash.svg"
                                             width:          ScreenTools.defaultFontPixelHeight
@@ -46,6 +46,8 @@ GridLayout {
         }
         subEditConfig.sendStatus = sendStatus.checked
         subEditConfig.incrementVehicleId = incrementVehicleId.checked
+        subEditConfig.swarmCount = parseInt(swarmCountField.text) || 0
+        subEditConfig.swarmLossPercent = parseInt(swarmLossField.text) || 0
     }
 
     Component.onCompleted: {
@@ -100,4 +102,26 @@ GridLayout {
         model:                  [ qsTr("ArduCopter"), qsTr("ArduPlane") ]
         visible:                firmwareTypeCombo.apmFirmwareSelected
     }
+
+    QGCLabel { text: qsTr("Swarm Vehicles") }
+    QGCTextField {
+        id:                     swarmCountField
+        Layout.preferredWidth:  _secondColumnWidth
+        text:                   subEditConfig.swarmCount
+        inputMethodHints:       Qt.ImhDigitsOnly
+        validator:              IntValidator { bottom: 0; top: 127 }
+    }
+
+    QGCLabel {
+        text:       qsTr("Swarm Loss %")
+        visible:    parseInt(swarmCountField.text) > 0
+    }
+    QGCTextField {
+        id:                     swarmLossField
+        Layout.preferredWidth:  _secondColumnWidth
+        text:                   subEditConfig.swarmLossPercent
+        inputMethodHints:       Qt.ImhDigitsOnly
+        validator:              IntValidator { bottom: 0; top: 100 }
+        visible:                parseInt(swarmCountField.text) > 0
+    }
 }
@@ -87,30 +87,25 @@ Item {
                 message = message.replace(new RegExp("<#E>", "g"), "color: " + qgcPal.warningText + "; font: " + (ScreenTools.defaultFontPointSize.toFixed(0) - 1) + "pt monospace;");
                 message = message.replace(new RegExp("<#I>", "g"), "color: " + qgcPal.warningText + "; font: " + (ScreenTools.defaultFontPointSize.toFixed(0) - 1) + "pt monospace;");
                 message = message.replace(new RegExp("<#N>", "g"), "color: " + qgcPal.text + "; font: " + (ScreenTools.defaultFontPointSize.toFixed(0) - 1) + "pt monospace;");
+                //-- Each message has its own delegate, the line break would only add an empty line below it
+                message = message.replace(new RegExp("<br/>$"), "");
                 return message;
             }
 
             Component.onCompleted: {
-                messageText.text = formatMessage(_activeVehicle.formattedMessages)
-                //-- Hack to scroll to last message
-                for (var i = 0; i < _activeVehicle.messageCount; i++)
-                    messageFlick.flick(0,-5000)
+                messageList.positionViewAtEnd()
                 _activeVehicle.resetMessages()
             }
 
             Connections {
-                target: _activeVehicle
-                onNewFormattedMessage :{
-                    messageText.append(formatMessage(formattedMessage))
-                    //-- Hack to scroll down
-                    messageFlick.flick(0,-500)
-                }
+                target: _activeVehicle ? _activeVehicle.messageModel : null
+                onRowsInserted: messageList.positionViewAtEnd()
             }
 
             QGCLabel {
                 anchors.centerIn:   parent
                 text:               qsTr("No Messages")
-                visible:            messageText.length === 0
+                visible:            messageList.count === 0
             }
 
             //-- Clear Messages
@@ -126,7 +121,7 @@ Item {
                 mipmap:             true
                 smooth:             true
                 color:              qgcPal.text
-                visible:            messageText.length !== 0
+                visible:            messageList.count !== 0
                 MouseArea {
                     anchors.fill:   parent
                     onClicked: {
@@ -138,19 +133,20 @@ Item {
                 }
             }
 
-            QGCFlickable {
-                id:                 messageFlick
+            QGCListView {
+                id:                 messageList
                 anchors.margins:    ScreenTools.defaultFontPixelHeight
                 anchors.fill:       parent
-                contentHeight:      messageText.height
-                contentWidth:       messageText.width
+                clip:               true
                 pixelAligned:       true
-
-                TextEdit {
-                    id:             messageText
-                    readOnly:       true
-                    textFormat:     TextEdit.RichText
-                    color:          qgcPal.text
+                model:              _activeVehicle ? _activeVehicle.messageModel : null
+
+                //-- One delegate per message, a repeated message only updates its own row
+                delegate: QGCLabel {
+                    width:          messageList.width
+                    textFormat:     Text.RichText
+                    wrapMode:       Text.WordWrap
+                    text:           formatMessage(formattedText)
                 }
             }
         }